@@ -26,6 +26,7 @@
 
 /* 3. The Drivers (Hardware Abstraction) */
 #include "stm32f446xx_adc_driver.h"
+#include "stm32f446xx_dma_driver.h"
 #include "stm32f446xx_gpio_driver.h"
 #include "stm32f446xx_i2c_driver.h"
 #include "stm32f446xx_usart_driver.h"
@@ -40,6 +41,9 @@
 #include "bsp_relay.h"
 #include "bsp_ldr.h"
 #include "bsp_i2c_oled.h"
+#include "bsp_oled_font.h"
+#include "bsp_oled_gfx.h"
+#include "bsp_oled_image.h"
 #include "bsp_lcd.h"
 #include "bsp_keypad.h"
 #include "bsp_delay.h"
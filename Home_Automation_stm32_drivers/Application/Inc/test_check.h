@@ -0,0 +1,44 @@
+/*
+ * test_check.h
+ *
+ *  Created on: Mar 12, 2026
+ *      Author: Rahul B.
+ *
+ * Pass/fail bookkeeping of the Unit_Tests_Example programs. Each program
+ * includes it once (everything here is static): Check() counts and prints
+ * a failure, Test_Summary() prints the last line, which the host runners
+ * and the serial log are read for:
+ *
+ *   ===== ALL PASSED (0 failures) =====
+ *   ===== FAILED (2 failures) =====
+ */
+
+#ifndef INC_TEST_CHECK_H_
+#define INC_TEST_CHECK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bsp_uart2_debug.h"
+
+static uint8_t g_failures = 0;
+
+/**
+ * @brief Count a failed check and name it on the log, passing checks are silent
+ */
+static inline void Check(bool ok, const char *what)
+{
+    if (!ok) {
+        g_failures++;
+        UART_Printf("[FAIL] %s\r\n", what);
+    }
+}
+
+/**
+ * @brief Print the verdict line of the program
+ */
+static inline void Test_Summary(void)
+{
+    UART_Printf("===== %s (%u failures) =====\r\n", g_failures ? "FAILED" : "ALL PASSED", g_failures);
+}
+
+#endif /* INC_TEST_CHECK_H_ */
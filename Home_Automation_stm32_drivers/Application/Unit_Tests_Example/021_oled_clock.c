@@ -92,12 +92,14 @@ int main(void)
         // Print Header (Inverted colors logic if you had it, or just text)
         OLED_Printf(0, 0, ">> Rahul's CLOCK <<");
 
-        // Print Time (Large format if font supported, otherwise standard)
-        // Centering text: (128 - (8chars * 5px)) / 2 = approx x=40
-        OLED_Printf(30, 20, "%02d:%02d:%02d", h, m, s);
+        // Print Time in the 24 px digits, centred (tabular: it does not jump)
+        char time_str[12];
+        snprintf(time_str, sizeof(time_str), "%02d:%02d:%02d", h, m, s);
+        BSP_OLED_DrawText((OLED_WIDTH - OledFont_TextWidth(&Font_Digits24, time_str)) / 2, 16,
+                          &Font_Digits24, time_str);
 
         // Print Date
-        OLED_Printf(10, 40, "%s, %02d/%02d/20%02d", days[W], D, M, Y);
+        OLED_Printf(10, 48, "%s, %02d/%02d/20%02d", days[W], D, M, Y);
 
         // C. Push to Display
         BSP_OLED_Update();
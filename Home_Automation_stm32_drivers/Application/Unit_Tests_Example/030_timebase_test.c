@@ -0,0 +1,269 @@
+/*
+ * 030_timebase_test.c
+ *
+ * Created on: Feb 14, 2026
+ * Author: Rahul B.
+ * Description: Checks for the SysTick / 64-bit TIM2 timebase
+ *
+ * On the target:
+ *
+ * 1. SysTick rate   : 1 s on the us clock must give 1000 +/- 1 ms ticks
+ * 2. TIM2 wrap      : counter is forced just below 2^32, now_us() must stay
+ *                     monotonic and continue past 0xFFFFFFFF
+ * 3. Clock change   : drop to HSI 16 MHz and back to 180 MHz, both clocks
+ *                     must stay monotonic and agree with each other
+ * 4. Deadlines      : a 50 ms deadline must expire within [50, 51) ms
+ *
+ * On a host build, where TIM2 and SysTick are registers in RAM
+ * (g_TimebaseHost*) that only the test moves:
+ *
+ * 5. Wrap, stepped  : CNT wraps between two now_us() calls, and between two
+ *                     SysTicks with no read in between
+ * 6. Wrap, racing   : one thread runs CNT through 64 wraps while another
+ *                     plays SysTick_Handler and main() reads now_us(): every
+ *                     read is monotonic and within the true 64-bit count,
+ *                     and no wrap is counted twice or missed
+ *
+ * Host build: link bsp_timebase.c with -pthread, UART_Printf mapped to
+ * printf and app_init() stubbed out. The RCC and timer calls of the
+ * timebase are provided here.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "bsp_uart2_debug.h"
+#include "stm32f446xx_rcc_driver.h"
+#include "stm32f446xx_timer_driver.h"
+#include "test_check.h"
+
+#if defined(__arm__)
+/* ===== TEST 1: SysTick period ===== */
+static void Test_TickRate(void)
+{
+    uint64_t ms0 = now_ms();
+    uint64_t us0 = now_us();
+
+    while ((now_us() - us0) < 1000000U);
+
+    uint32_t ticks = (uint32_t)(now_ms() - ms0);
+    UART_Printf("  1 s on TIM2 = %u SysTicks\r\n", ticks);
+    Check((ticks >= 999U) && (ticks <= 1001U), "SysTick 1 kHz");
+}
+
+/* ===== TEST 2: 32-bit TIM2 wrap ===== */
+static void Test_Wrap(void)
+{
+    uint64_t prev, now, start;
+    uint8_t monotonic = 1;
+
+    /* Jump ~4295 s forward, 20 ms before the 32-bit boundary */
+    TIMER_SetCounter(TIM2, 0xFFFFFFFFUL - 20000U);
+    start = prev = now_us();
+
+    while ((now_us() - start) < 50000U)
+    {
+        now = now_us();
+        if (now < prev) monotonic = 0;
+        prev = now;
+    }
+
+    Check(monotonic, "now_us monotonic across wrap");
+    Check((prev >> 32) != 0, "now_us beyond 32 bits");
+}
+
+/* ===== TEST 3: clock tree change ===== */
+static void Test_ClockChange(void)
+{
+    uint64_t us0 = now_us();
+    uint64_t ms0 = now_ms();
+    uint64_t prev = us0, now;
+    uint8_t monotonic = 1;
+
+    /* UART baud is wrong while on HSI, so stay silent until restored */
+    RCC_SetSystemClock_HSI();
+    while ((now_us() - us0) < 200000U)
+    {
+        now = now_us();
+        if (now < prev) monotonic = 0;
+        prev = now;
+    }
+    RCC_Config_MaxSpeed();
+
+    while ((now_us() - us0) < 400000U)
+    {
+        now = now_us();
+        if (now < prev) monotonic = 0;
+        prev = now;
+    }
+
+    uint32_t d_us = (uint32_t)(now_us() - us0);
+    uint32_t d_ms = (uint32_t)(now_ms() - ms0);
+    UART_Printf("  HSI/PLL round trip: %u us vs %u ms\r\n", d_us, d_ms);
+
+    Check(monotonic, "now_us monotonic across clock change");
+    Check((d_ms + 2U >= d_us / 1000U) && (d_ms <= d_us / 1000U + 2U), "ms and us agree (+/-2 ms)");
+    Check(SYSTICK->RVR == (RCC_GetHCLKFreq() / 1000U) - 1U, "SysTick reload follows HCLK");
+}
+
+/* ===== TEST 4: deadline helpers ===== */
+static void Test_Deadline(void)
+{
+    uint64_t start = now_us();
+    uint64_t d = deadline_after_ms(50);
+
+    Check(!deadline_expired(d), "deadline not expired early");
+    Check(deadline_remaining_ms(d) == 50U, "remaining_ms == 50");
+
+    while (!deadline_expired(d));
+
+    uint32_t took = (uint32_t)(now_us() - start);
+    UART_Printf("  50 ms deadline took %u us\r\n", took);
+    Check((took >= 50000U) && (took < 51000U), "deadline window");
+    Check(deadline_remaining_ms(d) == 0U, "remaining_ms == 0 after expiry");
+}
+
+#else
+/* ===== HOST: TIM2 AND SYSTICK IN RAM ===== */
+#include <pthread.h>
+#include <sched.h>
+
+#define RACE_STEP       0x01000000UL    // 256 steps per 32-bit lap
+#define RACE_WRAPS      64U
+
+TIM_RegDef_t     g_TimebaseHostTIM2;
+SysTick_RegDef_t g_TimebaseHostSysTick;
+SCB_RegDef_t     g_TimebaseHostSCB;
+
+uint32_t RCC_GetHCLKFreq(void) { return 16000000U; }
+void TIMER_DelayInit(void) { }
+void TIMER_SetCounter(TIM_RegDef_t *pTIMx, uint32_t Counter) { pTIMx->CNT = Counter; }
+
+void SysTick_Handler(void);
+
+/* ===== TEST 5: wrap between reads and between ticks ===== */
+static void Test_WrapStepped(void)
+{
+    uint64_t before, after;
+
+    g_TimebaseHostTIM2.CNT = 0xFFFFFF00UL;
+    BSP_Timebase_Init();
+
+    before = now_us();
+    g_TimebaseHostTIM2.CNT = 0x100U;            // wraps between two reads
+    after = now_us();
+    Check((before == 0xFFFFFF00ULL) && (after == 0x100000100ULL), "wrap between two now_us()");
+
+    g_TimebaseHostTIM2.CNT = 0xFFFFFFF0UL;
+    SysTick_Handler();
+    g_TimebaseHostTIM2.CNT = 0x10U;             // only the tick samples it
+    SysTick_Handler();
+    Check((now_us() == 0x200000010ULL) && (now_ms() == 2U), "wrap seen by SysTick alone");
+}
+
+/* ===== TEST 6: wrap while now_us() is read ===== */
+static volatile uint64_t g_true;                // the count CNT would have in 64 bits
+static volatile uint32_t g_reads;               // now_us() calls completed by main()
+static volatile uint32_t g_ticks;
+static volatile uint8_t  g_done;
+
+/* TIM2: runs CNT forward a 256th of a lap per step */
+static void *Counter_Thread(void *arg)
+{
+    uint32_t wraps = 0;
+    uint32_t reads;
+
+    (void)arg;
+    while (wraps < RACE_WRAPS)
+    {
+        uint64_t next = g_true + RACE_STEP;
+
+        if ((uint32_t)next < (uint32_t)g_true) wraps++;
+
+        /* As on the target, samples must come less than a lap apart: a
+         * full read runs after each step, the wrap lands anywhere in it */
+        reads = g_reads;
+        __atomic_store_n(&g_true, next, __ATOMIC_SEQ_CST);
+        g_TimebaseHostTIM2.CNT = (uint32_t)next;
+        while (g_reads < reads + 2U) sched_yield();
+    }
+    g_done = 1;
+    return NULL;
+}
+
+/* SysTick: interrupts the reader at random points */
+static void *Tick_Thread(void *arg)
+{
+    (void)arg;
+    while (!g_done)
+    {
+        SysTick_Handler();
+        g_ticks++;
+        sched_yield();
+    }
+    return NULL;
+}
+
+static void Test_WrapRacing(void)
+{
+    pthread_t counter, tick;
+    uint64_t prev = 0, before, us, after;
+    uint32_t bad = 0, laps = 0;
+    uint8_t monotonic = 1;
+
+    g_TimebaseHostTIM2.CNT = 0xF0000000UL;
+    g_true = 0xF0000000UL;
+    BSP_Timebase_Init();
+    g_ticks = 0;
+
+    pthread_create(&tick, NULL, Tick_Thread, NULL);
+    pthread_create(&counter, NULL, Counter_Thread, NULL);
+
+    while (!g_done)
+    {
+        before = __atomic_load_n(&g_true, __ATOMIC_SEQ_CST);
+        us = now_us();
+        after = __atomic_load_n(&g_true, __ATOMIC_SEQ_CST);
+        g_reads++;
+
+        if (us < prev) monotonic = 0;
+        if ((us + RACE_STEP < before) || (us > after)) bad++;
+        if ((us >> 32) != (prev >> 32)) laps++;
+        prev = us;
+        sched_yield();
+    }
+    pthread_join(counter, NULL);
+    pthread_join(tick, NULL);
+
+    UART_Printf("  %u reads saw %u laps, %u ticks ran alongside\r\n", g_reads, laps, g_ticks);
+    Check(monotonic, "now_us monotonic while CNT wraps");
+    Check(bad == 0, "every read within the true count");
+    Check(now_us() == g_true, "no wrap lost or counted twice");
+    Check(now_ms() == g_ticks, "every SysTick counted");
+}
+#endif
+
+int main(void)
+{
+    app_init();
+
+    UART_Printf("\r\n===== 030 Timebase Test =====\r\n");
+
+#if defined(__arm__)
+    Test_TickRate();
+    Test_Wrap();
+    Test_ClockChange();
+    Test_Deadline();
+#else
+    Test_WrapStepped();
+    Test_WrapRacing();
+#endif
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,120 @@
+/*
+ * 031_scheduler_key_latency.c
+ *
+ * Created on: Feb 15, 2026
+ * Author: Rahul B.
+ * Description: Keypress-to-handled latency through the cooperative scheduler
+ *
+ * Boots the real application tasks (StateMachine_Init), then walks the FSM
+ * through every state by injecting keys with Keypad_InjectKey(). For each key
+ * the time from injection until the FSM has consumed it and reached the
+ * expected state is measured while the dispatcher runs normally.
+ *
+ * Pass criterion: latency <= one FSM period + the longest slice any other
+ * task took (a run-to-completion task that is already running cannot be
+ * pre-empted). The numbers are printed so the bound can be tracked.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "main.h"
+#include "scheduler.h"
+#include "bsp_timebase.h"
+#include "test_check.h"
+
+static uint32_t g_worst_us = 0;
+
+/**
+ * @brief Longest slice of any task other than the FSM so far
+ */
+static uint32_t Other_Task_MaxSlice(void)
+{
+    uint32_t worst = 0;
+
+    for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+        const Task_t *t = Scheduler_GetTask(id);
+        if (!t->used || strcmp(t->name, "fsm") == 0) continue;
+        if (t->maxExecUs > worst) worst = t->maxExecUs;
+    }
+    return worst;
+}
+
+/**
+ * @brief Inject one key and run the scheduler until it is handled
+ */
+static void Expect(const char *what, char key, SystemState_t expected)
+{
+    Keypad_InjectKey(key);
+    uint64_t t0 = now_us();
+
+    while (Keypad_InjectPending() || g_SystemContext.currentState != expected) {
+        if ((now_us() - t0) > 2000000U) {
+            UART_Printf("  [FAIL] %-22s '%c' timeout (state %d)\r\n", what, key, g_SystemContext.currentState);
+            g_failures++;
+            return;
+        }
+        Scheduler_Dispatch();
+    }
+
+    uint32_t latency = (uint32_t)(now_us() - t0);
+    uint32_t bound = (FSM_TASK_PERIOD_MS * 1000U) + Other_Task_MaxSlice();
+    uint8_t ok = (latency <= bound);
+
+    if (latency > g_worst_us) g_worst_us = latency;
+    if (!ok) g_failures++;
+
+    UART_Printf("  [%s] %-22s '%c' %6u us (bound %6u us)\r\n",
+                ok ? "PASS" : "FAIL", what, key, latency, bound);
+}
+
+static void Run_For_Ms(uint32_t ms)
+{
+    uint64_t t0 = now_us();
+    while ((now_us() - t0) < (ms * 1000U)) Scheduler_Dispatch();
+}
+
+int main(void)
+{
+    StateMachine_Init();
+
+    UART_Printf("\r\n===== 031 Scheduler Key Latency =====\r\n");
+    Run_For_Ms(100);   // settle: first pass of every task
+
+    Expect("STANDBY wake",        '1', STATE_AUTHENTICATING);
+    Expect("AUTH digit 1",        '1', STATE_AUTHENTICATING);
+    Expect("AUTH digit 2",        '2', STATE_AUTHENTICATING);
+    Expect("AUTH digit 3",        '3', STATE_AUTHENTICATING);
+    Expect("AUTH digit 4 -> menu",'4', STATE_ACTIVE_MENU);
+    Expect("MENU down",           KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU select control", KEY_ENTER, STATE_CONTROL_DEVICES);
+    Expect("CONTROL down",        KEY_DOWN, STATE_CONTROL_DEVICES);
+    Expect("CONTROL back",        KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU up",             KEY_UP, STATE_ACTIVE_MENU);
+    Expect("MENU select sensors", KEY_ENTER, STATE_SENSOR_MONITOR);
+    Expect("SENSOR back",         KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU down",           KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU down",           KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU select settings",KEY_ENTER, STATE_SETTINGS);
+    Expect("SETTINGS back",       KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU logout",         KEY_LOGOUT, STATE_STANDBY);
+
+    /* Four wrong PINs lead to LOCKOUT */
+    Expect("STANDBY wake",        '1', STATE_AUTHENTICATING);
+    for (int attempt = 0; attempt <= MAX_LOGIN_ATTEMPTS; attempt++) {
+        for (int d = 0; d < PIN_LENGTH; d++) {
+            SystemState_t next = (attempt == MAX_LOGIN_ATTEMPTS && d == PIN_LENGTH - 1)
+                                 ? STATE_LOCKOUT : STATE_AUTHENTICATING;
+            Expect("AUTH wrong digit", '9', next);
+        }
+    }
+    Expect("LOCKOUT key ignored", '5', STATE_LOCKOUT);
+
+    UART_Printf("  worst latency: %u us\r\n", g_worst_us);
+    Scheduler_PrintStats();
+    Test_Summary();
+
+    while (1) {
+        Scheduler_Dispatch();
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * 032_soft_timer_bench.c
+ *
+ * Created on: Feb 16, 2026
+ * Author: Rahul B.
+ * Description: Timing wheel benchmark - per-tick cost vs. number of timers
+ *
+ * For 0, 50, 100, 250 and 500 armed timers the wheel is advanced through
+ * 20000 synthetic ticks with SoftTimer_AdvanceTo() and the average cost per
+ * tick is printed. Timers are armed 30..60 s out, so none expire inside the
+ * window and only the wheel mechanics (slot scan + cascades) are measured:
+ * the numbers must stay flat as the timer count grows.
+ *
+ * A second pass re-arms the same timers as periodic 1..64 ms timers and
+ * checks that every one of them fired the expected number of times.
+ *
+ * A third pass arms 600 mixed timers over 3,000,000 ticks: one-shots and
+ * periodics, short ones and ones far past the ~17.5 min wheel span. Every
+ * callback must run on exactly its tick, the one-shots once, the periodics
+ * the right number of times. On the host the wheel starts 10 minutes before
+ * the 32-bit tick wraps, so all of it also runs across the wrap.
+ *
+ * Host build: link soft_timer.c, UART_Printf mapped to printf and
+ * app_init() stubbed out; the clocks are provided here (the costs are then
+ * those of the host).
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "soft_timer.h"
+#include "test_check.h"
+
+#define MAX_TIMERS      500
+#define BENCH_TICKS     20000U
+
+#define EXACT_TIMERS    600
+#define EXACT_TICKS     3000000U
+
+static SoftTimer_t g_timers[MAX_TIMERS];
+static uint32_t g_fired[MAX_TIMERS];
+static uint32_t g_seed = 0x1234567U;
+
+/* ===== HOST PLATFORM ===== */
+#if !defined(__arm__)
+#include <time.h>
+
+uint64_t now_ms(void) { return 0xFFFFFFFFULL - 600000U; }  // the wheel runs ahead of it
+
+uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+#endif
+
+static uint32_t Rand(void)
+{
+    g_seed = (g_seed * 1103515245U) + 12345U;
+    return g_seed >> 8;
+}
+
+static void Count_Callback(void *arg)
+{
+    g_fired[(uintptr_t)arg]++;
+}
+
+static void Bench_IdleTicks(uint32_t count)
+{
+    SoftTimer_Init();
+
+    for (uint32_t i = 0; i < count; i++) {
+        SoftTimer_Create(&g_timers[i], Count_Callback, (void *)(uintptr_t)i);
+        SoftTimer_Start(&g_timers[i], 30000U + (Rand() % 30000U), 0);
+    }
+
+    uint32_t start_tick = SoftTimer_Now();
+    uint64_t t0 = now_us();
+    SoftTimer_AdvanceTo(start_tick + BENCH_TICKS);
+    uint32_t took = (uint32_t)(now_us() - t0);
+
+    UART_Printf("  %3u timers: %6u us / %u ticks = %4u ns/tick, %u cascaded\r\n",
+                count, took, BENCH_TICKS, (took * 1000U) / BENCH_TICKS,
+                SoftTimer_GetStats()->cascaded);
+}
+
+static void Check_Periodic(void)
+{
+    uint32_t errors = 0;
+
+    SoftTimer_Init();
+
+    uint32_t start_tick = SoftTimer_Now();
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        g_fired[i] = 0;
+        SoftTimer_Create(&g_timers[i], Count_Callback, (void *)(uintptr_t)i);
+        SoftTimer_Start(&g_timers[i], (i % 64U) + 1U, (i % 64U) + 1U);
+    }
+
+    uint64_t t0 = now_us();
+    SoftTimer_AdvanceTo(start_tick + BENCH_TICKS);
+    uint32_t took = (uint32_t)(now_us() - t0);
+
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        if (g_fired[i] != BENCH_TICKS / ((i % 64U) + 1U)) errors++;
+        SoftTimer_Stop(&g_timers[i]);
+    }
+
+    UART_Printf("  periodic: %u expiries in %u us (%u ns/expiry), %u wrong counts\r\n",
+                SoftTimer_GetStats()->expired, took,
+                (uint32_t)(((uint64_t)took * 1000U) / SoftTimer_GetStats()->expired), errors);
+    Check(errors == 0U, "periodic expiry counts");
+    Check(SoftTimer_GetStats()->armed == 0U, "all timers stopped");
+}
+
+/* ===== EXACT EXPIRY ===== */
+static SoftTimer_t g_exact[EXACT_TIMERS];
+static uint32_t g_due[EXACT_TIMERS];        // tick of the next expiry
+static uint32_t g_period[EXACT_TIMERS];
+static uint32_t g_count[EXACT_TIMERS];
+static uint32_t g_late = 0;
+
+static void Exact_Callback(void *arg)
+{
+    uint32_t i = (uint32_t)(uintptr_t)arg;
+
+    if (SoftTimer_Now() != g_due[i]) g_late++;
+    g_count[i]++;
+    g_due[i] += g_period[i];
+}
+
+static void Check_Exact(void)
+{
+    uint32_t wrong = 0;
+    uint32_t start, end;
+
+    SoftTimer_Init();
+    start = SoftTimer_Now();
+    end = start + EXACT_TICKS;
+    g_late = 0;
+
+    for (uint32_t i = 0; i < EXACT_TIMERS; i++) {
+        uint32_t delay;
+
+        switch (i % 4U) {
+        case 0:  delay = 1U + (Rand() % 64U);                   g_period[i] = 0;                       break;
+        case 1:  delay = 1U + (Rand() % (2U * STIMER_MAX_DELTA)); g_period[i] = 0;                     break;
+        case 2:  delay = 1U + (Rand() % 100U);                  g_period[i] = 1U + (Rand() % 100U);   break;
+        default: delay = 1U + (Rand() % STIMER_MAX_DELTA);      g_period[i] = 1000U + (Rand() % (2U * STIMER_MAX_DELTA)); break;
+        }
+        g_count[i] = 0;
+        g_due[i] = start + delay;
+        SoftTimer_Create(&g_exact[i], Exact_Callback, (void *)(uintptr_t)i);
+        SoftTimer_Start(&g_exact[i], delay, g_period[i]);
+    }
+
+    SoftTimer_AdvanceTo(end);
+
+    for (uint32_t i = 0; i < EXACT_TIMERS; i++) {
+        uint32_t first = g_due[i] - (g_count[i] * g_period[i]);     // back to the first expiry
+        uint32_t expect;
+
+        if ((first - start) > EXACT_TICKS) expect = 0;
+        else if (g_period[i] == 0U) expect = 1;
+        else expect = 1U + ((end - first) / g_period[i]);
+
+        if (g_count[i] != expect) wrong++;
+        SoftTimer_Stop(&g_exact[i]);
+    }
+
+    UART_Printf("  exact: %u timers from tick %u to %u, %u expiries, %u off their tick, %u wrong counts\r\n",
+                EXACT_TIMERS, start, end, SoftTimer_GetStats()->expired, g_late, wrong);
+    Check(g_late == 0U, "every expiry on its tick");
+    Check(wrong == 0U, "one-shot and periodic counts");
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = { 0, 50, 100, 250, 500 };
+
+    app_init();
+
+    UART_Printf("\r\n===== 032 Soft Timer Wheel Benchmark =====\r\n");
+    for (uint32_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        Bench_IdleTicks(counts[i]);
+    }
+    Check_Periodic();
+    Check_Exact();
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,228 @@
+/*
+ * 033_event_queue_stress.c
+ *
+ * Created on: Feb 17, 2026
+ * Author: Rahul B.
+ * Description: Event queue stress test - TIM5 ISR hammers the ring
+ *
+ * TIM5 update interrupt plays the part of the EXTI handlers: it runs at the
+ * producer priority (EVENTQ_PRODUCER_PRIORITY) and posts one EVT_SRC_TEST
+ * event per tick. The main loop is the consumer. The basic timers are
+ * taken (TIM6 by the LCD transport, TIM7 by BSP_Delay_IT), so the
+ * producer runs on TIM5, on the same APB1 clock as the time base.
+ *
+ * On the host a second thread is the producer, pacing itself to the same
+ * rate with nanosleep(). The two sides then really run concurrently (on
+ * separate cores where there are several), which exercises the barriers
+ * of the ring rather than the interrupt masking of the target.
+ *
+ *   Phase 1: 20 kHz producer, consumer drains flat out
+ *            -> no drops, sequence numbers contiguous
+ *   Phase 2: 20 kHz producer, consumer stalls 5 ms between drains
+ *            -> drops happen, high-water reaches EVENTQ_SIZE
+ *
+ * In both phases every post attempt must be accounted for exactly once:
+ * attempts == posted + dropped, consumed == posted, the sequence gaps seen
+ * by the consumer add up to the drop count, and timestamps never go back.
+ * Phase 1 must not drop on the target only: a host scheduler may hold the
+ * consumer off for longer than the ring lasts.
+ *
+ * Host build: link event_queue.c and -lpthread, UART_Printf mapped to
+ * printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "event_queue.h"
+#include "test_check.h"
+
+#define PRODUCER_RATE_HZ    20000U
+#define PHASE_TIME_MS       2000U
+
+static volatile uint32_t g_attempts = 0;
+
+#if defined(__arm__)
+/**
+ * @brief Producer: one post per TIM5 update
+ */
+void TIM5_IRQHandler(void)
+{
+    if (TIM5->SR & TIMER_SR_UIF) {
+        TIM5->SR = ~TIMER_SR_UIF;
+        EventQueue_Post(EVT_SRC_TEST, EVT_EDGE_RISING, now_us32());
+        g_attempts++;
+    }
+}
+
+static void Producer_Start(uint32_t rate_hz)
+{
+    TIMER_Handle_t tim5 = {0};
+
+    tim5.pTIMx = TIM5;
+    tim5.TIMER_Config.TIMER_Prescaler = (uint16_t)TIM2->PSC;   // same APB1 clock -> 1 MHz
+    tim5.TIMER_Config.TIMER_CounterMode = TIMER_MODE_UP;
+    tim5.TIMER_Config.TIMER_Period = (1000000U / rate_hz) - 1U;
+    tim5.TIMER_Config.TIMER_ClockDivision = TIMER_CKDIV_1;
+    tim5.TIMER_Config.TIMER_AutoReloadPreload = TIMER_ARR_BUFFERED;
+    TIMER_BaseInit(&tim5);
+
+    TIM5->SR = 0;
+    TIMER_ITConfig(TIM5, TIMER_DIER_UIE, ENABLE);
+    TIMER_IRQPriorityConfig(TIM5_IRQn, EVENTQ_PRODUCER_PRIORITY);
+    TIMER_IRQInterruptConfig(TIM5_IRQn, ENABLE);
+    TIMER_Enable(TIM5);
+}
+
+static void Producer_Stop(void)
+{
+    TIMER_Disable(TIM5);
+    TIMER_IRQInterruptConfig(TIM5_IRQn, DISABLE);
+    TIMER_ITConfig(TIM5, TIMER_DIER_UIE, DISABLE);
+}
+
+static void Consumer_Stall(uint32_t ms)
+{
+    uint64_t stall = deadline_after_ms(ms);
+    while (!deadline_expired(stall));
+}
+
+#else
+#include <pthread.h>
+#include <time.h>
+
+static pthread_t g_producer;
+static volatile bool g_producing;
+
+uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+uint64_t deadline_after_ms(uint32_t ms) { return now_us() + ((uint64_t)ms * 1000U); }
+bool deadline_expired(uint64_t deadline) { return now_us() >= deadline; }
+
+/**
+ * @brief Producer: one post per period, like the TIM5 interrupt
+ */
+static void *Producer_Thread(void *arg)
+{
+    struct timespec period = { 0, (long)(1000000000U / (uint32_t)(uintptr_t)arg) };
+
+    while (g_producing) {
+        EventQueue_Post(EVT_SRC_TEST, EVT_EDGE_RISING, (uint32_t)now_us());
+        g_attempts++;
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+static void Producer_Start(uint32_t rate_hz)
+{
+    g_producing = true;
+    pthread_create(&g_producer, NULL, Producer_Thread, (void *)(uintptr_t)rate_hz);
+}
+
+static void Producer_Stop(void)
+{
+    g_producing = false;
+    pthread_join(g_producer, NULL);
+}
+
+static void Consumer_Stall(uint32_t ms)
+{
+    struct timespec stall = { 0, (long)ms * 1000000L };
+    nanosleep(&stall, NULL);        // leaves the CPU to the producer
+}
+#endif
+
+/**
+ * @brief Run one producer/consumer phase
+ * @param stall_ms consumer pause between drains (0 = drain continuously)
+ */
+static void Run_Phase(const char *name, uint32_t stall_ms)
+{
+    Event_t evt;
+    uint32_t consumed = 0;
+    uint32_t gaps = 0;
+    uint32_t reordered = 0;
+    uint16_t expect_seq = 0;
+    uint32_t last_tick = 0;
+    bool first = true;
+
+    EventQueue_Init();
+    g_attempts = 0;
+
+    UART_Printf("\r\n--- %s ---\r\n", name);
+    Producer_Start(PRODUCER_RATE_HZ);
+
+    uint64_t end = deadline_after_ms(PHASE_TIME_MS);
+    bool producing = true;
+
+    while (producing || EventQueue_Count() != 0U) {
+        if (producing && deadline_expired(end)) {
+            Producer_Stop();
+            producing = false;
+        }
+
+        while (EventQueue_Get(&evt)) {
+            gaps += (uint16_t)(evt.seq - expect_seq);
+            if (!first && (int32_t)(evt.tick - last_tick) < 0) reordered++;
+            expect_seq = evt.seq + 1U;
+            last_tick = evt.tick;
+            first = false;
+            consumed++;
+        }
+
+        if (producing && stall_ms != 0U) {
+            Consumer_Stall(stall_ms);
+        }
+    }
+
+    // Posts dropped after the last delivered event leave no gap behind them
+    gaps += (uint16_t)((uint16_t)g_attempts - expect_seq);
+
+    const EventQueueStats_t *st = EventQueue_GetStats();
+
+    UART_Printf("  attempts %u, posted %u, dropped %u, consumed %u, high-water %u/%u\r\n",
+                g_attempts, st->posted, st->dropped, consumed, st->highWater, EVENTQ_SIZE);
+
+    Check(g_attempts == st->posted + st->dropped, "attempts == posted + dropped");
+    Check(consumed == st->posted && st->dispatched == st->posted, "consumed == posted");
+    Check(gaps == st->dropped, "sequence gaps == dropped");
+    Check(reordered == 0U, "timestamps monotonic");
+
+    if (stall_ms == 0U) {
+#if defined(__arm__)
+        Check(st->dropped == 0U, "no drops with a free-running consumer");
+#endif
+    } else {
+        Check(st->dropped != 0U, "drops counted under overload");
+        Check(st->highWater == EVENTQ_SIZE, "high-water reached ring size");
+    }
+}
+
+int main(void)
+{
+    app_init();
+
+#if defined(__arm__)
+    // Only TIM5 may post during the test: keep the button/IR EXTIs quiet
+    GPIO_IRQInterruptConfig(EXTI15_10_IRQn, DISABLE);
+    GPIO_IRQInterruptConfig(EXTI9_5_IRQn, DISABLE);
+#endif
+
+    UART_Printf("\r\n===== 033 Event Queue Stress (%u Hz producer) =====\r\n", PRODUCER_RATE_HZ);
+    Run_Phase("Phase 1: consumer keeps up", 0);
+    Run_Phase("Phase 2: consumer stalls 5 ms", 5);
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,171 @@
+/*
+ * 034_fsm_engine_test.c
+ *
+ * Created on: Feb 18, 2026
+ * Author: Rahul B.
+ * Description: Unit test for the table-driven FSM engine (fsm.c)
+ *
+ * Drives a small door-lock machine through the engine and checks:
+ *   - entry/exit hooks run exactly once per transition, never per Fsm_Run()
+ *   - guards pick between rows in table order
+ *   - internal transitions run their action without exit/entry
+ *   - FSM_ANY_STATE rows match from every state
+ *   - events raised inside hooks are queued, not nested, and overflow is counted
+ *   - the trace holds the last FSM_TRACE_DEPTH transitions, newest first
+ *
+ * Only fsm.c and UART_Printf are used: the same file builds on a host with
+ * UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "fsm.h"
+#include "test_check.h"
+#include <string.h>
+
+/* ===== DOOR MACHINE ===== */
+enum { S_LOCKED, S_UNLOCKED, S_OPEN, S_ALARM, S_COUNT };
+enum { E_NONE, E_CODE, E_PUSH, E_CLOSE, E_LOCK, E_TAMPER, E_RESET, E_BURST };
+
+static uint8_t g_entry[S_COUNT];
+static uint8_t g_exit[S_COUNT];
+static uint32_t g_runs = 0;
+static uint32_t g_clock = 0;
+static bool g_codeOk = false;
+static uint8_t g_badCodes = 0;
+static char g_order[16];
+static uint8_t g_orderLen = 0;
+
+static void Mark(char c) { if (g_orderLen < sizeof(g_order) - 1U) g_order[g_orderLen++] = c; }
+
+static uint32_t Test_Clock(void) { return g_clock; }
+
+static void Locked_Entry(Fsm_t *f)   { (void)f; g_entry[S_LOCKED]++;   Mark('L'); }
+static void Locked_Exit(Fsm_t *f)    { (void)f; g_exit[S_LOCKED]++;    Mark('l'); }
+static void Unlocked_Entry(Fsm_t *f) { (void)f; g_entry[S_UNLOCKED]++; Mark('U'); }
+static void Unlocked_Exit(Fsm_t *f)  { (void)f; g_exit[S_UNLOCKED]++;  Mark('u'); }
+static void Open_Entry(Fsm_t *f)     { (void)f; g_entry[S_OPEN]++;     Mark('O'); }
+static void Open_Exit(Fsm_t *f)      { (void)f; g_exit[S_OPEN]++;      Mark('o'); }
+static void Open_Run(Fsm_t *f)       { (void)f; g_runs++; }
+
+/* Alarm entry re-raises events: must be queued until the step completes */
+static void Alarm_Entry(Fsm_t *f)
+{
+    g_entry[S_ALARM]++;
+    Mark('A');
+    for (uint8_t i = 0; i < FSM_EVENT_QUEUE_DEPTH + 2U; i++) {
+        Fsm_Dispatch(f, E_BURST);
+    }
+}
+static void Alarm_Exit(Fsm_t *f)     { (void)f; g_exit[S_ALARM]++;     Mark('a'); }
+
+static bool Code_Ok(Fsm_t *f)        { (void)f; return g_codeOk; }
+static void Code_Bad(Fsm_t *f)       { (void)f; g_badCodes++;           Mark('x'); }
+static void Unlock_Action(Fsm_t *f)  { (void)f;                         Mark('*'); }
+
+static const FsmState_t states[S_COUNT] = {
+    [S_LOCKED]   = { "LOCKED",   Locked_Entry,   Locked_Exit,   NULL     },
+    [S_UNLOCKED] = { "UNLOCKED", Unlocked_Entry, Unlocked_Exit, NULL     },
+    [S_OPEN]     = { "OPEN",     Open_Entry,     Open_Exit,     Open_Run },
+    [S_ALARM]    = { "ALARM",    Alarm_Entry,    Alarm_Exit,    NULL     },
+};
+
+static const FsmTransition_t transitions[] = {
+    { S_LOCKED,      E_CODE,   Code_Ok, Unlock_Action, S_UNLOCKED   },
+    { S_LOCKED,      E_CODE,   NULL,    Code_Bad,      FSM_INTERNAL },
+    { S_UNLOCKED,    E_PUSH,   NULL,    NULL,          S_OPEN       },
+    { S_UNLOCKED,    E_LOCK,   NULL,    NULL,          S_LOCKED     },
+    { S_OPEN,        E_CLOSE,  NULL,    NULL,          S_UNLOCKED   },
+    { S_ALARM,       E_RESET,  NULL,    NULL,          S_LOCKED     },
+    { S_ALARM,       E_TAMPER, NULL,    NULL,          FSM_INTERNAL },
+    { FSM_ANY_STATE, E_TAMPER, NULL,    NULL,          S_ALARM      },
+};
+
+static Fsm_t g_fsm;
+
+static void Reset_Counters(void)
+{
+    memset(g_entry, 0, sizeof(g_entry));
+    memset(g_exit, 0, sizeof(g_exit));
+    memset(g_order, 0, sizeof(g_order));
+    g_orderLen = 0;
+}
+
+int main(void)
+{
+    app_init();
+
+    UART_Printf("\r\n===== 034 FSM Engine Test =====\r\n");
+
+    Fsm_Init(&g_fsm, states, S_COUNT, transitions,
+             (uint8_t)(sizeof(transitions) / sizeof(transitions[0])), Test_Clock, NULL);
+    Check(Fsm_GetState(&g_fsm) == FSM_NO_STATE, "stopped until Fsm_Start");
+
+    Fsm_Start(&g_fsm, S_LOCKED);
+    Check(Fsm_GetState(&g_fsm) == S_LOCKED && g_entry[S_LOCKED] == 1, "start runs initial entry once");
+
+    /* Guards: first matching row wins, internal row has no exit/entry */
+    Reset_Counters();
+    g_codeOk = false;
+    Check(Fsm_Dispatch(&g_fsm, E_CODE), "bad code handled");
+    Check(Fsm_GetState(&g_fsm) == S_LOCKED && g_badCodes == 1 &&
+          g_exit[S_LOCKED] == 0 && g_entry[S_LOCKED] == 0, "internal transition: action only");
+
+    g_codeOk = true;
+    g_clock = 100;
+    Fsm_Dispatch(&g_fsm, E_CODE);
+    Check(Fsm_GetState(&g_fsm) == S_UNLOCKED, "guarded row taken");
+    Check(strcmp(g_order, "xl*U") == 0, "order exit -> action -> entry");
+
+    /* Unknown event in this state */
+    uint32_t unhandled = g_fsm.unhandledCount;
+    Check(!Fsm_Dispatch(&g_fsm, E_CLOSE) && g_fsm.unhandledCount == unhandled + 1U, "unmatched event rejected");
+
+    /* Do hook runs every pass, entry does not */
+    Fsm_Dispatch(&g_fsm, E_PUSH);
+    for (int i = 0; i < 50; i++) Fsm_Run(&g_fsm);
+    Check(g_runs == 50, "do hook ran 50 times");
+    Check(g_entry[S_OPEN] == 1, "entry ran once for 50 passes");
+
+    /* Wildcard + events raised inside a hook */
+    Reset_Counters();
+    uint32_t dropped = g_fsm.droppedCount;
+    unhandled = g_fsm.unhandledCount;
+    g_clock = 200;
+    Fsm_Dispatch(&g_fsm, E_TAMPER);
+    Check(Fsm_GetState(&g_fsm) == S_ALARM, "FSM_ANY_STATE row matched");
+    Check(strcmp(g_order, "oA") == 0 && g_entry[S_ALARM] == 1, "hook events not nested");
+    Check(g_fsm.droppedCount == dropped + 2U, "queue overflow counted");
+    Check(g_fsm.unhandledCount == unhandled + FSM_EVENT_QUEUE_DEPTH, "queued events processed");
+
+    Fsm_Dispatch(&g_fsm, E_TAMPER);
+    Check(g_entry[S_ALARM] == 1 && g_exit[S_ALARM] == 0, "specific row beats wildcard");
+
+    Fsm_Dispatch(&g_fsm, E_RESET);
+    Check(g_exit[S_ALARM] == 1 && g_entry[S_LOCKED] == 1, "balanced entry/exit");
+
+    /* Trace: newest first */
+    const FsmTraceEntry_t *t0 = Fsm_GetTrace(&g_fsm, 0);
+    const FsmTraceEntry_t *t1 = Fsm_GetTrace(&g_fsm, 1);
+    Check(t0 && t0->from == S_ALARM && t0->to == S_LOCKED && t0->event == E_RESET, "trace newest = ALARM->LOCKED");
+    Check(t1 && t1->from == S_OPEN && t1->to == S_ALARM && t1->tick == 200, "trace tick recorded");
+
+    for (int i = 0; i < 40; i++) {
+        Fsm_Dispatch(&g_fsm, E_CODE);
+        Fsm_Dispatch(&g_fsm, E_LOCK);
+    }
+    Check(Fsm_TraceCount(&g_fsm) == FSM_TRACE_DEPTH &&
+          Fsm_GetTrace(&g_fsm, FSM_TRACE_DEPTH) == NULL, "trace capped at depth");
+    t0 = Fsm_GetTrace(&g_fsm, 0);
+    Check(t0->from == S_UNLOCKED && t0->to == S_LOCKED, "trace wraps correctly");
+
+    UART_Printf("  %u transitions, %u unhandled, %u dropped\r\n",
+                g_fsm.transitionCount, g_fsm.unhandledCount, g_fsm.droppedCount);
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
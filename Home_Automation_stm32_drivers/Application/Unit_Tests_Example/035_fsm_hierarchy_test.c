@@ -0,0 +1,149 @@
+/*
+ * 035_fsm_hierarchy_test.c
+ *
+ * Created on: Feb 19, 2026
+ * Author: Rahul B.
+ * Description: Unit test for hierarchical states in the FSM engine (fsm.c)
+ *
+ * Machine under test (same shape as the application):
+ *
+ *   IDLE
+ *   SESSION            (composite, initial = HOME, owns LOGOUT/TIMEOUT/BACK)
+ *     HOME
+ *     VIEW             (composite, initial = PAGE_A)
+ *       PAGE_A
+ *       PAGE_B
+ *
+ * Checks: initial-child drill down, event bubbling leaf -> parent ->
+ * grandparent, leaf rows overriding parent rows, exit/entry ordering across
+ * levels (only up to the common ancestor), local transitions from a
+ * superstate into its own substate, self transitions on a superstate,
+ * shallow history and Fsm_ClearHistory(), Fsm_IsIn().
+ *
+ * Only fsm.c and UART_Printf are used: the same file builds on a host with
+ * UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "fsm.h"
+#include "test_check.h"
+#include <string.h>
+
+enum { S_IDLE, S_SESSION, S_HOME, S_VIEW, S_PAGE_A, S_PAGE_B, S_COUNT };
+enum { E_NONE, E_LOGIN, E_RESUME, E_OPEN, E_NEXT, E_BACK, E_LOGOUT, E_TIMEOUT, E_RESET };
+
+static char g_log[64];
+static uint8_t g_logLen = 0;
+
+static void Log(char c) { if (g_logLen < sizeof(g_log) - 1U) g_log[g_logLen++] = c; }
+static void Log_Clear(void) { memset(g_log, 0, sizeof(g_log)); g_logLen = 0; }
+
+/* Upper case = entry, lower case = exit */
+static void Idle_In(Fsm_t *f)     { (void)f; Log('I'); }
+static void Idle_Out(Fsm_t *f)    { (void)f; Log('i'); }
+static void Session_In(Fsm_t *f)  { (void)f; Log('S'); }
+static void Session_Out(Fsm_t *f) { (void)f; Log('s'); }
+static void Home_In(Fsm_t *f)     { (void)f; Log('H'); }
+static void Home_Out(Fsm_t *f)    { (void)f; Log('h'); }
+static void View_In(Fsm_t *f)     { (void)f; Log('V'); }
+static void View_Out(Fsm_t *f)    { (void)f; Log('v'); }
+static void PageA_In(Fsm_t *f)    { (void)f; Log('A'); }
+static void PageA_Out(Fsm_t *f)   { (void)f; Log('a'); }
+static void PageB_In(Fsm_t *f)    { (void)f; Log('B'); }
+static void PageB_Out(Fsm_t *f)   { (void)f; Log('b'); }
+static void Forget(Fsm_t *f)      { Fsm_ClearHistory(f, S_SESSION); Log('!'); }
+
+static const FsmState_t states[S_COUNT] = {
+    [S_IDLE]    = { "IDLE",    Idle_In,    Idle_Out,    NULL },
+    [S_SESSION] = { "SESSION", Session_In, Session_Out, NULL },
+    [S_HOME]    = { "HOME",    Home_In,    Home_Out,    NULL },
+    [S_VIEW]    = { "VIEW",    View_In,    View_Out,    NULL },
+    [S_PAGE_A]  = { "PAGE_A",  PageA_In,   PageA_Out,   NULL },
+    [S_PAGE_B]  = { "PAGE_B",  PageB_In,   PageB_Out,   NULL },
+};
+
+static const FsmStateId_t parent[S_COUNT] = {
+    [S_IDLE]    = FSM_NO_STATE,
+    [S_SESSION] = FSM_NO_STATE,
+    [S_HOME]    = S_SESSION,
+    [S_VIEW]    = S_SESSION,
+    [S_PAGE_A]  = S_VIEW,
+    [S_PAGE_B]  = S_VIEW,
+};
+
+static const FsmStateId_t initial[S_COUNT] = {
+    [S_IDLE]    = FSM_NO_STATE,
+    [S_SESSION] = S_HOME,
+    [S_HOME]    = FSM_NO_STATE,
+    [S_VIEW]    = S_PAGE_A,
+    [S_PAGE_A]  = FSM_NO_STATE,
+    [S_PAGE_B]  = FSM_NO_STATE,
+};
+
+static const FsmTransition_t transitions[] = {
+    { S_IDLE,    E_LOGIN,   NULL, NULL,   S_SESSION              },
+    { S_IDLE,    E_RESUME,  NULL, NULL,   FSM_HISTORY(S_SESSION) },
+    { S_HOME,    E_OPEN,    NULL, NULL,   S_VIEW                 },
+    { S_PAGE_A,  E_NEXT,    NULL, NULL,   S_PAGE_B               },
+    { S_HOME,    E_BACK,    NULL, NULL,   FSM_INTERNAL           },   // overrides SESSION's row
+    { S_SESSION, E_BACK,    NULL, NULL,   S_HOME                 },
+    { S_SESSION, E_LOGOUT,  NULL, Forget, S_IDLE                 },
+    { S_SESSION, E_TIMEOUT, NULL, NULL,   S_IDLE                 },
+    { S_SESSION, E_RESET,   NULL, NULL,   S_SESSION              },
+};
+
+static Fsm_t g_fsm;
+
+static void Expect(const char *what, FsmEventId_t event, FsmStateId_t state, const char *log)
+{
+    Log_Clear();
+    if (event != E_NONE) Fsm_Dispatch(&g_fsm, event);
+
+    bool ok = (Fsm_GetState(&g_fsm) == state) && (strcmp(g_log, log) == 0);
+    UART_Printf("  [%s] %-28s %-7s hooks \"%s\"\r\n", ok ? "PASS" : "FAIL", what,
+                Fsm_StateName(&g_fsm, Fsm_GetState(&g_fsm)), g_log);
+    if (!ok) g_failures++;
+}
+
+int main(void)
+{
+    app_init();
+
+    UART_Printf("\r\n===== 035 FSM Hierarchy Test =====\r\n");
+
+    Fsm_Init(&g_fsm, states, S_COUNT, transitions,
+             (uint8_t)(sizeof(transitions) / sizeof(transitions[0])), NULL, NULL);
+    Fsm_SetHierarchy(&g_fsm, parent, initial);
+
+    Log_Clear();
+    Fsm_Start(&g_fsm, S_IDLE);
+    Expect("start",                       E_NONE,    S_IDLE,   "");
+    Expect("login drills to initial",     E_LOGIN,   S_HOME,   "iSH");
+    Expect("leaf row beats parent row",   E_BACK,    S_HOME,   "");
+    Expect("nested composite entry",      E_OPEN,    S_PAGE_A, "hVA");
+    Expect("sibling: leaf exit/entry",    E_NEXT,    S_PAGE_B, "aB");
+    Check(Fsm_IsIn(&g_fsm, S_VIEW) && Fsm_IsIn(&g_fsm, S_SESSION) && !Fsm_IsIn(&g_fsm, S_HOME),
+          "IsIn(VIEW) / IsIn(SESSION)");
+    Expect("bubble 2 levels to SESSION",  E_BACK,    S_HOME,   "bvH");
+
+    Expect("back into view",              E_OPEN,    S_PAGE_A, "hVA");
+    Expect("next page",                   E_NEXT,    S_PAGE_B, "aB");
+    Expect("timeout exits all levels",    E_TIMEOUT, S_IDLE,   "bvsI");
+    Expect("shallow history resume",      E_RESUME,  S_PAGE_A, "iSVA");
+    Expect("superstate self transition",  E_RESET,   S_HOME,   "avsSH");
+
+    Expect("open view again",             E_OPEN,    S_PAGE_A, "hVA");
+    Expect("logout clears history",       E_LOGOUT,  S_IDLE,   "avs!I");
+    Expect("resume w/o history = initial",E_RESUME,  S_HOME,   "iSH");
+
+    Check(!Fsm_Dispatch(&g_fsm, E_NEXT) && Fsm_GetState(&g_fsm) == S_HOME, "unhandled bubbles to nothing");
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
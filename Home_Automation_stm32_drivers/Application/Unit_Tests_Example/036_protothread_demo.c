@@ -0,0 +1,134 @@
+/*
+ * 036_protothread_demo.c
+ *
+ * Created on: Feb 20, 2026
+ * Author: Rahul B.
+ * Description: Protothreads (pt.h) - four sequential flows sharing one loop
+ *
+ *   Blink   - white LED 200 ms ON / 800 ms OFF           (PT_AWAIT_MS)
+ *   Keys    - collects 4 keys, then prints them         (PT_AWAIT_KEY)
+ *   Button  - counts PC13 presses, prints edge + time    (PT_AWAIT_EVENT)
+ *   Beeper  - spawns a 3-beep child thread every 10 s    (PT_SPAWN)
+ *
+ * Each flow reads top to bottom like a blocking loop, but every wait
+ * returns to main(), so all four run interleaved. The main loop counts its
+ * passes: a figure in the hundreds of thousands per second shows nobody
+ * blocks. Every coroutine costs sizeof(Pt_t) bytes of RAM plus its statics.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "event_queue.h"
+#include "pt.h"
+
+static Pt_t blinkPt, keysPt, buttonPt, beeperPt, beepPt;
+static uint32_t g_loops = 0;
+
+/* Interrupt Handler for Button: same as the application's */
+void EXTI15_10_IRQHandler(void)
+{
+    if (EXTI->PR & (1 << 13)) {
+        EXTI->PR = (1 << 13);
+        EventQueue_Post(EVT_SRC_WAKEUP_BTN,
+                        GPIO_ReadFromInputPin(GPIOC, GPIO_PIN_NO_13) ? EVT_EDGE_RISING : EVT_EDGE_FALLING,
+                        now_us32());
+    }
+}
+
+static PT_THREAD(Blink_Thread(Pt_t *pt))
+{
+    PT_BEGIN(pt);
+    for (;;) {
+        BSP_LED_On(LED_WHITE_PIN);
+        PT_AWAIT_MS(pt, 200);
+        BSP_LED_Off(LED_WHITE_PIN);
+        PT_AWAIT_MS(pt, 800);
+    }
+    PT_END(pt);
+}
+
+static PT_THREAD(Keys_Thread(Pt_t *pt))
+{
+    static char keys[5];
+    static uint8_t count;
+
+    PT_BEGIN(pt);
+    for (;;) {
+        for (count = 0; count < 4; count++) {
+            PT_AWAIT_KEY(pt, keys[count]);
+        }
+        keys[4] = '\0';
+        UART_Printf("[KEYS]   \"%s\"\r\n", keys);
+    }
+    PT_END(pt);
+}
+
+static PT_THREAD(Button_Thread(Pt_t *pt))
+{
+    static Event_t evt;
+    static uint32_t presses;
+
+    PT_BEGIN(pt);
+    for (;;) {
+        PT_AWAIT_EVENT(pt, EVT_SRC_WAKEUP_BTN, &evt);
+        if (evt.edge == EVT_EDGE_FALLING) presses++;
+        UART_Printf("[BUTTON] %s edge at %u us, %u presses\r\n",
+                    (evt.edge == EVT_EDGE_FALLING) ? "falling" : "rising", evt.tick, presses);
+    }
+    PT_END(pt);
+}
+
+static PT_THREAD(Beep_Thread(Pt_t *pt))
+{
+    static uint8_t beep;
+
+    PT_BEGIN(pt);
+    for (beep = 0; beep < 3; beep++) {
+        BSP_Buzzer_On();
+        PT_AWAIT_MS(pt, 50);
+        BSP_Buzzer_Off();
+        PT_AWAIT_MS(pt, 150);
+    }
+    PT_END(pt);
+}
+
+static PT_THREAD(Beeper_Thread(Pt_t *pt))
+{
+    static uint32_t lastLoops;
+
+    PT_BEGIN(pt);
+    for (;;) {
+        lastLoops = g_loops;
+        PT_AWAIT_MS(pt, 10000);
+        UART_Printf("[BEEPER] %u loop passes in 10 s\r\n", g_loops - lastLoops);
+        PT_SPAWN(pt, &beepPt, Beep_Thread(&beepPt));
+    }
+    PT_END(pt);
+}
+
+int main(void)
+{
+    app_init();
+    EventQueue_Init();
+
+    UART_Printf("\r\n===== 036 Protothread Demo (%u bytes per thread) =====\r\n",
+                (unsigned)sizeof(Pt_t));
+    UART_Printf("Type keys on the keypad, press the blue button.\r\n");
+
+    PT_INIT(&blinkPt);
+    PT_INIT(&keysPt);
+    PT_INIT(&buttonPt);
+    PT_INIT(&beeperPt);
+
+    while (1) {
+        EventQueue_Dispatch();
+        (void)Blink_Thread(&blinkPt);
+        (void)Keys_Thread(&keysPt);
+        (void)Button_Thread(&buttonPt);
+        (void)Beeper_Thread(&beeperPt);
+        g_loops++;
+    }
+    return 0;
+}
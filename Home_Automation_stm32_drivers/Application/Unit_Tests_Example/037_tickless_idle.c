@@ -0,0 +1,190 @@
+/*
+ * 037_tickless_idle.c
+ *
+ * Created on: Feb 21, 2026
+ * Author: Rahul B.
+ * Description: Tickless idle (idle.c + bsp_lowpower.c) - Sleep vs Stop
+ *
+ * Two scheduler tasks: a 50 ms green LED flash every 500 ms and a 10 s
+ * report. The main loop calls Idle_Enter() after every dispatch, so the
+ * CPU sleeps in every gap. Stop mode is toggled on each report:
+ *
+ *   Sleep only - ~99 % idle, gaps end on the TIM2 compare
+ *   Stop       - same idle share at a fraction of the current; Stop runs
+ *                on HSI and the HSE/PLL tree of app_init() (180 MHz) is
+ *                restored before the wake-up handlers run
+ *
+ * Each report prints the idle statistics and the drift of now_ms()
+ * against the RTC (LSI) since start, which must stay within the LSI
+ * calibration error (~0.1 %) plus one RTC sub-second step. Press the
+ * blue button (PC13) to check that EXTI wakes both modes: the edge is
+ * printed with its now_us() timestamp.
+ *
+ * The clock restore is checked after every Stop and in every button
+ * interrupt: SYSCLK source and dividers, PLL setup, TIM2 prescaler and
+ * USART2 baud register must be those app_init() left. Each Stop report
+ * passes if all of them matched (and at least one Stop happened).
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "bsp_lowpower.h"
+#include "scheduler.h"
+#include "event_queue.h"
+#include "idle.h"
+#include "test_check.h"
+
+static bool g_stop = false;
+static uint32_t g_rtcStart;
+static uint32_t g_msStart;
+
+/* ===== CLOCK TREE CHECK ===== */
+#define CFGR_CLOCK_MASK     ((0xFU << 0) | (0xFU << 4) | (0x7U << 10) | (0x7U << 13))   // SW, SWS, HPRE, PPRE1, PPRE2
+
+static struct {
+    uint32_t cfgr;
+    uint32_t pllcfgr;
+    uint32_t tim2Psc;
+    uint32_t usartBrr;
+} g_appClocks;
+
+static uint32_t g_restoreChecks, g_restoreMisses;     // after each Stop
+static volatile uint32_t g_edges, g_edgesOffClock;    // in the button ISR
+
+static void Clock_Capture(void)
+{
+    g_appClocks.cfgr = RCC->CFGR & CFGR_CLOCK_MASK;
+    g_appClocks.pllcfgr = RCC->PLLCFGR;
+    g_appClocks.tim2Psc = TIM2->PSC;
+    g_appClocks.usartBrr = USART2->BRR;
+}
+
+static bool Clock_IsApp(void)
+{
+    return ((RCC->CFGR & CFGR_CLOCK_MASK) == g_appClocks.cfgr) &&
+           (RCC->PLLCFGR == g_appClocks.pllcfgr) &&
+           (TIM2->PSC == g_appClocks.tim2Psc) &&
+           (USART2->BRR == g_appClocks.usartBrr);
+}
+
+/* Interrupt Handler for Button: same as the application's */
+void EXTI15_10_IRQHandler(void)
+{
+    if (EXTI->PR & (1 << 13)) {
+        EXTI->PR = (1 << 13);
+        g_edges++;
+        if (!Clock_IsApp()) g_edgesOffClock++;
+        EventQueue_Post(EVT_SRC_WAKEUP_BTN,
+                        GPIO_ReadFromInputPin(GPIOC, GPIO_PIN_NO_13) ? EVT_EDGE_RISING : EVT_EDGE_FALLING,
+                        now_us32());
+    }
+}
+
+static void Button_OnEvent(const Event_t *evt)
+{
+    UART_Printf("[BUTTON] %s edge at %u us\r\n",
+                (evt->edge == EVT_EDGE_FALLING) ? "falling" : "rising", evt->tick);
+}
+
+/* RTC time of day in ms (shadow registers are bypassed: re-read on a tick) */
+static uint32_t Rtc_Ms(void)
+{
+    uint32_t ssr, tr;
+    uint32_t sync = (RTC->PRER & 0x7FFFU) + 1U;
+
+    do {
+        ssr = RTC->SSR;
+        tr  = RTC->TR;
+    } while (ssr != RTC->SSR);
+
+    uint32_t sec = ((tr >> 20) & 0x3U) * 36000U + ((tr >> 16) & 0xFU) * 3600U +
+                   ((tr >> 12) & 0x7U) * 600U   + ((tr >> 8)  & 0xFU) * 60U   +
+                   ((tr >> 4)  & 0x7U) * 10U    +  (tr        & 0xFU);
+
+    return sec * 1000U + ((sync - 1U - ssr) * 1000U) / sync;
+}
+
+static void LedOff_Task(void)
+{
+    BSP_LED_Off(LED_GREEN_PIN);
+}
+
+static void Flash_Task(void)
+{
+    BSP_LED_On(LED_GREEN_PIN);
+    Scheduler_AddOneShot("ledoff", LedOff_Task, 50);
+}
+
+static uint32_t Events_WakeHint(void)
+{
+    return (EventQueue_Count() != 0U) ? 0U : SCHED_NO_DEADLINE;
+}
+
+static void Report_Task(void)
+{
+    static bool started = false;
+
+    if (!started) {             /* first run: right after registration */
+        started = true;
+        g_rtcStart = Rtc_Ms();
+        g_msStart  = (uint32_t)now_ms();
+        Idle_ResetStats();
+        return;
+    }
+
+    uint32_t ms  = (uint32_t)now_ms() - g_msStart;
+    uint32_t rtc = Rtc_Ms() - g_rtcStart;
+
+    UART_Printf("\r\n[REPORT] mode %s, now_ms %u ms vs RTC %u ms (drift %d ms)\r\n",
+                g_stop ? "STOP" : "SLEEP", ms, rtc, (int)(ms - rtc));
+    Idle_PrintStats();
+
+    if (g_stop) {
+        UART_Printf("  HSE/PLL back before unmasking: %u of %u Stops\r\n",
+                    g_restoreChecks - g_restoreMisses, g_restoreChecks);
+        Check((g_restoreChecks != 0U) && (g_restoreMisses == 0U), "HSE/PLL back before unmasking");
+    }
+    UART_Printf("  button edges on the app clocks: %u of %u\r\n",
+                g_edges - g_edgesOffClock, g_edges);
+    Check(g_edgesOffClock == 0U, "button edges on the app clocks");
+    UART_Printf("  %u failures so far (SYSCLK %u Hz)\r\n", g_failures, (unsigned)RCC_GetSystemClock());
+
+    g_restoreChecks = 0;
+    g_restoreMisses = 0;
+    g_edges = 0;
+    g_edgesOffClock = 0;
+    g_stop = !g_stop;
+    Idle_SetStopAllowed(g_stop);
+    Idle_ResetStats();
+}
+
+int main(void)
+{
+    app_init();
+    Clock_Capture();
+    EventQueue_Init();
+    EventQueue_Subscribe(EVT_SRC_WAKEUP_BTN, Button_OnEvent);
+
+    UART_Printf("\r\n===== 037 Tickless Idle =====\r\n");
+    Idle_Init();
+
+    Scheduler_Init();
+    Scheduler_SetWakeHint(Scheduler_AddTask("events", EventQueue_Dispatch, 1), Events_WakeHint);
+    Scheduler_AddTask("flash", Flash_Task, 500);
+    Scheduler_AddTask("report", Report_Task, 10000);
+
+    while (1) {
+        Scheduler_Dispatch();
+
+        uint32_t stops = Idle_GetStats()->stops;    // the report resets it
+        Idle_Enter();
+
+        if (Idle_GetStats()->stops != stops) {
+            g_restoreChecks++;
+            if (!Clock_IsApp()) g_restoreMisses++;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * 038_profiler_bench.c
+ *
+ * Created on: Feb 22, 2026
+ * Author: Rahul B.
+ * Description: Zone profiler (profiler.c) - micro-benchmarks and self-check
+ *
+ * Times a few pieces of code 1000 times each and prints the summary table
+ * and one histogram:
+ *
+ *   empty      - PROF_BEGIN/PROF_END with nothing between (the overhead)
+ *   memcpy 1k  - 1 KB copy, the size of the OLED frame buffer
+ *   snprintf   - one formatted log line, without sending it
+ *   fsm step   - Fsm_Dispatch() of a two-state toggle machine
+ *
+ * Checks: every zone counted 1000 samples, min <= mean <= p99 <= max, and
+ * the empty zone stays under 1 us.
+ *
+ * Only profiler.c, fsm.c and UART_Printf are used: the same file builds on
+ * a host with UART_Printf mapped to printf and app_init() stubbed out; the
+ * profiler then reads clock_gettime() instead of DWT CYCCNT.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "profiler.h"
+#include "fsm.h"
+#include "test_check.h"
+#include <string.h>
+#include <stdio.h>
+
+#define RUNS    1000U
+
+static uint8_t g_src[1024], g_dst[1024];
+static char g_line[96];
+
+enum { T_OFF, T_ON, T_COUNT };
+static const FsmState_t toggleStates[T_COUNT] = {
+    [T_OFF] = { "OFF", NULL, NULL, NULL },
+    [T_ON]  = { "ON",  NULL, NULL, NULL },
+};
+static const FsmTransition_t toggleRows[] = {
+    { T_OFF, 1, NULL, NULL, T_ON  },
+    { T_ON,  1, NULL, NULL, T_OFF },
+};
+static Fsm_t toggle;
+
+static void Check_Zone(ProfZone_t zone, const char *name)
+{
+    ProfStats_t st;
+    char what[48];
+
+    snprintf(what, sizeof(what), "%s: stats", name);
+    Check(Prof_GetStats(zone, &st), what);
+    snprintf(what, sizeof(what), "%s: %u samples", name, (unsigned)RUNS);
+    Check(st.count == RUNS, what);
+    snprintf(what, sizeof(what), "%s: min <= mean <= p99 <= max", name);
+    Check((st.minUs <= st.meanUs) && (st.meanUs <= st.p99Us) && (st.p99Us <= st.maxUs), what);
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+
+    ProfZone_t zEmpty  = Prof_AddZone("empty");
+    ProfZone_t zCopy   = Prof_AddZone("memcpy 1k");
+    ProfZone_t zFormat = Prof_AddZone("snprintf");
+    ProfZone_t zFsm    = Prof_AddZone("fsm step");
+
+    Fsm_Init(&toggle, toggleStates, T_COUNT, toggleRows, 2, NULL, NULL);
+    Fsm_Start(&toggle, T_OFF);
+
+    UART_Printf("\r\n===== 038 Profiler Bench (%u ticks/us) =====\r\n", (unsigned)Prof_TicksPerUs());
+
+    for (uint32_t i = 0; i < RUNS; i++) {
+        PROF_BEGIN(zEmpty);
+        PROF_END(zEmpty);
+
+        g_src[i & 1023U] = (uint8_t)i;
+        PROF_BEGIN(zCopy);
+        memcpy(g_dst, g_src, sizeof(g_dst));
+        PROF_END(zCopy);
+
+        PROF_BEGIN(zFormat);
+        snprintf(g_line, sizeof(g_line), "[SENSOR] LDR1=%4u LDR2=%4u T=%lu\r\n",
+                 (unsigned)(i & 4095U), (unsigned)(4095U - (i & 4095U)), (unsigned long)i);
+        PROF_END(zFormat);
+
+        PROF_BEGIN(zFsm);
+        (void)Fsm_Dispatch(&toggle, 1);
+        PROF_END(zFsm);
+    }
+
+    Prof_Dump();
+    Prof_DumpHistogram(zFormat);
+
+    Check_Zone(zEmpty, "empty");
+    Check_Zone(zCopy, "memcpy 1k");
+    Check_Zone(zFormat, "snprintf");
+    Check_Zone(zFsm, "fsm step");
+
+    ProfStats_t st;
+    (void)Prof_GetStats(zEmpty, &st);
+    Check(st.meanUs < 1U, "empty zone overhead below 1 us");
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,190 @@
+/*
+ * 039_intrusion_latency.c
+ *
+ * Created on: Feb 23, 2026
+ * Author: Rahul B.
+ * Description: Intrusion latency (latency.c) - simulation against the budget
+ *
+ * Replays the application's intrusion path with synthetic IR edges:
+ *
+ *   edge      posted to the event queue at pseudo-random instants,
+ *             alternating IR1 / IR2, as EXTI9_5_IRQHandler does
+ *   events    drained every EVENT_TASK_PERIOD_MS by a small main loop
+ *   display   a task that blocks the loop for DISPLAY_BLOCK_US every 50 ms,
+ *             the way a full OLED frame over I2C does
+ *   handler   Latency_Begin / decide / buzzer write / Latency_End, with
+ *             every 5th edge rate limited (no alert)
+ *
+ * Two runs of RUNS edges each:
+ *
+ *   8 ms display block   - every total within INTRUSION_LATENCY_BUDGET_US,
+ *                          worst <= block + events period + handler cost
+ *   30 ms display block  - the budget misses must be counted
+ *
+ * Also checked: per-sensor counts, min <= p50 <= p99 <= max, and the worst
+ * case breakdown adding up to the worst total.
+ *
+ * Only latency.c, event_queue.c and UART_Printf are used: the same file
+ * builds on a host with UART_Printf mapped to printf and app_init()
+ * stubbed out. now_us() is then a simulated clock that only the busy
+ * loops advance, so the run is deterministic and takes no time.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "event_queue.h"
+#include "latency.h"
+#include "config.h"
+#include "test_check.h"
+
+#define RUNS                500U
+#define DISPLAY_PERIOD_US   50000U
+#define DECIDE_COST_US      5U
+#define ACTUATE_COST_US     2U
+
+static uint32_t g_nextEdgeUs;
+static uint32_t g_posted;
+static uint32_t g_seed = 12345U;
+static volatile uint8_t g_buzzerPin;
+
+/* ===== CLOCK ===== */
+#if defined(__arm__)
+/* IR edges of the real sensors would mix with the synthetic ones */
+void EXTI9_5_IRQHandler(void)
+{
+    EXTI->PR = (1 << 6) | (1 << 8);
+}
+
+static void Sim_Advance(uint32_t until_us) { (void)until_us; }
+#else
+static uint64_t g_simUs = 1000U;
+
+uint64_t now_us(void) { return g_simUs; }
+uint64_t now_ms(void) { return g_simUs / 1000U; }
+
+static void Sim_Advance(uint32_t until_us) { g_simUs = until_us; }
+#endif
+
+static uint32_t Sim_Rand(uint32_t range)
+{
+    g_seed = g_seed * 1103515245U + 12345U;
+    return (g_seed >> 8) % range;
+}
+
+/* Burn us microseconds, posting every edge that falls inside (the "ISR") */
+static void Sim_Busy(uint32_t us)
+{
+    uint32_t end = (uint32_t)now_us() + us;
+
+    while (1) {
+        uint32_t now = (uint32_t)now_us();
+
+        if ((g_posted < RUNS) && ((int32_t)(now - g_nextEdgeUs) >= 0)) {
+            EventQueue_Post((g_posted & 1U) ? EVT_SRC_IR2 : EVT_SRC_IR1, EVT_EDGE_RISING, now);
+            g_posted++;
+            g_nextEdgeUs = now + 2000U + Sim_Rand(10000U);
+            continue;
+        }
+        if ((int32_t)(now - end) >= 0) break;
+
+        uint32_t next = ((g_posted < RUNS) && ((int32_t)(g_nextEdgeUs - end) < 0)) ? g_nextEdgeUs : end;
+        Sim_Advance(next);
+    }
+}
+
+/* ===== HANDLER (same shape as Intrusion_OnEvent) ===== */
+static void Intrusion_OnEvent(const Event_t *evt)
+{
+    LatTrace_t trace;
+
+    Latency_Begin(&trace, evt);
+    Sim_Busy(DECIDE_COST_US);
+    bool alert = (evt->seq % 5U) != 4U;
+    Latency_Decided(&trace);
+
+    if (alert) {
+        Sim_Busy(ACTUATE_COST_US);
+        g_buzzerPin = 1;
+        Latency_Actuated();
+    }
+    Latency_End(&trace);
+}
+
+/* Main loop: events every EVENT_TASK_PERIOD_MS, display every 50 ms */
+static void Run(uint32_t display_block_us)
+{
+    EventQueue_Init();
+    EventQueue_Subscribe(EVT_SRC_IR1, Intrusion_OnEvent);
+    EventQueue_Subscribe(EVT_SRC_IR2, Intrusion_OnEvent);
+    Latency_Reset();
+
+    g_posted = 0;
+    g_nextEdgeUs = (uint32_t)now_us() + 1000U;
+    uint32_t nextDisplay = (uint32_t)now_us();
+
+    while ((g_posted < RUNS) || (EventQueue_Count() != 0U)) {
+        EventQueue_Dispatch();
+        if ((int32_t)((uint32_t)now_us() - nextDisplay) >= 0) {
+            nextDisplay += DISPLAY_PERIOD_US;
+            Sim_Busy(display_block_us);
+        }
+        Sim_Busy(EVENT_TASK_PERIOD_MS * 1000U);
+    }
+
+    UART_Printf("\r\n--- display block %u us ---\r\n", (unsigned)display_block_us);
+    Latency_Dump();
+}
+
+static void Check_Sensor(LatSensor_t s, uint32_t edges)
+{
+    LatStats_t st;
+    const LatSensorData_t *d = Latency_GetSensor(s);
+
+    Check(Latency_GetStats(s, LAT_STAGE_QUEUE, &st) && (st.count == edges), "every edge dequeued and traced");
+    Check(Latency_GetStats(s, LAT_STAGE_DECIDE, &st) && (st.count == edges), "every edge decided");
+    Check(Latency_GetStats(s, LAT_STAGE_TOTAL, &st) && (st.count == edges - edges / 5U), "rate limited edges not in total");
+    Check((st.minUs <= st.p50Us) && (st.p50Us <= st.p99Us) && (st.p99Us <= st.maxUs), "min <= p50 <= p99 <= max");
+
+    const LatTrace_t *w = &d->worst;
+    Check((w->actuatorUs - w->edgeUs) == st.maxUs, "worst trace is the largest total");
+    Check(((w->dequeueUs - w->edgeUs) + (w->decisionUs - w->dequeueUs) + (w->actuatorUs - w->decisionUs))
+          == st.maxUs, "worst breakdown adds up");
+}
+
+int main(void)
+{
+    app_init();
+    Latency_Init();
+
+    UART_Printf("\r\n===== 039 Intrusion Latency (budget %u us) =====\r\n",
+                (unsigned)INTRUSION_LATENCY_BUDGET_US);
+
+    /* --- Within budget --- */
+    const uint32_t block = 8000U;
+    Run(block);
+    for (LatSensor_t s = LAT_SENSOR_IR1; s < LAT_SENSOR_COUNT; s++) {
+        LatStats_t st;
+        Check_Sensor(s, RUNS / 2U);
+        (void)Latency_GetStats(s, LAT_STAGE_TOTAL, &st);
+        Check(st.p99Us <= INTRUSION_LATENCY_BUDGET_US, "p99 within budget");
+        Check(st.maxUs <= block + EVENT_TASK_PERIOD_MS * 1000U + DECIDE_COST_US + ACTUATE_COST_US + 100U,
+              "worst within block + events period + handler");
+        Check(Latency_GetSensor(s)->overBudget == 0U, "no budget misses");
+    }
+
+    /* --- Slow display: budget misses must show up --- */
+    Run(30000U);
+    for (LatSensor_t s = LAT_SENSOR_IR1; s < LAT_SENSOR_COUNT; s++) {
+        Check_Sensor(s, RUNS / 2U);
+        Check(Latency_GetSensor(s)->overBudget != 0U, "budget misses counted");
+    }
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,118 @@
+/*
+ * 040_oled_dirty_bus.c
+ *
+ * Created on: Feb 24, 2026
+ * Author: Rahul B.
+ * Description: OLED dirty tracking (bsp_i2c_oled.c) - bytes on the I2C bus
+ *
+ * Draws the application's typical screens and prints, for every update,
+ * the windows, I2C transactions and bytes sent, with the bus time at
+ * 100 kHz (9 clocks per byte). The old full-frame update sent 1112 bytes
+ * (8 x (3 command transactions + 130 data bytes)), ~100 ms.
+ *
+ *   boot screen      4 lines of text after the power-up clear
+ *   sensors screen   Sensors_DisplayOnOLED(): clear + 3 lines
+ *   same again       redraw with nothing changed - must send nothing
+ *   state change     only "STATE: ..." on page 0 differs
+ *   print_Log        "> message" at y = 20, across pages 2 and 3
+ *   face bitmap      nearly the whole frame
+ *   clear            back to black
+ *
+ * On a host build link Tools/displaysim/sim_ssd1306.c, sim_hd44780.c
+ * and sim_host.c (I2C, GPIO, delays and clock) with bsp_i2c_oled.c,
+ * bsp_oled_gfx.c, the font and image files and profiler.c, UART_Printf
+ * mapped to printf and app_init() stubbed out; after every update the
+ * emulator's GDDRAM must equal the frame buffer.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "test_check.h"
+#include <string.h>
+#include <stdio.h>
+
+#define FULL_FRAME_BYTES    1112U   // before dirty tracking
+
+extern const uint8_t my_face_array[];
+
+/* ===== PANEL (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static bool Panel_Matches(void)
+{
+    return memcmp(Sim_OLED_GetRAM(), BSP_OLED_GetFrame(), OLED_PAGES * OLED_WIDTH) == 0;
+}
+#else
+static bool Panel_Matches(void) { return true; }
+#endif
+
+/* Update, print the bus traffic and return the bytes sent */
+static uint32_t Flush(const char *name)
+{
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_Update();
+
+    const OledBusStats_t *st = BSP_OLED_GetBusStats();
+    UART_Printf("[OLED] %-15s %2u windows %3u transactions %5u bytes %6u us\r\n", name,
+                (unsigned)st->windows, (unsigned)st->transactions, (unsigned)st->bytes,
+                (unsigned)(st->bytes * 90U));
+    Check(Panel_Matches(), "panel RAM equals frame buffer");
+    return st->bytes;
+}
+
+static void Sensors_Screen(const char *state)
+{
+    char buffer[32];
+
+    BSP_OLED_Clear();
+    snprintf(buffer, sizeof(buffer), "STATE: %s", state);
+    BSP_OLED_PrintString(0, 0, buffer);
+    BSP_OLED_PrintString(0, 16, "User: admin");
+    BSP_OLED_PrintString(0, 32, "User: admin");
+}
+
+int main(void)
+{
+    app_init();
+    BSP_OLED_Init();
+
+    UART_Printf("\r\n===== 040 OLED Dirty Tracking (full frame was %u bytes) =====\r\n",
+                (unsigned)FULL_FRAME_BYTES);
+
+    BSP_OLED_PrintString(10, 0, "STM32 System");
+    BSP_OLED_PrintString(0, 16, "Home Automation");
+    BSP_OLED_PrintString(20, 32, "v1.0");
+    BSP_OLED_PrintString(0, 48, "Initializing...");
+    Check(Flush("boot screen") < FULL_FRAME_BYTES / 2U, "boot screen below half a frame");
+
+    Sensors_Screen("STANDBY");
+    Check(Flush("sensors screen") < FULL_FRAME_BYTES / 2U, "sensors screen below half a frame");
+
+    Sensors_Screen("STANDBY");
+    Check(Flush("same again") == 0U, "unchanged screen sends nothing");
+
+    Sensors_Screen("MENU");
+    Check(Flush("state change") < 100U, "state change below 100 bytes");
+
+    OLED_Printf(0, 20, "> %-16s", "Door opened");
+    Check(Flush("print_Log") < 400U, "print_Log below 400 bytes");
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    Check(Flush("face bitmap") <= 1048U, "full frame no larger than one window");
+
+    BSP_OLED_Clear();
+    Flush("clear");
+
+    BSP_OLED_Invalidate();
+    Check(Flush("invalidate") == 1048U, "invalidate sends the whole frame");
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,181 @@
+/*
+ * 041_oled_async_flush.c
+ *
+ * Created on: Feb 25, 2026
+ * Author: Rahul B.
+ * Description: Interrupt driven OLED flush (bsp_i2c_oled.c) - pipeline checks
+ *
+ * With BSP_OLED_SetAsync(true), BSP_OLED_Update() commits the buffer and
+ * returns; the frame goes out from the I2C1 interrupt. Checked here:
+ *
+ *   return time     Update returns long before the frame is on the panel
+ *   queue           an Update during a flush waits for the bus (2 in flight)
+ *   coalescing      further Updates merge into the queued frame
+ *   snapshot        drawing without Update while frames are in flight does
+ *                   not reach the panel: it shows the last committed frame
+ *   callback        called once per frame, with the result
+ *   error           a NACK mid-frame is counted and the next Update resends
+ *                   the whole frame (host only)
+ *
+ * On a host build link Tools/displaysim/sim_ssd1306.c, sim_hd44780.c
+ * and sim_host.c with bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image
+ * files and profiler.c, UART_Printf mapped to printf and app_init()
+ * stubbed out.
+ * The emulator holds each DMA transaction until Bus_Step() plays the
+ * I2C1 interrupt; the clock advances by its bus time at 100 kHz.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_timebase.h"
+#include "test_check.h"
+#include <string.h>
+
+#define US_PER_BYTE         90U     // 9 clocks at 100 kHz
+
+extern I2C_Handle_t g_OledI2cHandle;
+
+static uint8_t g_committed[OLED_PAGES * OLED_WIDTH];   // buffer at the last Update
+static uint32_t g_callbacksOk = 0;
+static uint32_t g_callbacksFailed = 0;
+
+static void On_Flush(bool ok)
+{
+    if (ok) g_callbacksOk++;
+    else g_callbacksFailed++;
+}
+
+/* ===== PANEL AND BUS (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static void Bus_Setup(void)
+{
+    Sim_AdvanceUs(1000U);
+    Sim_OLED_SetBusTime(US_PER_BYTE);
+    Sim_OLED_SetDmaDeferred(true);
+}
+
+/* One I2C1 interrupt: the pending transaction completes */
+static void Bus_Step(void)
+{
+    (void)Sim_OLED_DmaStep();
+}
+
+static void Bus_Drain(void)
+{
+    while (Sim_OLED_DmaStep()) { }
+}
+
+/* The display NACKs the pending transaction */
+static void Bus_Fail(void)
+{
+    (void)Sim_OLED_DmaFail();
+}
+
+static bool Panel_Matches(const uint8_t *frame)
+{
+    return memcmp(Sim_OLED_GetRAM(), frame, OLED_PAGES * OLED_WIDTH) == 0;
+}
+#else
+static void Bus_Setup(void) { }
+static void Bus_Step(void) { }
+static void Bus_Drain(void) { BSP_OLED_WaitIdle(); }
+static bool Panel_Matches(const uint8_t *frame) { (void)frame; return true; }
+#endif
+
+/* Update and remember what was committed; returns how long the call took */
+static uint32_t Commit(void)
+{
+    uint32_t start = (uint32_t)now_us();
+
+    BSP_OLED_Update();
+    uint32_t us = (uint32_t)now_us() - start;
+    memcpy(g_committed, BSP_OLED_GetFrame(), sizeof(g_committed));
+    return us;
+}
+
+static void Print_Stats(const char *name)
+{
+    const OledFlushStats_t *fs = BSP_OLED_GetFlushStats();
+
+    UART_Printf("[OLED] %-12s started %u completed %u coalesced %u errors %u last %6u us max %6u us\r\n",
+                name, (unsigned)fs->started, (unsigned)fs->completed, (unsigned)fs->coalesced,
+                (unsigned)fs->errors, (unsigned)fs->lastUs, (unsigned)fs->maxUs);
+}
+
+int main(void)
+{
+    app_init();
+    BSP_OLED_Init();
+    Bus_Setup();
+
+    UART_Printf("\r\n===== 041 OLED Async Flush =====\r\n");
+
+    BSP_OLED_SetAsync(true);
+    BSP_OLED_SetFlushCallback(On_Flush);
+    BSP_OLED_ResetFlushStats();
+    const OledFlushStats_t *fs = BSP_OLED_GetFlushStats();
+
+    /* --- One frame: Update returns at once --- */
+    BSP_OLED_Clear();
+    BSP_OLED_PrintString(10, 0, "STM32 System");
+    BSP_OLED_PrintString(0, 16, "Home Automation");
+    uint32_t us = Commit();
+    UART_Printf("[OLED] Update returned after %u us\r\n", (unsigned)us);
+    Check(us < 1000U, "Update returns within 1 ms");
+    Check(BSP_OLED_FramesInFlight() == 1U, "one frame in flight");
+    Bus_Drain();
+    Check(BSP_OLED_FramesInFlight() == 0U, "no frame in flight after the flush");
+    Check(Panel_Matches(g_committed), "panel shows the frame");
+    Check((fs->completed == 1U) && (g_callbacksOk == 1U), "frame completed, callback once");
+    Check(fs->lastUs > us, "flush took longer than Update");
+    Print_Stats("one frame");
+
+    /* --- Updates during a flush: queued, then coalesced --- */
+    BSP_OLED_PrintString(0, 32, "v1.0");
+    (void)Commit();
+    Bus_Step();
+    BSP_OLED_PrintString(0, 48, "Initializing...");
+    (void)Commit();
+    Check(BSP_OLED_FramesInFlight() == 2U, "second update queued");
+    BSP_OLED_PrintString(0, 48, "Ready          ");
+    (void)Commit();
+    Check(fs->coalesced == 1U, "third update coalesced");
+
+    // Drawn but never committed: must not reach the panel
+    BSP_OLED_PrintString(0, 0, "NOT COMMITTED");
+    Bus_Drain();
+    Check(Panel_Matches(g_committed), "panel shows the last committed frame");
+    Check((fs->started == 3U) && (fs->completed == 3U) && (g_callbacksOk == 3U), "two frames for three updates");
+    Print_Stats("coalesced");
+
+#if !defined(__arm__)
+    /* --- NACK in the middle of a frame --- */
+    BSP_OLED_PrintString(0, 16, "Door opened    ");
+    (void)Commit();
+    Bus_Step();
+    Bus_Fail();
+    Check((fs->errors == 1U) && (g_callbacksFailed == 1U), "error counted, callback with false");
+    Check(BSP_OLED_FramesInFlight() == 0U, "bus released after the error");
+    Check(g_OledI2cHandle.pI2Cx->CR1 & (1 << I2C_CR1_STOP), "STOP generated");
+
+    BSP_OLED_ResetBusStats();
+    (void)Commit();
+    Bus_Drain();
+    Check(BSP_OLED_GetBusStats()->bytes == 1048U, "whole frame resent after the error");
+    Check(Panel_Matches(g_committed), "panel recovered");
+    Print_Stats("error");
+#endif
+
+    Check(fs->started == fs->completed + fs->errors, "every started frame ended");
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
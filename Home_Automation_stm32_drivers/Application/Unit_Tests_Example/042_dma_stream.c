@@ -0,0 +1,377 @@
+/*
+ * 042_dma_stream.c
+ *
+ * Created on: Feb 26, 2026
+ * Author: Rahul B.
+ * Description: DMA stream driver (stm32f446xx_dma_driver.c) - register checks
+ *
+ * Checked on a host build, against a model of the stream registers:
+ *
+ *   layout      LISR..HIFCR, stream blocks at 0x10 + 0x18 * n
+ *   init        CR and FCR for the OLED stream (M2P, channel 1, bytes)
+ *   m2p         16 bytes into a fake I2C DR: every byte, one TC callback
+ *   flags       every stream of both controllers: the right 6-bit group of
+ *               LISR/HISR is read and exactly its bits are written to
+ *               LIFCR/HIFCR
+ *   circular    P2M halfwords from a fake ADC DR with HT: HT, TC, HT, TC,
+ *               the stream stays busy until DMA_Abort()
+ *   error       TE: error callback, handle ready again
+ *   busy        DMA_StartIT on a busy stream does nothing
+ *
+ * The model keeps the registers in RAM: a Sim_Step() moves one data item
+ * between the 32-bit addresses in PAR/M0AR (mapped to host buffers),
+ * counts NDTR down, raises HT/TC and calls DMA_IRQHandling() when the
+ * interrupt is enabled. Write-1-to-clear is applied after every call.
+ * Build it with UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * On the target a DMA2 Stream0 memory-to-memory copy of 1 KiB is checked
+ * and timed against memcpy instead.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_timebase.h"
+#include "stm32f446xx_dma_driver.h"
+#include "test_check.h"
+#include <stddef.h>
+#include <string.h>
+
+static uint8_t g_events[16];
+static uint8_t g_eventCount = 0;
+
+static void On_Dma(DMA_Handle_t *pDMAHandle, uint8_t AppEv)
+{
+    (void)pDMAHandle;
+    if (g_eventCount < sizeof(g_events)) g_events[g_eventCount++] = AppEv;
+}
+
+#if !defined(__arm__)
+/* ===== STREAM MODEL (host only) ===== */
+#define SIM_I2C_DR          0x40005410U     // I2C1 DR
+#define SIM_ADC_DR          0x4001204CU     // ADC1 DR
+#define SIM_FRAME           0x20000000U
+#define SIM_ADC_BUF         0x20001000U
+
+static DMA_RegDef_t g_dma1, g_dma2;
+static uint8_t g_frame[16];
+static uint16_t g_adcBuf[8];
+static uint8_t g_i2cLog[32];
+static uint32_t g_i2cCount = 0;
+static uint16_t g_adcSample = 0;
+
+/* Transfer in progress: programmed length and items done in this lap */
+static uint32_t g_len = 0;
+static uint32_t g_done = 0;
+
+static void *Sim_Memory(uint32_t addr)
+{
+    if ((addr >= SIM_FRAME) && (addr < SIM_FRAME + sizeof(g_frame))) {
+        return &g_frame[addr - SIM_FRAME];
+    }
+    if ((addr >= SIM_ADC_BUF) && (addr < SIM_ADC_BUF + sizeof(g_adcBuf))) {
+        return (uint8_t *)g_adcBuf + (addr - SIM_ADC_BUF);
+    }
+    return NULL;
+}
+
+/* Write-1-to-clear of LIFCR/HIFCR */
+static void Sim_ApplyClear(DMA_RegDef_t *pDMAx)
+{
+    pDMAx->LISR &= ~pDMAx->LIFCR;
+    pDMAx->HISR &= ~pDMAx->HIFCR;
+    pDMAx->LIFCR = 0;
+    pDMAx->HIFCR = 0;
+}
+
+static void Sim_SetFlags(DMA_Handle_t *h, uint32_t flags)
+{
+    static const uint8_t shift[4] = { 0, 6, 16, 22 };
+
+    if (h->Stream < 4) h->pDMAx->LISR |= flags << shift[h->Stream];
+    else h->pDMAx->HISR |= flags << shift[h->Stream - 4];
+}
+
+/* NVIC: the handler runs when a flag with its interrupt enabled is set */
+static void Sim_Interrupt(DMA_Handle_t *h)
+{
+    DMA_IRQHandling(h);
+    Sim_ApplyClear(h->pDMAx);
+}
+
+static uint8_t Sim_Start(DMA_Handle_t *h, uint32_t periph, uint32_t mem, uint16_t len)
+{
+    uint8_t state = DMA_StartIT(h, periph, mem, len);
+
+    Sim_ApplyClear(h->pDMAx);
+    if (state == DMA_READY) {
+        g_len = len;
+        g_done = 0;
+    }
+    return state;
+}
+
+/* One data item moved by the stream */
+static void Sim_Step(DMA_Handle_t *h)
+{
+    DMA_Stream_RegDef_t *s = &h->pDMAx->S[h->Stream];
+    uint32_t size = 1U << ((s->CR >> DMA_SxCR_PSIZE) & 0x3);
+    uint32_t dir = (s->CR >> DMA_SxCR_DIR) & 0x3;
+    uint32_t mem = s->M0AR + ((s->CR & (1 << DMA_SxCR_MINC)) ? g_done * size : 0U);
+    uint32_t item = 0;
+
+    if (!(s->CR & (1 << DMA_SxCR_EN)) || (s->NDTR == 0U)) return;
+
+    if (dir == DMA_DIR_M2P) {
+        memcpy(&item, Sim_Memory(mem), size);
+        if (s->PAR == SIM_I2C_DR) g_i2cLog[g_i2cCount++ % sizeof(g_i2cLog)] = (uint8_t)item;
+    } else {
+        item = (s->PAR == SIM_ADC_DR) ? g_adcSample++ : 0U;
+        memcpy(Sim_Memory(mem), &item, size);
+    }
+
+    g_done++;
+    s->NDTR--;
+    if (g_done == g_len / 2U) {
+        Sim_SetFlags(h, DMA_FLAG_HTIF);
+        if (s->CR & (1 << DMA_SxCR_HTIE)) Sim_Interrupt(h);
+    }
+    if (s->NDTR == 0U) {
+        if (s->CR & (1 << DMA_SxCR_CIRC)) {
+            s->NDTR = g_len;
+            g_done = 0;
+        } else {
+            s->CR &= ~(1 << DMA_SxCR_EN);
+        }
+        Sim_SetFlags(h, DMA_FLAG_TCIF);
+        if (s->CR & (1 << DMA_SxCR_TCIE)) Sim_Interrupt(h);
+    }
+}
+
+static void Test_Layout(void)
+{
+    Check(offsetof(DMA_RegDef_t, HIFCR) == 0x0CU, "HIFCR at 0x0C");
+    Check(offsetof(DMA_RegDef_t, S[0]) == 0x10U, "S0CR at 0x10");
+    Check(offsetof(DMA_RegDef_t, S[7]) == 0xB8U, "S7CR at 0xB8");
+    Check(sizeof(DMA_Stream_RegDef_t) == 0x18U, "stream block is 0x18 bytes");
+    Check(offsetof(DMA_Stream_RegDef_t, FCR) == 0x14U, "SxFCR at 0x14");
+}
+
+static void Test_M2P(DMA_Handle_t *h)
+{
+    memset(&h->DMA_Config, 0, sizeof(h->DMA_Config));
+    h->pDMAx = &g_dma1;
+    h->Stream = 7;
+    h->DMA_Config.DMA_Channel = DMA_CHANNEL_1;
+    h->DMA_Config.DMA_Direction = DMA_DIR_M2P;
+    h->DMA_Config.DMA_MemInc = ENABLE;
+    h->DMA_Config.DMA_Priority = DMA_PRIORITY_LOW;
+    h->pCallback = On_Dma;
+    g_dma1.HISR = DMA_FLAG_TCIF << 22;      // stale flag from an earlier transfer
+    DMA_Init(h);
+    Sim_ApplyClear(&g_dma1);
+
+    DMA_Stream_RegDef_t *s = &g_dma1.S[7];
+    Check(s->CR == ((1U << DMA_SxCR_CHSEL) | (1U << DMA_SxCR_DIR) | (1U << DMA_SxCR_MINC)), "init: CR");
+    Check(s->FCR == 0U, "init: direct mode");
+    Check(g_dma1.HISR == 0U, "init: stale flag cleared");
+
+    for (uint32_t i = 0; i < sizeof(g_frame); i++) g_frame[i] = (uint8_t)(0x40 + i);
+    g_eventCount = 0;
+    g_i2cCount = 0;
+    Check(Sim_Start(h, SIM_I2C_DR, SIM_FRAME, sizeof(g_frame)) == DMA_READY, "m2p: started");
+    Check((s->PAR == SIM_I2C_DR) && (s->M0AR == SIM_FRAME) && (s->NDTR == sizeof(g_frame)), "m2p: PAR, M0AR, NDTR");
+    Check((s->CR & (1 << DMA_SxCR_EN)) && (s->CR & (1 << DMA_SxCR_TCIE)) && !(s->CR & (1 << DMA_SxCR_HTIE)),
+          "m2p: EN and TCIE, no HTIE");
+    Check(h->State == DMA_BUSY, "m2p: busy");
+
+    for (uint32_t i = 0; i < 2U * sizeof(g_frame); i++) Sim_Step(h);
+    Check((g_i2cCount == sizeof(g_frame)) && (memcmp(g_i2cLog, g_frame, sizeof(g_frame)) == 0),
+          "m2p: every byte written to DR, in order");
+    Check((g_eventCount == 1U) && (g_events[0] == DMA_EV_TC), "m2p: one TC callback");
+    Check((h->State == DMA_READY) && (DMA_GetRemaining(h) == 0U), "m2p: ready, NDTR 0");
+    Check(!(g_dma1.HISR & (DMA_FLAG_TCIF << 22)), "m2p: TCIF cleared");
+    Check(g_dma1.HISR & (DMA_FLAG_HTIF << 22), "m2p: HTIF left set (HTIE off)");
+}
+
+static void Test_Flags(void)
+{
+    static const uint8_t shift[4] = { 0, 6, 16, 22 };
+    DMA_RegDef_t *ctrl[2] = { &g_dma1, &g_dma2 };
+    uint32_t all = 0;
+
+    for (uint8_t g = 0; g < 4; g++) all |= (uint32_t)DMA_FLAG_ALL << shift[g];
+
+    for (uint8_t c = 0; c < 2; c++) {
+        for (uint8_t stream = 0; stream < 8; stream++) {
+            DMA_Handle_t h = { .pDMAx = ctrl[c], .Stream = stream };
+            uint32_t group = (uint32_t)DMA_FLAG_TCIF << shift[stream & 0x3];
+            volatile uint32_t *isr = (stream < 4) ? &ctrl[c]->LISR : &ctrl[c]->HISR;
+            volatile uint32_t *other = (stream < 4) ? &ctrl[c]->HISR : &ctrl[c]->LISR;
+
+            // Only this stream's TCIF set: seen here, not by the neighbours
+            ctrl[c]->LISR = ctrl[c]->HISR = 0;
+            *isr = group;
+            Check(DMA_GetFlagStatus(&h, DMA_FLAG_TCIF) == FLAG_SET, "flags: own TCIF seen");
+            Check(DMA_GetFlagStatus(&h, DMA_FLAG_ALL & ~DMA_FLAG_TCIF) == FLAG_RESET, "flags: no other flag seen");
+            for (uint8_t n = 0; n < 8; n++) {
+                DMA_Handle_t nb = { .pDMAx = ctrl[c], .Stream = n };
+                if ((n != stream) && (DMA_GetFlagStatus(&nb, DMA_FLAG_ALL) != FLAG_RESET)) {
+                    Check(false, "flags: neighbour sees nothing");
+                }
+            }
+
+            // Everything set: clearing TCIF writes exactly that bit
+            ctrl[c]->LISR = ctrl[c]->HISR = all;
+            DMA_ClearFlag(&h, DMA_FLAG_TCIF);
+            Check(((stream < 4) ? ctrl[c]->LIFCR : ctrl[c]->HIFCR) == group, "flags: IFCR bit");
+            Check(((stream < 4) ? ctrl[c]->HIFCR : ctrl[c]->LIFCR) == 0U, "flags: other IFCR untouched");
+            Sim_ApplyClear(ctrl[c]);
+            Check((*isr == (all & ~group)) && (*other == all), "flags: only TCIF cleared");
+        }
+        ctrl[c]->LISR = ctrl[c]->HISR = 0;
+    }
+}
+
+static void Test_Circular(DMA_Handle_t *h)
+{
+    memset(&h->DMA_Config, 0, sizeof(h->DMA_Config));
+    h->pDMAx = &g_dma2;
+    h->Stream = 0;
+    h->DMA_Config.DMA_Channel = DMA_CHANNEL_0;
+    h->DMA_Config.DMA_Direction = DMA_DIR_P2M;
+    h->DMA_Config.DMA_MemInc = ENABLE;
+    h->DMA_Config.DMA_PeriphSize = DMA_SIZE_HALFWORD;
+    h->DMA_Config.DMA_MemSize = DMA_SIZE_HALFWORD;
+    h->DMA_Config.DMA_Mode = DMA_MODE_CIRCULAR;
+    h->DMA_Config.DMA_Priority = DMA_PRIORITY_HIGH;
+    h->DMA_Config.DMA_HalfTransferIT = ENABLE;
+    h->pCallback = On_Dma;
+    DMA_Init(h);
+    Sim_ApplyClear(&g_dma2);
+
+    DMA_Stream_RegDef_t *s = &g_dma2.S[0];
+    Check(s->CR == ((1U << DMA_SxCR_CIRC) | (1U << DMA_SxCR_MINC) | (1U << DMA_SxCR_PSIZE) |
+                    (1U << DMA_SxCR_MSIZE) | (2U << DMA_SxCR_PL)), "circular: CR");
+
+    g_eventCount = 0;
+    g_adcSample = 0;
+    (void)Sim_Start(h, SIM_ADC_DR, SIM_ADC_BUF, 8);
+    Check(s->CR & (1 << DMA_SxCR_HTIE), "circular: HTIE");
+
+    for (uint32_t i = 0; i < 16U; i++) Sim_Step(h);
+    Check((g_eventCount == 4U) && (g_events[0] == DMA_EV_HT) && (g_events[1] == DMA_EV_TC) &&
+          (g_events[2] == DMA_EV_HT) && (g_events[3] == DMA_EV_TC), "circular: HT, TC, HT, TC");
+    Check((g_adcBuf[0] == 8U) && (g_adcBuf[7] == 15U), "circular: second lap over the first");
+    Check((h->State == DMA_BUSY) && (s->CR & (1 << DMA_SxCR_EN)) && (s->NDTR == 8U), "circular: still running");
+
+    DMA_Abort(h);
+    Sim_ApplyClear(&g_dma2);
+    Check((h->State == DMA_READY) && !(s->CR & (1 << DMA_SxCR_EN)), "abort: stopped, ready");
+    Check(!(s->CR & ((1 << DMA_SxCR_TCIE) | (1 << DMA_SxCR_HTIE) | (1 << DMA_SxCR_TEIE))), "abort: interrupts off");
+    Check(g_eventCount == 4U, "abort: no callback");
+}
+
+static void Test_Error(DMA_Handle_t *h)
+{
+    DMA_Stream_RegDef_t *s = &g_dma1.S[7];
+
+    Test_M2P(h);
+    g_eventCount = 0;
+    (void)Sim_Start(h, SIM_I2C_DR, SIM_FRAME, sizeof(g_frame));
+    Sim_Step(h);
+
+    // StartIT on a busy stream: nothing changes
+    Check(Sim_Start(h, SIM_I2C_DR, SIM_FRAME, 4) == DMA_BUSY, "busy: DMA_BUSY returned");
+    Check(s->NDTR == sizeof(g_frame) - 1U, "busy: NDTR untouched");
+
+    // Bus error: hardware clears EN and sets TEIF
+    s->CR &= ~(1 << DMA_SxCR_EN);
+    Sim_SetFlags(h, DMA_FLAG_TEIF);
+    Sim_Interrupt(h);
+    Check((g_eventCount == 1U) && (g_events[0] == DMA_ERROR_TE), "error: TE callback");
+    Check(h->State == DMA_READY, "error: ready again");
+    Check(!(g_dma1.HISR & (DMA_FLAG_TEIF << 22)), "error: TEIF cleared");
+}
+
+static void Run_Tests(void)
+{
+    DMA_Handle_t h;
+
+    Test_Layout();
+    Test_M2P(&h);
+    Test_Flags();
+    Test_Circular(&h);
+    Test_Error(&h);
+}
+#else
+/* ===== MEMORY TO MEMORY (target only) ===== */
+#define COPY_BYTES          1024U
+
+static DMA_Handle_t g_DmaHandle;
+static uint32_t g_src[COPY_BYTES / 4U];
+static uint32_t g_dst[COPY_BYTES / 4U];
+
+void DMA2_Stream0_IRQHandler(void)
+{
+    DMA_IRQHandling(&g_DmaHandle);
+}
+
+static void Run_Tests(void)
+{
+    DMA_Handle_t *h = &g_DmaHandle;
+
+    h->pDMAx = DMA2;
+    h->Stream = 0;
+    h->DMA_Config.DMA_Channel = DMA_CHANNEL_0;
+    h->DMA_Config.DMA_Direction = DMA_DIR_M2M;
+    h->DMA_Config.DMA_PeriphInc = ENABLE;
+    h->DMA_Config.DMA_MemInc = ENABLE;
+    h->DMA_Config.DMA_PeriphSize = DMA_SIZE_WORD;
+    h->DMA_Config.DMA_MemSize = DMA_SIZE_WORD;
+    h->DMA_Config.DMA_Mode = DMA_MODE_NORMAL;
+    h->DMA_Config.DMA_Priority = DMA_PRIORITY_HIGH;
+    h->DMA_Config.DMA_FIFOMode = DMA_FIFO_ENABLE;
+    h->DMA_Config.DMA_FIFOThreshold = DMA_FIFO_TH_FULL;
+    h->DMA_Config.DMA_HalfTransferIT = DISABLE;
+    h->pCallback = On_Dma;
+    DMA_Init(h);
+    DMA_IRQInterruptConfig(DMA_GetIRQNumber(DMA2, 0), ENABLE);
+
+    for (uint32_t i = 0; i < COPY_BYTES / 4U; i++) g_src[i] = 0xA5000000U | i;
+    memset(g_dst, 0, sizeof(g_dst));
+
+    g_eventCount = 0;
+    uint64_t start = now_us();
+    Check(DMA_StartIT(h, (uint32_t)g_src, (uint32_t)g_dst, COPY_BYTES / 4U) == DMA_READY, "m2m: started");
+    while (h->State == DMA_BUSY);
+    uint32_t dmaUs = (uint32_t)(now_us() - start);
+
+    Check((g_eventCount == 1U) && (g_events[0] == DMA_EV_TC), "m2m: one TC callback");
+    Check(memcmp(g_src, g_dst, sizeof(g_dst)) == 0, "m2m: copy matches");
+
+    start = now_us();
+    memcpy(g_dst, g_src, sizeof(g_dst));
+    uint32_t cpuUs = (uint32_t)(now_us() - start);
+    UART_Printf("[DMA] %u bytes: DMA %u us, memcpy %u us\r\n", (unsigned)COPY_BYTES,
+                (unsigned)dmaUs, (unsigned)cpuUs);
+
+    DMA_IRQInterruptConfig(DMA_GetIRQNumber(DMA2, 0), DISABLE);
+}
+#endif
+
+int main(void)
+{
+    app_init();
+
+    UART_Printf("\r\n===== 042 DMA Stream Driver =====\r\n");
+
+    Run_Tests();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,202 @@
+/*
+ * 043_oled_text_blit.c
+ *
+ * Created on: Feb 27, 2026
+ * Author: Rahul B.
+ * Description: OLED text blitter (bsp_i2c_oled.c) - equivalence and speed
+ *
+ * BSP_OLED_PrintString() writes whole glyph columns into the frame buffer
+ * instead of calling BSP_OLED_DrawPixel() 40 times per glyph. Checked
+ * against the per-pixel renderer, kept here as the reference:
+ *
+ *   equivalence   every y from 0 to 63 (page aligned and shifted) and
+ *                 x near both edges, drawn over the face bitmap so the
+ *                 masks must keep the pixels around the text
+ *   clipping      text past the right edge and below the bottom is cut,
+ *                 the rest of the buffer is unchanged
+ *   draw char     BSP_OLED_DrawChar() equals a one-character string
+ *
+ * Then both renderers draw RUNS times a print_Log line ("> message" at
+ * y = 20, two pages) and an OLED_Printf line (y = 0, one page), timed
+ * with the profiler. The blitter must be at least 3x faster.
+ *
+ * On a host build nothing is flushed, but the display code must link:
+ * add Tools/displaysim/sim_ssd1306.c, sim_hd44780.c and sim_host.c to
+ * bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image files and
+ * profiler.c, UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+#include <stdio.h>
+
+#define RUNS            1000U
+#define FONT_FIRST      32
+
+extern const uint8_t my_face_array[];
+
+static uint8_t g_expected[OLED_PAGES * OLED_WIDTH];
+
+/* ===== REFERENCE: the per-pixel renderer ===== */
+/* Glyph columns are read back from the blitter: a character drawn page
+   aligned on a cleared page 0 leaves its 5 column bytes in the buffer */
+static uint8_t g_font[95][5];
+
+static void Ref_LoadFont(void)
+{
+    for (uint8_t i = 0; i < 95; i++) {
+        BSP_OLED_Clear();
+        BSP_OLED_DrawChar(0, 0, (char)(FONT_FIRST + i));
+        memcpy(g_font[i], BSP_OLED_GetFrame(), 5);
+    }
+}
+
+static void Ref_PrintString(uint8_t x, uint8_t y, const char *str)
+{
+    uint16_t cursor_x = x;
+
+    while (*str) {
+        char c = *str;
+        if (c < 32 || c > 126) c = 32;
+
+        for (int col = 0; col < 5; col++) {
+            uint8_t column_data = g_font[c - FONT_FIRST][col];
+
+            for (int row = 0; row < 8; row++) {
+                if (cursor_x < OLED_WIDTH && y + row < OLED_HEIGHT) {
+                    BSP_OLED_DrawPixel((uint8_t)cursor_x, y + row, (column_data >> row) & 0x01);
+                }
+            }
+            cursor_x++;
+        }
+        cursor_x += 2;
+        str++;
+    }
+}
+
+/* ===== CHECKS ===== */
+static bool Same_As(const char *str, uint8_t x, uint8_t y)
+{
+    BSP_OLED_DrawBitmap(my_face_array);
+    Ref_PrintString(x, y, str);
+    memcpy(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected));
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_PrintString(x, y, (char *)str);
+    return memcmp(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0;
+}
+
+static void Test_Equivalence(void)
+{
+    static const uint8_t xs[] = { 0, 1, 7, 37, 100, 120, 125, 127, 128, 200 };
+    const char *text = "> Door opened ~!{}";
+    uint32_t mismatches = 0;
+
+    for (uint8_t y = 0; y < OLED_HEIGHT + 4; y++) {
+        for (uint8_t i = 0; i < sizeof(xs); i++) {
+            if (!Same_As(text, xs[i], y)) {
+                if (mismatches++ == 0) UART_Printf("[BLIT] first mismatch at x %u y %u\r\n", xs[i], y);
+            }
+        }
+    }
+    Check(mismatches == 0U, "blitter equals the per-pixel renderer");
+
+    char all[96];
+    for (uint8_t i = 0; i < 95; i++) all[i] = (char)(FONT_FIRST + i);
+    all[95] = '\0';
+    Check(Same_As(all, 0, 0) && Same_As(all, 3, 61), "whole font, past both edges");
+    Check(Same_As("\t\x7f\x80", 10, 10), "non-printable characters draw as spaces");
+}
+
+static void Test_Clipping(void)
+{
+    const uint8_t *frame = BSP_OLED_GetFrame();
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_PrintString(124, 60, "WWWWWWWW");
+    Check(memcmp(frame, my_face_array, 7 * OLED_WIDTH) == 0, "pages above the text untouched");
+    Check(memcmp(&frame[7 * OLED_WIDTH], &my_face_array[7 * OLED_WIDTH], 124) == 0,
+          "columns left of the text untouched");
+    Check((frame[7 * OLED_WIDTH + 124] & 0x0F) == (my_face_array[7 * OLED_WIDTH + 124] & 0x0F),
+          "rows above y untouched");
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_PrintString(128, 0, "clipped");
+    BSP_OLED_PrintString(0, 64, "clipped");
+    Check(memcmp(frame, my_face_array, sizeof(g_expected)) == 0, "text off the screen draws nothing");
+
+    BSP_OLED_Clear();
+    BSP_OLED_DrawChar(30, 13, 'A');
+    memcpy(g_expected, frame, sizeof(g_expected));
+    BSP_OLED_Clear();
+    BSP_OLED_PrintString(30, 13, "A");
+    Check(memcmp(g_expected, frame, sizeof(g_expected)) == 0, "DrawChar equals a one-character string");
+}
+
+/* ===== BENCHMARK ===== */
+typedef void (*Render_t)(uint8_t x, uint8_t y, const char *str);
+
+static void Fast_PrintString(uint8_t x, uint8_t y, const char *str)
+{
+    BSP_OLED_PrintString(x, y, (char *)str);
+}
+
+/* Average ns per string over RUNS renders, alternating two texts so every
+   call changes the buffer */
+static uint32_t Bench(Render_t render, uint8_t y, const char *a, const char *b)
+{
+    uint32_t start = Prof_Now();
+
+    for (uint32_t i = 0; i < RUNS; i++) {
+        render(0, y, (i & 1U) ? b : a);
+    }
+    uint32_t ticks = Prof_Now() - start;
+    return (uint32_t)(((uint64_t)ticks * 1000U / Prof_TicksPerUs()) / RUNS);
+}
+
+static void Bench_Line(const char *name, uint8_t y, const char *a, const char *b)
+{
+    uint32_t refNs = Bench(Ref_PrintString, y, a, b);
+    uint32_t fastNs = Bench(Fast_PrintString, y, a, b);
+    uint32_t x10 = fastNs ? (refNs * 10U) / fastNs : 0U;
+
+    UART_Printf("[BLIT] %-10s y %2u  per-pixel %6u ns  blitter %6u ns  x%u.%u\r\n", name, y,
+                (unsigned)refNs, (unsigned)fastNs, (unsigned)(x10 / 10U), (unsigned)(x10 % 10U));
+    Check(refNs >= 3U * fastNs, "blitter at least 3x faster");
+}
+
+int main(void)
+{
+    char logA[32], logB[32], printfA[64], printfB[64];
+
+    app_init();
+    Prof_Init();
+
+    UART_Printf("\r\n===== 043 OLED Text Blitter =====\r\n");
+
+    Ref_LoadFont();
+    Test_Equivalence();
+    Test_Clipping();
+
+    // print_Log: "> %-16s" at y = 20; OLED_Printf: a sensors line at y = 0
+    snprintf(logA, sizeof(logA), "> %-16s", "Door opened");
+    snprintf(logB, sizeof(logB), "> %-16s", "Intrusion IR2");
+    snprintf(printfA, sizeof(printfA), "T:%2dC H:%2d%% L:%4d", 24, 51, 812);
+    snprintf(printfB, sizeof(printfB), "T:%2dC H:%2d%% L:%4d", 25, 49, 1033);
+
+    BSP_OLED_Clear();
+    Bench_Line("print_Log", 20, logA, logB);
+    Bench_Line("OLED_Printf", 0, printfA, printfB);
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
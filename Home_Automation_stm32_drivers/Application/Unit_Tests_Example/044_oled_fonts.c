@@ -0,0 +1,242 @@
+/*
+ * 044_oled_fonts.c
+ *
+ * Created on: Feb 28, 2026
+ * Author: Rahul B.
+ * Description: OLED fonts (bsp_oled_font.c, bsp_oled_font_data.c) - tables,
+ *              metrics and BSP_OLED_DrawText()
+ *
+ *   tables      every font: glyph offsets inside the bitmap, ink inside
+ *               the cell, fallback present, kerning sorted and never
+ *               cutting into ink
+ *   small8      same pixels as the Font5x7 glyphs of BSP_OLED_DrawChar()
+ *   metrics     TextWidth of a clock string, kerning pairs, fallback
+ *   rendering   DrawText equals a per-pixel renderer for all fonts, every
+ *               y from 0 to 63 and x near both edges, over a bitmap
+ *   opaque      "11" over "88" leaves nothing of the 8s
+ *   clipping    text past the edges changes nothing outside the screen
+ *               part of its cells, and returns the unclipped end x
+ *
+ * Then a Digits24 clock string is drawn RUNS times page aligned, shifted
+ * and per pixel, timed with the profiler.
+ *
+ * On a host build nothing is flushed, but the display code must link:
+ * add Tools/displaysim/sim_ssd1306.c, sim_hd44780.c and sim_host.c to
+ * bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image files and
+ * profiler.c, UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_oled_font.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+
+#define RUNS            1000U
+
+extern const uint8_t my_face_array[];
+
+static const OledFont_t *const g_fonts[] = { &Font_Small8, &Font_Medium16, &Font_Digits24 };
+static uint8_t g_expected[OLED_PAGES * OLED_WIDTH];
+
+/* ===== REFERENCE: one pixel at a time from the font tables ===== */
+static bool Ref_Pixel(const OledFont_t *font, const OledGlyph_t *glyph, uint8_t col, uint8_t row)
+{
+    if (col < glyph->xOffset || col >= glyph->xOffset + glyph->width) return false;
+
+    const uint8_t *column = &font->bitmap[glyph->offset + (col - glyph->xOffset) * font->pages];
+    return (column[row / 8] >> (row % 8)) & 0x01;
+}
+
+static uint16_t Ref_DrawText(uint8_t x, uint8_t y, const OledFont_t *font, const char *str)
+{
+    uint16_t cursor = x;
+
+    for (; *str; str++) {
+        const OledGlyph_t *glyph = OledFont_Glyph(font, *str);
+        uint8_t cell = OledFont_CellWidth(font, str[0], str[1]);
+
+        for (uint8_t col = 0; col < cell; col++) {
+            for (uint8_t row = 0; row < font->height; row++) {
+                if (cursor + col < OLED_WIDTH && y + row < OLED_HEIGHT) {
+                    BSP_OLED_DrawPixel((uint8_t)(cursor + col), y + row, Ref_Pixel(font, glyph, col, row));
+                }
+            }
+        }
+        cursor += cell;
+    }
+    return cursor;
+}
+
+/* ===== CHECKS ===== */
+static void Test_Tables(const OledFont_t *font)
+{
+    uint8_t count = (uint8_t)(font->last - font->first + 1);
+    bool ok = (font->pages * 8U == font->height);
+
+    for (uint8_t i = 0; i < count; i++) {
+        const OledGlyph_t *g = &font->glyphs[i];
+        if (g->advance == 0) continue;
+        ok &= (g->offset + g->width * font->pages <= font->bitmapSize);
+        ok &= (g->xOffset + g->width <= g->advance);
+    }
+    Check(ok, "glyphs inside the bitmap and their cells");
+    Check(OledFont_Glyph(font, font->fallback)->advance != 0, "fallback glyph present");
+
+    for (uint8_t i = 0; i < font->kernCount; i++) {
+        const OledKern_t *k = &font->kerning[i];
+        const OledGlyph_t *g = OledFont_Glyph(font, k->left);
+
+        if (i > 0) {
+            const OledKern_t *p = &font->kerning[i - 1];
+            Check((p->left < k->left) || (p->left == k->left && p->right < k->right), "kerning sorted");
+        }
+        Check(g->advance + k->adjust >= g->xOffset + g->width, "kerning keeps the ink");
+        Check(OledFont_Kerning(font, k->left, k->right) == k->adjust, "kerning pair found");
+    }
+}
+
+/* Small8 is Font5x7 with the blank columns trimmed */
+static void Test_Small8(void)
+{
+    const uint8_t *frame = BSP_OLED_GetFrame();
+    uint32_t bad = 0;
+
+    for (char c = ' '; c <= '~'; c++) {
+        const OledGlyph_t *g = OledFont_Glyph(&Font_Small8, c);
+        uint8_t lo = 5, hi = 0;
+
+        BSP_OLED_Clear();
+        BSP_OLED_DrawChar(0, 0, c);
+        for (uint8_t col = 0; col < 5; col++) {
+            if (frame[col] == 0) continue;
+            if (lo == 5) lo = col;
+            hi = col;
+        }
+        if (lo == 5) {
+            bad += (g->width != 0);     // blank glyph (space)
+        } else if ((g->width != hi - lo + 1) || memcmp(&Font_Small8.bitmap[g->offset], &frame[lo], g->width)) {
+            bad++;
+        }
+    }
+    Check(bad == 0U, "Small8 glyphs equal Font5x7");
+}
+
+static void Test_Metrics(void)
+{
+    const OledGlyph_t *t = OledFont_Glyph(&Font_Small8, 'T');
+    const OledGlyph_t *dot = OledFont_Glyph(&Font_Small8, '.');
+
+    Check(OledFont_TextWidth(&Font_Digits24, "12:34") == 4U * 14U + 5U, "clock string 61 columns");
+    Check(OledFont_TextWidth(&Font_Digits24, "1") == OledFont_TextWidth(&Font_Digits24, "8"), "tabular digits");
+    Check(OledFont_TextWidth(&Font_Small8, "il") < OledFont_TextWidth(&Font_Small8, "mw"), "proportional Small8");
+    Check(OledFont_TextWidth(&Font_Small8, "T.") == t->advance + dot->advance - 1U, "Small8 T. kerned");
+    Check(OledFont_TextWidth(&Font_Medium16, "T.") ==
+          OledFont_TextWidth(&Font_Medium16, "T") + OledFont_TextWidth(&Font_Medium16, ".") - 2U, "Medium16 T. kerned x2");
+    Check(OledFont_TextWidth(&Font_Small8, ".T") == dot->advance + t->advance, "kerning is one way");
+    Check(OledFont_Glyph(&Font_Digits24, 'A') == OledFont_Glyph(&Font_Digits24, ' '), "missing glyph falls back");
+    Check(OledFont_Glyph(&Font_Digits24, '#') == OledFont_Glyph(&Font_Digits24, ' '), "hole in the table falls back");
+    Check(OledFont_TextWidth(&Font_Small8, "") == 0U, "empty string");
+}
+
+static bool Same_As(const OledFont_t *font, const char *str, uint8_t x, uint8_t y)
+{
+    BSP_OLED_DrawBitmap(my_face_array);
+    uint16_t refEnd = Ref_DrawText(x, y, font, str);
+    memcpy(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected));
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    uint16_t end = BSP_OLED_DrawText(x, y, font, str);
+    return (end == refEnd) && (memcmp(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0);
+}
+
+static void Test_Rendering(void)
+{
+    static const uint8_t xs[] = { 0, 3, 50, 100, 120, 127, 140 };
+    static const char *texts[] = { "Tr.y,L'T 42%~", "Home 23.5C", "-12:59 +7%A." };
+    uint32_t mismatches = 0;
+
+    for (uint8_t f = 0; f < sizeof(g_fonts) / sizeof(g_fonts[0]); f++) {
+        for (uint8_t y = 0; y < OLED_HEIGHT + 4; y++) {
+            for (uint8_t i = 0; i < sizeof(xs); i++) {
+                if (!Same_As(g_fonts[f], texts[f], xs[i], y)) {
+                    if (mismatches++ == 0) {
+                        UART_Printf("[FONT] first mismatch: %s x %u y %u\r\n", g_fonts[f]->name, xs[i], y);
+                    }
+                }
+            }
+        }
+    }
+    Check(mismatches == 0U, "DrawText equals the per-pixel renderer");
+
+    // Opaque cells: the narrower 1s leave nothing of the 8s behind
+    BSP_OLED_Clear();
+    BSP_OLED_DrawText(10, 20, &Font_Digits24, "11");
+    memcpy(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected));
+    BSP_OLED_Clear();
+    BSP_OLED_DrawText(10, 20, &Font_Digits24, "88");
+    BSP_OLED_DrawText(10, 20, &Font_Digits24, "11");
+    Check(memcmp(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0, "opaque cells");
+
+    // Off the screen: nothing drawn, the end x still counts
+    BSP_OLED_DrawBitmap(my_face_array);
+    Check(BSP_OLED_DrawText(128, 0, &Font_Medium16, "AB") == 128U + OledFont_TextWidth(&Font_Medium16, "AB"),
+          "end x past the right edge");
+    BSP_OLED_DrawText(0, 64, &Font_Digits24, "88");
+    Check(memcmp(my_face_array, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0, "off-screen text draws nothing");
+
+    // Bottom edge: Digits24 at y = 50 keeps pages 0-5 intact
+    BSP_OLED_DrawText(0, 50, &Font_Digits24, "88:88");
+    Check(memcmp(my_face_array, BSP_OLED_GetFrame(), 6 * OLED_WIDTH) == 0, "pages above the text untouched");
+}
+
+/* ===== BENCHMARK ===== */
+typedef uint16_t (*Render_t)(uint8_t x, uint8_t y, const OledFont_t *font, const char *str);
+
+static uint32_t Bench(Render_t render, uint8_t y)
+{
+    uint32_t start = Prof_Now();
+
+    for (uint32_t i = 0; i < RUNS; i++) {
+        render(20, y, &Font_Digits24, (i & 1U) ? "12:34" : "20:58");
+    }
+    uint32_t ticks = Prof_Now() - start;
+    return (uint32_t)(((uint64_t)ticks * 1000U / Prof_TicksPerUs()) / RUNS);
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+
+    UART_Printf("\r\n===== 044 OLED Fonts =====\r\n");
+
+    for (uint8_t f = 0; f < sizeof(g_fonts) / sizeof(g_fonts[0]); f++) {
+        const OledFont_t *font = g_fonts[f];
+
+        UART_Printf("[FONT] %-9s %2u px  '%c'..'%c'  bitmap %4u bytes  %u kerning pairs\r\n", font->name,
+                    font->height, font->first, font->last, font->bitmapSize, font->kernCount);
+        Test_Tables(font);
+    }
+    Test_Small8();
+    Test_Metrics();
+    Test_Rendering();
+
+    uint32_t alignedNs = Bench(BSP_OLED_DrawText, 16);
+    uint32_t shiftedNs = Bench(BSP_OLED_DrawText, 19);
+    uint32_t pixelNs = Bench(Ref_DrawText, 16);
+    UART_Printf("[FONT] Digits24 \"12:34\": page aligned %u ns, shifted %u ns, per pixel %u ns\r\n",
+                (unsigned)alignedNs, (unsigned)shiftedNs, (unsigned)pixelNs);
+    Check(alignedNs <= shiftedNs, "page aligned path is the fastest");
+    Check(pixelNs >= 3U * shiftedNs, "both paths at least 3x faster than per pixel");
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
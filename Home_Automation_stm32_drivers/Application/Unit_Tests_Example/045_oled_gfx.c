@@ -0,0 +1,360 @@
+/*
+ * 045_oled_gfx.c
+ *
+ * Created on: Mar 1, 2026
+ * Author: Rahul B.
+ * Description: OLED 2D primitives (bsp_oled_gfx.c) - equivalence and speed
+ *
+ * The primitives write byte masks and memset whole pages instead of
+ * calling BSP_OLED_DrawPixel() per pixel. Each is checked against a
+ * per-pixel reference kept here, drawn over the face bitmap so every mask
+ * must keep the pixels around the shape, in all three colors:
+ *
+ *   rectangles    random H/V lines, boxes and outlines, many off the edges;
+ *                 an inverted outline toggles its corners once
+ *   lines         random end points in every octant, both directions
+ *   circles       outline and disc, random centres and radii; a disc
+ *                 covers its outline exactly, inverting one twice is a no-op
+ *   widgets       sparkline end points and bar heights
+ *   flush         the whole-span dirty marks still send only what changed
+ *
+ * Then both versions draw RUNS times the Show_Progress_Bar() screen, a
+ * full-screen invert, a disc and a shallow line, timed with the profiler.
+ * The fills must be at least 3x faster.
+ *
+ * On a host build nothing is flushed, but the display code must link:
+ * add Tools/displaysim/sim_ssd1306.c, sim_hd44780.c and sim_host.c to
+ * bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image files and
+ * profiler.c, UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_oled_gfx.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define RUNS            1000U
+#define RANDOM_SHAPES   2000U
+
+extern const uint8_t my_face_array[];
+
+static uint8_t g_expected[OLED_PAGES * OLED_WIDTH];
+static uint32_t g_seed = 12345U;
+
+static int16_t Rand(int16_t lo, int16_t hi)
+{
+    g_seed = g_seed * 1103515245U + 12345U;
+    return (int16_t)(lo + (int16_t)((g_seed >> 16) % (uint32_t)(hi - lo + 1)));
+}
+
+/* ===== REFERENCE: one BSP_OLED_DrawPixel() per pixel ===== */
+static bool Ref_Get(int16_t x, int16_t y)
+{
+    return (BSP_OLED_GetFrame()[x + (y / 8) * OLED_WIDTH] >> (y % 8)) & 1U;
+}
+
+static void Ref_Pixel(int16_t x, int16_t y, OledColor_t color)
+{
+    if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT) return;
+    if (color == OLED_PIXEL_INVERT) BSP_OLED_DrawPixel((uint8_t)x, (uint8_t)y, !Ref_Get(x, y));
+    else BSP_OLED_DrawPixel((uint8_t)x, (uint8_t)y, (uint8_t)color);
+}
+
+static void Ref_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color)
+{
+    for (int16_t j = y; j < y + h; j++) {
+        for (int16_t i = x; i < x + w; i++) Ref_Pixel(i, j, color);
+    }
+}
+
+static void Ref_Rect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color)
+{
+    for (int16_t j = y; j < y + h; j++) {
+        for (int16_t i = x; i < x + w; i++) {
+            if (j == y || j == y + h - 1 || i == x || i == x + w - 1) Ref_Pixel(i, j, color);
+        }
+    }
+}
+
+static void Ref_Line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, OledColor_t color)
+{
+    int16_t dx = (int16_t)abs(x1 - x0), sx = (x0 < x1) ? 1 : -1;
+    int16_t dy = (int16_t)-abs(y1 - y0), sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx + dy;
+
+    for (;;) {
+        Ref_Pixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+/* Circle outline as a set of points around the centre (radius <= 63),
+   g_rowMin/g_rowMax[dy + 63]: leftmost and rightmost dx of row cy + dy */
+static bool g_onRing[127][127];
+static int16_t g_rowMin[127], g_rowMax[127];
+
+static void Ref_Ring(int16_t r)
+{
+    int16_t x = 0, y = r, d = 1 - r;
+
+    memset(g_onRing, 0, sizeof(g_onRing));
+    while (x <= y) {
+        const int16_t pts[8][2] = { { x, y }, { -x, y }, { x, -y }, { -x, -y },
+                                    { y, x }, { -y, x }, { y, -x }, { -y, -x } };
+        for (uint8_t k = 0; k < 8; k++) g_onRing[pts[k][1] + 63][pts[k][0] + 63] = true;
+
+        if (d < 0) d += 2 * x + 3;
+        else { d += 2 * (x - y) + 5; y--; }
+        x++;
+    }
+    for (int16_t dy = -63; dy <= 63; dy++) {
+        g_rowMin[dy + 63] = 127;
+        g_rowMax[dy + 63] = -127;
+        for (int16_t dx = -63; dx <= 63; dx++) {
+            if (!g_onRing[dy + 63][dx + 63]) continue;
+            if (dx < g_rowMin[dy + 63]) g_rowMin[dy + 63] = dx;
+            if (dx > g_rowMax[dy + 63]) g_rowMax[dy + 63] = dx;
+        }
+    }
+}
+
+static void Ref_Circle(int16_t cx, int16_t cy, int16_t r, OledColor_t color)
+{
+    Ref_Ring(r);
+    for (int16_t dy = -63; dy <= 63; dy++) {
+        for (int16_t dx = -63; dx <= 63; dx++) {
+            if (g_onRing[dy + 63][dx + 63]) Ref_Pixel(cx + dx, cy + dy, color);
+        }
+    }
+}
+
+static void Ref_FillCircle(int16_t cx, int16_t cy, int16_t r, OledColor_t color)
+{
+    Ref_Ring(r);
+    for (int16_t dy = -63; dy <= 63; dy++) {
+        for (int16_t dx = g_rowMin[dy + 63]; dx <= g_rowMax[dy + 63]; dx++) Ref_Pixel(cx + dx, cy + dy, color);
+    }
+}
+
+/* ===== CHECKS ===== */
+/* Draw the reference over the face, keep it, draw the primitive over the face */
+#define EXPECT(ref)     do { BSP_OLED_DrawBitmap(my_face_array); ref; \
+                             memcpy(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected)); \
+                             BSP_OLED_DrawBitmap(my_face_array); } while (0)
+#define MATCHES()       (memcmp(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0)
+
+static uint32_t g_mismatches;
+
+static void Count(bool same, const char *what, int16_t a, int16_t b, int16_t c, int16_t d, OledColor_t color)
+{
+    if (!same && g_mismatches++ == 0) {
+        UART_Printf("[GFX] first %s mismatch: %d %d %d %d color %u\r\n", what, a, b, c, d, (unsigned)color);
+    }
+}
+
+static void Test_Rectangles(void)
+{
+    g_mismatches = 0;
+    for (uint32_t i = 0; i < RANDOM_SHAPES; i++) {
+        int16_t x = Rand(-20, 140), y = Rand(-20, 80), w = Rand(-2, 60), h = Rand(-2, 40);
+        OledColor_t color = (OledColor_t)(i % 3);
+
+        EXPECT(Ref_FillRect(x, y, w, h, color));
+        BSP_OLED_FillRect(x, y, w, h, color);
+        Count(MATCHES(), "fill", x, y, w, h, color);
+
+        EXPECT(Ref_Rect(x, y, w, h, color));
+        BSP_OLED_DrawRect(x, y, w, h, color);
+        Count(MATCHES(), "outline", x, y, w, h, color);
+
+        EXPECT(Ref_FillRect(x, y, w, 1, color));
+        BSP_OLED_DrawHLine(x, y, w, color);
+        Count(MATCHES(), "hline", x, y, w, 1, color);
+
+        EXPECT(Ref_FillRect(x, y, 1, h, color));
+        BSP_OLED_DrawVLine(x, y, h, color);
+        Count(MATCHES(), "vline", x, y, 1, h, color);
+    }
+    Check(g_mismatches == 0U, "rectangles equal the per-pixel reference");
+
+    EXPECT(Ref_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, OLED_PIXEL_INVERT));
+    BSP_OLED_InvertRect(-5, -5, 200, 100);
+    Check(MATCHES(), "invert of more than the screen");
+}
+
+static void Test_Lines(void)
+{
+    g_mismatches = 0;
+    for (uint32_t i = 0; i < RANDOM_SHAPES; i++) {
+        int16_t x0 = Rand(-30, 157), y0 = Rand(-30, 93), x1 = Rand(-30, 157), y1 = Rand(-30, 93);
+        OledColor_t color = (OledColor_t)(i % 3);
+
+        if (i % 10 == 0) y1 = y0;           // some horizontal,
+        if (i % 10 == 1) x1 = x0;           // vertical
+        if (i % 10 == 2) y1 = y0 + (x1 - x0);   // and diagonal ones
+
+        EXPECT(Ref_Line(x0, y0, x1, y1, color));
+        BSP_OLED_DrawLine(x0, y0, x1, y1, color);
+        Count(MATCHES(), "line", x0, y0, x1, y1, color);
+    }
+    Check(g_mismatches == 0U, "lines equal the per-pixel reference");
+}
+
+static void Test_Circles(void)
+{
+    g_mismatches = 0;
+    for (uint32_t i = 0; i < RANDOM_SHAPES / 4; i++) {
+        int16_t cx = Rand(-20, 147), cy = Rand(-20, 83), r = Rand(0, 40);
+        OledColor_t color = (OledColor_t)(i % 3);
+
+        EXPECT(Ref_Circle(cx, cy, r, color));
+        BSP_OLED_DrawCircle(cx, cy, r, color);
+        Count(MATCHES(), "circle", cx, cy, r, 0, color);
+
+        EXPECT(Ref_FillCircle(cx, cy, r, color));
+        BSP_OLED_FillCircle(cx, cy, r, color);
+        Count(MATCHES(), "disc", cx, cy, r, 0, color);
+    }
+    Check(g_mismatches == 0U, "circles equal the per-pixel reference");
+
+    BSP_OLED_Clear();
+    BSP_OLED_FillCircle(64, 32, 25, OLED_PIXEL_ON);
+    memcpy(g_expected, BSP_OLED_GetFrame(), sizeof(g_expected));
+    BSP_OLED_DrawCircle(64, 32, 25, OLED_PIXEL_ON);
+    Check(MATCHES(), "a disc covers its outline");
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_FillCircle(60, 30, 33, OLED_PIXEL_INVERT);
+    BSP_OLED_FillCircle(60, 30, 33, OLED_PIXEL_INVERT);
+    Check(memcmp(my_face_array, BSP_OLED_GetFrame(), sizeof(g_expected)) == 0, "inverting a disc twice is a no-op");
+}
+
+static void Test_Widgets(void)
+{
+    static const int16_t samples[] = { 0, 50, 100, 25 };
+    static const int16_t flat[] = { 7, 7 };
+    static const int16_t bars[] = { 0, 50, 100 };
+
+    // Sparkline 97 x 21 at 10,20: points at x 10, 42, 74, 106 and rows 40, 30, 20, 35
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_DrawSparkline(10, 20, 97, 21, samples, 4, 0, 100);
+    Check(Ref_Get(10, 40) && Ref_Get(42, 30) && Ref_Get(74, 20) && Ref_Get(106, 35), "sparkline points");
+    Check(!Ref_Get(10, 20) && !Ref_Get(106, 40), "sparkline box cleared");
+    Check(Ref_Get(9, 20) == ((my_face_array[2 * OLED_WIDTH + 9] >> 4) & 1U), "sparkline leaves the outside");
+
+    BSP_OLED_Clear();
+    BSP_OLED_DrawSparkline(0, 0, 20, 10, flat, 2, 0, 0);
+    Check(Ref_Get(0, 9) && Ref_Get(19, 9) && !Ref_Get(10, 8), "sparkline auto range, flat data at the bottom");
+
+    // Three bars of 10 columns in 32 x 20: heights 0, 10, 20
+    BSP_OLED_Clear();
+    BSP_OLED_DrawBarGraph(0, 10, 32, 20, bars, 3, 0, 100);
+    Check(!Ref_Get(0, 29) && !Ref_Get(9, 29), "bar at min is empty");
+    Check(Ref_Get(11, 29) && Ref_Get(20, 20) && !Ref_Get(20, 19) && !Ref_Get(10, 29), "bar at half");
+    Check(Ref_Get(22, 10) && Ref_Get(31, 29) && !Ref_Get(31, 9), "bar at max");
+}
+
+static void Test_Flush(void)
+{
+    const OledBusStats_t *stats = BSP_OLED_GetBusStats();
+
+    BSP_OLED_Clear();
+    BSP_OLED_Update();
+
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_InvertRect(0, 0, OLED_WIDTH, OLED_HEIGHT);
+    BSP_OLED_InvertRect(0, 0, OLED_WIDTH, OLED_HEIGHT);
+    BSP_OLED_Update();
+    Check(stats->bytes == 0U, "marked but unchanged spans send nothing");
+
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_FillRect(10, 10, 20, 20, OLED_PIXEL_ON);   // pages 1..3, columns 10..29
+    // One window: its command, then per page address + 0x40 + 20 bytes
+    BSP_OLED_Update();
+    Check(stats->windows == 1U && stats->bytes == OLED_WINDOW_OVERHEAD + 3U * (2U + 20U),
+          "a box sends its own columns only");
+}
+
+/* ===== BENCHMARK ===== */
+typedef void (*Draw_t)(void);
+
+static void Ref_ProgressBar(void)
+{
+    Ref_Rect(10, 30, 109, 11, OLED_PIXEL_ON);
+    Ref_FillRect(12, 32, 79, 7, OLED_PIXEL_ON);
+}
+static void Fast_ProgressBar(void)
+{
+    BSP_OLED_DrawRect(10, 30, 109, 11, OLED_PIXEL_ON);
+    BSP_OLED_FillRect(12, 32, 79, 7, OLED_PIXEL_ON);
+}
+static void Ref_Invert(void)  { Ref_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, OLED_PIXEL_INVERT); }
+static void Fast_Invert(void) { BSP_OLED_InvertRect(0, 0, OLED_WIDTH, OLED_HEIGHT); }
+static void Ref_Disc(void)
+{
+    // Row extents from Ref_Ring(28), worked out before the run
+    for (int16_t dy = -28; dy <= 28; dy++) {
+        for (int16_t dx = g_rowMin[dy + 63]; dx <= g_rowMax[dy + 63]; dx++) Ref_Pixel(64 + dx, 32 + dy, OLED_PIXEL_INVERT);
+    }
+}
+static void Fast_Disc(void)   { BSP_OLED_FillCircle(64, 32, 28, OLED_PIXEL_INVERT); }
+static void Ref_Shallow(void)  { Ref_Line(0, 0, 127, 40, OLED_PIXEL_INVERT); }
+static void Fast_Shallow(void) { BSP_OLED_DrawLine(0, 0, 127, 40, OLED_PIXEL_INVERT); }
+
+/* Average ns per shape over RUNS draws */
+static uint32_t Bench(Draw_t draw)
+{
+    BSP_OLED_Clear();
+    uint32_t start = Prof_Now();
+
+    for (uint32_t i = 0; i < RUNS; i++) draw();
+    uint32_t ticks = Prof_Now() - start;
+    return (uint32_t)(((uint64_t)ticks * 1000U / Prof_TicksPerUs()) / RUNS);
+}
+
+static void Bench_Shape(const char *name, Draw_t ref, Draw_t fast, bool mustWin)
+{
+    uint32_t refNs = Bench(ref);
+    uint32_t fastNs = Bench(fast);
+    uint32_t x10 = fastNs ? (refNs * 10U) / fastNs : 0U;
+
+    UART_Printf("[GFX] %-13s per-pixel %7u ns  spans %6u ns  x%u.%u\r\n", name,
+                (unsigned)refNs, (unsigned)fastNs, (unsigned)(x10 / 10U), (unsigned)(x10 % 10U));
+    if (mustWin) Check(refNs >= 3U * fastNs, "spans at least 3x faster");
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+    BSP_OLED_Init();
+
+    UART_Printf("\r\n===== 045 OLED 2D Primitives =====\r\n");
+
+    Test_Rectangles();
+    Test_Lines();
+    Test_Circles();
+    Test_Widgets();
+    Test_Flush();
+
+    Bench_Shape("progress bar", Ref_ProgressBar, Fast_ProgressBar, true);
+    Bench_Shape("invert all", Ref_Invert, Fast_Invert, true);
+    Ref_Ring(28);
+    Bench_Shape("disc r 28", Ref_Disc, Fast_Disc, true);
+    Bench_Shape("line 127x40", Ref_Shallow, Fast_Shallow, false);
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,267 @@
+/*
+ * 046_oled_scroll.c
+ *
+ * Created on: Mar 2, 2026
+ * Author: Rahul B.
+ * Description: OLED scrolling (bsp_i2c_oled.c) - hardware scroll, marquee, bus bytes
+ *
+ *   scroll commands   BSP_OLED_StartScroll() sends pending drawing, then
+ *                     2Eh, 27h + 6 bytes, 2Fh in one transaction
+ *   while scrolling   updates send nothing (GDDRAM writes are prohibited),
+ *                     the drawing is kept
+ *   after the stop    the band is sent whole, with what was drawn meanwhile
+ *   shift band        software scroll of the buffer, both directions
+ *   boot banner       Scroll_Text() as a hardware marquee against the old
+ *                     per-frame redraw (x 128 to -80 in steps of 2)
+ *   long text         wider than the screen: software marquee, compared
+ *                     column by column with the text after every step;
+ *                     a step sends the band only
+ *
+ * On a host build link Tools/displaysim/sim_ssd1306.c, sim_hd44780.c
+ * and sim_host.c with bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image
+ * files and profiler.c, UART_Printf mapped to printf and app_init()
+ * stubbed out.
+ * The emulator's stop leaves the band rotated by as far as it scrolled,
+ * as on the panel, and after every update its GDDRAM must equal the
+ * frame buffer.
+ *
+ * On the board the boot banner runs for 2.5 s; check it by eye.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_delay.h"
+#include "test_check.h"
+#include <string.h>
+
+#define OLD_BANNER_STEPS    104U    // x = 128 .. -78, every 20 ms
+#define LONG_TEXT           "Intrusion on IR2 - check the back door"
+
+extern const uint8_t my_face_array[];
+
+/* ===== PANEL (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static bool Panel_Matches(void)
+{
+    return memcmp(Sim_OLED_GetRAM(), BSP_OLED_GetFrame(), OLED_PAGES * OLED_WIDTH) == 0;
+}
+#else
+static bool Panel_Matches(void) { return true; }
+#endif
+
+/* Update and return the bytes it put on the bus */
+static uint32_t Flush(void)
+{
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_Update();
+    return BSP_OLED_GetBusStats()->bytes;
+}
+
+/* ===== HARDWARE SCROLL ===== */
+static void Test_HardwareScroll(void)
+{
+    const OledBusStats_t *stats = BSP_OLED_GetBusStats();
+
+    BSP_OLED_Clear();
+    Flush();
+
+    // Pending drawing goes out first, then one command transaction
+    BSP_OLED_PrintString(10, 24, "scroll me");
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_StartScroll(3, 4, OLED_SCROLL_LEFT, OLED_SCROLL_2_FRAMES);
+    Check(BSP_OLED_IsScrolling(), "scrolling after the start");
+    Check(Panel_Matches(), "drawing sent before the scroll starts");
+#if !defined(__arm__)
+    static const uint8_t expected[] = { 0x00, 0x2E, 0x27, 0x00, 3, 7, 4, 0x00, 0xFF, 0x2F };
+    uint32_t len;
+    const uint8_t *tx = Sim_OLED_LastTransaction(&len);
+    Check(len == sizeof(expected) && memcmp(tx, expected, sizeof(expected)) == 0,
+          "2Eh, 27h 00 03 07 04 00 FF, 2Fh in one transaction");
+    Check(Sim_OLED_IsScrolling(), "panel scrolling");
+#endif
+    UART_Printf("[SCROLL] start: %u bytes, %u transactions\r\n",
+                (unsigned)stats->bytes, (unsigned)stats->transactions);
+
+    // Drawing while it runs stays in the buffer; the stop leaves the band
+    // wherever the panel got to
+    BSP_OLED_PrintString(0, 0, "meanwhile");
+    BSP_OLED_PrintString(0, 32, "band too");
+    Check(Flush() == 0U, "updates send nothing while scrolling");
+    BSP_Delay_ms(250);
+
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_StopScroll();
+    uint32_t stopBytes = stats->bytes;
+    uint32_t afterBytes = Flush();
+    Check(!BSP_OLED_IsScrolling(), "stopped");
+    Check(Panel_Matches(), "band and pending drawing sent after the stop");
+    Check(afterBytes >= 2U * OLED_WIDTH, "scrolled pages sent whole");
+    UART_Printf("[SCROLL] stop: %u bytes, next update %u bytes\r\n", (unsigned)stopBytes, (unsigned)afterBytes);
+    Check(Flush() == 0U, "then nothing is stale");
+
+#if !defined(__arm__)
+    Check(Sim_OLED_GetStats()->ramWritesWhileScrolling == 0U, "no GDDRAM writes while scrolling");
+#endif
+}
+
+static void Test_ShiftBand(void)
+{
+    const uint8_t *frame = BSP_OLED_GetFrame();
+    uint8_t zeros[OLED_WIDTH] = { 0 };
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_ShiftBand(2, 3, 5);
+    Check(memcmp(&frame[2 * OLED_WIDTH + 5], &my_face_array[2 * OLED_WIDTH], OLED_WIDTH - 5) == 0 &&
+          memcmp(&frame[2 * OLED_WIDTH], zeros, 5) == 0, "shift right by 5");
+    Check(memcmp(frame, my_face_array, 2 * OLED_WIDTH) == 0 &&
+          memcmp(&frame[4 * OLED_WIDTH], &my_face_array[4 * OLED_WIDTH], 4 * OLED_WIDTH) == 0,
+          "pages outside the band untouched");
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_ShiftBand(7, 7, -3);
+    Check(memcmp(&frame[7 * OLED_WIDTH], &my_face_array[7 * OLED_WIDTH + 3], OLED_WIDTH - 3) == 0 &&
+          memcmp(&frame[8 * OLED_WIDTH - 3], zeros, 3) == 0, "shift left by 3");
+
+    BSP_OLED_ShiftBand(7, 7, -300);
+    Check(memcmp(&frame[7 * OLED_WIDTH], zeros, OLED_WIDTH) == 0, "shift by more than the screen clears");
+}
+
+/* ===== MARQUEE ===== */
+static void Test_BootBanner(void)
+{
+    static Pt_t pt;
+    uint32_t oldBytes = 0, newBytes = 0;
+
+    // Before: clear, text at x, update - every 20 ms
+    BSP_OLED_Clear();
+    Flush();
+    for (int x = 128; x > -80; x -= 2) {
+        BSP_OLED_Clear();
+        BSP_OLED_PrintString(x, 28, "Hello Rahul!");
+        oldBytes += Flush();
+    }
+
+    // Now: Scroll_Text() as the boot sequence runs it, until it ends
+    BSP_OLED_Clear();
+    Flush();
+    BSP_OLED_ResetBusStats();
+    PT_INIT(&pt);
+    while (PT_SCHEDULE(Scroll_Text(&pt))) {
+        Check(BSP_OLED_IsScrolling(), "banner scrolled by the panel");
+        BSP_Delay_ms(20);
+    }
+    newBytes = BSP_OLED_GetBusStats()->bytes;
+    BSP_OLED_Clear();
+    newBytes += Flush();
+    Check(Panel_Matches(), "panel right after the banner");
+
+    UART_Printf("[SCROLL] boot banner: per-frame redraw %u bytes (%u frames; %u without dirty tracking),"
+                " hardware marquee %u bytes\r\n", (unsigned)oldBytes, OLD_BANNER_STEPS,
+                (unsigned)(OLD_BANNER_STEPS * 1112U), (unsigned)newBytes);
+    Check(newBytes * 10U < oldBytes, "marquee costs under a tenth");
+}
+
+/* Reference: the text as DrawText lays it out, pixel column by column */
+static uint8_t g_strip[2][512];
+
+static uint16_t Ref_Strip(const OledFont_t *font, const char *str)
+{
+    uint16_t cursor = 0;
+
+    memset(g_strip, 0, sizeof(g_strip));
+    for (; *str; str++) {
+        const OledGlyph_t *glyph = OledFont_Glyph(font, *str);
+        uint8_t cell = OledFont_CellWidth(font, str[0], str[1]);
+
+        for (uint8_t col = 0; col < cell; col++) {
+            int16_t ink = (int16_t)col - glyph->xOffset;
+            if (ink < 0 || ink >= glyph->width) continue;
+            for (uint8_t k = 0; k < font->pages; k++) {
+                g_strip[k][cursor + col] = font->bitmap[glyph->offset + ink * font->pages + k];
+            }
+        }
+        cursor += cell;
+    }
+    return cursor;
+}
+
+static bool Band_Shows(uint8_t page, uint8_t pages, uint16_t pos, uint16_t width, uint16_t period)
+{
+    const uint8_t *frame = BSP_OLED_GetFrame();
+
+    for (uint8_t k = 0; k < pages; k++) {
+        for (uint8_t x = 0; x < OLED_WIDTH; x++) {
+            uint16_t col = (uint16_t)((pos + x) % period);
+            uint8_t expected = (col < width) ? g_strip[k][col] : 0x00;
+            if (frame[(page + k) * OLED_WIDTH + x] != expected) return false;
+        }
+    }
+    return true;
+}
+
+static void Test_LongText(void)
+{
+    static const uint8_t steps[] = { 1, 2, 3, 5, 8, 2, 127, 128, 200 };
+    OledMarquee_t marquee;
+    uint16_t width = Ref_Strip(&Font_Medium16, LONG_TEXT);
+    uint16_t period = width + OLED_MARQUEE_GAP;
+    uint16_t pos = 0;
+    uint32_t mismatches = 0, maxBytes = 0;
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    Flush();
+    BSP_OLED_MarqueeStart(&marquee, 5, &Font_Medium16, LONG_TEXT, OLED_SCROLL_2_FRAMES);
+    Check(!marquee.hardware && !BSP_OLED_IsScrolling(), "text wider than the screen: software marquee");
+    Check(marquee.width == width, "marquee width = text width");
+    Check(Band_Shows(5, 2, 0, width, period), "starts with the text at x = 0");
+    Flush();
+
+    for (uint16_t i = 0; i < 3U * period / 2U; i++) {
+        uint8_t step = steps[i % sizeof(steps)];
+
+        BSP_OLED_MarqueeStep(&marquee, step);
+        pos = (uint16_t)((pos + (step > OLED_WIDTH ? OLED_WIDTH : step)) % period);
+        if (!Band_Shows(5, 2, pos, width, period)) {
+            if (mismatches++ == 0) UART_Printf("[SCROLL] first mismatch at step %u, pos %u\r\n", i, pos);
+        }
+        uint32_t bytes = Flush();
+        if (bytes > maxBytes) maxBytes = bytes;
+    }
+    Check(mismatches == 0U, "every step shows the text columns it should");
+    Check(Panel_Matches(), "panel follows the software marquee");
+    Check(memcmp(BSP_OLED_GetFrame(), my_face_array, 5 * OLED_WIDTH) == 0 &&
+          memcmp(&BSP_OLED_GetFrame()[7 * OLED_WIDTH], &my_face_array[7 * OLED_WIDTH], OLED_WIDTH) == 0,
+          "pages outside the band untouched");
+    Check(maxBytes <= OLED_WINDOW_OVERHEAD + 2U * (2U + OLED_WIDTH), "a step sends the band only");
+    UART_Printf("[SCROLL] long text: %u columns, software steps send at most %u bytes\r\n",
+                (unsigned)width, (unsigned)maxBytes);
+
+    BSP_OLED_MarqueeStop(&marquee);
+}
+
+int main(void)
+{
+    app_init();
+    BSP_OLED_Init();
+
+    UART_Printf("\r\n===== 046 OLED Scrolling =====\r\n");
+
+    Test_HardwareScroll();
+    Test_ShiftBand();
+    Test_BootBanner();
+    Test_LongText();
+
+#if !defined(__arm__)
+    Check(Sim_OLED_GetStats()->scrollSetupsWhileScrolling == 0U, "no scroll set up while scrolling");
+#endif
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
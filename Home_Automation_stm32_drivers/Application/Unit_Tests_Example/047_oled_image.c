@@ -0,0 +1,246 @@
+/*
+ * 047_oled_image.c
+ *
+ * Created on: Mar 3, 2026
+ * Author: Rahul B.
+ * Description: Compressed OLED images (bsp_oled_image.c) - decode, playback, streaming
+ *
+ *   face          Image_Face decodes to my_face_array, the bitmap it was
+ *                 made from
+ *   heart         both Anim_Heart frames equal the heart the old
+ *                 Draw_Heart() drew with FillRect; the later frames hold
+ *                 only the pages that change
+ *   playback      Heart_Beat() runs to its end on the player; after the
+ *                 first frame only the heart pages go on the bus
+ *   streaming     BSP_OLED_StreamImage() puts the image on the panel and
+ *                 leaves the frame buffer alone; the next update restores it
+ *
+ * Then the sizes (raw and compressed) and the decode time of a full
+ * screen against a 1 KB memcpy.
+ *
+ * On a host build link Tools/displaysim/sim_ssd1306.c, sim_hd44780.c
+ * and sim_host.c with bsp_i2c_oled.c, bsp_oled_gfx.c, the font and image
+ * files and profiler.c, UART_Printf mapped to printf and app_init()
+ * stubbed out; the emulator also notes the GDDRAM pages written.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_oled_gfx.h"
+#include "bsp_oled_image.h"
+#include "bsp_delay.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+
+#define RUNS            1000U
+#define HEART_PAGES     0x3CU   // pages 2..5: rows 20..44 of the big heart
+
+extern const uint8_t my_face_array[];
+
+static uint8_t g_heart[2][OLED_PAGES * OLED_WIDTH];
+
+/* ===== PANEL (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static bool Panel_Shows(const uint8_t *frame)
+{
+    return memcmp(Sim_OLED_GetRAM(), frame, OLED_PAGES * OLED_WIDTH) == 0;
+}
+
+static uint8_t Pages_Written(void)
+{
+    uint8_t pages = Sim_OLED_GetStats()->pagesWritten;
+
+    Sim_OLED_ResetStats();
+    return pages;
+}
+#else
+static bool Panel_Shows(const uint8_t *frame) { (void)frame; return true; }
+static uint8_t Pages_Written(void) { return HEART_PAGES; }
+#endif
+
+/* Update and return the bytes it put on the bus */
+static uint32_t Flush(void)
+{
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_Update();
+    return BSP_OLED_GetBusStats()->bytes;
+}
+
+/* Reference: the heart of the old Draw_Heart(), every dot a size x size block */
+static void Ref_Heart(uint8_t *out, uint8_t x0, uint8_t y0, uint8_t size)
+{
+    static const uint8_t heart_small[5][7] = {
+        {0,1,1,0,1,1,0},
+        {1,1,1,1,1,1,1},
+        {1,1,1,1,1,1,1},
+        {0,1,1,1,1,1,0},
+        {0,0,1,1,1,0,0}
+    };
+
+    BSP_OLED_Clear();
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 7; x++) {
+            if (heart_small[y][x]) BSP_OLED_FillRect(x0 + x*size, y0 + y*size, size, size, OLED_PIXEL_ON);
+        }
+    }
+    memcpy(out, BSP_OLED_GetFrame(), OLED_PAGES * OLED_WIDTH);
+}
+
+/* Pages in which two frames differ */
+static uint8_t Diff_Pages(const uint8_t *a, const uint8_t *b)
+{
+    uint8_t pages = 0;
+
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        if (memcmp(&a[page * OLED_WIDTH], &b[page * OLED_WIDTH], OLED_WIDTH) != 0) pages |= (uint8_t)(1U << page);
+    }
+    return pages;
+}
+
+/* ===== DECODE ===== */
+static void Test_Face(void)
+{
+    BSP_OLED_Clear();
+    BSP_OLED_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, OLED_PIXEL_ON);
+    BSP_OLED_DrawImage(&Image_Face, 0);
+    Check(memcmp(BSP_OLED_GetFrame(), my_face_array, OLED_PAGES * OLED_WIDTH) == 0, "Image_Face decodes to my_face_array");
+    Check(Image_Face.frameCount == 1 && Image_Face.data[Image_Face.frames[0]] == 0xFF, "still image: one key frame");
+
+    Flush();
+    Check(Panel_Shows(my_face_array), "face on the panel");
+}
+
+static void Test_Heart(void)
+{
+    const OledImage_t *anim = &Anim_Heart;
+
+    Ref_Heart(g_heart[0], 50, 25, 3);
+    Ref_Heart(g_heart[1], 45, 20, 5);
+
+    Check(anim->frameCount == 2 && anim->frameMs == 200U, "2 frames of 200 ms");
+    Check(anim->data[anim->frames[0]] == 0xFF, "frame 0 is complete");
+    Check(anim->data[anim->frames[1]] == Diff_Pages(g_heart[0], g_heart[1]), "frame 1 holds the changed pages only");
+    Check(anim->data[anim->frames[2]] == Diff_Pages(g_heart[1], g_heart[0]), "so does the loop frame");
+    Check((anim->data[anim->frames[1]] & (uint8_t)~HEART_PAGES) == 0, "heart pages only");
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    BSP_OLED_DrawImage(anim, 0);
+    Check(memcmp(BSP_OLED_GetFrame(), g_heart[0], sizeof(g_heart[0])) == 0, "frame 0 = small heart, over anything");
+    BSP_OLED_DrawImage(anim, 1);
+    Check(memcmp(BSP_OLED_GetFrame(), g_heart[1], sizeof(g_heart[1])) == 0, "frame 1 = big heart");
+    BSP_OLED_DrawImage(anim, 2);
+    Check(memcmp(BSP_OLED_GetFrame(), g_heart[0], sizeof(g_heart[0])) == 0, "loop frame = small heart again");
+}
+
+/* ===== PLAYBACK ===== */
+static void Test_Playback(void)
+{
+    static Pt_t pt;
+    uint32_t oldBytes = 0, newBytes = 0, frames = 0, updates;
+    uint8_t otherPages = 0;
+
+    // Before: clear, draw the heart, update - 10 times
+    BSP_OLED_DrawBitmap(my_face_array);
+    Flush();
+    for (uint8_t i = 0; i < 10U; i++) {
+        Ref_Heart(g_heart[i & 1U], (i & 1U) ? 45 : 50, (i & 1U) ? 20 : 25, (i & 1U) ? 5 : 3);
+        oldBytes += Flush();
+    }
+
+    // Now: Heart_Beat() on the player, from the face again
+    BSP_OLED_DrawBitmap(my_face_array);
+    Flush();
+    Pages_Written();
+    BSP_OLED_ResetBusStats();
+    PT_INIT(&pt);
+    updates = BSP_OLED_GetBusStats()->updates;
+    while (PT_SCHEDULE(Heart_Beat(&pt))) {
+        if (BSP_OLED_GetBusStats()->updates != updates) {
+            const uint8_t *expected = g_heart[frames & 1U];
+
+            updates = BSP_OLED_GetBusStats()->updates;
+            Check(memcmp(BSP_OLED_GetFrame(), expected, sizeof(g_heart[0])) == 0, "player frame");
+            Check(Panel_Shows(expected), "panel follows the player");
+            if (frames++ > 0) otherPages |= (uint8_t)(Pages_Written() & (uint8_t)~HEART_PAGES);
+            else Pages_Written();
+        }
+        BSP_Delay_ms(20);
+    }
+    newBytes = BSP_OLED_GetBusStats()->bytes;
+
+    Check(frames == 10U, "5 beats, 10 frames");
+    Check(otherPages == 0U, "after the first frame only the heart pages are sent");
+    Check(newBytes <= oldBytes, "no more bytes than the redraw");
+    UART_Printf("[IMAGE] heart beat: redraw %u bytes, player %u bytes (%u frames)\r\n",
+                (unsigned)oldBytes, (unsigned)newBytes, (unsigned)frames);
+}
+
+/* ===== STREAMING ===== */
+static void Test_Stream(void)
+{
+    const OledBusStats_t *stats = BSP_OLED_GetBusStats();
+
+    BSP_OLED_DrawBitmap(my_face_array);
+    Flush();
+
+    BSP_OLED_ResetBusStats();
+    BSP_OLED_StreamImage(&Anim_Heart, 0);
+    Check(Panel_Shows(g_heart[0]), "streamed image on the panel");
+    Check(memcmp(BSP_OLED_GetFrame(), my_face_array, OLED_PAGES * OLED_WIDTH) == 0, "frame buffer untouched");
+    Check(stats->windows == OLED_PAGES, "a window per page");
+    UART_Printf("[IMAGE] stream: %u bytes, %u transactions\r\n", (unsigned)stats->bytes, (unsigned)stats->transactions);
+
+    BSP_OLED_StreamImage(&Anim_Heart, 1);
+    Check(Panel_Shows(g_heart[1]), "delta frame streamed over it");
+
+    Flush();
+    Check(Panel_Shows(my_face_array), "next update puts the frame buffer back");
+    Check(Flush() == 0U, "then nothing is left");
+}
+
+/* ===== SIZE AND SPEED ===== */
+static void Bench_Decode(void)
+{
+    uint32_t start, decodeNs, copyNs;
+
+    start = Prof_Now();
+    for (uint32_t i = 0; i < RUNS; i++) BSP_OLED_DrawImage(&Image_Face, 0);
+    decodeNs = (uint32_t)(((uint64_t)(Prof_Now() - start) * 1000U / Prof_TicksPerUs()) / RUNS);
+
+    start = Prof_Now();
+    for (uint32_t i = 0; i < RUNS; i++) BSP_OLED_DrawBitmap(my_face_array);
+    copyNs = (uint32_t)(((uint64_t)(Prof_Now() - start) * 1000U / Prof_TicksPerUs()) / RUNS);
+
+    UART_Printf("[IMAGE] face: %u bytes (raw %u), heart: %u bytes (raw %u)\r\n",
+                (unsigned)Image_Face.size, OLED_PAGES * OLED_WIDTH,
+                (unsigned)Anim_Heart.size, 2U * OLED_PAGES * OLED_WIDTH);
+    UART_Printf("[IMAGE] full screen: decode %u ns, memcpy %u ns\r\n", (unsigned)decodeNs, (unsigned)copyNs);
+    Check(Image_Face.size < OLED_PAGES * OLED_WIDTH / 2U, "face under half its raw size");
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+    BSP_OLED_Init();
+
+    UART_Printf("\r\n===== 047 OLED Images =====\r\n");
+
+    Test_Face();
+    Test_Heart();
+    Test_Playback();
+    Test_Stream();
+    Bench_Decode();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
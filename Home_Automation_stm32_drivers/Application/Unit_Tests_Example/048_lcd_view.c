@@ -0,0 +1,198 @@
+/*
+ * 048_lcd_view.c
+ *
+ * Created on: Mar 5, 2026
+ * Author: Rahul B.
+ * Description: LCD view and shadow buffer (bsp_lcd.c) - diff flush, bus cost of menu navigation
+ *
+ *   flush         a flush puts the view on the glass; a second one sends
+ *                 nothing
+ *   diff          one changed character costs a cursor move and the
+ *                 character; a one character gap is rewritten, a longer
+ *                 one is skipped with a move
+ *   raw writes    text sent with SetCursor/PrintString is tracked on the
+ *                 shadow, and the next flush puts the view back over it
+ *   clear         blanking a full screen sends the clear command, not 32
+ *                 spaces
+ *   navigation    down to Logout and back up on the main menu: the old
+ *                 redraw (clear, then both lines) against Menu_Display()
+ *                 and a flush, in bytes and in time spent in the driver
+ *
+ * On a host build link Tools/displaysim/sim_hd44780.c and sim_host.c
+ * (GPIO, delays and clock) with bsp_lcd.c, auth_menu.c and profiler.c,
+ * UART_Printf mapped to printf and app_init() stubbed out; the glass is
+ * then read back from the HD44780 emulator.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_lcd.h"
+#include "bsp_timebase.h"
+#include "state_machine.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ===== GLASS (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static bool Glass_Shows(const char *line1, const char *line2)
+{
+    char row[SIM_LCD_COLS + 1];
+
+    Sim_LCD_GetRow(0, row);
+    if (strcmp(row, line1) != 0) return false;
+    Sim_LCD_GetRow(1, row);
+    return strcmp(row, line2) == 0;
+}
+#else
+static bool Glass_Shows(const char *line1, const char *line2) { (void)line1; (void)line2; return true; }
+#endif
+
+/* Flush and return the bytes it sent */
+static uint32_t Flush(void)
+{
+    BSP_LCD_ResetBusStats();
+    BSP_LCD_Flush();
+    return BSP_LCD_GetBusStats()->bytes;
+}
+
+/* ===== DIFF FLUSH ===== */
+static void Test_Flush(void)
+{
+    BSP_LCD_SetLine(0, "Hello");
+    BSP_LCD_SetLine(1, "  Citadel");
+    Flush();
+    Check(Glass_Shows("Hello           ", "  Citadel       "), "flush puts the view on the glass");
+    Check(Flush() == 0, "nothing to send when the glass shows the view");
+}
+
+static void Test_Diff(void)
+{
+    const LcdBusStats_t *st = BSP_LCD_GetBusStats();
+
+    BSP_LCD_WriteAt(0, 1, "a");
+    Check(Flush() == 2 && st->moves == 1 && st->chars == 1, "one character: a move and the character");
+
+    // The cursor is now at column 2: move to 6, rewrite 7, write 8
+    BSP_LCD_WriteAt(0, 6, "x");
+    BSP_LCD_WriteAt(0, 8, "y");
+    Check(Flush() == 4 && st->moves == 1 && st->chars == 3, "one character gap: rewritten, not skipped");
+
+    BSP_LCD_WriteAt(1, 2, "K");
+    BSP_LCD_WriteAt(1, 8, "L");
+    Check(Flush() == 4 && st->moves == 2 && st->chars == 2, "longer gap: skipped with a cursor move");
+    Check(Glass_Shows("Hallo x y       ", "  KitadeL       "), "diff flushes leave the view on the glass");
+}
+
+static void Test_RawWrites(void)
+{
+    BSP_LCD_SetCursor(1, 0);
+    BSP_LCD_PrintString("ZZ");
+    Check(Flush() == 3, "raw text is tracked: one move and two characters put the view back");
+    Check(Glass_Shows("Hallo x y       ", "  KitadeL       "), "view restored over raw text");
+
+    // Unknown glass: 34 bytes cell by cell, or a clear and the 17 of the text
+    BSP_LCD_Invalidate();
+    Check(Flush() == 1 + 9 + 8 && BSP_LCD_GetBusStats()->clears == 1, "after Invalidate the screen is cleared and redrawn");
+    Check(Glass_Shows("Hallo x y       ", "  KitadeL       "), "redrawn view after Invalidate");
+}
+
+static void Test_Clear(void)
+{
+    const LcdBusStats_t *st = BSP_LCD_GetBusStats();
+
+    BSP_LCD_SetLine(0, "ABCDEFGHIJKLMNOP");
+    BSP_LCD_SetLine(1, "abcdefghijklmnop");
+    Flush();
+    BSP_LCD_ClearView();
+    Check(Flush() == 1 && st->clears == 1, "blank screen: the clear command");
+    Check(Glass_Shows("                ", "                "), "glass blank after the clear");
+}
+
+/* ===== MENU NAVIGATION ===== */
+static const int8_t g_keys[] = { +1, +1, +1, -1, -1, -1 };
+
+/* The LCD task before the view: clear, then both lines */
+static void Old_Redraw(uint8_t cursor)
+{
+    static const char *const items[] = {
+        "1.Sensor Monitor", "2.Device Control", "3.Settings      ", "4.Logout        "
+    };
+    char line1[30], line2[30];
+
+    snprintf(line1, sizeof(line1), ">%s", items[cursor]);
+    snprintf(line2, sizeof(line2), " %s", items[(cursor + 1) % 4]);
+    BSP_LCD_SendCommand(LCD_CMD_CLEAR);
+    BSP_LCD_SetCursor(0, 0);
+    BSP_LCD_PrintString(line1);
+    BSP_LCD_SetCursor(1, 0);
+    BSP_LCD_PrintString(line2);
+}
+
+static void New_Redraw(void)
+{
+    BSP_LCD_ClearView();
+    Menu_Display();
+    BSP_LCD_Flush();
+}
+
+static void Bench_Navigation(void)
+{
+    uint32_t bytes[2], us[2];
+
+    g_SystemContext.currentState = STATE_ACTIVE_MENU;
+
+    for (uint8_t way = 0; way < 2; way++) {
+        uint8_t cursor = 0;
+        uint64_t t0;
+
+        // Same starting screen for both
+        g_SystemContext.menuCursor = 0;
+        New_Redraw();
+
+        BSP_LCD_ResetBusStats();
+        t0 = now_us();
+        for (uint8_t i = 0; i < sizeof(g_keys); i++) {
+            cursor = (uint8_t)(cursor + g_keys[i]);
+            g_SystemContext.menuCursor = cursor;
+            if (way == 0) Old_Redraw(cursor);
+            else New_Redraw();
+        }
+        us[way] = (uint32_t)(now_us() - t0);
+        bytes[way] = BSP_LCD_GetBusStats()->bytes;
+    }
+
+    Check(Glass_Shows(">1.Sensor Monito", " 2.Device Contro"), "navigation ends on the first item");
+    Check(bytes[1] < bytes[0], "navigation: fewer bytes through the view");
+    Check(us[1] < us[0], "navigation: less time in the driver through the view");
+
+    UART_Printf("[NAV] %u keys: old %u bytes (%u nibbles) %u us, view %u bytes (%u nibbles) %u us\r\n",
+                (unsigned)sizeof(g_keys), (unsigned)bytes[0], (unsigned)(2U * bytes[0]), (unsigned)us[0],
+                (unsigned)bytes[1], (unsigned)(2U * bytes[1]), (unsigned)us[1]);
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+    BSP_LCD_Init();
+
+    UART_Printf("\r\n===== 048 LCD View =====\r\n");
+
+    Test_Flush();
+    Test_Diff();
+    Test_RawWrites();
+    Test_Clear();
+    Bench_Navigation();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
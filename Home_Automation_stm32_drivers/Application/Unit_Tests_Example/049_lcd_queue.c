@@ -0,0 +1,167 @@
+/*
+ * 049_lcd_queue.c
+ *
+ * Created on: Mar 6, 2026
+ * Author: Rahul B.
+ * Description: Interrupt driven LCD transport (bsp_lcd.c, TIM6) - queue, timings, overruns
+ *
+ *   return        a full screen written through the queue returns in
+ *                 far less time than the blocking driver takes for it
+ *   drain         the TIM6 interrupt sends every queued byte; the glass
+ *                 shows the screen and the byte time is the pulses plus
+ *                 the execution time, not the 300 us of the blocking path
+ *   clear         a clear holds the queue for LCD_EXEC_CLEAR_US, so the
+ *                 next byte does not reach a busy controller
+ *   overrun       more bytes than the queue holds: the caller waits for
+ *                 room, nothing is lost
+ *   sync          disabling the queue waits for it to drain first
+ *
+ * On a host build link Tools/displaysim/sim_hd44780.c and sim_host.c (GPIO,
+ * delays, clock and TIM6) with bsp_lcd.c and profiler.c, UART_Printf
+ * mapped to printf and app_init() stubbed out; the glass and the busy
+ * violations are then read back from the HD44780 emulator.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "bsp_lcd.h"
+#include "bsp_timebase.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+
+/* ===== GLASS (host only) ===== */
+#if !defined(__arm__)
+#include "displaysim.h"
+
+static bool Glass_Shows(const char *line1, const char *line2)
+{
+    char row[SIM_LCD_COLS + 1];
+
+    Sim_LCD_GetRow(0, row);
+    if (strcmp(row, line1) != 0) return false;
+    Sim_LCD_GetRow(1, row);
+    return strcmp(row, line2) == 0;
+}
+
+static uint32_t Busy_Violations(void) { return Sim_LCD_GetStats()->busyViolations; }
+static uint32_t Bytes_Latched(void) { return Sim_LCD_GetStats()->instructions + Sim_LCD_GetStats()->dataBytes; }
+#else
+static bool Glass_Shows(const char *line1, const char *line2) { (void)line1; (void)line2; return true; }
+static uint32_t Busy_Violations(void) { return 0; }
+static uint32_t Bytes_Latched(void) { return BSP_LCD_GetQueueStats()->sent; }
+#endif
+
+/* Full screen through the view, returns the time spent in the call */
+static uint32_t Draw(const char *line1, const char *line2)
+{
+    uint64_t t0 = now_us();
+
+    BSP_LCD_SetLine(0, line1);
+    BSP_LCD_SetLine(1, line2);
+    BSP_LCD_Flush();
+    return (uint32_t)(now_us() - t0);
+}
+
+/* ===== TESTS ===== */
+static void Test_ReturnAndDrain(void)
+{
+    const LcdQueueStats_t *qs = BSP_LCD_GetQueueStats();
+    uint32_t syncUs, asyncUs, drainUs, bytes;
+    uint64_t t0;
+
+    syncUs = Draw("Blocking driver", "300 us per byte");
+    bytes = BSP_LCD_GetBusStats()->bytes;
+
+    BSP_LCD_SetAsync(true);
+    BSP_LCD_ResetBusStats();
+    BSP_LCD_ResetQueueStats();
+
+    asyncUs = Draw("Queued by TIM6", "returns at once");
+    Check(asyncUs * 10U < syncUs, "queued screen returns in under a tenth of the blocking time");
+    Check(BSP_LCD_QueueDepth() == BSP_LCD_GetBusStats()->bytes, "every byte of the screen is waiting in the queue");
+
+    t0 = now_us();
+    BSP_LCD_WaitIdle();
+    drainUs = (uint32_t)(now_us() - t0);
+
+    Check(BSP_LCD_QueueDepth() == 0 && qs->sent == qs->queued, "the interrupt sends every queued byte");
+    Check(Glass_Shows("Queued by TIM6  ", "returns at once "), "queued screen on the glass");
+    Check(drainUs < syncUs, "queued bytes go out faster than blocking ones");
+    Check(Busy_Violations() == 0, "no byte reaches a busy controller");
+
+    UART_Printf("[LCD] blocking: %u bytes in %u us; queue: returned in %u us, %u bytes out in %u us (max depth %u)\r\n",
+                (unsigned)bytes, (unsigned)syncUs, (unsigned)asyncUs, (unsigned)qs->sent,
+                (unsigned)drainUs, (unsigned)qs->maxDepth);
+}
+
+static void Test_Clear(void)
+{
+    uint64_t t0 = now_us();
+
+    BSP_LCD_SendCommand(LCD_CMD_CLEAR);
+    BSP_LCD_SetCursor(0, 0);
+    BSP_LCD_SendData('C');
+    BSP_LCD_WaitIdle();
+
+    Check(now_us() - t0 >= LCD_EXEC_CLEAR_US, "clear holds the queue for its execution time");
+    Check(Busy_Violations() == 0, "no byte during the clear");
+    Check(Glass_Shows("C               ", "                "), "byte after the clear on the glass");
+    BSP_LCD_Invalidate();
+}
+
+static void Test_Overrun(void)
+{
+    const LcdQueueStats_t *qs = BSP_LCD_GetQueueStats();
+    uint32_t latched = Bytes_Latched();
+
+    // Line 1 five times over: 85 bytes for a 64 byte queue
+    BSP_LCD_ResetQueueStats();
+    for (uint8_t i = 0; i < 5; i++) {
+        BSP_LCD_SetCursor(0, 0);
+        BSP_LCD_PrintString(i < 4 ? "xxxxxxxxxxxxxxxx" : "oooooooooooooooo");
+    }
+    Check(qs->overruns > 0 && qs->maxDepth == LCD_QUEUE_SIZE, "queue full: overrun counted");
+    BSP_LCD_WaitIdle();
+    Check(qs->sent == qs->queued && Bytes_Latched() - latched == qs->queued, "overrun: nothing lost");
+    Check(Glass_Shows("oooooooooooooooo", "                "), "overrun: the glass is right");
+    Check(Busy_Violations() == 0, "overrun: no byte reaches a busy controller");
+    BSP_LCD_Invalidate();
+}
+
+static void Test_Sync(void)
+{
+    uint32_t us;
+
+    BSP_LCD_SetLine(0, "Back to");
+    BSP_LCD_SetLine(1, "blocking");
+    BSP_LCD_Flush();
+    BSP_LCD_SetAsync(false);
+    Check(BSP_LCD_QueueDepth() == 0, "disabling the queue drains it");
+
+    us = Draw("Blocking again", "");
+    Check(us > 0 && BSP_LCD_QueueDepth() == 0, "blocking writes do not use the queue");
+    Check(Glass_Shows("Blocking again  ", "                "), "blocking screen on the glass");
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+    BSP_LCD_Init();
+
+    UART_Printf("\r\n===== 049 LCD Queue =====\r\n");
+
+    Test_ReturnAndDrain();
+    Test_Clear();
+    Test_Overrun();
+    Test_Sync();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
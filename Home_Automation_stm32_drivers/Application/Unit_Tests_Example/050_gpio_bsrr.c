@@ -0,0 +1,288 @@
+/*
+ * 050_gpio_bsrr.c
+ *
+ * Created on: Mar 7, 2026
+ * Author: Rahul B.
+ * Description: Atomic multi-pin GPIO writes (BSRR) - register accesses and cycles, before and after
+ *
+ * The pin updates of the BSP, written the way the driver did them before
+ * (one read-modify-write of ODR per pin) and the way they are done now
+ * (one store to BSRR for the whole group):
+ *
+ *   lcd nibble    D4-D7 and the EN pulse of one LCD nibble
+ *   keypad row    all rows high but the scanned one
+ *   keypad idle   all rows low
+ *   led bank      the three LEDs off
+ *   relay bank    the four relays switched together
+ *
+ * Host build: the GPIO driver (stm32f446xx_gpio_driver.c) runs on a port
+ * in RAM. A BSRR store is applied to ODR after each call, which counts it
+ * and checks that the call left ODR alone; the old path counts its own
+ * ODR load and store. Both paths must leave the same levels on the port.
+ * Link profiler.c, UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Target build: the same sequences run on GPIOH (nothing on the board is
+ * wired to its ODR), timed in CPU cycles with the DWT counter.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "config.h"
+#include "profiler.h"
+#include "test_check.h"
+
+#define BENCH_RUNS      1000U
+
+/* ===== BUS ===== */
+#if !defined(__arm__)
+static GPIO_RegDef_t g_ram_port;
+#define BENCH_PORT      (&g_ram_port)
+
+static struct {
+    uint32_t accesses;          // loads and stores of port registers
+    uint32_t odr;               // ODR as the counted accesses left it
+    uint32_t strayOdrWrites;    // ODR changed by a call of the new path
+} g_bus;
+
+/* The register file after a driver call: apply and count a BSRR store */
+static void Bus_Settle(void)
+{
+    uint32_t bsrr = g_ram_port.BSRR;
+
+    if (g_ram_port.ODR != g_bus.odr) g_bus.strayOdrWrites++;
+    if (bsrr != 0U) {
+        g_bus.accesses++;
+        g_ram_port.ODR = (g_bus.odr | (bsrr & 0xFFFFU)) & ~(bsrr >> 16);
+        g_ram_port.BSRR = 0;
+    }
+    g_bus.odr = g_ram_port.ODR;
+}
+
+static void Bus_Reset(uint32_t odr)
+{
+    g_ram_port.ODR = odr;
+    g_ram_port.BSRR = 0;
+    g_bus.accesses = 0;
+    g_bus.odr = odr;
+}
+#else
+#define BENCH_PORT      GPIOH
+
+static void Bus_Settle(void) { }
+static void Bus_Reset(uint32_t odr) { GPIOH->ODR = odr; }
+#endif
+
+/* ===== OLD PATH: the driver before BSRR ===== */
+static void Old_Write(GPIO_RegDef_t *port, uint8_t pin, uint8_t value)
+{
+    if (value == GPIO_PIN_SET) port->ODR |= (1U << pin);
+    else port->ODR &= ~(1U << pin);
+#if !defined(__arm__)
+    g_bus.accesses += 2U;       // LDR + STR of ODR
+    g_bus.odr = port->ODR;
+#endif
+}
+
+static void Old_LcdNibble(uint8_t nibble)
+{
+    Old_Write(BENCH_PORT, LCD_D4_PIN, (nibble >> 0) & 0x1);
+    Old_Write(BENCH_PORT, LCD_D5_PIN, (nibble >> 1) & 0x1);
+    Old_Write(BENCH_PORT, LCD_D6_PIN, (nibble >> 2) & 0x1);
+    Old_Write(BENCH_PORT, LCD_D7_PIN, (nibble >> 3) & 0x1);
+    Old_Write(BENCH_PORT, LCD_EN_PIN, 1);
+    Old_Write(BENCH_PORT, LCD_EN_PIN, 0);
+}
+
+static void Old_KeypadRow(uint8_t row)
+{
+    static const uint8_t rows[4] = { KEYPAD_R0_PIN, KEYPAD_R1_PIN, KEYPAD_R2_PIN, KEYPAD_R3_PIN };
+
+    for (uint8_t r = 0; r < 4; r++) Old_Write(BENCH_PORT, rows[r], GPIO_PIN_SET);
+    Old_Write(BENCH_PORT, rows[row], GPIO_PIN_RESET);
+}
+
+static void Old_KeypadIdle(uint8_t arg)
+{
+    (void)arg;
+    Old_Write(BENCH_PORT, KEYPAD_R0_PIN, GPIO_PIN_RESET);
+    Old_Write(BENCH_PORT, KEYPAD_R1_PIN, GPIO_PIN_RESET);
+    Old_Write(BENCH_PORT, KEYPAD_R2_PIN, GPIO_PIN_RESET);
+    Old_Write(BENCH_PORT, KEYPAD_R3_PIN, GPIO_PIN_RESET);
+}
+
+static void Old_LedBank(uint8_t arg)
+{
+    (void)arg;
+    Old_Write(BENCH_PORT, LED_GREEN_PIN, GPIO_PIN_RESET);
+    Old_Write(BENCH_PORT, LED_RED_PIN, GPIO_PIN_RESET);
+    Old_Write(BENCH_PORT, LED_WHITE_PIN, GPIO_PIN_RESET);
+}
+
+static void Old_RelayBank(uint8_t state)
+{
+    Old_Write(BENCH_PORT, RELAY1_PIN, state);
+    Old_Write(BENCH_PORT, RELAY2_PIN, state);
+    Old_Write(BENCH_PORT, RELAY3_PIN, state);
+    Old_Write(BENCH_PORT, RELAY4_PIN, state);
+}
+
+/* ===== NEW PATH: as bsp_lcd.c, bsp_keypad.c, bsp_led.c, bsp_relay.c do it ===== */
+static void New_LcdNibble(uint8_t nibble)
+{
+    uint16_t pins = (uint16_t)(((nibble & 0x1) ? GPIO_PIN_MASK(LCD_D4_PIN) : 0U) |
+                               ((nibble & 0x2) ? GPIO_PIN_MASK(LCD_D5_PIN) : 0U) |
+                               ((nibble & 0x4) ? GPIO_PIN_MASK(LCD_D6_PIN) : 0U) |
+                               ((nibble & 0x8) ? GPIO_PIN_MASK(LCD_D7_PIN) : 0U));
+
+    GPIO_WriteMasked(BENCH_PORT, LCD_DATA_MASK, pins);
+    Bus_Settle();
+    GPIO_WriteToOutputPin(BENCH_PORT, LCD_EN_PIN, 1);
+    Bus_Settle();
+    GPIO_WriteToOutputPin(BENCH_PORT, LCD_EN_PIN, 0);
+    Bus_Settle();
+}
+
+static void New_KeypadRow(uint8_t row)
+{
+    static const uint8_t rows[4] = { KEYPAD_R0_PIN, KEYPAD_R1_PIN, KEYPAD_R2_PIN, KEYPAD_R3_PIN };
+
+    GPIO_WriteMaskedFast(BENCH_PORT, KEYPAD_ROW_MASK, KEYPAD_ROW_MASK & (uint16_t)~GPIO_PIN_MASK(rows[row]));
+    Bus_Settle();
+}
+
+static void New_KeypadIdle(uint8_t arg)
+{
+    (void)arg;
+    GPIO_ResetPinsFast(BENCH_PORT, KEYPAD_ROW_MASK);
+    Bus_Settle();
+}
+
+static void New_LedBank(uint8_t arg)
+{
+    (void)arg;
+    GPIO_ResetPins(BENCH_PORT, LED_ALL_MASK);
+    Bus_Settle();
+}
+
+static void New_RelayBank(uint8_t state)
+{
+    GPIO_WriteMasked(BENCH_PORT, RELAY_ALL_MASK, (state == SET) ? RELAY_ALL_MASK : 0U);
+    Bus_Settle();
+}
+
+/* ===== BENCH ===== */
+typedef struct {
+    const char *name;
+    void (*oldPath)(uint8_t);
+    void (*newPath)(uint8_t);
+    uint8_t arg;
+    uint32_t startOdr;
+} GpioCase_t;
+
+static const GpioCase_t g_cases[] = {
+    { "lcd nibble",  Old_LcdNibble,  New_LcdNibble,  0x0A,  0x0015U },
+    { "keypad row",  Old_KeypadRow,  New_KeypadRow,  2,     0xF00AU },
+    { "keypad idle", Old_KeypadIdle, New_KeypadIdle, 0,     0x000DU },
+    { "led bank",    Old_LedBank,    New_LedBank,    0,     0x00E0U },
+    { "relay bank",  Old_RelayBank,  New_RelayBank,  RESET, 0xA00FU },
+};
+
+/* One run from the case's starting levels: register accesses (host) or
+ * cycles of BENCH_RUNS runs (target), and the levels left on the port */
+static uint32_t Run(const GpioCase_t *c, bool newPath, uint32_t *odr)
+{
+    uint32_t runs = 1U, t0;
+
+#if defined(__arm__)
+    runs = BENCH_RUNS;
+#endif
+    Bus_Reset(c->startOdr);
+    t0 = Prof_Now();
+    for (uint32_t i = 0; i < runs; i++) {
+        if (newPath) c->newPath(c->arg);
+        else c->oldPath(c->arg);
+    }
+    t0 = Prof_Now() - t0;
+    *odr = BENCH_PORT->ODR;
+
+#if !defined(__arm__)
+    return g_bus.accesses;
+#else
+    return t0 / BENCH_RUNS;
+#endif
+}
+
+static void Bench_Cases(void)
+{
+    uint32_t totalOld = 0, totalNew = 0;
+
+    for (uint8_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+        const GpioCase_t *c = &g_cases[i];
+        uint32_t odrOld, odrNew, costOld, costNew;
+
+        costOld = Run(c, false, &odrOld);
+        costNew = Run(c, true, &odrNew);
+        totalOld += costOld;
+        totalNew += costNew;
+
+        Check(odrOld == odrNew, c->name);
+        Check(costNew < costOld, "the BSRR path is cheaper");
+#if !defined(__arm__)
+        UART_Printf("[GPIO] %-12s old %2u accesses  new %u  (ODR %04X)\r\n",
+                    c->name, (unsigned)costOld, (unsigned)costNew, (unsigned)odrNew);
+#else
+        UART_Printf("[GPIO] %-12s old %3u cycles  new %3u\r\n", c->name, (unsigned)costOld, (unsigned)costNew);
+#endif
+    }
+
+#if !defined(__arm__)
+    Check(g_bus.strayOdrWrites == 0, "the new path never writes ODR");
+#endif
+    UART_Printf("[GPIO] total: old %u, new %u\r\n", (unsigned)totalOld, (unsigned)totalNew);
+}
+
+/* ===== DRIVER SEMANTICS ===== */
+static void Test_Driver(void)
+{
+    uint32_t odr;
+
+    Bus_Reset(0x00F0U);
+    GPIO_WriteMasked(BENCH_PORT, 0x0FF0U, 0x0A5AU);     // 4..11 -> 0101 1010
+    Bus_Settle();
+    GPIO_SetPins(BENCH_PORT, GPIO_PIN_MASK(GPIO_PIN_NO_0));
+    Bus_Settle();
+    GPIO_ResetPins(BENCH_PORT, GPIO_PIN_MASK(GPIO_PIN_NO_6));
+    Bus_Settle();
+    GPIO_ToggleOutputPin(BENCH_PORT, GPIO_PIN_NO_15);
+    Bus_Settle();
+    GPIO_ToggleOutputPin(BENCH_PORT, GPIO_PIN_NO_4);
+    Bus_Settle();
+    odr = BENCH_PORT->ODR;
+
+    // 0x00F0 -> masked 0x0A50 -> +pin0 0x0A51 -> -pin6 0x0A11 -> ^15 0x8A11 -> ^4 0x8A01
+    Check(odr == 0x8A01U, "masked write, set, reset and toggle leave the right levels");
+    Bus_Reset(0);
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+#if defined(__arm__)
+    GPIO_PeriClockControl(GPIOH, ENABLE);
+#endif
+
+    UART_Printf("\r\n===== 050 GPIO BSRR =====\r\n");
+
+    Test_Driver();
+    Bench_Cases();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,290 @@
+/*
+ * 051_gpio_init_group.c
+ *
+ * Created on: Mar 8, 2026
+ * Author: Rahul B.
+ * Description: Board pin table and GPIO_InitGroup() - same register images as per-pin GPIO_Init, faster
+ *
+ *   images        the pins of USART2, the LEDs, keypad, relays, LCD and
+ *                 OLED configured the way the BSP did it before (a filled
+ *                 GPIO_Handle_t and one GPIO_Init() per pin) and from the
+ *                 BOARD_PINS_* tables of config.h with GPIO_InitGroup():
+ *                 MODER, OTYPER, OSPEEDR, PUPDR and AFR of ports A, B and
+ *                 C must come out identical
+ *   time          both ways BENCH_RUNS times; on the target the group
+ *                 must be faster (on the host the ports are cached RAM and
+ *                 the time is only printed)
+ *
+ * Host build: the GPIO driver (stm32f446xx_gpio_driver.c) runs on ports in
+ * RAM that start from the reference manual reset values. Link profiler.c,
+ * UART_Printf mapped to printf and app_init() stubbed out.
+ *
+ * Target build: app_init() has configured the board through the tables;
+ * the registers are read back, the old per-pin code is run over them and
+ * they are read again. Every pin is set to what it already has, so the
+ * board keeps working (the per-pin code can glitch a pin for a few cycles,
+ * as it always did at boot).
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "config.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+
+#define BENCH_RUNS      100U
+#define NUM_PORTS       3U
+
+/* ===== PORTS ===== */
+typedef struct {
+    uint32_t MODER, OTYPER, OSPEEDR, PUPDR, AFR[2];
+} PortImage_t;
+
+static GPIO_RegDef_t *const g_boardPorts[NUM_PORTS] = { GPIOA, GPIOB, GPIOC };
+
+#if !defined(__arm__)
+static GPIO_RegDef_t g_ramPorts[NUM_PORTS];
+
+/* Board port -> the RAM port that stands in for it */
+static GPIO_RegDef_t *Port(GPIO_RegDef_t *pGPIOx)
+{
+    for (uint8_t i = 0; i < NUM_PORTS; i++) {
+        if (g_boardPorts[i] == pGPIOx) return &g_ramPorts[i];
+    }
+    return NULL;
+}
+
+/* RM0390 reset values (PA13-15 and PB3-4 are the debug pins) */
+static void Ports_Reset(void)
+{
+    memset(g_ramPorts, 0, sizeof(g_ramPorts));
+    g_ramPorts[0].MODER = 0xA8000000U;
+    g_ramPorts[0].OSPEEDR = 0x0C000000U;
+    g_ramPorts[0].PUPDR = 0x64000000U;
+    g_ramPorts[1].MODER = 0x00000280U;
+    g_ramPorts[1].OSPEEDR = 0x000000C0U;
+    g_ramPorts[1].PUPDR = 0x00000100U;
+}
+#else
+static GPIO_RegDef_t *Port(GPIO_RegDef_t *pGPIOx) { return pGPIOx; }
+static void Ports_Reset(void) { }
+#endif
+
+static void Ports_Read(PortImage_t *img)
+{
+    for (uint8_t i = 0; i < NUM_PORTS; i++) {
+        GPIO_RegDef_t *p = Port(g_boardPorts[i]);
+
+        img[i].MODER = p->MODER;
+        img[i].OTYPER = p->OTYPER;
+        img[i].OSPEEDR = p->OSPEEDR;
+        img[i].PUPDR = p->PUPDR;
+        img[i].AFR[0] = p->AFR[0];
+        img[i].AFR[1] = p->AFR[1];
+    }
+}
+
+/* ===== BEFORE: one GPIO_Init() per pin, as the BSP modules did it ===== */
+static void Old_Pin(GPIO_Handle_t *h, uint8_t pin)
+{
+    h->GPIO_PinConfig.GPIO_PinNumber = pin;
+    GPIO_Init(h);
+}
+
+static void Old_BoardInit(void)
+{
+    GPIO_Handle_t h;
+
+    // USART2_GPIOInit()
+    memset(&h, 0, sizeof(h));
+    h.pGPIOx = Port(USART_VCP_PORT);
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    h.GPIO_PinConfig.GPIO_PinAltFunMode = USART_VCP_AF;
+    Old_Pin(&h, USART_TX_PIN);
+    Old_Pin(&h, USART_RX_PIN);
+
+    // BSP_LED_Init()
+    memset(&h, 0, sizeof(h));
+    h.pGPIOx = Port(LED_PORT);
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_LOW;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
+    Old_Pin(&h, LED_GREEN_PIN);
+    Old_Pin(&h, LED_RED_PIN);
+    Old_Pin(&h, LED_WHITE_PIN);
+
+    // Keypad_Init(): rows and columns alike, open-drain with pull-up
+    memset(&h, 0, sizeof(h));
+    h.pGPIOx = Port(KEYPAD_ROW_PORT);
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_OD;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    Old_Pin(&h, KEYPAD_R0_PIN);
+    Old_Pin(&h, KEYPAD_R1_PIN);
+    Old_Pin(&h, KEYPAD_R2_PIN);
+    Old_Pin(&h, KEYPAD_R3_PIN);
+    h.pGPIOx = Port(KEYPAD_COL_PORT);
+    Old_Pin(&h, KEYPAD_C0_PIN);
+    Old_Pin(&h, KEYPAD_C1_PIN);
+    Old_Pin(&h, KEYPAD_C2_PIN);
+    Old_Pin(&h, KEYPAD_C3_PIN);
+
+    // BSP_Relay_Init()
+    memset(&h, 0, sizeof(h));
+    h.pGPIOx = Port(RELAY_PORT);
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    Old_Pin(&h, RELAY1_PIN);
+    Old_Pin(&h, RELAY2_PIN);
+    Old_Pin(&h, RELAY3_PIN);
+    Old_Pin(&h, RELAY4_PIN);
+
+    // BSP_LCD_Init()
+    memset(&h, 0, sizeof(h));
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
+    h.pGPIOx = Port(LCD_CTRL_PORT);
+    Old_Pin(&h, LCD_RS_PIN);
+    Old_Pin(&h, LCD_EN_PIN);
+    h.pGPIOx = Port(LCD_DATA_PORT);
+    Old_Pin(&h, LCD_D4_PIN);
+    Old_Pin(&h, LCD_D5_PIN);
+    Old_Pin(&h, LCD_D6_PIN);
+    Old_Pin(&h, LCD_D7_PIN);
+
+    // OLED_GPIO_Init()
+    memset(&h, 0, sizeof(h));
+    h.pGPIOx = Port(OLED_I2C_PORT);
+    h.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
+    h.GPIO_PinConfig.GPIO_PinAltFunMode = OLED_I2C_AF;
+    h.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_OD;
+    h.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+    h.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    Old_Pin(&h, OLED_SCL_PIN);
+    Old_Pin(&h, OLED_SDA_PIN);
+}
+
+/* ===== AFTER: the board pin table, one GPIO_InitGroup() per module ===== */
+static const GPIO_Handle_t g_usart[] = { BOARD_PINS_USART2 };
+static const GPIO_Handle_t g_led[] = { BOARD_PINS_LED };
+static const GPIO_Handle_t g_keypad[] = { BOARD_PINS_KEYPAD };
+static const GPIO_Handle_t g_relay[] = { BOARD_PINS_RELAY };
+static const GPIO_Handle_t g_lcd[] = { BOARD_PINS_LCD };
+static const GPIO_Handle_t g_oled[] = { BOARD_PINS_OLED };
+
+typedef struct {
+    const GPIO_Handle_t *pins;
+    uint8_t count;
+} PinGroup_t;
+
+static PinGroup_t g_groups[] = {
+    { g_usart,  GPIO_PIN_COUNT(g_usart) },
+    { g_led,    GPIO_PIN_COUNT(g_led) },
+    { g_keypad, GPIO_PIN_COUNT(g_keypad) },
+    { g_relay,  GPIO_PIN_COUNT(g_relay) },
+    { g_lcd,    GPIO_PIN_COUNT(g_lcd) },
+    { g_oled,   GPIO_PIN_COUNT(g_oled) },
+};
+
+#if !defined(__arm__)
+static GPIO_Handle_t g_ramPins[32];
+
+/* Same tables, ports swapped for the RAM ones */
+static void Groups_Remap(void)
+{
+    uint8_t n = 0;
+
+    for (uint8_t g = 0; g < sizeof(g_groups) / sizeof(g_groups[0]); g++) {
+        for (uint8_t i = 0; i < g_groups[g].count; i++) {
+            g_ramPins[n + i] = g_groups[g].pins[i];
+            g_ramPins[n + i].pGPIOx = Port(g_groups[g].pins[i].pGPIOx);
+        }
+        g_groups[g].pins = &g_ramPins[n];
+        n = (uint8_t)(n + g_groups[g].count);
+    }
+}
+#else
+static void Groups_Remap(void) { }
+#endif
+
+static void New_BoardInit(void)
+{
+    for (uint8_t g = 0; g < sizeof(g_groups) / sizeof(g_groups[0]); g++) {
+        GPIO_InitGroup(g_groups[g].pins, g_groups[g].count);
+    }
+}
+
+/* ===== TESTS ===== */
+static void Test_Images(void)
+{
+    static const char names[NUM_PORTS] = { 'A', 'B', 'C' };
+    PortImage_t before[NUM_PORTS], after[NUM_PORTS];
+
+    Ports_Reset();
+    New_BoardInit();
+    Ports_Read(after);
+
+    Ports_Reset();
+    Old_BoardInit();
+    Ports_Read(before);
+
+    for (uint8_t i = 0; i < NUM_PORTS; i++) {
+        bool same = memcmp(&before[i], &after[i], sizeof(PortImage_t)) == 0;
+
+        Check(same, "register image of the port unchanged");
+        UART_Printf("[INIT] GPIO%c MODER %08X OTYPER %04X OSPEEDR %08X PUPDR %08X AFR %08X %08X %s\r\n",
+                    names[i], (unsigned)after[i].MODER, (unsigned)after[i].OTYPER,
+                    (unsigned)after[i].OSPEEDR, (unsigned)after[i].PUPDR,
+                    (unsigned)after[i].AFR[0], (unsigned)after[i].AFR[1], same ? "same" : "DIFFERENT");
+    }
+}
+
+static void Bench_Init(void)
+{
+    uint32_t t0, oldTicks, newTicks;
+
+    t0 = Prof_Now();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) Old_BoardInit();
+    oldTicks = (Prof_Now() - t0) / BENCH_RUNS;
+
+    t0 = Prof_Now();
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) New_BoardInit();
+    newTicks = (Prof_Now() - t0) / BENCH_RUNS;
+
+#if defined(__arm__)
+    Check(newTicks < oldTicks, "the group init is faster");
+#endif
+    UART_Printf("[INIT] 21 pins: GPIO_Init per pin %u ticks, GPIO_InitGroup %u ticks (%u ticks/us)\r\n",
+                (unsigned)oldTicks, (unsigned)newTicks, (unsigned)Prof_TicksPerUs());
+}
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+
+    UART_Printf("\r\n===== 051 GPIO Init Group =====\r\n");
+    Groups_Remap();
+
+    Test_Images();
+    Bench_Init();
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
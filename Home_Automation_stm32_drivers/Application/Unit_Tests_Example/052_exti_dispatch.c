@@ -0,0 +1,246 @@
+/*
+ * 052_exti_dispatch.c
+ *
+ * Created on: Mar 9, 2026
+ * Author: Rahul B.
+ * Description: EXTI service of the GPIO driver - callback registry, demultiplexing, statistics
+ *
+ *   order         the lines taken by one call are served highest first,
+ *                 each callback gets its line and the pin level
+ *   stats         every edge counts a hit and stamps the clock, edges of
+ *                 lines without a callback count as unhandled
+ *   detach        attaching NULL detaches, only valid lines are served
+ *
+ * and on the target, through the real interrupts (EXTI->SWIER):
+ *
+ *   shared        several lines of one vector pending together are served
+ *                 by one interrupt and one write to PR clears them all
+ *   re-trigger    an edge arriving while the callbacks run is not lost
+ *   unregister    a masked line does not interrupt any more
+ *   cycles        interrupt entry to last callback, one and five lines
+ *
+ * Host build: link stm32f446xx_gpio_driver.c and profiler.c, UART_Printf
+ * mapped to printf and app_init() stubbed out. The levels are read from a
+ * port in RAM and the lines are handed to GPIO_EXTI_Service() directly.
+ *
+ * Target build: this file brings its own EXTI9_5 and EXTI15_10 handlers
+ * and registers lines on GPIOH (no pin of the board), so no real edge
+ * interferes with the software triggered ones.
+ *
+ * Results are printed on USART2 (115200 8N1).
+ */
+
+#include "bsp_init.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "profiler.h"
+#include "test_check.h"
+
+#define MAX_CALLS       16U
+
+/* ===== CALLBACK TRACE ===== */
+static struct {
+    uint8_t line[MAX_CALLS];
+    uint8_t level[MAX_CALLS];
+    uint8_t count;
+    uint32_t lastCycles;        // Prof_Now() in the last callback
+} g_trace;
+
+static uint32_t g_clock;
+
+static uint32_t Test_Clock(void) { return g_clock; }
+
+static void Trace_Reset(void)
+{
+    g_trace.count = 0;
+}
+
+static void Trace_OnEdge(uint8_t line, uint8_t level)
+{
+    if (g_trace.count < MAX_CALLS) {
+        g_trace.line[g_trace.count] = line;
+        g_trace.level[g_trace.count] = level;
+        g_trace.count++;
+    }
+    g_trace.lastCycles = Prof_Now();
+}
+
+static bool Trace_Is(const uint8_t *lines, uint8_t count)
+{
+    if (g_trace.count != count) return false;
+    for (uint8_t i = 0; i < count; i++) {
+        if (g_trace.line[i] != lines[i]) return false;
+    }
+    return true;
+}
+
+/* ===== SERVICE (host and target) ===== */
+#if !defined(__arm__)
+static GPIO_RegDef_t g_ram_port;
+#define TEST_PORT       (&g_ram_port)
+#else
+#define TEST_PORT       GPIOH
+#endif
+
+static void Test_Order(void)
+{
+    static const uint8_t expect[] = { 13, 9, 7, 5 };
+
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_5, Trace_OnEdge);
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_7, Trace_OnEdge);
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_9, Trace_OnEdge);
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_13, Trace_OnEdge);
+
+#if !defined(__arm__)
+    g_ram_port.IDR = GPIO_PIN_MASK(GPIO_PIN_NO_7) | GPIO_PIN_MASK(GPIO_PIN_NO_13);
+#endif
+    Trace_Reset();
+    GPIO_EXTI_Service(GPIO_EXTI_LINE(5) | GPIO_EXTI_LINE(7) | GPIO_EXTI_LINE(9) | GPIO_EXTI_LINE(13));
+
+    Check(Trace_Is(expect, sizeof(expect)), "lines served highest first");
+#if !defined(__arm__)
+    Check(g_trace.level[0] == 1 && g_trace.level[1] == 0 &&
+          g_trace.level[2] == 1 && g_trace.level[3] == 0, "callbacks get the pin level");
+#endif
+    UART_Printf("[EXTI] order: %u %u %u %u\r\n", g_trace.line[0], g_trace.line[1],
+                g_trace.line[2], g_trace.line[3]);
+}
+
+static void Test_Stats(void)
+{
+    const GPIO_EXTIStats_t *s7 = GPIO_EXTI_GetStats(7);
+    const GPIO_EXTIStats_t *s8 = GPIO_EXTI_GetStats(8);
+
+    GPIO_EXTI_ResetStats();
+    GPIO_EXTI_SetClock(Test_Clock);
+
+    g_clock = 1000;
+    GPIO_EXTI_Service(GPIO_EXTI_LINE(7));
+    g_clock = 2500;
+    GPIO_EXTI_Service(GPIO_EXTI_LINE(7) | GPIO_EXTI_LINE(8));     // 8 has no callback
+
+    Check(s7->Hits == 2 && s7->Unhandled == 0, "hits counted");
+    Check(s7->LastTime == 2500, "last edge timestamped");
+    Check(s8->Hits == 1 && s8->Unhandled == 1 && s8->LastTime == 2500, "edge without a callback counted as unhandled");
+    Check(GPIO_EXTI_GetStats(GPIO_EXTI_LINE_COUNT) == NULL, "no stats for an invalid line");
+
+    GPIO_EXTI_ResetStats();
+    Check(s7->Hits == 0 && s8->Unhandled == 0 && s7->LastTime == 0, "stats reset");
+    GPIO_EXTI_SetClock(NULL);
+}
+
+static void Test_Detach(void)
+{
+    const GPIO_EXTIStats_t *s9 = GPIO_EXTI_GetStats(9);
+
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_9, NULL);
+    Trace_Reset();
+    GPIO_EXTI_Service(GPIO_EXTI_LINE(9) | GPIO_EXTI_LINE(22));       // 22: RTC wakeup, not a GPIO line
+
+    Check(g_trace.count == 0, "detached line calls nothing");
+    Check(s9->Unhandled == 1, "detached line counted as unhandled");
+    GPIO_EXTI_Attach(TEST_PORT, GPIO_PIN_NO_9, Trace_OnEdge);
+    GPIO_EXTI_ResetStats();
+}
+
+/* ===== INTERRUPTS (target only) ===== */
+#if defined(__arm__)
+static volatile uint32_t g_entries;
+static volatile uint8_t g_retrigger;    // line a callback pends once more
+
+void EXTI9_5_IRQHandler(void)
+{
+    g_entries++;
+    GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_9_5);
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+    g_entries++;
+    GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_15_10);
+}
+
+static void Retrigger_OnEdge(uint8_t line, uint8_t level)
+{
+    Trace_OnEdge(line, level);
+    if (g_retrigger == line) {
+        g_retrigger = 0xFF;
+        EXTI->SWIER = GPIO_EXTI_LINE(line);     // pends again while the vector runs
+    }
+}
+
+/* Pends `lines` in one store, returns the cycles to the last callback */
+static uint32_t Fire(uint32_t lines)
+{
+    uint32_t t0;
+
+    g_entries = 0;
+    Trace_Reset();
+    t0 = Prof_Now();
+    EXTI->SWIER = lines;
+    __asm volatile ("dsb\n isb");
+    return g_trace.lastCycles - t0;
+}
+
+static void Test_Interrupts(void)
+{
+    static const uint8_t shared[] = { 9, 8, 7, 6, 5 };
+    static const uint8_t twice[] = { 7, 7 };
+    uint32_t one, five;
+
+    for (uint8_t line = 5; line <= 9; line++) {
+        GPIO_EXTI_Register(GPIOH, line, GPIO_MODE_IT_RFT, Trace_OnEdge);
+    }
+    GPIO_EXTI_Register(GPIOH, GPIO_PIN_NO_14, GPIO_MODE_IT_FT, Trace_OnEdge);
+
+    one = Fire(GPIO_EXTI_LINE(14));
+    Check(g_entries == 1 && g_trace.count == 1 && g_trace.line[0] == 14, "one line, one interrupt");
+
+    five = Fire(GPIO_EXTI_LINES_9_5);
+    Check(Trace_Is(shared, sizeof(shared)), "shared vector: all five lines, highest first");
+    Check(g_entries == 1, "shared vector: one interrupt for five lines");
+    Check((EXTI->PR & (GPIO_EXTI_LINES_9_5 | GPIO_EXTI_LINE(14))) == 0, "pending bits cleared");
+
+    GPIO_EXTI_Attach(GPIOH, GPIO_PIN_NO_7, Retrigger_OnEdge);
+    g_retrigger = 7;
+    Fire(GPIO_EXTI_LINE(7));
+    Check(Trace_Is(twice, sizeof(twice)) && g_entries == 2, "edge during the callback served by the next interrupt");
+    GPIO_EXTI_Attach(GPIOH, GPIO_PIN_NO_7, Trace_OnEdge);
+
+    GPIO_EXTI_Unregister(GPIO_PIN_NO_14);
+    Fire(GPIO_EXTI_LINE(14));
+    Check(g_entries == 0 && g_trace.count == 0, "unregistered line does not interrupt");
+
+    Check(GPIO_EXTI_GetStats(5)->Hits == 1 && GPIO_EXTI_GetStats(7)->Hits == 3, "hits of the interrupts");
+
+    for (uint8_t line = 5; line <= 9; line++) {
+        GPIO_EXTI_Unregister(line);
+    }
+    UART_Printf("[EXTI] SWIER to last callback: 1 line %u cycles, 5 lines %u cycles\r\n",
+                (unsigned)one, (unsigned)five);
+}
+#endif
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+#if defined(__arm__)
+    GPIO_PeriClockControl(GPIOH, ENABLE);
+#endif
+
+    UART_Printf("\r\n===== 052 EXTI Dispatch =====\r\n");
+
+    Test_Order();
+    Test_Stats();
+    Test_Detach();
+#if defined(__arm__)
+    Test_Interrupts();
+#endif
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
@@ -0,0 +1,435 @@
+/*
+ * 053_keypad_engine.c
+ *
+ * Created on: Mar 10, 2026
+ * Author: Rahul B.
+ * Description: Timer driven keypad scanning (bsp_keypad.c, TIM3) - debounce, events, latency, scan cost
+ *
+ * Scan patterns are fed to the debounce engine with Keypad_Feed(), one per
+ * scan period, and compared with the polled scanner it replaces (key on
+ * the first scan that sees it, release after two idle scans):
+ *
+ *   press         clean press and release: one PRESS, one RELEASE, and
+ *                 Keypad_AnyKeyDown() follows the engine in between
+ *   bounce        contact bounce on both edges: still one of each
+ *                 (the polled scanner reported the key twice)
+ *   glitch        a one-scan spike is no key (the polled scanner took it)
+ *   long          held: LONG after KEYPAD_LONG_PRESS_MS, then REPEATs
+ *   rollover      two keys at once, released apart: four events
+ *   getkey        Keypad_GetKey() returns presses only, injected key first
+ *   flush         keys held at Keypad_Flush() report nothing
+ *   overflow      a full queue drops and counts, nothing is overwritten
+ *   latency       contact to PRESS for every phase of the contact against
+ *                 the scans: at most KEYPAD_LATENCY_MAX_US (host only)
+ *
+ * and on the target, with the TIM3 interrupt enabled:
+ *
+ *   timer         no key down: the timer stops and no scan runs; a row
+ *                 edge (EXTI->SWIER) starts one scan of
+ *                 KEYPAD_SCAN_PERIOD_MS, then the timer stops again
+ *   cost          idle scan (one read) and full scan (four rows) against
+ *                 the polled scanner, in CPU cycles
+ *
+ * Host build: link bsp_keypad.c and profiler.c, UART_Printf mapped to
+ * printf and app_init() stubbed out; the clock, BSP_Delay_us and the GPIO,
+ * EXTI and timer calls of the driver are provided here.
+ *
+ * Results are printed on USART2 (115200 8N1). On the target keep the keypad
+ * untouched while the test runs.
+ */
+
+#include "bsp_init.h"
+#include "bsp_keypad.h"
+#include "bsp_timebase.h"
+#include "bsp_delay.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "stm32f446xx_timer_driver.h"
+#include "config.h"
+#include "profiler.h"
+#include "test_check.h"
+#include <string.h>
+
+#define SCAN_US         (KEYPAD_SCAN_PERIOD_MS * 1000U)
+#define LONG_SCANS      (KEYPAD_LONG_PRESS_MS / KEYPAD_SCAN_PERIOD_MS)
+#define REPEAT_SCANS    (KEYPAD_REPEAT_MS / KEYPAD_SCAN_PERIOD_MS)
+
+#define KEY_1           KEYPAD_KEY_BIT(0, 0)
+#define KEY_5           KEYPAD_KEY_BIT(1, 1)
+#define KEY_7           KEYPAD_KEY_BIT(2, 0)
+#define KEY_9           KEYPAD_KEY_BIT(2, 2)
+#define KEY_A           KEYPAD_KEY_BIT(0, 3)
+#define KEY_0           KEYPAD_KEY_BIT(3, 1)
+#define KEY_HASH        KEYPAD_KEY_BIT(3, 2)
+
+/* ===== HOST PLATFORM ===== */
+#if !defined(__arm__)
+static uint64_t g_nowUs = 0;
+
+uint64_t now_us(void) { return g_nowUs; }
+void BSP_Delay_us(uint32_t us) { g_nowUs += us; }
+
+void GPIO_InitGroup(const GPIO_Handle_t *pPins, uint8_t Count) { (void)pPins; (void)Count; }
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask) { (void)pGPIOx; (void)PinMask; }
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask) { (void)pGPIOx; (void)PinMask; }
+void GPIO_EXTI_Register(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Trigger, GPIO_EXTICallback_t Callback) { (void)pGPIOx; (void)PinNumber; (void)Trigger; (void)Callback; }
+void GPIO_EXTI_Unregister(uint8_t Line) { (void)Line; }
+
+void TIMER_PeriodicInit(TIM_RegDef_t *pTIMx, uint32_t TickHz, uint16_t Ticks) { (void)pTIMx; (void)TickHz; (void)Ticks; }
+void TIMER_Enable(TIM_RegDef_t *pTIMx) { (void)pTIMx; }
+void TIMER_Disable(TIM_RegDef_t *pTIMx) { (void)pTIMx; }
+void TIMER_SetCounter(TIM_RegDef_t *pTIMx, uint32_t Counter) { (void)pTIMx; (void)Counter; }
+void TIMER_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority) { (void)IRQNumber; (void)IRQPriority; }
+void TIMER_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi) { (void)IRQNumber; (void)EnorDi; }
+uint8_t TIMER_GetFlagStatus(TIM_RegDef_t *pTIMx, uint16_t TIMER_FLAG) { (void)pTIMx; (void)TIMER_FLAG; return FLAG_RESET; }
+void TIMER_ClearFlag(TIM_RegDef_t *pTIMx, uint16_t TIMER_FLAG) { (void)pTIMx; (void)TIMER_FLAG; }
+
+static void Clock_Advance(uint32_t us) { g_nowUs += us; }
+#else
+static void Clock_Advance(uint32_t us) { (void)us; }
+#endif
+
+/* ===== SCANS ===== */
+
+/* One scan period with `keys` down */
+static void Scan(uint16_t keys)
+{
+    Clock_Advance(SCAN_US);
+    Keypad_Feed(keys);
+}
+
+static void Hold(uint16_t keys, uint32_t scans)
+{
+    for (uint32_t i = 0; i < scans; i++) Scan(keys);
+}
+
+/* Scans of a string pattern: '1' key down, '0' key up */
+static void Pattern(uint16_t keys, const char *pattern)
+{
+    for (; *pattern; pattern++) Scan((*pattern == '1') ? keys : 0U);
+}
+
+/* Drains the queue into `out`, returns the number of events */
+static uint8_t Drain(KeypadEvent_t *out, uint8_t max)
+{
+    KeypadEvent_t evt;
+    uint8_t n = 0;
+
+    while (Keypad_GetEvent(&evt)) {
+        if (n < max) out[n] = evt;
+        n++;
+    }
+    return n;
+}
+
+static bool Event_Is(const KeypadEvent_t *evt, char key, KeypadEventType_t type)
+{
+    return evt->key == key && evt->type == (uint8_t)type;
+}
+
+/* ===== OLD PATH: the polled scanner before the engine ===== */
+static uint16_t g_oldHeld;
+static uint8_t g_oldReleaseCount;
+
+/* Keys the old Keypad_GetKey() would have returned for this scan (0 or 1) */
+static uint8_t Old_Scan(uint16_t keys)
+{
+    uint16_t key = keys & (uint16_t)-keys;      // it stopped at the first key found
+
+    if (key == 0) {
+        if (g_oldHeld != 0 && ++g_oldReleaseCount >= 2) g_oldHeld = 0;
+        return 0;
+    }
+    g_oldReleaseCount = 0;
+    if (key == g_oldHeld) return 0;
+    g_oldHeld = key;
+    return 1;
+}
+
+static uint8_t Old_Pattern(uint16_t keys, const char *pattern)
+{
+    uint8_t presses = 0;
+
+    g_oldHeld = 0;
+    g_oldReleaseCount = 0;
+    for (; *pattern; pattern++) presses += Old_Scan((*pattern == '1') ? keys : 0U);
+    return presses;
+}
+
+/* ===== TESTS ===== */
+static void Test_Press(void)
+{
+    KeypadEvent_t ev[4];
+    uint8_t n;
+
+    Hold(KEY_5, KEYPAD_DEBOUNCE_SCANS - 1U);
+    Check(Drain(ev, 4) == 0, "press: nothing before the debounce time");
+    Hold(KEY_5, 1);
+    n = Drain(ev, 4);
+    Check(n == 1 && Event_Is(&ev[0], '5', KEYPAD_EVT_PRESS) && ev[0].heldMs == 0, "press: PRESS after the debounce time");
+
+    Hold(KEY_5, 20);
+    Check(Keypad_AnyKeyDown(), "press: any key down while held");
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    Check(!Keypad_AnyKeyDown(), "press: no key down once released");
+    n = Drain(ev, 4);
+    Check(n == 1 && Event_Is(&ev[0], '5', KEYPAD_EVT_RELEASE), "press: one RELEASE");
+    Check(n == 1 && ev[0].heldMs == (20U + KEYPAD_DEBOUNCE_SCANS) * KEYPAD_SCAN_PERIOD_MS, "press: release tells the hold time");
+}
+
+static void Test_Bounce(void)
+{
+    // Bouncing contact, held, then bouncing open
+    static const char pattern[] = "1001011111111111111101100000000";
+    KeypadEvent_t ev[8];
+    uint8_t n, oldPresses;
+
+    Pattern(KEY_1, pattern);
+    n = Drain(ev, 8);
+    oldPresses = Old_Pattern(KEY_1, pattern);
+
+    Check(n == 2 && Event_Is(&ev[0], '1', KEYPAD_EVT_PRESS) && Event_Is(&ev[1], '1', KEYPAD_EVT_RELEASE),
+          "bounce: one PRESS, one RELEASE");
+    Check(oldPresses > 1, "bounce: the polled scanner doubled the key");
+    UART_Printf("[KEYPAD] bounce: polled scanner %u presses, engine 1\r\n", (unsigned)oldPresses);
+}
+
+static void Test_Glitch(void)
+{
+    static const char pattern[] = "000100000";
+    KeypadEvent_t ev[4];
+    uint8_t oldPresses;
+
+    Pattern(KEY_9, pattern);
+    oldPresses = Old_Pattern(KEY_9, pattern);
+
+    Check(Drain(ev, 4) == 0, "glitch: a one-scan spike is no key");
+    Check(oldPresses == 1, "glitch: the polled scanner took it");
+}
+
+static void Test_Long(void)
+{
+    KeypadEvent_t ev[8];
+    uint8_t n;
+
+    Hold(KEY_A, KEYPAD_DEBOUNCE_SCANS + LONG_SCANS + 2U * REPEAT_SCANS);
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    n = Drain(ev, 8);
+
+    Check(n == 5, "long: five events");
+    Check(Event_Is(&ev[0], 'A', KEYPAD_EVT_PRESS) && Event_Is(&ev[1], 'A', KEYPAD_EVT_LONG) &&
+          Event_Is(&ev[2], 'A', KEYPAD_EVT_REPEAT) && Event_Is(&ev[3], 'A', KEYPAD_EVT_REPEAT) &&
+          Event_Is(&ev[4], 'A', KEYPAD_EVT_RELEASE), "long: PRESS, LONG, REPEAT, REPEAT, RELEASE");
+    Check(ev[1].heldMs == KEYPAD_LONG_PRESS_MS && ev[3].heldMs == KEYPAD_LONG_PRESS_MS + 2U * KEYPAD_REPEAT_MS,
+          "long: LONG and REPEAT on time");
+#if !defined(__arm__)
+    Check(ev[2].tick - ev[1].tick == KEYPAD_REPEAT_MS * 1000U, "long: repeat period");
+#endif
+}
+
+static void Test_Rollover(void)
+{
+    KeypadEvent_t ev[8];
+    uint8_t n;
+
+    Hold(KEY_1 | KEY_HASH, 10);
+    Hold(KEY_1, 10);
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    n = Drain(ev, 8);
+
+    Check(n == 4, "rollover: four events");
+    Check(Event_Is(&ev[0], '#', KEYPAD_EVT_PRESS) && Event_Is(&ev[1], '1', KEYPAD_EVT_PRESS) &&
+          Event_Is(&ev[2], '#', KEYPAD_EVT_RELEASE) && Event_Is(&ev[3], '1', KEYPAD_EVT_RELEASE),
+          "rollover: both keys pressed, released apart");
+}
+
+static void Test_GetKey(void)
+{
+    Hold(KEY_7, 10);
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    Keypad_InjectKey('3');
+
+    Check(Keypad_GetKey() == '3', "getkey: injected key first");
+    Check(Keypad_GetKey() == '7', "getkey: then the press");
+    Check(Keypad_GetKey() == KEYPAD_NO_KEY, "getkey: the release is skipped");
+}
+
+static void Test_Flush(void)
+{
+    KeypadEvent_t ev[4];
+    uint8_t n;
+
+    Hold(KEY_0, 10);
+    Keypad_Flush();
+    Check(Drain(ev, 4) == 0, "flush: queue emptied");
+
+    Hold(KEY_0, LONG_SCANS);
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    Check(Drain(ev, 4) == 0, "flush: the held key reports nothing, not even its release");
+
+    Hold(KEY_0, KEYPAD_DEBOUNCE_SCANS);
+    Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    n = Drain(ev, 4);
+    Check(n == 2 && Event_Is(&ev[0], '0', KEYPAD_EVT_PRESS), "flush: the next press is reported");
+}
+
+static void Test_Overflow(void)
+{
+    const KeypadStats_t *st = Keypad_GetStats();
+    KeypadEvent_t ev[KEYPAD_QUEUE_SIZE + 4U];
+    uint32_t dropped = st->dropped;
+    uint8_t n;
+
+    // Twelve press / release pairs, nobody reading
+    for (uint8_t i = 0; i < 12; i++) {
+        Hold(KEY_5, KEYPAD_DEBOUNCE_SCANS);
+        Hold(0, KEYPAD_DEBOUNCE_SCANS);
+    }
+    n = Drain(ev, sizeof(ev) / sizeof(ev[0]));
+
+    Check(n == KEYPAD_QUEUE_SIZE, "overflow: the queue holds KEYPAD_QUEUE_SIZE events");
+    Check(st->dropped - dropped == 24U - KEYPAD_QUEUE_SIZE, "overflow: the rest is counted as dropped");
+    Check(Event_Is(&ev[0], '5', KEYPAD_EVT_PRESS) && Event_Is(&ev[KEYPAD_QUEUE_SIZE - 1U], '5', KEYPAD_EVT_RELEASE),
+          "overflow: the oldest events are kept");
+}
+
+#if !defined(__arm__)
+/* Contact at every phase against the scans, 250 us apart */
+static void Test_Latency(void)
+{
+    KeypadEvent_t ev[4];
+    uint32_t worst = 0, best = 0xFFFFFFFFU;
+
+    for (uint32_t phase = 0; phase < SCAN_US; phase += 250U) {
+        uint64_t contact = g_nowUs + phase + 1U;
+
+        // Scans go on every SCAN_US; the first one after the contact sees it
+        while (Drain(ev, 4) == 0) Scan((g_nowUs + SCAN_US >= contact) ? KEY_5 : 0U);
+
+        uint32_t us = ev[0].tick - (uint32_t)contact;
+        if (us > worst) worst = us;
+        if (us < best) best = us;
+        Hold(0, KEYPAD_DEBOUNCE_SCANS);
+        Drain(ev, 4);
+    }
+
+    Check(worst <= KEYPAD_LATENCY_MAX_US, "latency: within KEYPAD_LATENCY_MAX_US");
+    Check(Keypad_GetStats()->maxDebounceUs == (KEYPAD_DEBOUNCE_SCANS - 1U) * SCAN_US, "latency: debounce time as configured");
+    UART_Printf("[KEYPAD] key -> event: %u..%u us (bound %u us); polled scanner: up to %u us, no debounce\r\n",
+                (unsigned)best, (unsigned)worst, (unsigned)KEYPAD_LATENCY_MAX_US, (unsigned)(FSM_TASK_PERIOD_MS * 1000U));
+}
+#endif
+
+/* ===== TARGET: TIMER AND SCAN COST ===== */
+#if defined(__arm__)
+static const uint8_t g_rows[4] = { KEYPAD_R0_PIN, KEYPAD_R1_PIN, KEYPAD_R2_PIN, KEYPAD_R3_PIN };
+static const uint8_t g_cols[4] = { KEYPAD_C0_PIN, KEYPAD_C1_PIN, KEYPAD_C2_PIN, KEYPAD_C3_PIN };
+
+/* The polled scan: rows one at a time, a settle loop, a read per column */
+static uint32_t Old_FullScan(void)
+{
+    uint32_t t0 = Prof_Now();
+    volatile char found = KEYPAD_NO_KEY;
+
+    for (uint8_t row = 0; row < 4; row++) {
+        GPIO_WriteMaskedFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK, KEYPAD_ROW_MASK & (uint16_t)~GPIO_PIN_MASK(g_rows[row]));
+        Keypad_Delay(1);
+        for (uint8_t col = 0; col < 4; col++) {
+            if (GPIO_ReadFromInputPin(KEYPAD_COL_PORT, g_cols[col]) == GPIO_PIN_RESET) found = '?';
+        }
+    }
+    GPIO_ResetPinsFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+    (void)found;
+    return Prof_Now() - t0;
+}
+
+/* The engine's scan with a key down: rows in one write, columns in one
+ * read; a row settles for a tick between its write and its read, which
+ * costs nothing here */
+static uint32_t New_FullScan(void)
+{
+    uint32_t t0 = Prof_Now();
+    volatile uint16_t keys = 0;
+
+    for (uint8_t row = 0; row < 4; row++) {
+        GPIO_WriteMaskedFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK, KEYPAD_ROW_MASK & (uint16_t)~GPIO_PIN_MASK(g_rows[row]));
+        keys |= (uint16_t)(((~KEYPAD_COL_PORT->IDR >> KEYPAD_C0_PIN) & 0xFU) << (row * 4U));
+    }
+    GPIO_ResetPinsFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+    return Prof_Now() - t0;
+}
+
+/* Parked, the keypad wakes on the row lines; main.c serves them in the app */
+void EXTI0_IRQHandler(void)
+{
+    GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(KEYPAD_R0_PIN));
+}
+
+static void Test_Timer(void)
+{
+    const KeypadStats_t *st = Keypad_GetStats();
+    const ProfZoneData_t *zone = Prof_GetZone(PROF_ZONE_KEYPAD_SCAN);
+    uint32_t idleScans, oldCycles, newCycles;
+
+    // The scan left pending since Keypad_Init() finds no key and parks
+    TIMER_IRQInterruptConfig(KEYPAD_TIMER_IRQ, ENABLE);
+    BSP_Delay_ms(2U * KEYPAD_SCAN_PERIOD_MS);
+    Prof_Reset();
+    Keypad_ResetStats();
+
+    BSP_Delay_ms(500);
+    idleScans = st->scans;
+    Check(idleScans == 0 && !Keypad_IsScanning() && (KEYPAD_TIMER->CR1 & 0x1U) == 0,
+          "timer: stopped while no key is down");
+
+    // A row edge, as a key would give it
+    EXTI->SWIER = GPIO_EXTI_LINE(KEYPAD_R0_PIN);
+    __asm volatile ("dsb\n isb");
+    Check(Keypad_IsScanning(), "timer: a row edge starts the scan");
+    BSP_Delay_ms(KEYPAD_SCAN_PERIOD_MS + 2U);
+    Check(st->scans == 1 && st->fullScans == 0 && !Keypad_IsScanning(),
+          "timer: one idle scan, then stopped again");
+    Check(!Keypad_AnyKeyDown(), "timer: no key down");
+    TIMER_IRQInterruptConfig(KEYPAD_TIMER_IRQ, DISABLE);
+
+    __asm volatile ("cpsid i");
+    oldCycles = Old_FullScan();
+    newCycles = New_FullScan();
+    __asm volatile ("cpsie i");
+    Check(newCycles < oldCycles, "full scan cheaper than the polled one");
+
+    UART_Printf("[KEYPAD] idle: %u scans in 500 ms; tick max %u cycles; full scan %u cycles (polled scanner %u)\r\n",
+                (unsigned)idleScans, (unsigned)zone->maxTicks, (unsigned)newCycles, (unsigned)oldCycles);
+}
+#endif
+
+int main(void)
+{
+    app_init();
+    Prof_Init();
+    Keypad_Init();
+    // The engine is fed by hand below; the scan interrupt stays off meanwhile
+    TIMER_IRQInterruptConfig(KEYPAD_TIMER_IRQ, DISABLE);
+
+    UART_Printf("\r\n===== 053 Keypad Engine =====\r\n");
+
+    Test_Press();
+    Test_Bounce();
+    Test_Glitch();
+    Test_Long();
+    Test_Rollover();
+    Test_GetKey();
+    Test_Flush();
+    Test_Overflow();
+#if !defined(__arm__)
+    Test_Latency();
+#else
+    Test_Timer();
+#endif
+
+    Test_Summary();
+
+#if defined(__arm__)
+    while (1);
+#endif
+    return g_failures;
+}
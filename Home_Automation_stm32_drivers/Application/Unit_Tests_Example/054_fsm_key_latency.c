@@ -0,0 +1,254 @@
+/*
+ * 054_fsm_key_latency.c
+ *
+ * Created on: Mar 11, 2026
+ * Author: Rahul B.
+ * Description: Keypress-to-handled latency of the application FSM, host build
+ *
+ * The host counterpart of 031: the real tasks and state tables
+ * (state_machine.c, state_handlers.c) run on the real scheduler, soft
+ * timers and event queue against a clock that only the test moves. Keys
+ * are injected at a different phase of the FSM period each time, then the
+ * clock advances 1 ms per dispatcher pass until the key is consumed and
+ * the FSM is in the expected state.
+ *
+ * Pass criterion: latency <= one period of the "fsm" task in the state the
+ * key arrives in (FSM_TASK_PERIOD_MS, STANDBY_FSM_PERIOD_MS in STANDBY).
+ * Tasks take no time on the clock here, so nothing else can stretch it.
+ *
+ * The walk covers every state the keypad reaches: STANDBY, AUTH, MENU,
+ * SENSOR_MONITOR, CONTROL_DEVICES, SETTINGS and LOCKOUT, plus the
+ * inactivity timeout out of SETTINGS and the re-login back into it.
+ *
+ * Host build: link state_machine.c, state_handlers.c, fsm.c, scheduler.c,
+ * soft_timer.c, event_queue.c, latency.c and profiler.c, UART_Printf
+ * mapped to printf and app_init() stubbed out. The keypad, the clock and
+ * the drivers below the FSM (LEDs, displays, buzzer, idle) are provided
+ * here. On the target use 031.
+ *
+ * Results are printed on stdout.
+ */
+
+#include "bsp_init.h"
+#include "state_machine.h"
+#include "scheduler.h"
+#include "bsp_keypad.h"
+#include "bsp_led.h"
+#include "bsp_buzzer.h"
+#include "bsp_relay.h"
+#include "bsp_lcd.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_delay.h"
+#include "bsp_timebase.h"
+#include "console.h"
+#include "idle.h"
+#include "config.h"
+#include "test_check.h"
+#include <string.h>
+
+#if defined(__arm__)
+#error "054 is a host test, use 031 on the target"
+#endif
+
+static uint32_t g_worst_ms = 0;
+
+/* ===== CLOCK ===== */
+static uint64_t g_nowUs = 0;
+
+uint64_t now_us(void) { return g_nowUs; }
+uint64_t now_ms(void) { return g_nowUs / 1000U; }
+uint32_t now_us32(void) { return (uint32_t)g_nowUs; }
+void BSP_Delay_1s(void) { g_nowUs += 1000000U; }
+
+/* ===== KEYPAD ===== */
+static char g_key = KEYPAD_NO_KEY;
+
+void Keypad_InjectKey(char key) { g_key = key; }
+bool Keypad_InjectPending(void) { return g_key != KEYPAD_NO_KEY; }
+bool Keypad_AnyKeyDown(void) { return false; }
+void Keypad_Flush(void) { }
+
+char Keypad_GetKey(void)
+{
+    char key = g_key;
+
+    g_key = KEYPAD_NO_KEY;
+    return key;
+}
+
+/* ===== BELOW THE FSM ===== */
+void BSP_LED_On(uint8_t PinNumber) { (void)PinNumber; }
+void BSP_LED_Off(uint8_t PinNumber) { (void)PinNumber; }
+void BSP_LED_Toggle(uint8_t pinNumber) { (void)pinNumber; }
+void BSP_LED_AllOff(void) { }
+void BSP_Buzzer_On(void) { }
+void BSP_Buzzer_Off(void) { }
+void BSP_Relay_SetAll(uint8_t state) { (void)state; }
+void BSP_Relay_SetState(uint8_t relay_pin, uint8_t state) { (void)relay_pin; (void)state; }
+void BSP_Relay_Toggle(uint8_t relay_pin) { (void)relay_pin; }
+void BSP_LCD_SetLine(uint8_t row, const char *text) { (void)row; (void)text; }
+void BSP_LCD_WriteAt(uint8_t row, uint8_t col, const char *text) { (void)row; (void)col; (void)text; }
+void BSP_LCD_Flush(void) { }
+void BSP_OLED_PrintString(uint8_t x, uint8_t y, char *str) { (void)x; (void)y; (void)str; }
+void BSP_OLED_Update(void) { }
+
+uint8_t GPIO_ReadFromInputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber) { (void)pGPIOx; (void)PinNumber; return 1; }
+void GPIO_WriteToOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Value) { (void)pGPIOx; (void)PinNumber; (void)Value; }
+void GPIO_EXTI_Attach(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, GPIO_EXTICallback_t Callback) { (void)pGPIOx; (void)PinNumber; (void)Callback; }
+void GPIO_EXTI_SetClock(uint32_t (*pNow)(void)) { (void)pNow; }
+const GPIO_EXTIStats_t *GPIO_EXTI_GetStats(uint8_t Line) { static GPIO_EXTIStats_t s; (void)Line; return &s; }
+uint8_t I2C_CheckDevice(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddr) { (void)pI2Cx; (void)SlaveAddr; return 0; }
+
+void Idle_SetStopAllowed(bool allowed) { (void)allowed; }
+void Idle_ResetStats(void) { }
+void Idle_PrintStats(void) { }
+void Console_Init(void) { }
+void Device_Init(void) { }
+void Device_PlayBuzzer(BuzzerPattern_t pattern) { (void)pattern; }
+void Sensors_Init(void) { }
+void Display_Init(void) { }
+void Display_RequestRefresh(void) { }
+void Display_ClaimOLED(bool claimed) { (void)claimed; }
+void Display_UpdateOLED(void) { }
+void Display_UpdateLCD(void) { }
+void Display_ClearAll(void) { }
+void update_lcd_display(const char *line1, const char *line2) { (void)line1; (void)line2; }
+void print_Log(const char *format, ...) { (void)format; }
+
+PT_THREAD(greet(Pt_t *pt))
+{
+    PT_BEGIN(pt);
+    PT_END(pt);
+}
+
+/* ===== HELPERS ===== */
+
+/**
+ * @brief Period of the "fsm" task right now
+ */
+static uint32_t Fsm_PeriodMs(void)
+{
+    for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+        const Task_t *t = Scheduler_GetTask(id);
+        if (t->used && strcmp(t->name, "fsm") == 0) return t->period;
+    }
+    return 0;
+}
+
+static void Run_For_Ms(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++) {
+        g_nowUs += 1000U;
+        Scheduler_Dispatch();
+    }
+}
+
+/**
+ * @brief Inject one key and run the dispatcher until it is handled
+ */
+static void Expect(const char *what, char key, SystemState_t expected)
+{
+    static uint32_t step = 0;
+    uint32_t bound = Fsm_PeriodMs();
+    uint32_t latency = 0;
+
+    // Land the key at a different point of the FSM period every time
+    Run_For_Ms((step++ * 7U) % bound);
+
+    Keypad_InjectKey(key);
+    Scheduler_Dispatch();
+    while (Keypad_InjectPending() || g_SystemContext.currentState != expected) {
+        if (latency > 2000U) {
+            UART_Printf("  [FAIL] %-24s '%c' timeout (state %d)\r\n", what, key, g_SystemContext.currentState);
+            g_failures++;
+            return;
+        }
+        Run_For_Ms(1);
+        latency++;
+    }
+
+    uint8_t ok = (latency <= bound);
+
+    if (latency > g_worst_ms) g_worst_ms = latency;
+    if (!ok) g_failures++;
+
+    UART_Printf("  [%s] %-24s '%c' %4u ms (bound %3u ms)\r\n",
+                ok ? "PASS" : "FAIL", what, key, latency, bound);
+}
+
+/**
+ * @brief Let the clock run `ms` and check where the FSM ends up
+ */
+static void Expect_After(const char *what, uint32_t ms, SystemState_t expected)
+{
+    Run_For_Ms(ms);
+
+    uint8_t ok = (g_SystemContext.currentState == expected);
+
+    if (!ok) g_failures++;
+    UART_Printf("  [%s] %-24s after %u ms\r\n", ok ? "PASS" : "FAIL", what, ms);
+}
+
+static void Login(void)
+{
+    Expect("STANDBY wake",          '1', STATE_AUTHENTICATING);
+    Expect("AUTH digit 1",          '1', STATE_AUTHENTICATING);
+    Expect("AUTH digit 2",          '2', STATE_AUTHENTICATING);
+    Expect("AUTH digit 3",          '3', STATE_AUTHENTICATING);
+}
+
+int main(void)
+{
+    StateMachine_Init();
+
+    UART_Printf("\r\n===== 054 FSM Key Latency (host) =====\r\n");
+    Run_For_Ms(100);   // settle: first pass of every task
+
+    Login();
+    Expect("AUTH digit 4 -> menu",  '4', STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU select settings",  KEY_ENTER, STATE_SETTINGS);
+    Expect("SETTINGS other key",    '7', STATE_SETTINGS);
+    Expect("SETTINGS back",         KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU up",               KEY_UP, STATE_ACTIVE_MENU);
+    Expect("MENU select control",   KEY_ENTER, STATE_CONTROL_DEVICES);
+    Expect("CONTROL down",          KEY_DOWN, STATE_CONTROL_DEVICES);
+    Expect("CONTROL toggle",        KEY_ENTER, STATE_CONTROL_DEVICES);
+    Expect("CONTROL back",          KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU up",               KEY_UP, STATE_ACTIVE_MENU);
+    Expect("MENU select sensors",   KEY_ENTER, STATE_SENSOR_MONITOR);
+    Expect("SENSOR back",           KEY_BACK, STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU select settings",  KEY_ENTER, STATE_SETTINGS);
+    Expect("SETTINGS logout",       KEY_LOGOUT, STATE_STANDBY);
+
+    /* Inactivity in SETTINGS logs out; the next login resumes it */
+    Login();
+    Expect("AUTH digit 4 -> menu",  '4', STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU down",             KEY_DOWN, STATE_ACTIVE_MENU);
+    Expect("MENU select settings",  KEY_ENTER, STATE_SETTINGS);
+    Expect_After("SETTINGS timeout", SCREEN_TIMEOUT_SEC * 1000U, STATE_STANDBY);
+    Login();
+    Expect("AUTH digit 4 -> resume", '4', STATE_SETTINGS);
+    Expect("SETTINGS logout",       KEY_LOGOUT, STATE_STANDBY);
+
+    /* Four wrong PINs lead to LOCKOUT */
+    Expect("STANDBY wake",          '1', STATE_AUTHENTICATING);
+    for (int attempt = 0; attempt <= MAX_LOGIN_ATTEMPTS; attempt++) {
+        for (int d = 0; d < PIN_LENGTH; d++) {
+            SystemState_t next = (attempt == MAX_LOGIN_ATTEMPTS && d == PIN_LENGTH - 1)
+                                 ? STATE_LOCKOUT : STATE_AUTHENTICATING;
+            Expect("AUTH wrong digit",  '9', next);
+        }
+    }
+    Expect("LOCKOUT key ignored",   '5', STATE_LOCKOUT);
+    Expect_After("LOCKOUT over",    LOCKOUT_TIME_SEC * 1000U, STATE_STANDBY);
+
+    UART_Printf("  worst latency: %u ms\r\n", g_worst_ms);
+    Test_Summary();
+
+    return 0;
+}
@@ -12,11 +12,18 @@
 #include "stm32f446xx.h"
 #include "stm32f446xx_i2c_driver.h"
 #include "stm32f446xx_gpio_driver.h"
+#include "stm32f446xx_dma_driver.h"
+#include "bsp_oled_font.h"
+#include "pt.h"
+#include <stdbool.h>
 
 // --- Configuration ---
 #define OLED_I2C_ADDR       0x3C // 7-bit Address (0x78 if 8-bit)
 #define OLED_WIDTH          128
 #define OLED_HEIGHT         64
+#define OLED_PAGES          (OLED_HEIGHT / 8)
+#define OLED_WINDOW_OVERHEAD 8  // bus bytes to open an address window (addr + 0x00 + 6 cmd bytes)
+#define OLED_MARQUEE_GAP    16  // blank columns between the end of a marquee text and its start
 
 // --- Helper Macros ---
 // Control byte: Co = 0, D/C = 0 -> 0x00 (Command)
@@ -24,17 +31,122 @@
 #define OLED_CONTROL_CMD    0x00
 #define OLED_CONTROL_DATA   0x40
 
+// --- Bus Statistics ---
+// Counted since power-up or BSP_OLED_ResetBusStats()
+typedef struct {
+    uint32_t updates;       // BSP_OLED_Update() calls
+    uint32_t windows;       // address windows sent
+    uint32_t transactions;  // I2C transactions (commands and data)
+    uint32_t bytes;         // bytes on the bus, address byte included
+} OledBusStats_t;
+
+// --- Flush Statistics ---
+// Interrupt driven updates, counted since power-up or BSP_OLED_ResetFlushStats()
+typedef struct {
+    uint32_t started;       // frames put on the bus
+    uint32_t completed;
+    uint32_t coalesced;     // updates folded into a frame that was already queued
+    uint32_t errors;        // frames aborted by a bus error (next one is a full frame)
+    uint32_t lastUs;        // first byte to last byte of a frame
+    uint32_t maxUs;
+} OledFlushStats_t;
+
+// Called from the I2C1/DMA interrupts when a frame is done (ok = false on a bus error)
+typedef void (*OledFlushCallback_t)(bool ok);
+
+// --- Hardware Scroll ---
+// Commands 26h/27h: the panel rotates the band by itself
+typedef enum {
+    OLED_SCROLL_RIGHT = 0x26,
+    OLED_SCROLL_LEFT  = 0x27
+} OledScrollDir_t;
+
+// Panel frames per column step (the 3-bit interval code of 26h/27h)
+typedef enum {
+    OLED_SCROLL_2_FRAMES   = 7,
+    OLED_SCROLL_3_FRAMES   = 4,
+    OLED_SCROLL_4_FRAMES   = 5,
+    OLED_SCROLL_5_FRAMES   = 0,
+    OLED_SCROLL_25_FRAMES  = 6,
+    OLED_SCROLL_64_FRAMES  = 1,
+    OLED_SCROLL_128_FRAMES = 2,
+    OLED_SCROLL_256_FRAMES = 3
+} OledScrollSpeed_t;
+
+// --- Marquee ---
+// Text running right to left through a band of pages, round and round.
+// If the text and OLED_MARQUEE_GAP fit on the screen, the panel scrolls it
+// and nothing goes on the bus until it stops. Otherwise every
+// BSP_OLED_MarqueeStep() shifts the band in the buffer and brings in the
+// next columns; the update then sends only the band.
+typedef struct {
+    const char        *text;
+    const OledFont_t  *font;
+    uint8_t           page;         // top page of the band, font->pages high
+    uint16_t          width;        // text width in columns
+    uint16_t          period;       // software: width + gap, columns before it repeats
+    uint16_t          pos;          // software: columns scrolled, modulo period
+    bool              hardware;
+} OledMarquee_t;
+
 // --- Function Prototypes ---
 
 /* Initializes I2C1 GPIOs and the SSD1306 Display */
 void BSP_OLED_Init(void);
-void greet(void);
+
+/* Boot greeting animation, a protothread (see pt.h) */
+PT_THREAD(greet(Pt_t *pt));
+PT_THREAD(Scroll_Text(Pt_t *pt));
+PT_THREAD(Heart_Beat(Pt_t *pt));
+
 /* Clears the screen buffer (does not update display immediately) */
 void BSP_OLED_Clear(void);
 
-/* Pushes the buffer to the actual OLED screen via I2C */
+/* Pushes the changed parts of the buffer to the OLED via I2C */
 void BSP_OLED_Update(void);
 
+/* Interrupt driven updates: BSP_OLED_Update() returns at once, the buffer
+   is snapshotted and may be drawn into while the frame goes out */
+void BSP_OLED_SetAsync(bool enable);
+void BSP_OLED_WaitIdle(void);
+uint8_t BSP_OLED_FramesInFlight(void);
+void BSP_OLED_SetFlushCallback(OledFlushCallback_t callback);
+const OledFlushStats_t *BSP_OLED_GetFlushStats(void);
+void BSP_OLED_ResetFlushStats(void);
+
+/* Next update sends the whole buffer (panel content unknown, e.g. after a reset) */
+void BSP_OLED_Invalidate(void);
+
+/* Panel scrolls pages startPage..endPage by itself, one column every `speed`
+   frames, wrapping around. Pending drawing is sent first. Until
+   BSP_OLED_StopScroll() the GDDRAM must not be written: updates keep the
+   drawing in the buffer. After the stop the band is sent again. */
+void BSP_OLED_StartScroll(uint8_t startPage, uint8_t endPage, OledScrollDir_t dir, OledScrollSpeed_t speed);
+void BSP_OLED_StopScroll(void);
+bool BSP_OLED_IsScrolling(void);
+
+/* Software scroll: moves the columns of pages startPage..endPage by dx
+   (negative = left); the columns that come in are cleared */
+void BSP_OLED_ShiftBand(uint8_t startPage, uint8_t endPage, int16_t dx);
+
+/* Marquee of str in font with its top at page (see OledMarquee_t); the band
+   is cleared first. speed is used when the panel scrolls it. */
+void BSP_OLED_MarqueeStart(OledMarquee_t *m, uint8_t page, const OledFont_t *font, const char *str, OledScrollSpeed_t speed);
+/* Software marquee: scrolls it by columns (no-op while the panel scrolls) */
+void BSP_OLED_MarqueeStep(OledMarquee_t *m, uint8_t columns);
+void BSP_OLED_MarqueeStop(OledMarquee_t *m);
+
+/* Frame buffer: 8 pages of 128 column bytes, LSB = top row of the page */
+const uint8_t *BSP_OLED_GetFrame(void);
+
+/* For drawing modules (bsp_oled_gfx.c): the frame buffer to draw into,
+   and columns x0..x1 of a page that were drawn there */
+uint8_t *BSP_OLED_GetDrawBuffer(void);
+void BSP_OLED_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1);
+
+const OledBusStats_t *BSP_OLED_GetBusStats(void);
+void BSP_OLED_ResetBusStats(void);
+
 /* Draws a character at x,y */
 void BSP_OLED_DrawChar(uint8_t x, uint8_t y, char c);
 
@@ -51,6 +163,13 @@ void BSP_OLED_PrintString(uint8_t x, uint8_t y, char *str);
 /* Usage: OLED_Printf(0, 0, "Temp: %d", temp_val); */
 void OLED_Printf(uint8_t x, uint8_t y, const char *format, ...);
 
+/* Draws a string in a font (bsp_oled_font.h) with its top row at y;
+   returns the x after the text. Cells are opaque, clipped at the edges */
+uint16_t BSP_OLED_DrawText(uint8_t x, uint8_t y, const OledFont_t *font, const char *str);
+
+/* Usage: OLED_PrintfFont(0, 16, &Font_Digits24, "%02d:%02d", h, m); */
+void OLED_PrintfFont(uint8_t x, uint8_t y, const OledFont_t *font, const char *format, ...);
+
 /* NEW: Function to draw a full bitmap */
 void BSP_OLED_DrawBitmap(const uint8_t *bitmap);
 #endif /* BSP_I2C_OLED_H_ */
@@ -10,12 +10,81 @@
 
 #include "stm32f446xx.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 #define KEYPAD_NO_KEY   '\0'
 
+/* ===== Scan Engine =====
+ * A periodic timer scans the matrix and runs a debounce state machine per
+ * key; the key events wait in a queue for the FSM. Between scans all rows
+ * are driven LOW, so one read of the columns tells whether any key is down.
+ * A scan takes KEYPAD_SCAN_TICKS timer interrupts: the column read, then
+ * one per row, each sampling the row the one before selected.
+ *
+ * With every key up the timer stops: the columns drive LOW instead and a
+ * key pulls its row down, whose falling edge (EXTI lines 0-3, through the
+ * GPIO EXTI registry) starts the timer again. The columns cannot wake it
+ * themselves, line 6 of C2 belongs to IR1 on PC6.
+ */
+#define KEYPAD_TIMER            TIM3
+#define KEYPAD_TIMER_IRQ        TIM3_IRQn
+#define KEYPAD_TIMER_HZ         10000U  // 100 us ticks
+#define KEYPAD_SCAN_PERIOD_MS   5U      // one scan through the debounce engine
+#define KEYPAD_SCAN_TICKS       5U      // timer interrupts per scan: column read, four rows
+#define KEYPAD_DEBOUNCE_SCANS   4U      // equal scans in a row to accept a press or a release
+#define KEYPAD_LONG_PRESS_MS    1000U   // held this long: KEYPAD_EVT_LONG
+#define KEYPAD_REPEAT_MS        200U    // then KEYPAD_EVT_REPEAT at this rate
+#define KEYPAD_QUEUE_SIZE       16U     // events, a power of two
+
+// Timer interrupt period, also the settle time of a row before its read
+#define KEYPAD_TICK_US          (KEYPAD_SCAN_PERIOD_MS * 1000U / KEYPAD_SCAN_TICKS)
+
+// Worst case key-to-event latency: the contact closes right after a column
+// read, the next one sees it, its rows are read over the rest of that scan
+// and KEYPAD_DEBOUNCE_SCANS scans must agree
+#define KEYPAD_LATENCY_MAX_US   ((KEYPAD_SCAN_PERIOD_MS * KEYPAD_DEBOUNCE_SCANS * 1000U) + \
+                                 ((KEYPAD_SCAN_TICKS - 1U) * KEYPAD_TICK_US))
+
+// Bit of a key in a scanned matrix (Keypad_Feed)
+#define KEYPAD_KEY_BIT(row, col)    ((uint16_t)(1U << ((row) * 4U + (col))))
+
+typedef enum {
+    KEYPAD_EVT_PRESS = 0,   // debounced press
+    KEYPAD_EVT_RELEASE,     // debounced release
+    KEYPAD_EVT_LONG,        // held for KEYPAD_LONG_PRESS_MS
+    KEYPAD_EVT_REPEAT       // still held, every KEYPAD_REPEAT_MS after the long press
+} KeypadEventType_t;
+
+/* One queued key event */
+typedef struct {
+    char     key;           // character of the key ('0'..'9', 'A'..'D', '*', '#')
+    uint8_t  type;          // KeypadEventType_t
+    uint16_t heldMs;        // time the key had been down (0 for a press)
+    uint32_t tick;          // low 32 bits of now_us() when posted
+} KeypadEvent_t;
+
+/* Counters of the scan engine (Keypad_GetStats) */
+typedef struct {
+    uint32_t scans;         // scans run through the debounce engine
+    uint32_t fullScans;     // of those, scans that had to drive the rows (a key was down)
+    uint32_t events;        // events put in the queue
+    uint32_t dropped;       // events lost because the queue was full
+    uint32_t maxDebounceUs; // longest first contact seen -> press event
+} KeypadStats_t;
+
 /* ===== Function Prototypes ===== */
 void Keypad_Init(void);
 char Keypad_GetKey(void);
+bool Keypad_GetEvent(KeypadEvent_t *evt);
+bool Keypad_AnyKeyDown(void);
+bool Keypad_IsScanning(void);
+void Keypad_Flush(void);
+void Keypad_Feed(uint16_t keys);
 void Keypad_Delay(uint32_t delay);
+void Keypad_InjectKey(char key);
+bool Keypad_InjectPending(void);
+
+const KeypadStats_t *Keypad_GetStats(void);
+void Keypad_ResetStats(void);
 
 #endif /* INC_STM32F446XX_KEYPAD_H_ */
\ No newline at end of file
@@ -9,6 +9,8 @@
 #ifndef INC_BSP_LCD_H_
 #define INC_BSP_LCD_H_
 
+#include <stdbool.h>
+
 #include "stm32f446xx_gpio_driver.h"
 #include "config.h" // Includes your pin definitions
 
@@ -24,6 +26,35 @@
 #define LCD_CMD_BLINK_ON        0x0F
 #define LCD_CMD_SET_CURSOR      0x80
 
+#define LCD_ROWS                2
+#define LCD_COLS                16
+
+// Interrupt driven transport (BSP_LCD_SetAsync): a one-pulse basic timer
+// steps each byte through its two nibbles and the execution time
+#define LCD_TIMER               TIM6
+#define LCD_TIMER_IRQ           TIM6_DAC_IRQn
+#define LCD_QUEUE_SIZE          64U     // bytes, a power of two
+#define LCD_PULSE_US            2U      // EN high, then EN low (PW_EH 450 ns, t_cycE 1 us)
+#define LCD_EXEC_US             50U     // most instructions and data writes (37 us)
+#define LCD_EXEC_CLEAR_US       2000U   // clear display, return home (1.52 ms)
+
+/* Counters of the byte queue (BSP_LCD_GetQueueStats) */
+typedef struct {
+    uint32_t queued;        // bytes put in the queue
+    uint32_t sent;          // bytes the interrupt finished (execution time included)
+    uint16_t maxDepth;      // most bytes waiting at once
+    uint32_t overruns;      // times a caller found the queue full and waited for room
+} LcdQueueStats_t;
+
+/* Bus counters of the view (BSP_LCD_GetBusStats) */
+typedef struct {
+    uint32_t flushes;       // flushes that had something to send
+    uint32_t clears;        // of those, flushes that started with a clear
+    uint32_t chars;         // characters sent by flushes (gap rewrites included)
+    uint32_t moves;         // cursor moves sent by flushes
+    uint32_t bytes;         // every byte sent to the controller, any path
+} LcdBusStats_t;
+
 /* Initializes GPIOs and LCD controller */
 void BSP_LCD_Init(void);
 
@@ -39,4 +70,46 @@ void BSP_LCD_PrintString(char *message);
 /* Moves cursor to specific row (0/1) and column (0-15) */
 void BSP_LCD_SetCursor(uint8_t row, uint8_t col);
 
+/*
+ * View: a 2x16 buffer of what the screen should show, and a shadow of
+ * what the glass shows now. Screens are written into the view and
+ * BSP_LCD_Flush() sends only the characters that differ, moving the
+ * cursor only over gaps where a move is cheaper than rewriting the
+ * unchanged characters (or clearing first, when that is cheaper still).
+ * Every byte sent through this driver, raw calls included, keeps the
+ * shadow right; text written with the raw calls is overwritten by the
+ * next flush unless the view holds it as well.
+ */
+
+/* Writes text into the view at (row, col); cut at the end of the line */
+void BSP_LCD_WriteAt(uint8_t row, uint8_t col, const char *text);
+
+/* Sets a whole line of the view: text, then spaces to column 15 */
+void BSP_LCD_SetLine(uint8_t row, const char *text);
+
+/* Fills the view with spaces (nothing is sent) */
+void BSP_LCD_ClearView(void);
+
+/* Sends the difference between the view and the glass */
+void BSP_LCD_Flush(void);
+
+/* Forgets what the glass shows: the next flush rewrites every character */
+void BSP_LCD_Invalidate(void);
+
+const LcdBusStats_t *BSP_LCD_GetBusStats(void);
+void BSP_LCD_ResetBusStats(void);
+
+/* Interrupt driven writes: commands and data go into a queue and return at
+   once; the LCD_TIMER interrupt sends them with the timings above. Writers
+   block while the queue is full: the caller sleeps (WFI) until a byte has
+   gone out, up to LCD_EXEC_US per byte past LCD_QUEUE_SIZE (a clear holds
+   LCD_EXEC_CLEAR_US). Nothing is dropped, so do not write from an
+   interrupt. Disabling waits for the queue to drain. The timer is set up
+   by BSP_LCD_Init() from the PCLK1 of that moment. */
+void BSP_LCD_SetAsync(bool enable);
+void BSP_LCD_WaitIdle(void);
+uint16_t BSP_LCD_QueueDepth(void);
+const LcdQueueStats_t *BSP_LCD_GetQueueStats(void);
+void BSP_LCD_ResetQueueStats(void);
+
 #endif /* INC_BSP_LCD_H_ */
@@ -17,5 +17,6 @@ void BSP_LED_Off(uint8_t PinNumber);
 void BSP_LED_Toggle(uint8_t pinNumber);
 
 void BSP_LED_AllOff(void);
+void BSP_LED_SetMask(uint16_t OnMask);
 
 #endif /* INC_BSP_LED_H_ */
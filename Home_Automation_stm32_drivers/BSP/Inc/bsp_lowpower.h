@@ -0,0 +1,62 @@
+/*
+ * bsp_lowpower.h
+ *
+ * Created on: Feb 21, 2026
+ * Author: Rahul B.
+ * Description: Low-power primitives - WFI sleep and Stop mode with timed wakeup
+ *
+ * Two ways to wait for the next deadline, both entered with IRQs masked
+ * (PRIMASK = 1) so the caller's "nothing to do" decision cannot race an
+ * interrupt. A pending, NVIC-enabled interrupt still ends the wait; its
+ * handler runs as soon as the caller unmasks.
+ *
+ *   BSP_LowPower_Sleep() - Sleep mode. SysTick is suppressed and a TIM2
+ *                          compare (CC1) ends the wait. TIM2 keeps
+ *                          counting, so the timebase loses nothing.
+ *   BSP_LowPower_Stop()  - Stop mode (all clocks off, low-power regulator).
+ *                          The RTC wakeup timer on LSI ends the wait; the
+ *                          slept time is measured on the RTC and added to
+ *                          the timebase. The clock tree is switched to HSI
+ *                          before Stop and restored through the RCC driver
+ *                          by BSP_LowPower_RestoreClocks(), before the
+ *                          caller unmasks.
+ *
+ * The GPIO EXTI lines (PC13, PC6, PC8) wake both modes. LSI is calibrated
+ * against TIM2 by BSP_LowPower_Init() (call again to re-calibrate).
+ */
+
+#ifndef INC_BSP_LOWPOWER_H_
+#define INC_BSP_LOWPOWER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "stm32f446xx.h"
+
+/* ===== CONFIGURATION ===== */
+#define LOWPOWER_LSI_CAL_US         20000U  /* LSI calibration window */
+#define LOWPOWER_WUT_DIV            16U     /* RTC wakeup clock = RTCCLK / 16 */
+#define LOWPOWER_STOP_MAX_MS        30000U  /* longest single Stop (16-bit WUTR) */
+
+/**
+ * @brief Outcome of one sleep
+ */
+typedef struct {
+    uint32_t sleptUs;       /* time spent in the low-power mode */
+    uint32_t resumeUs;      /* wake-up to "ready for interrupts", software path */
+    bool     early;         /* ended by an interrupt before the deadline */
+} LowPowerResult_t;
+
+/* ===== INITIALIZATION ===== */
+void BSP_LowPower_Init(void);
+bool BSP_LowPower_StopAvailable(void);     /* RTC running and LSI calibrated */
+uint32_t BSP_LowPower_GetLsiHz(void);
+
+/* ===== SLEEP (call with IRQs masked) ===== */
+LowPowerResult_t BSP_LowPower_Sleep(uint32_t max_us);
+LowPowerResult_t BSP_LowPower_Stop(uint32_t max_ms);
+
+/* Re-enable HSE/PLL after Stop, if they were in use (IRQs still masked) */
+void BSP_LowPower_RestoreClocks(void);
+
+#endif /* INC_BSP_LOWPOWER_H_ */
@@ -0,0 +1,73 @@
+/*
+ * bsp_oled_font.h
+ *
+ * Created on: Feb 28, 2026
+ * Author: Rahul B.
+ * Description: Proportional bitmap fonts for the SSD1306 OLED
+ *
+ * Glyph bitmaps are stored the way the frame buffer is: column by column,
+ * one byte per 8 rows (LSB = top row), `pages` bytes per column. Only the
+ * inked columns are stored; the blank columns before them (xOffset) and
+ * after them (up to advance) are implied. A glyph is drawn opaque: every
+ * column of its cell, blank ones included, is written, so a shorter
+ * number drawn over a longer one leaves nothing behind.
+ *
+ * The tables in bsp_oled_font_data.c are generated from the descriptions
+ * in Tools/fontgen/fonts by Tools/fontgen/fontgen.py - do not edit them,
+ * change the .fnt file and run the generator.
+ */
+
+#ifndef BSP_OLED_FONT_H_
+#define BSP_OLED_FONT_H_
+
+#include <stdint.h>
+
+// --- Font Format ---
+typedef struct {
+    uint16_t offset;        // first byte in the font bitmap
+    uint8_t  width;         // inked columns stored at offset
+    uint8_t  xOffset;       // blank columns before them
+    uint8_t  advance;       // cell width, spacing included (0 = not in the font)
+} OledGlyph_t;
+
+// Kerning pair: cell of `left` is adjusted when `right` follows
+typedef struct {
+    char    left;
+    char    right;
+    int8_t  adjust;         // columns, negative = tighter
+} OledKern_t;
+
+typedef struct {
+    const char        *name;
+    uint8_t           height;       // rows, a multiple of 8
+    uint8_t           pages;        // height / 8 = bytes per column
+    char              first;        // first character of the glyph table
+    char              last;         // last character of the glyph table
+    char              fallback;     // drawn for characters not in the font
+    const OledGlyph_t *glyphs;      // last - first + 1 entries
+    const uint8_t     *bitmap;
+    uint16_t          bitmapSize;
+    const OledKern_t  *kerning;     // sorted by left, then right
+    uint8_t           kernCount;
+} OledFont_t;
+
+// --- Fonts (bsp_oled_font_data.c) ---
+extern const OledFont_t Font_Small8;    // 8 px, ASCII 32-126, same glyphs as Font5x7
+extern const OledFont_t Font_Medium16;  // 16 px, ASCII 32-126, Small8 scaled x2
+extern const OledFont_t Font_Digits24;  // 24 px, "0-9 : . - % +" and space, tabular digits
+
+// --- Metrics ---
+
+/* Glyph of c, the fallback glyph if c is not in the font */
+const OledGlyph_t *OledFont_Glyph(const OledFont_t *font, char c);
+
+/* Kerning between two characters (0 if the pair is not listed) */
+int8_t OledFont_Kerning(const OledFont_t *font, char left, char right);
+
+/* Cell width of c followed by next (kerning applied, next may be '\0') */
+uint8_t OledFont_CellWidth(const OledFont_t *font, char c, char next);
+
+/* Columns BSP_OLED_DrawText() uses for str, kerning and spacing included */
+uint16_t OledFont_TextWidth(const OledFont_t *font, const char *str);
+
+#endif /* BSP_OLED_FONT_H_ */
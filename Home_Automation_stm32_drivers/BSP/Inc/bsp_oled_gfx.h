@@ -0,0 +1,68 @@
+/*
+ * bsp_oled_gfx.h
+ *
+ * Created on: Mar 1, 2026
+ * Author: Rahul B.
+ * Description: 2D primitives and widgets for the SSD1306 OLED frame buffer
+ *
+ * Everything is drawn straight into the frame buffer a byte at a time,
+ * not through BSP_OLED_DrawPixel(). A byte is 8 rows of one column, so a
+ * horizontal span is one masked byte per column and a fill covers whole
+ * bytes (memset) in every page between its first and last. Coordinates
+ * are signed: shapes may hang off any edge and are clipped.
+ *
+ * Nothing is sent until BSP_OLED_Update().
+ */
+
+#ifndef BSP_OLED_GFX_H_
+#define BSP_OLED_GFX_H_
+
+#include "bsp_i2c_oled.h"
+#include <stdint.h>
+
+// --- Colors ---
+typedef enum {
+    OLED_PIXEL_OFF = 0,
+    OLED_PIXEL_ON = 1,
+    OLED_PIXEL_INVERT = 2       // XOR: drawing the same shape twice restores the screen
+} OledColor_t;
+
+// --- Primitives ---
+
+/* Row of w pixels from x,y to the right */
+void BSP_OLED_DrawHLine(int16_t x, int16_t y, int16_t w, OledColor_t color);
+
+/* Column of h pixels from x,y down */
+void BSP_OLED_DrawVLine(int16_t x, int16_t y, int16_t h, OledColor_t color);
+
+/* Outline of the w x h box at x,y (every pixel drawn once, also when inverting) */
+void BSP_OLED_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color);
+
+/* Filled w x h box at x,y */
+void BSP_OLED_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color);
+
+/* Inverts the w x h box at x,y (highlight of a menu item, alarm flash) */
+void BSP_OLED_InvertRect(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/* Bresenham line from x0,y0 to x1,y1, both ends included */
+void BSP_OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, OledColor_t color);
+
+/* Midpoint circle of radius r around cx,cy */
+void BSP_OLED_DrawCircle(int16_t cx, int16_t cy, int16_t r, OledColor_t color);
+
+/* Filled disc: exactly the outline of BSP_OLED_DrawCircle() and its inside */
+void BSP_OLED_FillCircle(int16_t cx, int16_t cy, int16_t r, OledColor_t color);
+
+// --- Widgets ---
+// Both clear their w x h box first. min >= max scales to the values given.
+
+/* Sensor history as a line graph: values[0] (oldest) at the left edge,
+   values[count - 1] at the right, min at the bottom row, max at the top */
+void BSP_OLED_DrawSparkline(int16_t x, int16_t y, int16_t w, int16_t h,
+                            const int16_t *values, uint8_t count, int16_t min, int16_t max);
+
+/* One bar per value, rising from the bottom of the box, 1 column apart */
+void BSP_OLED_DrawBarGraph(int16_t x, int16_t y, int16_t w, int16_t h,
+                           const int16_t *values, uint8_t count, int16_t min, int16_t max);
+
+#endif /* BSP_OLED_GFX_H_ */
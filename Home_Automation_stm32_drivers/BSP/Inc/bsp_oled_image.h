@@ -0,0 +1,77 @@
+/*
+ * bsp_oled_image.h
+ *
+ * Created on: Mar 3, 2026
+ * Author: Rahul B.
+ * Description: Compressed full screen images and animations for the SSD1306 OLED
+ *
+ * An image is one or more 128x64 frames, run length encoded page by page
+ * in the frame buffer layout (one byte per column, LSB = top row):
+ *
+ *   frame   mask byte (bit p = page p follows), then each of those pages
+ *   page    packets until 128 bytes are out, never crossing into the next
+ *             0x00..0x7F  n + 1 literal bytes follow
+ *             0x80..0xFF  the next byte, (n & 0x7F) + 1 times
+ *
+ * Frame 0 has all 8 pages; every later frame only the pages that changed
+ * since the one before, and a last "loop" frame goes back from the final
+ * frame to frame 0. A page is decoded straight into its destination (the
+ * frame buffer or the I2C tx buffer), there is no intermediate copy.
+ *
+ * The tables in bsp_oled_image_data.c are generated from the PBM files in
+ * Tools/imagegen/images by Tools/imagegen/imagegen.py - do not edit them,
+ * change the image and run the generator.
+ */
+
+#ifndef BSP_OLED_IMAGE_H_
+#define BSP_OLED_IMAGE_H_
+
+#include "bsp_i2c_oled.h"
+#include <stdint.h>
+
+// --- Image Format ---
+typedef struct {
+    uint8_t        frameCount;
+    uint16_t       frameMs;     // time each frame is shown (0 = still image)
+    const uint8_t  *data;
+    const uint16_t *frames;     // frameCount + 1 offsets into data, the last is the loop frame
+    uint16_t       size;
+} OledImage_t;
+
+// --- Images (bsp_oled_image_data.c) ---
+extern const OledImage_t Image_Face;    // greeting screen
+extern const OledImage_t Anim_Heart;    // 2 frame heart beat, 200 ms
+
+// --- Animation Player ---
+typedef struct {
+    Pt_t              pt;
+    const OledImage_t *image;
+    uint8_t           frame;    // frame on the screen
+    uint8_t           loops;    // loops left, 0 = forever
+} OledPlayer_t;
+
+// --- Decoding ---
+
+/* Decodes one page (128 bytes) from src into dst, returns the next packet */
+const uint8_t *OledImage_DecodePage(const uint8_t *src, uint8_t *dst);
+
+/* Applies frame to the frame buffer and marks only its pages dirty.
+   frame == frameCount applies the loop frame. Frame 0 is always complete;
+   a later frame is only right over the frame before it. */
+void BSP_OLED_DrawImage(const OledImage_t *image, uint8_t frame);
+
+/* Sends the pages of frame straight to the panel, decoded into the I2C tx
+   buffer, without touching the frame buffer (splash screens, a one-off
+   screen under a menu). Nothing is sent while the panel scrolls. */
+void BSP_OLED_StreamImage(const OledImage_t *image, uint8_t frame);
+
+// --- Playback ---
+
+/* Plays image `loops` times (0 = until the thread is no longer scheduled) */
+void BSP_OLED_PlayerInit(OledPlayer_t *player, const OledImage_t *image, uint8_t loops);
+
+/* Protothread: frame 0, then one frame every frameMs, each flushed with
+   BSP_OLED_Update() so only the pages that change are sent */
+PT_THREAD(BSP_OLED_PlayerRun(OledPlayer_t *player));
+
+#endif /* BSP_OLED_IMAGE_H_ */
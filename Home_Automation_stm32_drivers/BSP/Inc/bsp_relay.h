@@ -13,6 +13,7 @@
 
 void BSP_Relay_Init(void);
 void BSP_Relay_SetState(uint8_t relay_pin, uint8_t state);
+void BSP_Relay_SetAll(uint8_t state);
 void BSP_Relay_Toggle(uint8_t relay_pin);
 
 #endif /* INC_BSP_RELAY_H_ */
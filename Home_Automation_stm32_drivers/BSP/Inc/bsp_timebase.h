@@ -0,0 +1,71 @@
+/*
+ * bsp_timebase.h
+ *
+ * Created on: Feb 14, 2026
+ * Author: Rahul B.
+ * Description: System timebase - 1 ms SysTick tick + 64-bit microsecond clock
+ *
+ * SysTick runs at 1 kHz (reload derived from RCC_GetHCLKFreq()) and keeps
+ * the millisecond count. TIM2 (already set up by BSP_Delay_Init() as a free
+ * running 1 MHz 32-bit counter) is extended to 64 bits in software, so
+ * neither now_us() nor now_ms() wraps during the lifetime of the product.
+ *
+ * Both clocks follow clock-tree changes automatically: RCC_ClockConfig()
+ * calls RCC_ClockChangedCallback(), which re-derives the SysTick reload and
+ * the TIM2 prescaler while keeping the timebase continuous.
+ */
+
+#ifndef INC_BSP_TIMEBASE_H_
+#define INC_BSP_TIMEBASE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "stm32f446xx.h"
+
+/* SysTick exception priority (0 = highest ... 15 = lowest) */
+#define TIMEBASE_SYSTICK_PRIORITY   14U
+
+#if !defined(__arm__)
+/* Host builds read these instead of the peripherals. The test defines them
+ * and moves TIM2 CNT itself (see 030_timebase_test.c). */
+extern TIM_RegDef_t     g_TimebaseHostTIM2;
+extern SysTick_RegDef_t g_TimebaseHostSysTick;
+extern SCB_RegDef_t     g_TimebaseHostSCB;
+#endif
+
+/* ===== INITIALIZATION ===== */
+
+/* Start the 1 ms SysTick. Call once, after BSP_Delay_Init(). */
+void BSP_Timebase_Init(void);
+
+/* Re-derive SysTick reload and TIM2 prescaler from the current clock tree.
+ * Called automatically from RCC_ClockChangedCallback(). */
+void BSP_Timebase_Reconfigure(void);
+
+/* ===== TICK SUPPRESSION (tickless idle, call with IRQs masked) =====
+ * Suspend stops SysTick; Resume restarts it in phase and adds the missed
+ * milliseconds. unseen_us is sleep time TIM2 did not count (Stop mode). */
+
+void BSP_Timebase_SuspendTick(void);
+void BSP_Timebase_ResumeTick(uint32_t unseen_us);
+
+/* ===== TIME READ-OUT (thread and ISR safe) ===== */
+
+uint64_t now_us(void);
+uint64_t now_ms(void);
+
+/* Low 32 bits of now_us() without masking interrupts (wraps every ~71 min).
+ * For interrupt timestamps and short differences. */
+uint32_t now_us32(void);
+
+/* ===== DEADLINE HELPERS =====
+ * A deadline is an absolute point on the now_us() axis. Since the axis is
+ * 64 bits wide, plain comparisons are overflow safe. */
+
+uint64_t deadline_after_us(uint32_t us);
+uint64_t deadline_after_ms(uint32_t ms);
+bool     deadline_expired(uint64_t deadline);
+uint32_t deadline_remaining_ms(uint64_t deadline);
+
+#endif /* INC_BSP_TIMEBASE_H_ */
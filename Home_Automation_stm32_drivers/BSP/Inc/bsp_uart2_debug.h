@@ -18,6 +18,9 @@ void UART_Printf(const char *format, ...);
 /* Blocking receive 1 byte */
 uint8_t UART_ReceiveByte(void);
 
+/* Non-blocking receive 1 byte, false if none is waiting */
+bool UART_TryReceiveByte(uint8_t *data);
+
 /* Clears terminal screen */
 void Debug_ClearScreen(void);
 
@@ -29,6 +29,7 @@
 #define SENSOR_ADC              	ADC1
 #define SENSOR_LDR1_CHANNEL     	0              // ADC Channel 0
 #define SENSOR_LDR2_CHANNEL     	1              // ADC Channel 1
+#define SENSOR_HISTORY_LEN      	64             // LDR1 samples in the OLED sparkline
 
 /* ===== USART2 (ST-LINK Virtual COM Port) ===== */
 // Port A - Reserved for debugging/programming
@@ -47,6 +48,8 @@
 #define LED_GREEN_PIN       		GPIO_PIN_NO_5
 #define LED_RED_PIN         		GPIO_PIN_NO_6
 #define LED_WHITE_PIN         		GPIO_PIN_NO_7
+#define LED_ALL_MASK                (GPIO_PIN_MASK(LED_GREEN_PIN) | GPIO_PIN_MASK(LED_RED_PIN) | \
+                                     GPIO_PIN_MASK(LED_WHITE_PIN))
 
 /* ===== KEYPAD PIN CONFIGURATION ===== */
 /* 4x4 Matrix Keypad Layout:
@@ -57,19 +60,23 @@
  *   R3   *     0     #     D
  */
 
-// Rows (Output) - Port B
+// Rows (Open-drain, Pull-up) - Port B
 #define KEYPAD_ROW_PORT             GPIOB
 #define KEYPAD_R0_PIN               GPIO_PIN_NO_0
 #define KEYPAD_R1_PIN               GPIO_PIN_NO_1
 #define KEYPAD_R2_PIN               GPIO_PIN_NO_2
 #define KEYPAD_R3_PIN               GPIO_PIN_NO_3
+#define KEYPAD_ROW_MASK             (GPIO_PIN_MASK(KEYPAD_R0_PIN) | GPIO_PIN_MASK(KEYPAD_R1_PIN) | \
+                                     GPIO_PIN_MASK(KEYPAD_R2_PIN) | GPIO_PIN_MASK(KEYPAD_R3_PIN))
 
-// Columns (Input with Pull-up) - Port B
+// Columns (Open-drain, Pull-up) - Port B
 #define KEYPAD_COL_PORT             GPIOB
 #define KEYPAD_C0_PIN               GPIO_PIN_NO_4
 #define KEYPAD_C1_PIN               GPIO_PIN_NO_5
 #define KEYPAD_C2_PIN               GPIO_PIN_NO_6
 #define KEYPAD_C3_PIN               GPIO_PIN_NO_7
+#define KEYPAD_COL_MASK             (GPIO_PIN_MASK(KEYPAD_C0_PIN) | GPIO_PIN_MASK(KEYPAD_C1_PIN) | \
+                                     GPIO_PIN_MASK(KEYPAD_C2_PIN) | GPIO_PIN_MASK(KEYPAD_C3_PIN))
 
 /* ===== OLED DISPLAY (128x64, I2C1) ===== */
 #define OLED_I2C_PORT               GPIOB
@@ -77,6 +84,9 @@
 #define OLED_SDA_PIN                GPIO_PIN_NO_9  // I2C1_SDA (AF4)
 #define OLED_I2C                    I2C1
 #define OLED_I2C_AF                 4              // Alternate Function 4
+#define OLED_DMA                    DMA1           // I2C1_TX request: DMA1 Stream7 Channel1
+#define OLED_DMA_STREAM             7              // (Stream6 is left to USART2_TX)
+#define OLED_DMA_CHANNEL            1
 
 // Relays (with transistor buffers)
 #define RELAY_PORT                  GPIOB
@@ -84,6 +94,8 @@
 #define RELAY2_PIN                  GPIO_PIN_NO_13
 #define RELAY3_PIN                  GPIO_PIN_NO_14
 #define RELAY4_PIN                  GPIO_PIN_NO_15
+#define RELAY_ALL_MASK              (GPIO_PIN_MASK(RELAY1_PIN) | GPIO_PIN_MASK(RELAY2_PIN) | \
+                                     GPIO_PIN_MASK(RELAY3_PIN) | GPIO_PIN_MASK(RELAY4_PIN))
 
 /* ===== LCD 16x2 PIN CONFIGURATION (4-bit mode) ===== */
 // Control Pins - Port C
@@ -97,6 +109,8 @@
 #define LCD_D5_PIN                  GPIO_PIN_NO_3
 #define LCD_D6_PIN                  GPIO_PIN_NO_4
 #define LCD_D7_PIN                  GPIO_PIN_NO_5
+#define LCD_DATA_MASK               (GPIO_PIN_MASK(LCD_D4_PIN) | GPIO_PIN_MASK(LCD_D5_PIN) | \
+                                     GPIO_PIN_MASK(LCD_D6_PIN) | GPIO_PIN_MASK(LCD_D7_PIN))
 
 // IR Proximity Sensors (powered by 3.3V - SAFE)
 #define IR1_PORT                    GPIOC
@@ -109,11 +123,70 @@
 #define WAKEUP_BTN_PIN              GPIO_PIN_NO_13
 #define WAKEUP_BTN_IRQ              EXTI15_10_IRQn
 
+/* ===== BOARD PIN TABLE ===== */
+/* Pin groups of the BSP modules, one GPIO_PIN_DESC row per pin:
+ * (port, pin, mode, output type, speed, pull, AF). A module puts its group
+ * in a static const table and configures it with GPIO_InitGroup().
+ */
+#define BOARD_PINS_USART2 \
+    GPIO_PIN_DESC(USART_VCP_PORT, USART_TX_PIN, GPIO_MODE_ALTFN, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_PIN_PU, USART_VCP_AF), \
+    GPIO_PIN_DESC(USART_VCP_PORT, USART_RX_PIN, GPIO_MODE_ALTFN, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_PIN_PU, USART_VCP_AF)
+
+#define BOARD_PINS_LED \
+    GPIO_PIN_DESC(LED_PORT, LED_GREEN_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_LOW, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LED_PORT, LED_RED_PIN,   GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_LOW, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LED_PORT, LED_WHITE_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_LOW, GPIO_NO_PUPD, 0)
+
+#define BOARD_PINS_KEYPAD \
+    GPIO_PIN_DESC(KEYPAD_ROW_PORT, KEYPAD_R0_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_ROW_PORT, KEYPAD_R1_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_ROW_PORT, KEYPAD_R2_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_ROW_PORT, KEYPAD_R3_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_COL_PORT, KEYPAD_C0_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_COL_PORT, KEYPAD_C1_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_COL_PORT, KEYPAD_C2_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0), \
+    GPIO_PIN_DESC(KEYPAD_COL_PORT, KEYPAD_C3_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU,  0)
+
+#define BOARD_PINS_RELAY \
+    GPIO_PIN_DESC(RELAY_PORT, RELAY1_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(RELAY_PORT, RELAY2_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(RELAY_PORT, RELAY3_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(RELAY_PORT, RELAY4_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0)
+
+#define BOARD_PINS_LCD \
+    GPIO_PIN_DESC(LCD_CTRL_PORT, LCD_RS_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LCD_CTRL_PORT, LCD_EN_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LCD_DATA_PORT, LCD_D4_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LCD_DATA_PORT, LCD_D5_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LCD_DATA_PORT, LCD_D6_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0), \
+    GPIO_PIN_DESC(LCD_DATA_PORT, LCD_D7_PIN, GPIO_MODE_OUT, GPIO_OP_TYPE_PP, GPIO_SPEED_FAST, GPIO_NO_PUPD, 0)
+
+#define BOARD_PINS_OLED \
+    GPIO_PIN_DESC(OLED_I2C_PORT, OLED_SCL_PIN, GPIO_MODE_ALTFN, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU, OLED_I2C_AF), \
+    GPIO_PIN_DESC(OLED_I2C_PORT, OLED_SDA_PIN, GPIO_MODE_ALTFN, GPIO_OP_TYPE_OD, GPIO_SPEED_FAST, GPIO_PIN_PU, OLED_I2C_AF)
+
 /* ===== TIMING CONSTANTS ===== */
 #define DEBOUNCE_DELAY_MS           50
 #define LCD_DELAY_US                50
 #define BUZZER_BEEP_MS              200
 #define SCREEN_TIMEOUT_SEC          30
+#define DISPLAY_MSG_HOLD_MS         1000  // ms a print_Log/alert message stays on screen
+
+/* ===== SCHEDULER TASK PERIODS (ms) ===== */
+#define EVENT_TASK_PERIOD_MS        1
+#define FSM_TASK_PERIOD_MS          20
+#define SOFT_TIMER_TASK_PERIOD_MS   1
+#define SENSOR_TASK_PERIOD_MS       200
+#define SELFTEST_TASK_PERIOD_MS     10
+#define STANDBY_FSM_PERIOD_MS       100   // keypad poll period while asleep in STANDBY
+#define CONSOLE_TASK_PERIOD_MS      50    // USART2 command poll
+
+/* ===== IDLE / LOW POWER ===== */
+#define IDLE_SLEEP_GUARD_US         500   // wake this far ahead of a ms deadline
+#define IDLE_STOP_MIN_MS            20    // Stop only pays off above this budget
+
+/* ===== INTRUSION RESPONSE ===== */
+#define INTRUSION_LATENCY_BUDGET_US 20000 // IR edge -> buzzer on
 
 /* ===== KEYPAD KEY CODES ===== */
 #define KEY_UP                      '2'
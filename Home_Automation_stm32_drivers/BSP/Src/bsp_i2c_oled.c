@@ -6,15 +6,69 @@
  */
 
 #include "bsp_i2c_oled.h"
+#include "bsp_oled_gfx.h"
+#include "bsp_oled_image.h"
 #include "main.h"
+#include "profiler.h"
+#include "bsp_timebase.h"
+
+static void OLED_I2CEvent(I2C_Handle_t *pI2CHandle, uint8_t AppEv);
 
 // --- Global Handles ---
-I2C_Handle_t g_OledI2cHandle;
+I2C_Handle_t g_OledI2cHandle = { .pCallback = OLED_I2CEvent };   // events of the other buses go elsewhere
+DMA_Handle_t g_OledDmaHandle;   // I2C1 TX stream of the interrupt driven flush
 
 // --- Frame Buffer ---
 // 128 * 64 bits = 1024 bytes
 static uint8_t OLED_Buffer[1024];
 
+// --- Flush Pipeline ---
+// Three copies of the screen:
+//   OLED_Buffer  drawn into by the BSP_OLED_* calls
+//   OLED_Frame   committed by BSP_OLED_Update(), the frame waiting to go out
+//   OLED_Panel   mirror of the SSD1306 GDDRAM (sent, or being sent)
+// Drawing marks a column span per page of OLED_Buffer. Update copies the
+// marked spans into OLED_Frame and hands the marks over. A flush trims each
+// span to the bytes that differ from OLED_Panel, copies them there and sends
+// them as address windows: blocking, or by DMA while the main loop keeps
+// drawing into OLED_Buffer. There the CPU only sees the START/address/BTF
+// events of each transaction; the data bytes go from s_txBuf to I2C1->DR
+// on DMA1 Stream7. While the panel scrolls a band by itself nothing is
+// flushed; afterwards the band's GDDRAM is unknown (s_panelStale) and its
+// pages are sent whole.
+typedef struct {
+    uint8_t lo;             // first dirty column
+    uint8_t hi;             // last dirty column, lo > hi = clean
+} OledSpan_t;
+
+typedef struct {
+    uint8_t p0, p1;         // pages
+    uint8_t lo, hi;         // columns
+} OledWindow_t;
+
+static uint8_t OLED_Frame[1024];
+static uint8_t OLED_Panel[1024];
+static OledSpan_t s_drawDirty[OLED_PAGES];
+static OledSpan_t s_frameDirty[OLED_PAGES];
+static bool s_panelValid = false;          // false: GDDRAM content unknown, send all
+static uint8_t s_panelStale = 0;           // bit per page: GDDRAM row unknown, send it whole
+static bool s_scrolling = false;           // hardware scroll running, no GDDRAM access
+static uint8_t s_scrollP0, s_scrollP1;
+
+static OledWindow_t s_windows[OLED_PAGES];
+static uint8_t s_windowCount = 0;
+static uint8_t s_txWindow = 0;             // window being sent
+static uint8_t s_txPage = 0;               // its next page row, > p1 = command not sent yet
+static uint8_t s_txBuf[OLED_WIDTH + 1];
+
+static bool s_async = false;
+static volatile bool s_busy = false;       // a frame is on the bus (interrupt driven)
+static volatile bool s_queued = false;     // a committed frame waits for the bus
+static uint32_t s_frameStartUs;
+static OledFlushCallback_t s_flushCallback = NULL;
+static OledFlushStats_t s_flushStats;
+static OledBusStats_t s_busStats;
+
 static const uint8_t Font5x7[][5] = {
     {0x00, 0x00, 0x00, 0x00, 0x00}, //   (Space)
     {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
@@ -113,6 +167,7 @@ static const uint8_t Font5x7[][5] = {
     {0x10, 0x08, 0x08, 0x10, 0x08}  // ~
 };
 
+// Face as a raw frame buffer; the greeting draws Image_Face, the same picture compressed
 const uint8_t my_face_array[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -180,103 +235,680 @@ const uint8_t my_face_array[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+static inline void OLED_CountTransaction(uint32_t len) {
+    s_busStats.transactions++;
+    s_busStats.bytes += len + 1; // + address byte
+}
+
+// Helper: one blocking I2C transaction to the display
+static void OLED_Send(uint8_t *data, uint32_t len) {
+    BSP_OLED_WaitIdle();
+    I2C_MasterSendData(&g_OledI2cHandle, data, len, OLED_I2C_ADDR, I2C_DISABLE_SR);
+    OLED_CountTransaction(len);
+}
+
 // Helper: Write Command
 void OLED_WriteCmd(uint8_t cmd) {
     uint8_t data[2];
     data[0] = OLED_CONTROL_CMD; // 0x00
     data[1] = cmd;
     // Send 2 bytes: Control + Command
-    I2C_MasterSendData(&g_OledI2cHandle, data, 2, OLED_I2C_ADDR, I2C_DISABLE_SR);
+    OLED_Send(data, 2);
+}
+
+// Helper: keep the I2C1 and DMA interrupts out while the frame state changes
+static inline void OLED_LockIrq(void) {
+    if (!s_async) return;
+    I2C_IRQInterruptConfig(I2C1_EV_IRQn, DISABLE);
+    I2C_IRQInterruptConfig(I2C1_ER_IRQn, DISABLE);
+    DMA_IRQInterruptConfig(DMA_GetIRQNumber(OLED_DMA, OLED_DMA_STREAM), DISABLE);
 }
 
-// Helper: Initialize I2C Pins (PB6=SCL, PB7=SDA)
+static inline void OLED_UnlockIrq(void) {
+    if (!s_async) return;
+    I2C_IRQInterruptConfig(I2C1_EV_IRQn, ENABLE);
+    I2C_IRQInterruptConfig(I2C1_ER_IRQn, ENABLE);
+    DMA_IRQInterruptConfig(DMA_GetIRQNumber(OLED_DMA, OLED_DMA_STREAM), ENABLE);
+}
+
+// Helper: Initialize I2C Pins (SCL, SDA: AF4, open drain, pull-up)
+static const GPIO_Handle_t s_i2cPins[] = { BOARD_PINS_OLED };
+
 void OLED_GPIO_Init(void) {
-    GPIO_Handle_t i2c_gpio;
-    i2c_gpio.pGPIOx = GPIOB;
-    i2c_gpio.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
-    i2c_gpio.GPIO_PinConfig.GPIO_PinAltFunMode = OLED_I2C_AF; // AF4 = I2C1
-    i2c_gpio.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_OD; // Open Drain
-    i2c_gpio.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU; // Pull Up
-    i2c_gpio.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    GPIO_InitGroup(s_i2cPins, GPIO_PIN_COUNT(s_i2cPins));
+}
+
+// Helper: widen a dirty span to cover columns x0..x1
+static inline void OLED_SpanAdd(OledSpan_t *span, uint8_t x0, uint8_t x1) {
+    if (x0 < span->lo) span->lo = x0;
+    if (x1 > span->hi) span->hi = x1;
+}
+
+static inline void OLED_SpanClear(OledSpan_t *span) {
+    span->lo = 0xFF;
+    span->hi = 0;
+}
+
+static inline void OLED_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1) {
+    OLED_SpanAdd(&s_drawDirty[page], x0, x1);
+}
+
+static void OLED_MarkAll(void) {
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        OLED_MarkDirty(page, 0, OLED_WIDTH - 1);
+    }
+}
 
-    i2c_gpio.GPIO_PinConfig.GPIO_PinNumber = OLED_SCL_PIN; // SCL
-    GPIO_Init(&i2c_gpio);
+// Helper: copy the drawn spans into the committed frame
+static void OLED_Commit(void) {
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        OledSpan_t *span = &s_drawDirty[page];
+        if (span->lo > span->hi) continue;
 
-    i2c_gpio.GPIO_PinConfig.GPIO_PinNumber = OLED_SDA_PIN; // SDA
-    GPIO_Init(&i2c_gpio);
+        uint16_t offset = page * OLED_WIDTH + span->lo;
+        memcpy(&OLED_Frame[offset], &OLED_Buffer[offset], span->hi - span->lo + 1);
+        OLED_SpanAdd(&s_frameDirty[page], span->lo, span->hi);
+        OLED_SpanClear(span);
+    }
+}
+
+// Helper: shrink the dirty span of a frame page to the bytes that differ from the panel
+// Returns false (and marks the page clean) if nothing is left to send.
+static bool OLED_TrimPage(uint8_t page) {
+    OledSpan_t *span = &s_frameDirty[page];
+    uint8_t lo = span->lo;
+    uint8_t hi = span->hi;
+    const uint8_t *frame = &OLED_Frame[page * OLED_WIDTH];
+    const uint8_t *panel = &OLED_Panel[page * OLED_WIDTH];
+
+    if (lo > hi) return false;
+    if (!s_panelValid || (s_panelStale & (1U << page))) return true;
+
+    while (lo <= hi && frame[lo] == panel[lo]) lo++;
+    if (lo > hi) {
+        OLED_SpanClear(span);
+        return false;
+    }
+    while (frame[hi] == panel[hi]) hi--;
+
+    span->lo = lo;
+    span->hi = hi;
+    return true;
+}
+
+// Helper: turn the frame's dirty spans into address windows and move their
+// bytes into OLED_Panel, which the transactions are then built from
+// Returns the number of windows.
+static uint8_t OLED_Plan(void) {
+    uint8_t page = 0;
+
+    s_windowCount = 0;
+    while (page < OLED_PAGES) {
+        if (!OLED_TrimPage(page)) {
+            page++;
+            continue;
+        }
+
+        // Grow the window over the next dirty pages while the extra columns
+        // cost fewer bytes than opening a window of their own
+        uint8_t lo = s_frameDirty[page].lo;
+        uint8_t hi = s_frameDirty[page].hi;
+        uint8_t last = page;
+
+        while ((last + 1 < OLED_PAGES) && OLED_TrimPage(last + 1)) {
+            uint8_t next_lo = s_frameDirty[last + 1].lo;
+            uint8_t next_hi = s_frameDirty[last + 1].hi;
+            uint8_t new_lo = (next_lo < lo) ? next_lo : lo;
+            uint8_t new_hi = (next_hi > hi) ? next_hi : hi;
+            uint8_t rows = last - page + 1;
+
+            uint32_t merged = (uint32_t)(new_hi - new_lo + 1) * (rows + 1);
+            uint32_t apart = (uint32_t)(hi - lo + 1) * rows + (next_hi - next_lo + 1) + OLED_WINDOW_OVERHEAD;
+            if (merged > apart) break;
+
+            lo = new_lo;
+            hi = new_hi;
+            last++;
+        }
+
+        OledWindow_t *w = &s_windows[s_windowCount++];
+        w->p0 = page;
+        w->p1 = last;
+        w->lo = lo;
+        w->hi = hi;
+
+        for (uint8_t p = page; p <= last; p++) {
+            uint16_t offset = p * OLED_WIDTH + lo;
+            memcpy(&OLED_Panel[offset], &OLED_Frame[offset], hi - lo + 1);
+            OLED_SpanClear(&s_frameDirty[p]);
+            s_panelStale &= (uint8_t)~(1U << p);
+        }
+        page = last + 1;
+    }
+    s_panelValid = true;
+
+    s_txWindow = 0;
+    s_txPage = 0xFF;
+    return s_windowCount;
+}
+
+// Helper: build the next transaction of the planned frame in s_txBuf
+// Returns its length, 0 when the frame is complete.
+static uint32_t OLED_NextTransaction(void) {
+    if (s_txWindow >= s_windowCount) return 0;
+
+    const OledWindow_t *w = &s_windows[s_txWindow];
+
+    if (s_txPage > w->p1) {
+        // Column and page address (horizontal addressing mode), one transaction
+        s_txBuf[0] = OLED_CONTROL_CMD;
+        s_txBuf[1] = 0x21; s_txBuf[2] = w->lo; s_txBuf[3] = w->hi;
+        s_txBuf[4] = 0x22; s_txBuf[5] = w->p0; s_txBuf[6] = w->p1;
+        s_txPage = w->p0;
+        s_busStats.windows++;
+        OLED_CountTransaction(7);
+        return 7;
+    }
+
+    // The GDDRAM pointer runs on across transactions: one per page row
+    uint8_t width = w->hi - w->lo + 1;
+    s_txBuf[0] = OLED_CONTROL_DATA; // 0x40
+    memcpy(&s_txBuf[1], &OLED_Panel[s_txPage * OLED_WIDTH + w->lo], width);
+
+    if (s_txPage++ == w->p1) {
+        s_txWindow++;
+        s_txPage = 0xFF;
+    }
+    OLED_CountTransaction(width + 1);
+    return width + 1;
+}
+
+// Helper: plan the committed frame and put its first transaction on the bus
+// Called with the I2C1 interrupts locked out, or from them.
+static void OLED_StartFrame(void) {
+    if (OLED_Plan() == 0) return;
+
+    s_busy = true;
+    s_flushStats.started++;
+    s_frameStartUs = (uint32_t)now_us();
+    I2C_MasterSendDataDMA(&g_OledI2cHandle, s_txBuf, OLED_NextTransaction(), OLED_I2C_ADDR, I2C_DISABLE_SR);
+}
+
+static void OLED_EndFrame(bool ok) {
+    uint32_t us = (uint32_t)now_us() - s_frameStartUs;
+
+    s_busy = false;
+    if (ok) {
+        s_flushStats.completed++;
+        s_flushStats.lastUs = us;
+        if (us > s_flushStats.maxUs) s_flushStats.maxUs = us;
+    } else {
+        // Where the transfer stopped is unknown: resend everything next time
+        s_flushStats.errors++;
+        s_panelValid = false;
+        for (uint8_t page = 0; page < OLED_PAGES; page++) {
+            OLED_SpanAdd(&s_frameDirty[page], 0, OLED_WIDTH - 1);
+        }
+    }
+
+    if (s_flushCallback != NULL) s_flushCallback(ok);
+}
+
+/**
+ * @brief I2C1 / DMA events of the OLED transfers (interrupt context)
+ * @note  Registered on g_OledI2cHandle only, so events of other I2C buses
+ *        never get here.
+ */
+static void OLED_I2CEvent(I2C_Handle_t *pI2CHandle, uint8_t AppEv) {
+    if (!s_busy) return;
+
+    if (AppEv == I2C_EV_TX_CMPLT) {
+        uint32_t len = OLED_NextTransaction();
+        if (len != 0) {
+            I2C_MasterSendDataDMA(pI2CHandle, s_txBuf, len, OLED_I2C_ADDR, I2C_DISABLE_SR);
+            return;
+        }
+        OLED_EndFrame(true);
+
+        // Updates that arrived meanwhile were coalesced into one frame
+        if (s_queued) {
+            s_queued = false;
+            OLED_StartFrame();
+        }
+    } else if ((AppEv >= I2C_ERROR_BERR && AppEv <= I2C_ERROR_TIMEOUT) || AppEv == I2C_ERROR_DMA) {
+        // Release the bus; a queued frame waits for the next update
+        pI2CHandle->pI2Cx->CR1 |= (1 << I2C_CR1_STOP);
+        I2C_CloseSendData(pI2CHandle);
+        OLED_EndFrame(false);
+    }
+}
+
+void I2C1_EV_IRQHandler(void) {
+    I2C_EV_IRQHandling(&g_OledI2cHandle);
+}
+
+void I2C1_ER_IRQHandler(void) {
+    I2C_ER_IRQHandling(&g_OledI2cHandle);
+}
+
+void DMA1_Stream7_IRQHandler(void) {
+    DMA_IRQHandling(&g_OledDmaHandle);
 }
 
 void BSP_OLED_Clear(void) {
     memset(OLED_Buffer, 0x00, sizeof(OLED_Buffer));
+    OLED_MarkAll();
 }
 
+/*
+ * Commits the buffer and sends what changed (see Flush Pipeline above).
+ * Blocking by default; after BSP_OLED_SetAsync(true) it returns at once and
+ * the frame goes out by DMA, driven from the I2C1 interrupt. Updates made
+ * while a frame is on the bus are coalesced into the next one.
+ */
 void BSP_OLED_Update(void) {
-    // We send data in chunks or pixel-by-pixel
-    // SSD1306 standard mode: Write 0x40 then data bytes
-    for (uint8_t i = 0; i < 8; i++) {
-        OLED_WriteCmd(0xB0 + i); // Set Page Start
-        OLED_WriteCmd(0x00);     // Set Low Column
-        OLED_WriteCmd(0x10);     // Set High Column
-
-        // Send 128 bytes of data for this page
-        // We need to insert the 0x40 control byte first.
-        // NOTE: Standard drivers might send 0x40 then 128 bytes in one go.
-        // Here we do a loop for simplicity using your driver.
-
-        uint8_t packet[129];
-        packet[0] = OLED_CONTROL_DATA; // 0x40
-        memcpy(&packet[1], &OLED_Buffer[i * 128], 128);
-
-        I2C_MasterSendData(&g_OledI2cHandle, packet, 129, OLED_I2C_ADDR, I2C_DISABLE_SR);
+    PROF_BEGIN(PROF_ZONE_OLED_UPDATE);
+
+    s_busStats.updates++;
+
+    // No GDDRAM access while the panel scrolls: the drawing waits in OLED_Buffer
+    if (s_scrolling) {
+        PROF_END(PROF_ZONE_OLED_UPDATE);
+        return;
+    }
+
+    if (s_async) {
+        OLED_LockIrq();
+        OLED_Commit();
+        if (!s_busy) {
+            s_queued = false;
+            OLED_StartFrame();
+        } else if (s_queued) {
+            s_flushStats.coalesced++;
+        } else {
+            s_queued = true;
+        }
+        OLED_UnlockIrq();
+    } else {
+        BSP_OLED_WaitIdle();
+        OLED_Commit();
+        OLED_Plan();
+
+        uint32_t len;
+        while ((len = OLED_NextTransaction()) != 0) {
+            I2C_MasterSendData(&g_OledI2cHandle, s_txBuf, len, OLED_I2C_ADDR, I2C_DISABLE_SR);
+        }
+    }
+
+    PROF_END(PROF_ZONE_OLED_UPDATE);
+}
+
+/* Switches between blocking and interrupt driven updates */
+void BSP_OLED_SetAsync(bool enable) {
+    BSP_OLED_WaitIdle();
+
+    uint8_t dmaIrq = DMA_GetIRQNumber(OLED_DMA, OLED_DMA_STREAM);
+
+    if (enable) {
+        I2C_IRQPriorityConfig(I2C1_EV_IRQn, NVIC_IRQ_PRI15);
+        I2C_IRQPriorityConfig(I2C1_ER_IRQn, NVIC_IRQ_PRI15);
+        DMA_IRQPriorityConfig(dmaIrq, NVIC_IRQ_PRI15);
+        I2C_IRQInterruptConfig(I2C1_EV_IRQn, ENABLE);
+        I2C_IRQInterruptConfig(I2C1_ER_IRQn, ENABLE);
+        DMA_IRQInterruptConfig(dmaIrq, ENABLE);
+    } else {
+        I2C_IRQInterruptConfig(I2C1_EV_IRQn, DISABLE);
+        I2C_IRQInterruptConfig(I2C1_ER_IRQn, DISABLE);
+        DMA_IRQInterruptConfig(dmaIrq, DISABLE);
+    }
+    s_async = enable;
+}
+
+/* Waits until no frame is on the bus or queued (needs interrupts enabled) */
+void BSP_OLED_WaitIdle(void) {
+    while (s_busy || s_queued) {
+        if (!s_busy) {
+            // Queued behind a frame that failed: start it from here
+            OLED_LockIrq();
+            if (!s_busy && s_queued) {
+                s_queued = false;
+                OLED_StartFrame();
+            }
+            OLED_UnlockIrq();
+        }
+    }
+}
+
+/* Frames on the bus or waiting for it: 0, 1 or 2 */
+uint8_t BSP_OLED_FramesInFlight(void) {
+    return (uint8_t)s_busy + (uint8_t)s_queued;
+}
+
+void BSP_OLED_SetFlushCallback(OledFlushCallback_t callback) {
+    s_flushCallback = callback;
+}
+
+const OledFlushStats_t *BSP_OLED_GetFlushStats(void) {
+    return &s_flushStats;
+}
+
+void BSP_OLED_ResetFlushStats(void) {
+    memset(&s_flushStats, 0, sizeof(s_flushStats));
+}
+
+/* Forgets what the panel shows: the next update sends the whole frame */
+void BSP_OLED_Invalidate(void) {
+    OLED_LockIrq();
+    s_panelValid = false;
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        OLED_SpanAdd(&s_frameDirty[page], 0, OLED_WIDTH - 1);
     }
+    OLED_MarkAll();
+    OLED_UnlockIrq();
+}
+
+const uint8_t *BSP_OLED_GetFrame(void) {
+    return OLED_Buffer;
+}
+
+uint8_t *BSP_OLED_GetDrawBuffer(void) {
+    return OLED_Buffer;
+}
+
+void BSP_OLED_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1) {
+    OLED_MarkDirty(page, x0, x1);
+}
+
+const OledBusStats_t *BSP_OLED_GetBusStats(void) {
+    return &s_busStats;
+}
+
+void BSP_OLED_ResetBusStats(void) {
+    memset(&s_busStats, 0, sizeof(s_busStats));
 }
 
 void BSP_OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t state) {
     if (x >= OLED_WIDTH || y >= OLED_HEIGHT) return;
 
-    if (state) {
-        OLED_Buffer[x + (y / 8) * 128] |= (1 << (y % 8));
-    } else {
-        OLED_Buffer[x + (y / 8) * 128] &= ~(1 << (y % 8));
+    uint8_t *byte = &OLED_Buffer[x + (y / 8) * 128];
+    uint8_t value = state ? (*byte | (1 << (y % 8))) : (*byte & ~(1 << (y % 8)));
+
+    if (value != *byte) {
+        *byte = value;
+        OLED_MarkDirty(y / 8, x, x);
     }
 }
 
 
+// --- Text ---
+// A Font5x7 column is 8 rows with bit 0 on top, the same layout as a
+// buffer byte. At a page aligned y a glyph column is one byte store; else
+// it is split over two pages: (bits << shift) into the low rows' byte,
+// (bits >> (8 - shift)) into the next page, each under its mask. All 8
+// rows are written (row 7 clears the line below the glyph); the 2 columns
+// between glyphs are left alone.
+
+// Helper: glyph of a character, non-printable ones draw as a space
+static inline const uint8_t *OLED_Glyph(char c) {
+    if (c < 32 || c > 126) c = 32;
+    return Font5x7[c - 32];
+}
+
+// Helper: store bits under mask at column x of a page row, note the change
+static inline void OLED_BlitByte(uint8_t *row, uint8_t x, uint8_t mask, uint8_t bits, OledSpan_t *changed) {
+    uint8_t value = (row[x] & ~mask) | (bits & mask);
+
+    if (value != row[x]) {
+        row[x] = value;
+        OLED_SpanAdd(changed, x, x);
+    }
+}
+
+// Draws str from x, y; clipped at the right and bottom edges
+static void OLED_BlitText(uint8_t x, uint8_t y, const char *str) {
+    if (y >= OLED_HEIGHT) return;
+
+    uint8_t page = y / 8;
+    uint8_t shift = y % 8;
+    uint8_t *row0 = &OLED_Buffer[page * OLED_WIDTH];
+    uint8_t *row1 = (shift != 0 && page + 1 < OLED_PAGES) ? row0 + OLED_WIDTH : NULL;
+    uint8_t mask0 = (uint8_t)(0xFF << shift);
+    uint8_t mask1 = (uint8_t)~mask0;
+    OledSpan_t changed0 = { 0xFF, 0 };
+    OledSpan_t changed1 = { 0xFF, 0 };
+    uint16_t cursor = x;
+
+    for (; *str && cursor < OLED_WIDTH; str++) {
+        const uint8_t *glyph = OLED_Glyph(*str);
+
+        for (uint8_t col = 0; col < 5 && cursor < OLED_WIDTH; col++, cursor++) {
+            if (shift == 0) {
+                // Page aligned: the column is the byte
+                if (row0[cursor] != glyph[col]) {
+                    row0[cursor] = glyph[col];
+                    OLED_SpanAdd(&changed0, cursor, cursor);
+                }
+            } else {
+                OLED_BlitByte(row0, cursor, mask0, (uint8_t)(glyph[col] << shift), &changed0);
+                if (row1) OLED_BlitByte(row1, cursor, mask1, (uint8_t)(glyph[col] >> (8 - shift)), &changed1);
+            }
+        }
+        cursor += 2; // spacing between characters
+    }
+
+    if (changed0.lo <= changed0.hi) OLED_MarkDirty(page, changed0.lo, changed0.hi);
+    if (changed1.lo <= changed1.hi) OLED_MarkDirty(page + 1, changed1.lo, changed1.hi);
+}
+
+void BSP_OLED_DrawChar(uint8_t x, uint8_t y, char c) {
+    char str[2] = { c, '\0' };
+
+    OLED_BlitText(x, y, str);
+}
+
 void BSP_OLED_PrintString(uint8_t x, uint8_t y, char *str) {
-    uint8_t cursor_x = x;
-
-    while(*str) {
-        // 1. Get ASCII character
-        char c = *str;
-
-        // 2. Safety Check: Ensure it fits in our Font Array
-        // Our array starts at Space (ASCII 32) and ends at ~ (ASCII 126)
-        if(c < 32 || c > 126) c = 32;
-
-        // 3. Calculate Index (Array starts at 0, ASCII starts at 32)
-        uint8_t index = c - 32;
-
-        // 4. Draw the 5 columns of the character
-        for(int col=0; col<5; col++) {
-            uint8_t column_data = Font5x7[index][col];
-
-            // Draw 8 pixels vertically for this column
-            for(int row=0; row<8; row++) {
-                // Check if the bit at 'row' is 1 or 0
-                if((column_data >> row) & 0x01) {
-                     BSP_OLED_DrawPixel(cursor_x, y + row, 1);
-                } else {
-                     BSP_OLED_DrawPixel(cursor_x, y + row, 0);
+    OLED_BlitText(x, y, str);
+}
+
+// --- Fonts (bsp_oled_font.h) ---
+// The same two cases for glyphs of `pages` bytes per column. Page aligned,
+// column byte k is stored as is in page + k. Else output byte k (0..pages)
+// is (bits[k] << shift) | (bits[k - 1] >> (8 - shift)); only the first and
+// the last are masked. Every column of a cell is written, blank ones as 0.
+uint16_t BSP_OLED_DrawText(uint8_t x, uint8_t y, const OledFont_t *font, const char *str) {
+    uint8_t page = y / 8;
+    uint8_t shift = y % 8;
+    uint8_t pages = font->pages;
+    uint8_t outPages = pages + (shift ? 1 : 0);
+    OledSpan_t changed[OLED_PAGES + 1];
+    uint16_t cursor = x;
+
+    for (uint8_t k = 0; k < outPages; k++) OLED_SpanClear(&changed[k]);
+    if (page + outPages > OLED_PAGES) outPages = (page < OLED_PAGES) ? OLED_PAGES - page : 0;
+
+    for (; *str; str++) {
+        const OledGlyph_t *glyph = OledFont_Glyph(font, *str);
+        const uint8_t *bits = &font->bitmap[glyph->offset];
+        uint16_t next = cursor + OledFont_CellWidth(font, str[0], str[1]);
+
+        for (uint8_t col = 0; cursor < next && cursor < OLED_WIDTH; col++, cursor++) {
+            uint8_t ink = (uint8_t)(col - glyph->xOffset);
+            const uint8_t *column = (col >= glyph->xOffset && ink < glyph->width) ? &bits[ink * pages] : NULL;
+
+            if (shift == 0) {
+                // Page aligned: the column bytes are the buffer bytes
+                for (uint8_t k = 0; k < outPages; k++) {
+                    uint8_t *byte = &OLED_Buffer[(page + k) * OLED_WIDTH + cursor];
+                    uint8_t value = column ? column[k] : 0;
+
+                    if (*byte != value) {
+                        *byte = value;
+                        OLED_SpanAdd(&changed[k], (uint8_t)cursor, (uint8_t)cursor);
+                    }
                 }
+            } else {
+                for (uint8_t k = 0; k < outPages; k++) {
+                    uint8_t lo = (column && k < pages) ? column[k] : 0;
+                    uint8_t hi = (column && k > 0) ? column[k - 1] : 0;
+                    uint8_t mask = (k == 0) ? (uint8_t)(0xFF << shift) : (k == pages) ? (uint8_t)(0xFF >> (8 - shift)) : 0xFF;
+
+                    OLED_BlitByte(&OLED_Buffer[(page + k) * OLED_WIDTH], (uint8_t)cursor, mask,
+                                  (uint8_t)((lo << shift) | (hi >> (8 - shift))), &changed[k]);
+                }
+            }
+        }
+        cursor = next;
+    }
+
+    for (uint8_t k = 0; k < outPages; k++) {
+        if (changed[k].lo <= changed[k].hi) OLED_MarkDirty(page + k, changed[k].lo, changed[k].hi);
+    }
+    return cursor;
+}
+
+void OLED_PrintfFont(uint8_t x, uint8_t y, const OledFont_t *font, const char *format, ...)
+{
+    char buffer[64];
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    BSP_OLED_DrawText(x, y, font, buffer);
+}
+
+// --- Scrolling ---
+// Hardware: one command transaction (2Eh, 26h/27h and its 6 bytes, 2Fh)
+// and the panel rotates the band on its own. Software: the band columns
+// are moved in OLED_Buffer and the update sends the band as one window.
+
+void BSP_OLED_StartScroll(uint8_t startPage, uint8_t endPage, OledScrollDir_t dir, OledScrollSpeed_t speed) {
+    uint8_t cmd[] = {
+        OLED_CONTROL_CMD,
+        0x2E,                       // Deactivate Scroll (setup may not change while it runs)
+        (uint8_t)dir, 0x00, startPage, (uint8_t)speed, endPage,
+        0x00, 0xFF,                 // all columns
+        0x2F                        // Activate Scroll
+    };
+
+    if (startPage > endPage || endPage >= OLED_PAGES) return;
+    if (s_scrolling) BSP_OLED_StopScroll();
+
+    // The panel scrolls what it shows: send the drawing first
+    BSP_OLED_Update();
+    OLED_Send(cmd, sizeof(cmd));
+
+    s_scrolling = true;
+    s_scrollP0 = startPage;
+    s_scrollP1 = endPage;
+}
+
+void BSP_OLED_StopScroll(void) {
+    uint8_t cmd[] = { OLED_CONTROL_CMD, 0x2E };
+
+    if (!s_scrolling) return;
+    OLED_Send(cmd, sizeof(cmd));
+    s_scrolling = false;
+
+    // Where the rows stopped is unknown (the datasheet asks for a rewrite)
+    OLED_LockIrq();
+    for (uint8_t page = s_scrollP0; page <= s_scrollP1; page++) {
+        s_panelStale |= (uint8_t)(1U << page);
+        OLED_SpanAdd(&s_frameDirty[page], 0, OLED_WIDTH - 1);
+    }
+    OLED_UnlockIrq();
+}
+
+bool BSP_OLED_IsScrolling(void) {
+    return s_scrolling;
+}
+
+void BSP_OLED_ShiftBand(uint8_t startPage, uint8_t endPage, int16_t dx) {
+    if (startPage > endPage || endPage >= OLED_PAGES || dx == 0) return;
+
+    uint8_t n = (dx <= -OLED_WIDTH || dx >= OLED_WIDTH) ? OLED_WIDTH : (uint8_t)abs(dx);
+
+    for (uint8_t page = startPage; page <= endPage; page++) {
+        uint8_t *row = &OLED_Buffer[page * OLED_WIDTH];
+
+        if (dx < 0) {
+            memmove(row, row + n, OLED_WIDTH - n);
+            memset(row + OLED_WIDTH - n, 0x00, n);
+        } else {
+            memmove(row + n, row, OLED_WIDTH - n);
+            memset(row, 0x00, n);
+        }
+        OLED_MarkDirty(page, 0, OLED_WIDTH - 1);
+    }
+}
+
+// Helper: column col of str as BSP_OLED_DrawText() draws it, font->pages bytes
+static void OLED_TextColumn(const OledFont_t *font, const char *str, uint16_t col, uint8_t *out) {
+    uint16_t cursor = 0;
+
+    memset(out, 0x00, font->pages);
+    for (; *str; str++) {
+        uint8_t cell = OledFont_CellWidth(font, str[0], str[1]);
+
+        if (col < cursor + cell) {
+            const OledGlyph_t *glyph = OledFont_Glyph(font, *str);
+            uint8_t ink = (uint8_t)(col - cursor - glyph->xOffset);
+
+            if (col - cursor >= glyph->xOffset && ink < glyph->width) {
+                memcpy(out, &font->bitmap[glyph->offset + ink * font->pages], font->pages);
             }
-            cursor_x++;
+            return;
         }
+        cursor += cell;
+    }
+}
+
+void BSP_OLED_MarqueeStart(OledMarquee_t *m, uint8_t page, const OledFont_t *font, const char *str, OledScrollSpeed_t speed) {
+    uint8_t last = page + font->pages - 1;
+
+    if (last >= OLED_PAGES) return;
+    if (s_scrolling) BSP_OLED_StopScroll();
+
+    m->text = str;
+    m->font = font;
+    m->page = page;
+    m->width = OledFont_TextWidth(font, str);
+    m->period = m->width + OLED_MARQUEE_GAP;
+    m->pos = 0;
+    m->hardware = (m->period <= OLED_WIDTH);
 
-        cursor_x += 2; // Add 2 pixels of spacing between characters
-        str++;
+    BSP_OLED_ShiftBand(page, last, OLED_WIDTH);   // shifted out entirely = cleared
+    BSP_OLED_DrawText(0, page * 8, font, str);
+    if (m->hardware) BSP_OLED_StartScroll(page, last, OLED_SCROLL_LEFT, speed);
+}
+
+void BSP_OLED_MarqueeStep(OledMarquee_t *m, uint8_t columns) {
+    uint8_t pages = m->font->pages;
+    uint8_t bits[OLED_PAGES];
+
+    if (m->hardware || columns == 0) return;
+    if (columns > OLED_WIDTH) columns = OLED_WIDTH;
+
+    BSP_OLED_ShiftBand(m->page, m->page + pages - 1, -(int16_t)columns);
+    m->pos = (uint16_t)((m->pos + columns) % m->period);
+
+    // Bring in the columns on the right: visible column x shows text column pos + x
+    for (uint8_t x = OLED_WIDTH - columns; x < OLED_WIDTH; x++) {
+        uint16_t col = (uint16_t)((m->pos + x) % m->period);
+        if (col >= m->width) continue;   // the gap, already cleared
+
+        OLED_TextColumn(m->font, m->text, col, bits);
+        for (uint8_t k = 0; k < pages; k++) OLED_Buffer[(m->page + k) * OLED_WIDTH + x] = bits[k];
     }
 }
 
+void BSP_OLED_MarqueeStop(OledMarquee_t *m) {
+    if (m->hardware && s_scrolling) BSP_OLED_StopScroll();
+    m->hardware = false;
+    m->width = 0;
+}
+
 /* ===== NEW FUNCTION: OLED Printf ===== */
 void OLED_Printf(uint8_t x, uint8_t y, const char *format, ...)
 {
@@ -297,6 +929,38 @@ void BSP_OLED_DrawBitmap(const uint8_t *bitmap) {
     // 128 cols * 64 rows / 8 bits = 1024 bytes
     // We copy the external array directly into our screen buffer
     memcpy(OLED_Buffer, bitmap, 1024);
+    OLED_MarkAll();
+}
+
+/*
+ * Each page of the frame is decoded into s_txBuf behind the data control
+ * byte and sent as a window of its own; OLED_Panel keeps the mirror. The
+ * pages are marked dirty, so the next update puts OLED_Buffer back where
+ * it differs from the image.
+ */
+void BSP_OLED_StreamImage(const OledImage_t *image, uint8_t frame) {
+    const uint8_t *src = &image->data[image->frames[frame]];
+    uint8_t mask = *src++;
+
+    if (s_scrolling) return;
+
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        uint8_t cmd[] = { OLED_CONTROL_CMD, 0x21, 0, OLED_WIDTH - 1, 0x22, page, page };
+
+        if (!(mask & (1U << page))) continue;
+
+        OLED_Send(cmd, sizeof(cmd));    // waits for the bus before s_txBuf is reused
+        s_busStats.windows++;
+        s_txBuf[0] = OLED_CONTROL_DATA;
+        src = OledImage_DecodePage(src, &s_txBuf[1]);
+        OLED_Send(s_txBuf, OLED_WIDTH + 1);
+
+        OLED_LockIrq();
+        memcpy(&OLED_Panel[page * OLED_WIDTH], &s_txBuf[1], OLED_WIDTH);
+        s_panelStale &= (uint8_t)~(1U << page);
+        OLED_MarkDirty(page, 0, OLED_WIDTH - 1);
+        OLED_UnlockIrq();
+    }
 }
 
 void BSP_OLED_Init(void) {
@@ -314,6 +978,21 @@ void BSP_OLED_Init(void) {
     // Enable I2C Peripheral
     I2C_PeripheralControl(I2C1, ENABLE);
 
+    // TX stream for the interrupt driven flush: s_txBuf -> I2C1->DR, bytes
+    g_OledDmaHandle.pDMAx = OLED_DMA;
+    g_OledDmaHandle.Stream = OLED_DMA_STREAM;
+    g_OledDmaHandle.DMA_Config.DMA_Channel = OLED_DMA_CHANNEL;
+    g_OledDmaHandle.DMA_Config.DMA_Direction = DMA_DIR_M2P;
+    g_OledDmaHandle.DMA_Config.DMA_PeriphInc = DISABLE;
+    g_OledDmaHandle.DMA_Config.DMA_MemInc = ENABLE;
+    g_OledDmaHandle.DMA_Config.DMA_PeriphSize = DMA_SIZE_BYTE;
+    g_OledDmaHandle.DMA_Config.DMA_MemSize = DMA_SIZE_BYTE;
+    g_OledDmaHandle.DMA_Config.DMA_Mode = DMA_MODE_NORMAL;
+    g_OledDmaHandle.DMA_Config.DMA_Priority = DMA_PRIORITY_LOW;
+    g_OledDmaHandle.DMA_Config.DMA_FIFOMode = DMA_FIFO_DIRECT;
+    DMA_Init(&g_OledDmaHandle);
+    g_OledI2cHandle.pDMATx = &g_OledDmaHandle;
+
     // 3. SSD1306 Startup Sequence
     OLED_WriteCmd(0xAE); // Display OFF
     OLED_WriteCmd(0x20); // Set Memory Addressing Mode
@@ -344,30 +1023,39 @@ void BSP_OLED_Init(void) {
     OLED_WriteCmd(0x14); // Enable Charge Pump
     OLED_WriteCmd(0xAF); // Display ON
 
+    // GDDRAM holds garbage after power-up: the first update sends it all
+    BSP_OLED_Invalidate();
     BSP_OLED_Clear();
     BSP_OLED_Update();
 }
 
-void greet(void) {
+/**
+ * @brief Boot greeting: face, scrolling name, heart beat - three rounds
+ * @note  Protothread: call until it returns PT_ENDED (see pt.h). Every
+ *        frame is followed by a non-blocking wait, so the main loop keeps
+ *        running between frames.
+ */
+PT_THREAD(greet(Pt_t *pt)) {
+    static Pt_t child;
+    static uint8_t round;
+
+    PT_BEGIN(pt);
 
-    for(int i = 0; i < 3; i++)
+    for (round = 0; round < 3; round++)
     {
         // --- STEP 1: Show Face (3 Seconds) ---
-        BSP_OLED_Clear();
-        // NOW this works because the name matches the array above!
-        BSP_OLED_DrawBitmap(my_face_array);
+        BSP_OLED_DrawImage(&Image_Face, 0);
         BSP_OLED_Update();
-        BSP_Delay_3s();
+        PT_AWAIT_MS(pt, 3000);
 
-        // --- STEP 2: Show Text (2 Seconds) ---
-        BSP_OLED_Clear();
-        // OLED_Printf(25, 30, "Hello Rahul !");
-        Scroll_Text(); 
-        BSP_OLED_Update();
-        Heart_Beat(); 
-        BSP_Delay_3s();
+        // --- STEP 2: Show Text, then the heart (3 Seconds) ---
+        PT_SPAWN(pt, &child, Scroll_Text(&child));
+        PT_SPAWN(pt, &child, Heart_Beat(&child));
+        PT_AWAIT_MS(pt, 3000);
     }
     BSP_OLED_Clear();
+
+    PT_END(pt);
 }
 
 void Blink_Warning(void) {
@@ -385,16 +1073,23 @@ void Blink_Warning(void) {
     }
 }
 
-void Scroll_Text(void) {
-    char *msg = "Hello Rahul!";
+/**
+ * @brief Boot banner: "Hello Rahul!" runs across the middle of the screen
+ * @note  The panel scrolls page 3 by itself (one column every 2 frames,
+ *        about one lap in 2.5 s): one frame and two command transactions
+ *        on the bus instead of a redraw every 20 ms.
+ */
+PT_THREAD(Scroll_Text(Pt_t *pt)) {
+    static OledMarquee_t marquee;
 
-    // Start off-screen (right side)
-    for (int x = 128; x > -80; x -= 2) {
-        BSP_OLED_Clear();
-        BSP_OLED_PrintString(x, 28, msg);
-        BSP_OLED_Update();
-        BSP_Delay_ms(20);
-    }
+    PT_BEGIN(pt);
+
+    BSP_OLED_Clear();
+    BSP_OLED_MarqueeStart(&marquee, 3, &Font_Small8, "Hello Rahul!", OLED_SCROLL_2_FRAMES);
+    PT_AWAIT_MS(pt, 2500);
+    BSP_OLED_MarqueeStop(&marquee);
+
+    PT_END(pt);
 }
 
 void Show_Progress_Bar(uint8_t percent) {
@@ -405,23 +1100,12 @@ void Show_Progress_Bar(uint8_t percent) {
     // Title
     BSP_OLED_PrintString(20, 10, "Loading...");
 
-    // Draw empty bar outline
-    for (int x = 10; x < 118; x++) {
-        BSP_OLED_DrawPixel(x, 30, 1);  // Top line
-        BSP_OLED_DrawPixel(x, 40, 1);  // Bottom line
-    }
-    for (int y = 30; y <= 40; y++) {
-        BSP_OLED_DrawPixel(10, y, 1);   // Left line
-        BSP_OLED_DrawPixel(118, y, 1);  // Right line
-    }
+    // Draw empty bar outline: x 10..118, y 30..40
+    BSP_OLED_DrawRect(10, 30, 109, 11, OLED_PIXEL_ON);
 
     // Fill bar based on percentage
     int fill_width = (percent * 106) / 100;  // 106 = 118-12 (bar width)
-    for (int x = 12; x < 12 + fill_width; x++) {
-        for (int y = 32; y < 39; y++) {
-            BSP_OLED_DrawPixel(x, y, 1);
-        }
-    }
+    BSP_OLED_FillRect(12, 32, fill_width, 7, OLED_PIXEL_ON);
 
     // Show percentage
     OLED_Printf(50, 50, "%d%%", percent);
@@ -429,51 +1113,19 @@ void Show_Progress_Bar(uint8_t percent) {
     BSP_OLED_Update();
 }
 
-void Heart_Beat(void) {
-    // Small heart
-    uint8_t heart_small[5][7] = {
-        {0,1,1,0,1,1,0},
-        {1,1,1,1,1,1,1},
-        {1,1,1,1,1,1,1},
-        {0,1,1,1,1,1,0},
-        {0,0,1,1,1,0,0}
-    };
+/**
+ * @brief Heart beat: Anim_Heart (small / big heart, 200 ms each), 5 beats
+ * @note  After the first frame only the 4 pages of the heart are redrawn.
+ */
+PT_THREAD(Heart_Beat(Pt_t *pt)) {
+    static OledPlayer_t player;
 
-    for (int beat = 0; beat < 5; beat++) {
-        // Draw small
-        BSP_OLED_Clear();
-        for (int y = 0; y < 5; y++) {
-            for (int x = 0; x < 7; x++) {
-                if (heart_small[y][x]) {
-                    // Draw 3x3 block
-                    for (int i = 0; i < 3; i++) {
-                        for (int j = 0; j < 3; j++) {
-                            BSP_OLED_DrawPixel(50 + x*3 + i, 25 + y*3 + j, 1);
-                        }
-                    }
-                }
-            }
-        }
-        BSP_OLED_Update();
-        BSP_Delay_ms(200);
+    PT_BEGIN(pt);
 
-        // Draw big
-        BSP_OLED_Clear();
-        for (int y = 0; y < 5; y++) {
-            for (int x = 0; x < 7; x++) {
-                if (heart_small[y][x]) {
-                    // Draw 5x5 block
-                    for (int i = 0; i < 5; i++) {
-                        for (int j = 0; j < 5; j++) {
-                            BSP_OLED_DrawPixel(45 + x*5 + i, 20 + y*5 + j, 1);
-                        }
-                    }
-                }
-            }
-        }
-        BSP_OLED_Update();
-        BSP_Delay_ms(200);
-    }
+    BSP_OLED_PlayerInit(&player, &Anim_Heart, 5);
+    PT_WAIT_WHILE(pt, PT_SCHEDULE(BSP_OLED_PlayerRun(&player)));
+
+    PT_END(pt);
 }
 
 void Show_Alarm(void) {
@@ -487,9 +1139,7 @@ void Show_Alarm(void) {
         BSP_Delay_ms(300);
 
         // Flash 2 (inverted - all white)
-        for (int j = 0; j < 1024; j++) {
-            OLED_Buffer[j] = 0xFF;  // All white
-        }
+        BSP_OLED_FillRect(0, 0, OLED_WIDTH, OLED_HEIGHT, OLED_PIXEL_ON);
         BSP_OLED_Update();
         BSP_Delay_ms(300);
     }
@@ -518,29 +1168,15 @@ void Countdown(uint8_t seconds) {
 void Show_Battery(uint8_t percent) {
     BSP_OLED_Clear();
 
-    // Draw battery outline
-    for (int x = 30; x < 100; x++) {
-        BSP_OLED_DrawPixel(x, 20, 1);  // Top
-        BSP_OLED_DrawPixel(x, 40, 1);  // Bottom
-    }
-    for (int y = 20; y <= 40; y++) {
-        BSP_OLED_DrawPixel(30, y, 1);  // Left
-        BSP_OLED_DrawPixel(100, y, 1); // Right
-    }
+    // Draw battery outline: x 30..100, y 20..40
+    BSP_OLED_DrawRect(30, 20, 71, 21, OLED_PIXEL_ON);
 
     // Battery tip
-    for (int y = 26; y <= 34; y++) {
-        BSP_OLED_DrawPixel(101, y, 1);
-        BSP_OLED_DrawPixel(102, y, 1);
-    }
+    BSP_OLED_FillRect(101, 26, 2, 9, OLED_PIXEL_ON);
 
     // Fill based on percentage
     int fill = (percent * 66) / 100;  // 66 pixels width
-    for (int x = 32; x < 32 + fill; x++) {
-        for (int y = 22; y < 39; y++) {
-            BSP_OLED_DrawPixel(x, y, 1);
-        }
-    }
+    BSP_OLED_FillRect(32, 22, fill, 17, OLED_PIXEL_ON);
 
     // Show percentage
     OLED_Printf(50, 50, "%d%%", percent);
@@ -16,6 +16,7 @@
 #include "bsp_lcd.h"
 #include "bsp_keypad.h"
 #include "bsp_delay.h"
+#include "bsp_timebase.h"
 #include "bsp_button.h"
 #include "bsp_uart2_debug.h"
 
@@ -23,6 +24,7 @@ void app_init(void) {
 	/* 1. System Core (Clock & Basic Timing) */
 
 	    BSP_Delay_Init();
+	    BSP_Timebase_Init();    // 1 ms SysTick + 64-bit us clock on TIM2
 	    USART2_GPIOInit();
 	    USART2_Init();
 	    BSP_Delay_100ms();
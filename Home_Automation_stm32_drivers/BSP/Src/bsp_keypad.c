@@ -8,7 +8,10 @@
 #include "bsp_keypad.h"
 #include "stm32f446xx.h"
 #include "stm32f446xx_gpio_driver.h"
+#include "stm32f446xx_timer_driver.h"
 #include "config.h"
+#include "bsp_timebase.h"
+#include "profiler.h"
 #include <string.h>
 
 /* ===== Keypad Character Map ===== */
@@ -27,47 +30,99 @@ static const uint8_t ROW_PINS[4] = {
     KEYPAD_R3_PIN
 };
 
-/* ===== Column Pins Array ===== */
-static const uint8_t COL_PINS[4] = {
-    KEYPAD_C0_PIN, 
-    KEYPAD_C1_PIN, 
-    KEYPAD_C2_PIN, 
-    KEYPAD_C3_PIN
-};
+/* The columns are read in one go: they must be adjacent, C0 lowest */
+#if (KEYPAD_C1_PIN != KEYPAD_C0_PIN + 1) || (KEYPAD_C2_PIN != KEYPAD_C0_PIN + 2) || \
+    (KEYPAD_C3_PIN != KEYPAD_C0_PIN + 3)
+#error "keypad columns must be four adjacent pins, C0 first"
+#endif
 
-void Keypad_Init(void)
+/* A scan is the column read plus one tick per row */
+#if KEYPAD_SCAN_TICKS != 5U
+#error "KEYPAD_SCAN_TICKS must be 5: one column read, then the four rows"
+#endif
+
+/* ===== Keypad Pins: rows and columns open-drain with pull-up ===== */
+static const GPIO_Handle_t KEYPAD_PINS[] = { BOARD_PINS_KEYPAD };
+
+#define KEYPAD_KEYS             16U
+#define KEYPAD_QUEUE_MASK       (KEYPAD_QUEUE_SIZE - 1U)
+#define KEYPAD_LONG_SCANS       (KEYPAD_LONG_PRESS_MS / KEYPAD_SCAN_PERIOD_MS)
+#define KEYPAD_REPEAT_SCANS     (KEYPAD_REPEAT_MS / KEYPAD_SCAN_PERIOD_MS)
+
+/* Orders the slot write before the index publish (and vice versa) */
+#if defined(__arm__)
+#define KEYPAD_BARRIER()        __asm volatile ("dmb" ::: "memory")
+#else
+#define KEYPAD_BARRIER()        __atomic_thread_fence(__ATOMIC_SEQ_CST)    /* host builds */
+#endif
+
+/* Masks interrupts around the few thread-side writes the scan must not split */
+#if defined(__arm__)
+static inline uint32_t Keypad_Lock(void)
 {
-    GPIO_Handle_t keypad_gpio;
-    memset(&keypad_gpio, 0, sizeof(keypad_gpio));
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask" : "=r" (primask));
+    __asm volatile ("cpsid i" ::: "memory");
+    return primask;
+}
 
-    // Enable Port Clock
-    GPIOB_PCLK_EN();
+static inline void Keypad_Unlock(uint32_t primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+#else
+static inline uint32_t Keypad_Lock(void) { return 0; }
+static inline void Keypad_Unlock(uint32_t primask) { (void)primask; }
+#endif
 
-    // Configure Rows as Output
-    keypad_gpio.pGPIOx = KEYPAD_ROW_PORT;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+/* ===== DEBOUNCE STATE OF EACH KEY ===== */
+typedef enum {
+    KEYSTATE_UP = 0,
+    KEYSTATE_PRESSING,          // contact seen, not yet KEYPAD_DEBOUNCE_SCANS in a row
+    KEYSTATE_DOWN,
+    KEYSTATE_RELEASING          // open seen, not yet KEYPAD_DEBOUNCE_SCANS in a row
+} KeyState_t;
 
-    uint8_t rows[] = {KEYPAD_R0_PIN, KEYPAD_R1_PIN, KEYPAD_R2_PIN, KEYPAD_R3_PIN};
-    for(int i = 0; i < 4; i++) {
-        keypad_gpio.GPIO_PinConfig.GPIO_PinNumber = rows[i];
-        GPIO_Init(&keypad_gpio);
-        // Default rows HIGH (Keypad logic expects current row to pull LOW)
-        GPIO_WriteToOutputPin(KEYPAD_ROW_PORT, rows[i], GPIO_PIN_SET);
-    }
+typedef struct {
+    uint8_t  state;             // KeyState_t
+    uint8_t  count;             // equal scans in a row (PRESSING, RELEASING)
+    uint32_t heldScans;         // scans since the press was accepted
+    uint32_t since;             // now_us() of the first contact
+} KeyDebounce_t;
 
-    // Configure Columns as Input with Pull-up
-    keypad_gpio.pGPIOx = KEYPAD_COL_PORT;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_IN;
-    keypad_gpio.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+static KeyDebounce_t s_keys[KEYPAD_KEYS];
+static uint16_t s_active = 0;                  // keys not in KEYSTATE_UP
+static volatile bool s_suppress = false;       // Keypad_Flush: no events until all keys are up
+static KeypadStats_t s_stats;
 
-    uint8_t cols[] = {KEYPAD_C0_PIN, KEYPAD_C1_PIN, KEYPAD_C2_PIN, KEYPAD_C3_PIN};
-    for(int i = 0; i < 4; i++) {
-        keypad_gpio.GPIO_PinConfig.GPIO_PinNumber = cols[i];
-        GPIO_Init(&keypad_gpio);
-    }
+/* ===== SCAN STATE (timer interrupt) ===== */
+static uint8_t s_tick = 0;                     // timer interrupt of the scan, 0..KEYPAD_SCAN_TICKS-1
+static bool s_walking = false;                 // a key was down at the column read: rows being read
+static uint16_t s_scanKeys = 0;                // rows read so far in this scan
+static bool s_parked = false;                  // matrix turned around, rows settling
+static volatile bool s_asleep = false;         // timer stopped, row edges armed
+
+/* ===== EVENT QUEUE (timer interrupt -> FSM) ===== */
+static KeypadEvent_t s_queue[KEYPAD_QUEUE_SIZE];
+static volatile uint32_t s_qHead = 0;          // written by the interrupt only
+static volatile uint32_t s_qTail = 0;          // written by the consumer only
+
+static volatile char s_injected_key = KEYPAD_NO_KEY;
+
+void Keypad_Init(void)
+{
+    GPIO_InitGroup(KEYPAD_PINS, GPIO_PIN_COUNT(KEYPAD_PINS));
+
+    // Columns released, rows idle LOW: a key pulls its column down until
+    // the scan finds it
+    GPIO_SetPins(KEYPAD_COL_PORT, KEYPAD_COL_MASK);
+    GPIO_ResetPins(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+
+    // Scanning from the start; with no key down it parks after one scan
+    TIMER_PeriodicInit(KEYPAD_TIMER, KEYPAD_TIMER_HZ,
+                       (uint16_t)(KEYPAD_TICK_US / (1000000U / KEYPAD_TIMER_HZ)));
+    TIMER_IRQPriorityConfig(KEYPAD_TIMER_IRQ, NVIC_IRQ_PRI15);
+    TIMER_IRQInterruptConfig(KEYPAD_TIMER_IRQ, ENABLE);
 }
 
 /* ===== Simple Delay Function ===== */
@@ -76,49 +131,381 @@ void Keypad_Delay(uint32_t delay)
     for(uint32_t i = 0; i < delay * 1000; i++);
 }
 
+/* ===== PARKING =====
+ * With every key up the matrix is turned around: rows released, columns
+ * LOW. A key then pulls its row down, and the falling edge of the row's
+ * EXTI line restarts the scan. The timer stays off meanwhile.
+ */
+static void Keypad_Unpark(void);
 
-/* ===== GET KEY PRESS ===== */
-char Keypad_GetKey(void)
+/* Row edge while parked: a key came down */
+static void Keypad_OnRowEdge(uint8_t Line, uint8_t Level)
+{
+    (void)Line;
+    (void)Level;
+
+    // Edges of several rows may be served in one go, the first one wakes
+    if(s_asleep)
+    {
+        Keypad_Unpark();
+    }
+}
+
+/* No key down or debouncing: turn the matrix around, the rows settle until
+ * the next tick */
+static void Keypad_Park(void)
+{
+    GPIO_SetPinsFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+    GPIO_ResetPinsFast(KEYPAD_COL_PORT, KEYPAD_COL_MASK);
+    s_parked = true;
+}
+
+/* The tick after Keypad_Park(): all rows HIGH stops the timer and arms the
+ * row edges, a row LOW is a key that came down meanwhile */
+static void Keypad_Sleep(void)
+{
+    if((KEYPAD_ROW_PORT->IDR & KEYPAD_ROW_MASK) == KEYPAD_ROW_MASK)
+    {
+        TIMER_Disable(KEYPAD_TIMER);
+        s_asleep = true;
+        for(uint8_t row = 0; row < 4; row++)
+        {
+            GPIO_EXTI_Register(KEYPAD_ROW_PORT, ROW_PINS[row], GPIO_MODE_IT_FT, Keypad_OnRowEdge);
+        }
+
+        // A key that closed before its line was armed gives no edge
+        if((KEYPAD_ROW_PORT->IDR & KEYPAD_ROW_MASK) == KEYPAD_ROW_MASK)
+        {
+            return;
+        }
+    }
+    Keypad_Unpark();
+}
+
+/* Back to scanning: columns released, rows LOW, a scan from its first tick */
+static void Keypad_Unpark(void)
+{
+    GPIO_SetPinsFast(KEYPAD_COL_PORT, KEYPAD_COL_MASK);
+    GPIO_ResetPinsFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+    s_parked = false;
+    s_tick = 0;
+
+    if(s_asleep)
+    {
+        s_asleep = false;
+        for(uint8_t row = 0; row < 4; row++)
+        {
+            GPIO_EXTI_Unregister(ROW_PINS[row]);
+        }
+
+        // The columns settle for a whole tick before they are read
+        TIMER_SetCounter(KEYPAD_TIMER, 0);
+        TIMER_ClearFlag(KEYPAD_TIMER, TIMER_SR_UIF);
+        TIMER_Enable(KEYPAD_TIMER);
+    }
+}
+
+/* ===== MATRIX SCAN =====
+ * One timer interrupt of a scan. The first reads the columns with all rows
+ * LOW: with no key down that one read is the whole scan. Otherwise every
+ * following tick reads the row the tick before selected and selects the
+ * next (in one BSRR write, its four columns in one IDR read), so each row
+ * settles for a tick and the interrupt never waits. The last tick runs the
+ * keys, bit 4 * row + col, through the debounce engine.
+ */
+static void Keypad_Tick(void)
+{
+    if(s_parked)
+    {
+        Keypad_Sleep();
+        return;
+    }
+
+    if(s_tick == 0)
+    {
+        s_scanKeys = 0;
+        if((KEYPAD_COL_PORT->IDR & KEYPAD_COL_MASK) != KEYPAD_COL_MASK)
+        {
+            s_stats.fullScans++;
+            s_walking = true;
+            GPIO_WriteMaskedFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK,
+                                 KEYPAD_ROW_MASK & (uint16_t)~GPIO_PIN_MASK(ROW_PINS[0]));
+        }
+    }
+    else if(s_walking)
+    {
+        uint8_t row = s_tick - 1U;
+
+        // A LOW column is a key down on the row selected last tick
+        s_scanKeys |= (uint16_t)(((~KEYPAD_COL_PORT->IDR >> KEYPAD_C0_PIN) & 0xFU) << (row * 4U));
+
+        if(row < 3U)
+        {
+            // Next row LOW, the others released, in one write
+            GPIO_WriteMaskedFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK,
+                                 KEYPAD_ROW_MASK & (uint16_t)~GPIO_PIN_MASK(ROW_PINS[row + 1U]));
+        }
+        else
+        {
+            // Back to idle: all rows LOW
+            GPIO_ResetPinsFast(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK);
+            s_walking = false;
+        }
+    }
+
+    if(++s_tick < KEYPAD_SCAN_TICKS)
+    {
+        return;
+    }
+    s_tick = 0;
+
+    Keypad_Feed(s_scanKeys);
+    if(s_active == 0)
+    {
+        Keypad_Park();
+    }
+}
+
+/* Timer interrupt: one tick of the scan */
+void TIM3_IRQHandler(void)
+{
+    if(TIMER_GetFlagStatus(KEYPAD_TIMER, TIMER_SR_UIF))
+    {
+        TIMER_ClearFlag(KEYPAD_TIMER, TIMER_SR_UIF);
+
+        PROF_BEGIN(PROF_ZONE_KEYPAD_SCAN);
+        Keypad_Tick();
+        PROF_END(PROF_ZONE_KEYPAD_SCAN);
+    }
+}
+
+/* Queue an event of key k (interrupt side) */
+static void Keypad_Post(uint8_t k, KeypadEventType_t type, uint32_t heldScans)
+{
+    uint32_t head = s_qHead;
+    KeypadEvent_t *slot;
+
+    if(s_suppress)
+    {
+        return;
+    }
+    if(head - s_qTail >= KEYPAD_QUEUE_SIZE)
+    {
+        s_stats.dropped++;
+        return;
+    }
+
+    slot = &s_queue[head & KEYPAD_QUEUE_MASK];
+    slot->key = KEYPAD_CHARS[k / 4U][k % 4U];
+    slot->type = (uint8_t)type;
+    slot->heldMs = (uint16_t)((heldScans * KEYPAD_SCAN_PERIOD_MS > 0xFFFFU) ? 0xFFFFU
+                                                                            : heldScans * KEYPAD_SCAN_PERIOD_MS);
+    slot->tick = (uint32_t)now_us();
+
+    KEYPAD_BARRIER();
+    s_qHead = head + 1U;
+    s_stats.events++;
+}
+
+/* One scan of key k through its debounce state machine */
+static void Keypad_Step(uint8_t k, bool down)
 {
-    // Scan each row
-    for(uint8_t row = 0; row < 4; row++)
+    KeyDebounce_t *key = &s_keys[k];
+    uint32_t now;
+
+    switch(key->state)
     {
-        // Set all rows HIGH
-        for(uint8_t r = 0; r < 4; r++)
+    case KEYSTATE_UP:
+        if(!down)
+        {
+            break;
+        }
+        key->since = (uint32_t)now_us();
+        key->count = 0;
+        key->state = KEYSTATE_PRESSING;
+        s_active |= (uint16_t)(1U << k);
+        /* fall through */
+    case KEYSTATE_PRESSING:
+        if(!down)
         {
-            GPIO_WriteToOutputPin(KEYPAD_ROW_PORT, ROW_PINS[r], GPIO_PIN_SET);
+            // Bounce or glitch shorter than the debounce time: nothing happened
+            key->state = KEYSTATE_UP;
+            s_active &= (uint16_t)~(1U << k);
         }
-        
-        // Set current row LOW
-        GPIO_WriteToOutputPin(KEYPAD_ROW_PORT, ROW_PINS[row], GPIO_PIN_RESET);
-        
-        // Small delay for signal stabilization
-        Keypad_Delay(1);
-        
-        // Check each column
-        for(uint8_t col = 0; col < 4; col++)
+        else if(++key->count >= KEYPAD_DEBOUNCE_SCANS)
         {
-            // If column is LOW, key is pressed
-            if(GPIO_ReadFromInputPin(KEYPAD_COL_PORT, COL_PINS[col]) == GPIO_PIN_RESET)
+            key->state = KEYSTATE_DOWN;
+            key->heldScans = 0;
+            now = (uint32_t)now_us();
+            if(now - key->since > s_stats.maxDebounceUs)
             {
-                // Debounce delay
-                Keypad_Delay(20);
-                
-                // Verify key is still pressed
-                if(GPIO_ReadFromInputPin(KEYPAD_COL_PORT, COL_PINS[col]) == GPIO_PIN_RESET)
-                {
-                    // Wait for key release
-                    while(GPIO_ReadFromInputPin(KEYPAD_COL_PORT, COL_PINS[col]) == GPIO_PIN_RESET);
-                    
-                    // Small delay after release
-                    Keypad_Delay(20);
-                    
-                    // Return the pressed key
-                    return KEYPAD_CHARS[row][col];
-                }
+                s_stats.maxDebounceUs = now - key->since;
             }
+            Keypad_Post(k, KEYPAD_EVT_PRESS, 0);
         }
+        break;
+
+    case KEYSTATE_DOWN:
+        if(down)
+        {
+            key->heldScans++;
+            if(key->heldScans == KEYPAD_LONG_SCANS)
+            {
+                Keypad_Post(k, KEYPAD_EVT_LONG, key->heldScans);
+            }
+            else if(key->heldScans > KEYPAD_LONG_SCANS &&
+                    (key->heldScans - KEYPAD_LONG_SCANS) % KEYPAD_REPEAT_SCANS == 0)
+            {
+                Keypad_Post(k, KEYPAD_EVT_REPEAT, key->heldScans);
+            }
+            break;
+        }
+        key->count = 0;
+        key->state = KEYSTATE_RELEASING;
+        /* fall through */
+    case KEYSTATE_RELEASING:
+        key->heldScans++;
+        if(down)
+        {
+            key->state = KEYSTATE_DOWN;     // bounce on release, still held
+        }
+        else if(++key->count >= KEYPAD_DEBOUNCE_SCANS)
+        {
+            key->state = KEYSTATE_UP;
+            s_active &= (uint16_t)~(1U << k);
+            Keypad_Post(k, KEYPAD_EVT_RELEASE, key->heldScans);
+        }
+        break;
+
+    default:
+        key->state = KEYSTATE_UP;
+        s_active &= (uint16_t)~(1U << k);
+        break;
+    }
+}
+
+/* ===== DEBOUNCE ENGINE =====
+ * Runs one scan result (bit 4 * row + col set = key down) through the state
+ * machine of every key that is down or was down, highest bit first. Called
+ * by the timer interrupt every KEYPAD_SCAN_PERIOD_MS while it scans; tests
+ * feed it directly with the timer interrupt disabled.
+ */
+void Keypad_Feed(uint16_t keys)
+{
+    uint32_t work = (uint32_t)(keys | s_active);
+
+    s_stats.scans++;
+    while(work)
+    {
+        uint8_t k = (uint8_t)(31U - (uint32_t)__builtin_clz(work));
+
+        work &= ~(1U << k);
+        Keypad_Step(k, (keys >> k) & 0x1);
+    }
+
+    if(s_suppress && s_active == 0)
+    {
+        s_suppress = false;
+    }
+}
+
+/* ===== KEY EVENTS (thread context) ===== */
+
+/* Takes the oldest key event out of the queue, false if there is none */
+bool Keypad_GetEvent(KeypadEvent_t *evt)
+{
+    uint32_t tail = s_qTail;
+
+    if(tail == s_qHead)
+    {
+        return false;
     }
-    
-    return KEYPAD_NO_KEY; // No key pressed
+
+    KEYPAD_BARRIER();
+    *evt = s_queue[tail & KEYPAD_QUEUE_MASK];
+    KEYPAD_BARRIER();
+    s_qTail = tail + 1U;
+    return true;
+}
+
+/* ===== GET KEY PRESS =====
+ * Non-blocking: returns the key of the next press in the queue, once per
+ * press; releases, long presses and repeats are skipped (Keypad_GetEvent()
+ * has them). Presses are debounced by the timer interrupt, so the rate the
+ * caller polls at only delays them.
+ */
+char Keypad_GetKey(void)
+{
+    KeypadEvent_t evt;
+    char key;
+
+    if(s_injected_key != KEYPAD_NO_KEY)
+    {
+        key = s_injected_key;
+        s_injected_key = KEYPAD_NO_KEY;
+        return key;
+    }
+
+    while(Keypad_GetEvent(&evt))
+    {
+        if(evt.type == KEYPAD_EVT_PRESS)
+        {
+            return evt.key;
+        }
+    }
+    return KEYPAD_NO_KEY;
+}
+
+/* True while the debounce engine has a key down, or one being accepted or
+ * released. The pins are not read: parked, a key wakes the scan first. */
+bool Keypad_AnyKeyDown(void)
+{
+    return s_active != 0;
+}
+
+/* True while the scan timer runs, false while parked with every key up.
+ * Stop mode would freeze the timer in the middle of a key. */
+bool Keypad_IsScanning(void)
+{
+    return !s_asleep;
+}
+
+/* Drops the queued events and ignores the keys held now: they report
+ * nothing, not even their release, until every key is up again */
+void Keypad_Flush(void)
+{
+    uint32_t primask = Keypad_Lock();
+
+    s_qTail = s_qHead;
+    if(s_active != 0)
+    {
+        s_suppress = true;
+    }
+
+    Keypad_Unlock(primask);
+}
+
+const KeypadStats_t *Keypad_GetStats(void)
+{
+    return &s_stats;
+}
+
+void Keypad_ResetStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* ===== KEY INJECTION =====
+ * Feeds a key into the next Keypad_GetKey() call, as if it had been pressed.
+ * Used by on-target tests and remote (UART) control.
+ */
+void Keypad_InjectKey(char key)
+{
+    s_injected_key = key;
+}
+
+/* Returns true while an injected key has not been consumed yet */
+bool Keypad_InjectPending(void)
+{
+    return s_injected_key != KEYPAD_NO_KEY;
 }
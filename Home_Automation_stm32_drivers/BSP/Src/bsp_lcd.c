@@ -6,6 +6,104 @@
 
 #include "bsp_lcd.h"
 #include "bsp_delay.h"// For delays
+#include "profiler.h"
+#include "stm32f446xx_timer_driver.h"
+#include <string.h>
+
+#define LCD_ADDR_UNKNOWN    0xFF    // address counter not known (CGRAM, cursor shift)
+#define LCD_GLASS_UNKNOWN   '\0'    // shadow cell that must be rewritten
+#define LCD_MOVE_COST       1U      // a cursor move is one instruction byte
+#define LCD_CLEAR_COST      8U      // clear: one byte + 2 ms, about 8 bytes of 300 us
+
+// View: what the screen should show, and the shadow of what it shows now
+static char s_view[LCD_ROWS][LCD_COLS] = { "                ", "                " };
+static char s_glass[LCD_ROWS][LCD_COLS];        // unknown until the first clear
+static uint8_t s_addr = LCD_ADDR_UNKNOWN;       // DDRAM address counter
+static LcdBusStats_t s_stats;
+
+// Byte queue of the interrupt driven transport: the caller writes at
+// s_qHead, the LCD_TIMER interrupt sends from s_qTail. A byte leaves the
+// queue once its execution time is over.
+#define LCD_QUEUE_MASK      (LCD_QUEUE_SIZE - 1U)
+#define LCD_ENTRY_DATA      0x100U  // RS = 1
+
+// Orders the queue write before the head publish
+#if defined(__arm__)
+#define LCD_BARRIER()       __asm volatile ("dmb" ::: "memory")
+#else
+#define LCD_BARRIER()       __atomic_thread_fence(__ATOMIC_SEQ_CST)    /* host builds */
+#endif
+
+// Waits for the next interrupt: the LCD_TIMER one is at most
+// LCD_EXEC_CLEAR_US away while bytes are queued. The emulator's time only
+// moves in the delays.
+#if defined(__arm__)
+#define LCD_WAIT_IRQ()      __asm volatile ("wfi")
+#else
+#define LCD_WAIT_IRQ()      BSP_Delay_us(LCD_PULSE_US)
+#endif
+
+typedef enum {
+    LCD_TX_NEXT = 0,                // take the next byte: RS, high nibble, EN high
+    LCD_TX_HIGH_LATCH,              // EN low: high nibble latched
+    LCD_TX_LOW,                     // low nibble, EN high
+    LCD_TX_LOW_LATCH                // EN low: byte latched, execution time
+} LcdTxPhase_t;
+
+static uint16_t s_queue[LCD_QUEUE_SIZE];
+static volatile uint16_t s_qHead, s_qTail;
+static volatile bool s_txRunning = false;
+static LcdTxPhase_t s_txPhase = LCD_TX_NEXT;
+static bool s_async = false;
+static LcdQueueStats_t s_qStats;
+
+// RS, EN and D4-D7, configured in one pass
+static const GPIO_Handle_t s_lcdPins[] = { BOARD_PINS_LCD };
+
+// D4-D7 levels of each nibble, so a nibble is one masked write
+#define LCD_NIBBLE_PINS(n)  ((((n) & 0x1) ? GPIO_PIN_MASK(LCD_D4_PIN) : 0U) | \
+                             (((n) & 0x2) ? GPIO_PIN_MASK(LCD_D5_PIN) : 0U) | \
+                             (((n) & 0x4) ? GPIO_PIN_MASK(LCD_D6_PIN) : 0U) | \
+                             (((n) & 0x8) ? GPIO_PIN_MASK(LCD_D7_PIN) : 0U))
+
+static const uint16_t s_nibblePins[16] = {
+    LCD_NIBBLE_PINS(0),  LCD_NIBBLE_PINS(1),  LCD_NIBBLE_PINS(2),  LCD_NIBBLE_PINS(3),
+    LCD_NIBBLE_PINS(4),  LCD_NIBBLE_PINS(5),  LCD_NIBBLE_PINS(6),  LCD_NIBBLE_PINS(7),
+    LCD_NIBBLE_PINS(8),  LCD_NIBBLE_PINS(9),  LCD_NIBBLE_PINS(10), LCD_NIBBLE_PINS(11),
+    LCD_NIBBLE_PINS(12), LCD_NIBBLE_PINS(13), LCD_NIBBLE_PINS(14), LCD_NIBBLE_PINS(15)
+};
+
+// Keeps the shadow and the address counter in step with a byte sent
+// (entry mode 06h: increment, no display shift)
+static void LCD_Track(uint8_t value, uint8_t is_data)
+{
+    if (is_data) {
+        if (s_addr == LCD_ADDR_UNKNOWN) return;
+
+        uint8_t col = s_addr & 0x3F;
+        if (col < LCD_COLS) s_glass[(s_addr & 0x40) ? 1 : 0][col] = (char)value;
+        s_addr = (col < 0x27) ? (uint8_t)(s_addr + 1) : LCD_ADDR_UNKNOWN;
+        return;
+    }
+
+    if (value & 0x80) {                         // set DDRAM address
+        s_addr = value & 0x7F;
+    } else if (value & 0x40) {                  // set CGRAM address
+        s_addr = LCD_ADDR_UNKNOWN;
+    } else if (value & 0x20) {                  // function set
+    } else if (value & 0x10) {                  // cursor or display shift
+        s_addr = LCD_ADDR_UNKNOWN;
+        if (value & 0x08) memset(s_glass, LCD_GLASS_UNKNOWN, sizeof(s_glass));
+    } else if (value & 0x08) {                  // display control
+    } else if (value & 0x04) {                  // entry mode
+        if (value != LCD_CMD_ENTRY_MODE) BSP_LCD_Invalidate();
+    } else if (value & 0x02) {                  // return home
+        s_addr = 0x00;
+    } else if (value & 0x01) {                  // clear
+        memset(s_glass, ' ', sizeof(s_glass));
+        s_addr = 0x00;
+    }
+}
 
 // Private Helper: Pulse the Enable Pin
 static void LCD_EnablePulse(void)
@@ -15,21 +113,109 @@ static void LCD_EnablePulse(void)
     GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_EN_PIN, 0);
     BSP_Delay_us(50); // Added delay after pulse to let LCD think
 }
+// Private Helper: Put 4 bits on D4-D7, all four in one BSRR write
+static void LCD_PutNibble(uint8_t nibble)
+{
+    GPIO_WriteMasked(LCD_DATA_PORT, LCD_DATA_MASK, s_nibblePins[nibble & 0x0F]);
+}
+
 // Private Helper: Send 4 bits to D4-D7
 void LCD_Write4Bits(uint8_t nibble)
 {
-    GPIO_WriteToOutputPin(LCD_DATA_PORT, LCD_D4_PIN, (nibble >> 0) & 0x1);
-    GPIO_WriteToOutputPin(LCD_DATA_PORT, LCD_D5_PIN, (nibble >> 1) & 0x1);
-    GPIO_WriteToOutputPin(LCD_DATA_PORT, LCD_D6_PIN, (nibble >> 2) & 0x1);
-    GPIO_WriteToOutputPin(LCD_DATA_PORT, LCD_D7_PIN, (nibble >> 3) & 0x1);
-
+    LCD_PutNibble(nibble);
     LCD_EnablePulse();
 }
 
+// One step of the interrupt driven transport, then the timer is started
+// for the time the step must hold
+static void LCD_TxStep(void)
+{
+    uint16_t entry = s_queue[s_qTail & LCD_QUEUE_MASK];
+    uint16_t holdUs = LCD_PULSE_US;
+
+    switch (s_txPhase) {
+    case LCD_TX_NEXT:
+        if (s_qTail == s_qHead) {
+            s_txRunning = false;
+            return;
+        }
+        GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_RS_PIN, (entry & LCD_ENTRY_DATA) ? 1 : 0);
+        LCD_PutNibble((uint8_t)(entry >> 4) & 0x0F);
+        GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_EN_PIN, 1);
+        s_txPhase = LCD_TX_HIGH_LATCH;
+        break;
+
+    case LCD_TX_HIGH_LATCH:
+        GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_EN_PIN, 0);
+        s_txPhase = LCD_TX_LOW;
+        break;
+
+    case LCD_TX_LOW:
+        LCD_PutNibble((uint8_t)entry & 0x0F);
+        GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_EN_PIN, 1);
+        s_txPhase = LCD_TX_LOW_LATCH;
+        break;
+
+    case LCD_TX_LOW_LATCH:
+    default:
+        GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_EN_PIN, 0);
+        if (entry == LCD_CMD_CLEAR || entry == LCD_CMD_RETURN_HOME) holdUs = LCD_EXEC_CLEAR_US;
+        else holdUs = LCD_EXEC_US;
+        s_qTail++;
+        s_qStats.sent++;
+        s_txPhase = LCD_TX_NEXT;
+        break;
+    }
+    TIMER_OnePulseStart(LCD_TIMER, holdUs);
+}
+
+void TIM6_DAC_IRQHandler(void)
+{
+    if (TIMER_GetFlagStatus(LCD_TIMER, TIMER_SR_UIF)) {
+        TIMER_ClearFlag(LCD_TIMER, TIMER_SR_UIF);
+        LCD_TxStep();
+    }
+}
+
+// Queues one byte and starts the transport if it is idle. A full queue
+// blocks the caller, asleep, until the interrupt has sent a byte.
+static void LCD_Enqueue(uint8_t value, uint8_t is_data)
+{
+    if ((uint16_t)(s_qHead - s_qTail) >= LCD_QUEUE_SIZE) {
+        s_qStats.overruns++;
+        while ((uint16_t)(s_qHead - s_qTail) >= LCD_QUEUE_SIZE) {
+            LCD_WAIT_IRQ();     // the interrupt makes room
+        }
+    }
+
+    s_queue[s_qHead & LCD_QUEUE_MASK] = value | (is_data ? LCD_ENTRY_DATA : 0);
+    LCD_BARRIER();
+    s_qHead++;
+    s_qStats.queued++;
+
+    TIMER_IRQInterruptConfig(LCD_TIMER_IRQ, DISABLE);
+    uint16_t depth = (uint16_t)(s_qHead - s_qTail);
+    if (depth > s_qStats.maxDepth) s_qStats.maxDepth = depth;
+    if (!s_txRunning) {
+        s_txRunning = true;
+        s_txPhase = LCD_TX_NEXT;
+        TIMER_OnePulseStart(LCD_TIMER, LCD_PULSE_US);
+    }
+    TIMER_IRQInterruptConfig(LCD_TIMER_IRQ, ENABLE);
+}
+
 // Private Helper: Send byte (Split into two 4-bit nibbles)
 // is_data = 1 for Character, 0 for Command
 static void LCD_Send(uint8_t value, uint8_t is_data)
 {
+    LCD_Track(value, is_data);
+    s_stats.bytes++;
+
+    if (s_async) {
+        LCD_Enqueue(value, is_data);
+        return;
+    }
+
     // 1. Set RS (0 = Command, 1 = Data)
     GPIO_WriteToOutputPin(LCD_CTRL_PORT, LCD_RS_PIN, is_data);
 
@@ -45,8 +231,8 @@ static void LCD_Send(uint8_t value, uint8_t is_data)
 
 void BSP_LCD_SendCommand(uint8_t cmd) {
     LCD_Send(cmd, 0);
-    // Clear command needs more time
-    if(cmd == LCD_CMD_CLEAR || cmd == 0x02) {
+    // Clear command needs more time (queued: the interrupt holds it)
+    if(!s_async && (cmd == LCD_CMD_CLEAR || cmd == LCD_CMD_RETURN_HOME)) {
         BSP_Delay_ms(2); 
     }
 }
@@ -56,9 +242,11 @@ void BSP_LCD_SendData(uint8_t data) {
 }
 
 void BSP_LCD_PrintString(char *message) {
+    PROF_BEGIN(PROF_ZONE_LCD_PRINT);
     while (*message) {
         BSP_LCD_SendData((uint8_t)*message++);
     }
+    PROF_END(PROF_ZONE_LCD_PRINT);
 }
 
 void BSP_LCD_SetCursor(uint8_t row, uint8_t col) {
@@ -69,32 +257,101 @@ void BSP_LCD_SetCursor(uint8_t row, uint8_t col) {
     BSP_LCD_SendCommand(0x80 | address);
 }
 
+void BSP_LCD_WriteAt(uint8_t row, uint8_t col, const char *text) {
+    if (row >= LCD_ROWS) return;
+    while (col < LCD_COLS && *text) {
+        s_view[row][col++] = *text++;
+    }
+}
+
+void BSP_LCD_SetLine(uint8_t row, const char *text) {
+    if (row >= LCD_ROWS) return;
+    memset(s_view[row], ' ', LCD_COLS);
+    BSP_LCD_WriteAt(row, 0, text);
+}
+
+void BSP_LCD_ClearView(void) {
+    memset(s_view, ' ', sizeof(s_view));
+}
+
+void BSP_LCD_Invalidate(void) {
+    memset(s_glass, LCD_GLASS_UNKNOWN, sizeof(s_glass));
+    s_addr = LCD_ADDR_UNKNOWN;
+}
+
+const LcdBusStats_t *BSP_LCD_GetBusStats(void) {
+    return &s_stats;
+}
+
+void BSP_LCD_ResetBusStats(void) {
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+// Walks the cells where the view differs from the glass (or from a blank
+// glass after a clear) and returns the bytes that takes; sends them if asked.
+// The gap behind a changed cell is rewritten when that is not dearer than
+// a cursor move: its characters are unchanged, so rewriting them is harmless.
+static uint16_t LCD_Walk(uint8_t afterClear, uint8_t send)
+{
+    uint16_t bytes = 0;
+    uint8_t addr = afterClear ? 0x00 : s_addr;
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        uint8_t base = (row == 0) ? 0x00 : 0x40;
+
+        for (uint8_t col = 0; col < LCD_COLS; col++) {
+            char shown = afterClear ? ' ' : s_glass[row][col];
+            uint8_t target = base + col;
+
+            if (s_view[row][col] == shown) continue;
+
+            if (addr != target) {
+                if (addr >= base && addr < target && (uint8_t)(target - addr) <= LCD_MOVE_COST) {
+                    for (; addr < target; addr++) {
+                        bytes++;
+                        if (send) {
+                            BSP_LCD_SendData((uint8_t)s_view[row][addr - base]);
+                            s_stats.chars++;
+                        }
+                    }
+                } else {
+                    bytes += LCD_MOVE_COST;
+                    if (send) {
+                        BSP_LCD_SetCursor(row, col);
+                        s_stats.moves++;
+                    }
+                }
+            }
+
+            bytes++;
+            if (send) {
+                BSP_LCD_SendData((uint8_t)s_view[row][col]);
+                s_stats.chars++;
+            }
+            addr = target + 1;
+        }
+    }
+    return bytes;
+}
+
+void BSP_LCD_Flush(void) {
+    uint16_t direct = LCD_Walk(0, 0);
+    if (direct == 0) return;
+
+    PROF_BEGIN(PROF_ZONE_LCD_PRINT);
+    s_stats.flushes++;
+    if (LCD_CLEAR_COST + LCD_Walk(1, 0) < direct) {
+        BSP_LCD_SendCommand(LCD_CMD_CLEAR);
+        s_stats.clears++;
+    }
+    LCD_Walk(0, 1);
+    PROF_END(PROF_ZONE_LCD_PRINT);
+}
+
 void BSP_LCD_Init(void)
 {
-    // 1. Initialize GPIO Pins
-    GPIO_Handle_t lcd_pin;
-    lcd_pin.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
-    lcd_pin.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    lcd_pin.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
-    lcd_pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
-
-    // Control Pins (PC0, PC1)
-    lcd_pin.pGPIOx = LCD_CTRL_PORT;
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_RS_PIN;
-    GPIO_Init(&lcd_pin);
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_EN_PIN;
-    GPIO_Init(&lcd_pin);
-
-    // Data Pins (PC2-PC5)
-    lcd_pin.pGPIOx = LCD_DATA_PORT;
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_D4_PIN;
-    GPIO_Init(&lcd_pin);
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_D5_PIN;
-    GPIO_Init(&lcd_pin);
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_D6_PIN;
-    GPIO_Init(&lcd_pin);
-    lcd_pin.GPIO_PinConfig.GPIO_PinNumber = LCD_D7_PIN;
-    GPIO_Init(&lcd_pin);
+    // 1. Initialize GPIO Pins (RS, EN, D4-D7)
+    GPIO_InitGroup(s_lcdPins, GPIO_PIN_COUNT(s_lcdPins));
 
     // 2. LCD Startup Sequence
     // Wait >15ms after power up
@@ -126,4 +383,39 @@ void BSP_LCD_Init(void)
     BSP_LCD_SendCommand(LCD_CMD_DISPLAY_ON);   // Display ON
     BSP_LCD_SendCommand(LCD_CMD_CLEAR);        // Clear Screen
     BSP_LCD_SendCommand(LCD_CMD_ENTRY_MODE);   // Auto-increment cursor
+
+    // 4. Transport timer: 1 us ticks at this PCLK1, interrupt off until async
+    TIMER_OnePulseInit(LCD_TIMER, 1000000U);
+    TIMER_IRQPriorityConfig(LCD_TIMER_IRQ, NVIC_IRQ_PRI15);
+}
+
+void BSP_LCD_SetAsync(bool enable) {
+    if (enable == s_async) return;
+
+    if (enable) {
+        TIMER_IRQInterruptConfig(LCD_TIMER_IRQ, ENABLE);
+        s_async = true;
+    } else {
+        BSP_LCD_WaitIdle();
+        s_async = false;
+        TIMER_IRQInterruptConfig(LCD_TIMER_IRQ, DISABLE);
+    }
+}
+
+void BSP_LCD_WaitIdle(void) {
+    while (s_txRunning) {
+        LCD_WAIT_IRQ();
+    }
+}
+
+uint16_t BSP_LCD_QueueDepth(void) {
+    return (uint16_t)(s_qHead - s_qTail);
+}
+
+const LcdQueueStats_t *BSP_LCD_GetQueueStats(void) {
+    return &s_qStats;
+}
+
+void BSP_LCD_ResetQueueStats(void) {
+    memset(&s_qStats, 0, sizeof(s_qStats));
 }
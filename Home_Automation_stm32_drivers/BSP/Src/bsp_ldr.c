@@ -7,6 +7,7 @@
 
 #include <bsp_ldr.h>
 #include "config.h"
+#include "profiler.h"
 
 /* ===== LDR/ADC Initialization ===== */
 void BSP_LDR_init(void) {
@@ -43,6 +44,7 @@ void BSP_LDR_init(void) {
  */
 uint16_t BSP_Sensor_ReadLDR(uint8_t channel)
 {
+    PROF_BEGIN(PROF_ZONE_LDR_READ);
     ADC_Handle_t tempHandle;
     tempHandle.pADCx = SENSOR_ADC;
 
@@ -58,5 +60,7 @@ uint16_t BSP_Sensor_ReadLDR(uint8_t channel)
     while(ADC_GetFlagStatus(SENSOR_ADC, ADC_SR_EOC) == RESET);
 
     // 4. Return the result from Data Register
-    return ADC_ReadValue(SENSOR_ADC);
+    uint16_t value = ADC_ReadValue(SENSOR_ADC);
+    PROF_END(PROF_ZONE_LDR_READ);
+    return value;
 }
@@ -8,26 +8,11 @@
 #include "bsp_led.h"
 
 /* ===== LED Initialization ===== */
-void BSP_LED_Init(void){
-    GPIO_Handle_t led_pin;
-
-    led_pin.pGPIOx = LED_PORT;
-    led_pin.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
-    led_pin.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_LOW;
-    led_pin.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    led_pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
-
-    // Green LED
-    led_pin.GPIO_PinConfig.GPIO_PinNumber = LED_GREEN_PIN;
-    GPIO_Init(&led_pin);
+static const GPIO_Handle_t s_led_pins[] = { BOARD_PINS_LED };
 
-    // Red LED
-    led_pin.GPIO_PinConfig.GPIO_PinNumber = LED_RED_PIN;
-    GPIO_Init(&led_pin);
-
-    // White LED
-    led_pin.GPIO_PinConfig.GPIO_PinNumber = LED_WHITE_PIN;
-    GPIO_Init(&led_pin);
+void BSP_LED_Init(void){
+    // Green, red and white LEDs in one pass
+    GPIO_InitGroup(s_led_pins, GPIO_PIN_COUNT(s_led_pins));
 }
 
 /* ================= LED CONTROL FUNCTIONS ================= */
@@ -72,8 +57,17 @@ void BSP_LED_Toggle(uint8_t PinNumber)
  */
 void BSP_LED_AllOff(void)
 {
-    GPIO_WriteToOutputPin(LED_PORT, LED_GREEN_PIN, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(LED_PORT, LED_RED_PIN, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(LED_PORT, LED_WHITE_PIN, GPIO_PIN_RESET);
+    GPIO_ResetPins(LED_PORT, LED_ALL_MASK);
+}
+
+/**
+ * @brief Set the whole LED bank at once
+ * @param OnMask: LEDs to turn ON (GPIO_PIN_MASK of their pins), the others go OFF
+ *
+ * Usage: BSP_LED_SetMask(GPIO_PIN_MASK(LED_GREEN_PIN));
+ */
+void BSP_LED_SetMask(uint16_t OnMask)
+{
+    GPIO_WriteMasked(LED_PORT, LED_ALL_MASK, OnMask);
 }
 
@@ -0,0 +1,469 @@
+/*
+ * bsp_lowpower.c
+ *
+ * Created on: Feb 21, 2026
+ * Author: Rahul B.
+ * Description: Low-power primitives - WFI sleep and Stop mode with timed wakeup
+ *
+ * The RTC runs from LSI with PREDIV_A = 8 so its sub-second register (SSR)
+ * ticks every ~250 us; that is the resolution of an early Stop wake-up and
+ * of the LSI calibration. The calendar still counts 1 Hz seconds.
+ */
+
+#include "bsp_lowpower.h"
+#include "bsp_timebase.h"
+#include "stm32f446xx_rcc_driver.h"
+#include "stm32f446xx_timer_driver.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "stm32f446xx_usart_driver.h"
+
+/* ===== PRIVATE DEFINES ===== */
+#define LP_RTC_PREDIV_A         8U      /* ck_apre = LSI / 8   (~4 kHz) */
+#define LP_RTC_PREDIV_S         4000U   /* ck_spre = ck_apre / 4000 (1 Hz) */
+#define LP_EXTI_LINE_RTC_WKUP   22U
+#define LP_TIMEOUT              100000U /* register poll loops */
+
+/* Raw bit positions, as in the RTC and RCC drivers */
+#define LP_RCC_CSR_LSION        (1U << 0)
+#define LP_RCC_CSR_LSIRDY       (1U << 1)
+#define LP_RCC_BDCR_RTCSEL_MSK  (3U << 8)
+#define LP_RCC_BDCR_RTCSEL_LSI  (2U << 8)
+#define LP_RCC_BDCR_RTCEN       (1U << 15)
+#define LP_RCC_BDCR_BDRST       (1U << 16)
+#define LP_PWR_CR_LPDS          (1U << 0)
+#define LP_PWR_CR_PDDS          (1U << 1)
+#define LP_PWR_CR_CWUF          (1U << 2)
+#define LP_PWR_CR_DBP           (1U << 8)
+#define LP_RTC_CR_BYPSHAD       (1U << 5)
+#define LP_RTC_CR_WUTE          (1U << 10)
+#define LP_RTC_CR_WUTIE         (1U << 14)
+#define LP_RTC_ISR_WUTWF        (1U << 2)
+#define LP_RTC_ISR_INITF        (1U << 6)
+#define LP_RTC_ISR_INIT         (1U << 7)
+#define LP_RTC_ISR_WUTF         (1U << 10)
+
+/* ===== PRIVATE STATE ===== */
+
+/* Clock tree in use before Stop, put back by BSP_LowPower_RestoreClocks() */
+typedef struct {
+    uint32_t cfgr;
+    uint32_t pllcfgr;
+    uint32_t latency;
+    bool     hseBypass;
+} LowPowerClocks_t;
+
+static LowPowerClocks_t s_saved;
+static volatile bool s_restorePending = false;
+static bool     s_stopReady = false;
+static uint32_t s_lsiHz     = 0;
+
+/* ===== PRIVATE HELPERS ===== */
+
+static inline void LowPower_Wfi(void)
+{
+    __asm volatile ("dsb" ::: "memory");
+    __asm volatile ("wfi");
+    __asm volatile ("isb" ::: "memory");
+}
+
+static void LowPower_RtcUnlock(void)
+{
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+}
+
+static void LowPower_RtcLock(void)
+{
+    RTC->WPR = 0xFF;
+}
+
+static bool LowPower_WaitSet(volatile uint32_t *reg, uint32_t mask)
+{
+    for (uint32_t i = 0; i < LP_TIMEOUT; i++)
+    {
+        if (*reg & mask)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Monotonic count of ck_apre ticks within the current day.
+ * @note  BYPSHAD is set, so SSR and TR are read live: re-read until SSR
+ *        is stable so both belong to the same tick.
+ */
+static uint32_t LowPower_RtcTicks(void)
+{
+    uint32_t ssr, tr;
+    uint32_t sync = (RTC->PRER & 0x7FFFU) + 1U;
+
+    do
+    {
+        ssr = RTC->SSR;
+        tr  = RTC->TR;
+    } while (ssr != RTC->SSR);
+
+    uint32_t sec = ((tr >> 20) & 0x3U) * 36000U + ((tr >> 16) & 0xFU) * 3600U +
+                   ((tr >> 12) & 0x7U) * 600U   + ((tr >> 8)  & 0xFU) * 60U   +
+                   ((tr >> 4)  & 0x7U) * 10U    +  (tr        & 0xFU);
+
+    return (sec * sync) + (sync - 1U - ssr);
+}
+
+/**
+ * @brief Take the RTC over: LSI clock, fine sub-second prescaler,
+ *        shadow registers bypassed. The calendar value is kept.
+ */
+static bool LowPower_RtcSetup(void)
+{
+    RCC->APB1ENR |= (1U << 28);                 /* PWR clock */
+    PWR->CR |= LP_PWR_CR_DBP;
+
+    RCC->CSR |= LP_RCC_CSR_LSION;
+    if (!LowPower_WaitSet(&RCC->CSR, LP_RCC_CSR_LSIRDY))
+    {
+        return false;
+    }
+
+    uint32_t sel = RCC->BDCR & LP_RCC_BDCR_RTCSEL_MSK;
+    if ((sel != 0U) && (sel != LP_RCC_BDCR_RTCSEL_LSI))
+    {
+        /* RTCSEL is write-once: only a backup domain reset frees it */
+        RCC->BDCR |= LP_RCC_BDCR_BDRST;
+        RCC->BDCR &= ~LP_RCC_BDCR_BDRST;
+    }
+    RCC->BDCR = (RCC->BDCR & ~LP_RCC_BDCR_RTCSEL_MSK) | LP_RCC_BDCR_RTCSEL_LSI;
+    RCC->BDCR |= LP_RCC_BDCR_RTCEN;
+
+    LowPower_RtcUnlock();
+    RTC->ISR |= LP_RTC_ISR_INIT;
+    if (!LowPower_WaitSet(&RTC->ISR, LP_RTC_ISR_INITF))
+    {
+        LowPower_RtcLock();
+        return false;
+    }
+    /* PREDIV_S first, then PREDIV_A (two separate writes) */
+    RTC->PRER = (LP_RTC_PREDIV_S - 1U);
+    RTC->PRER = ((LP_RTC_PREDIV_A - 1U) << 16) | (LP_RTC_PREDIV_S - 1U);
+    RTC->ISR &= ~LP_RTC_ISR_INIT;
+    RTC->CR |= LP_RTC_CR_BYPSHAD;
+    LowPower_RtcLock();
+
+    return true;
+}
+
+/**
+ * @brief Measure LSI against TIM2 (1 MHz). Returns Hz, 0 if the RTC is dead.
+ * @note  Counts whole SSR steps between two SSR edges, for at least
+ *        LOWPOWER_LSI_CAL_US and 64 steps. LSI is only +/-50 % specified.
+ */
+static uint32_t LowPower_CalibrateLsi(void)
+{
+    uint32_t async = ((RTC->PRER >> 16) & 0x7FU) + 1U;
+    uint32_t sync  = (RTC->PRER & 0x7FFFU) + 1U;
+    uint32_t steps = 0;
+
+    /* Align on an SSR edge */
+    uint32_t ss = RTC->SSR;
+    uint64_t t0 = now_us();
+    while (RTC->SSR == ss)
+    {
+        if ((now_us() - t0) > LOWPOWER_LSI_CAL_US)
+        {
+            return 0;
+        }
+    }
+
+    ss = RTC->SSR;
+    t0 = now_us();
+    uint64_t t1 = t0;
+
+    while (((t1 - t0) < LOWPOWER_LSI_CAL_US) || (steps < 64U))
+    {
+        uint32_t s2 = RTC->SSR;
+        if (s2 != ss)
+        {
+            steps += (ss + sync - s2) % sync;    /* SSR counts down */
+            ss = s2;
+            t1 = now_us();
+        }
+        else if ((now_us() - t1) > LOWPOWER_LSI_CAL_US)
+        {
+            return 0;
+        }
+    }
+
+    return (uint32_t)(((uint64_t)steps * async * 1000000ULL) / (t1 - t0));
+}
+
+static void LowPower_WakeupClear(void)
+{
+    RTC->ISR &= ~LP_RTC_ISR_WUTF;               /* rc_w0 */
+    EXTI->PR = (1U << LP_EXTI_LINE_RTC_WKUP);
+}
+
+/**
+ * @brief Arm the RTC wakeup timer for ticks periods of RTCCLK/16.
+ */
+static bool LowPower_WakeupArm(uint32_t ticks)
+{
+    LowPower_RtcUnlock();
+    RTC->CR &= ~(LP_RTC_CR_WUTE | LP_RTC_CR_WUTIE);
+    if (!LowPower_WaitSet(&RTC->ISR, LP_RTC_ISR_WUTWF))
+    {
+        LowPower_RtcLock();
+        return false;
+    }
+    RTC->WUTR = ticks - 1U;
+    RTC->CR &= ~0x7U;                           /* WUCKSEL = RTCCLK / 16 */
+    LowPower_WakeupClear();
+    RTC->CR |= LP_RTC_CR_WUTE | LP_RTC_CR_WUTIE;
+    LowPower_RtcLock();
+
+    return true;
+}
+
+static void LowPower_WakeupDisarm(void)
+{
+    LowPower_RtcUnlock();
+    RTC->CR &= ~(LP_RTC_CR_WUTE | LP_RTC_CR_WUTIE);
+    LowPower_RtcLock();
+    LowPower_WakeupClear();
+    *NVIC_ICPR0 = (1UL << RTC_WKUP_IRQn);
+}
+
+/* ===== INITIALIZATION ===== */
+
+/**
+ * @brief Enable the TIM2 compare and RTC wakeup interrupts, start the RTC
+ *        on LSI and calibrate it. Call after BSP_Timebase_Init().
+ */
+void BSP_LowPower_Init(void)
+{
+    s_stopReady = false;
+
+    /* TIM2 CC1 ends a Sleep; lowest priority, the handler only clears */
+    TIMER_IRQPriorityConfig(TIM2_IRQn, NVIC_IRQ_PRI15);
+    TIMER_IRQInterruptConfig(TIM2_IRQn, ENABLE);
+
+    if (!LowPower_RtcSetup())
+    {
+        s_lsiHz = 0;
+        return;
+    }
+
+    /* RTC wakeup -> EXTI line 22 (rising) -> RTC_WKUP_IRQn */
+    EXTI->IMR  |= (1U << LP_EXTI_LINE_RTC_WKUP);
+    EXTI->RTSR |= (1U << LP_EXTI_LINE_RTC_WKUP);
+    GPIO_IRQPriorityConfig(RTC_WKUP_IRQn, NVIC_IRQ_PRI15);
+    GPIO_IRQInterruptConfig(RTC_WKUP_IRQn, ENABLE);
+
+    s_lsiHz = LowPower_CalibrateLsi();
+    s_stopReady = (s_lsiHz != 0U);
+}
+
+bool BSP_LowPower_StopAvailable(void)
+{
+    return s_stopReady;
+}
+
+uint32_t BSP_LowPower_GetLsiHz(void)
+{
+    return s_lsiHz;
+}
+
+/* ===== SLEEP ===== */
+
+/**
+ * @brief Sleep mode (WFI) for at most max_us. Call with IRQs masked.
+ * @note  Any enabled interrupt wakes the core; the TIM2 CC1 compare
+ *        provides the deadline, SysTick is off meanwhile.
+ */
+LowPowerResult_t BSP_LowPower_Sleep(uint32_t max_us)
+{
+    LowPowerResult_t r = {0};
+
+    if (max_us == 0U)
+    {
+        return r;
+    }
+
+    BSP_Timebase_SuspendTick();
+
+    uint32_t start = TIM2->CNT;
+    TIM2->CCR1 = start + max_us;
+    TIM2->SR   = ~TIMER_SR_CC1IF;
+    TIM2->DIER |= TIMER_DIER_CC1IE;
+
+    if ((TIM2->CNT - start) < max_us)       /* compare not already passed */
+    {
+        SCB->SCR &= ~(1UL << SCB_SCR_SLEEPDEEP);
+        LowPower_Wfi();
+    }
+    uint32_t woke = TIM2->CNT;
+
+    TIM2->DIER &= ~TIMER_DIER_CC1IE;
+    TIM2->SR    = ~TIMER_SR_CC1IF;
+    *NVIC_ICPR0 = (1UL << TIM2_IRQn);
+
+    r.sleptUs = woke - start;
+    r.early   = (r.sleptUs < max_us);
+
+    BSP_Timebase_ResumeTick(0);
+    r.resumeUs = TIM2->CNT - woke;
+
+    return r;
+}
+
+/**
+ * @brief Stop mode for at most max_ms. Call with IRQs masked.
+ * @note  Returns with SYSCLK on HSI; call BSP_LowPower_RestoreClocks()
+ *        before unmasking IRQs. TIM2 is frozen in
+ *        Stop, the slept time comes from the RTC. Returns sleptUs = 0
+ *        without sleeping when max_ms is below ~1 wakeup period or Stop
+ *        is unavailable; the caller should fall back to Sleep.
+ */
+LowPowerResult_t BSP_LowPower_Stop(uint32_t max_ms)
+{
+    LowPowerResult_t r = {0};
+
+    if (!s_stopReady || (max_ms == 0U))
+    {
+        return r;
+    }
+    if (max_ms > LOWPOWER_STOP_MAX_MS)
+    {
+        max_ms = LOWPOWER_STOP_MAX_MS;
+    }
+
+    uint32_t ticks = (uint32_t)(((uint64_t)max_ms * s_lsiHz) / (1000U * LOWPOWER_WUT_DIV));
+    if (ticks < 2U)
+    {
+        return r;
+    }
+    if (ticks > 0x10000U)
+    {
+        ticks = 0x10000U;
+    }
+
+    /* Stop freezes the USART mid-byte: let the last one leave */
+    for (uint32_t i = 0; (i < LP_TIMEOUT) && !(USART2->SR & USART_FLAG_TC); i++)
+    {
+    }
+
+    /* Stop turns HSE and PLL off; wake-up always runs on HSI */
+    s_saved.cfgr      = RCC->CFGR;
+    s_saved.pllcfgr   = RCC->PLLCFGR;
+    s_saved.latency   = FLASH->ACR & 0xFU;
+    s_saved.hseBypass = (RCC->CR & (1U << 18)) != 0U;
+    if (((s_saved.cfgr >> 2) & 0x3U) != RCC_SYSCLKSOURCE_HSI)
+    {
+        RCC_SetSystemClock_HSI();
+        s_restorePending = true;
+    }
+
+    BSP_Timebase_SuspendTick();
+    if (!LowPower_WakeupArm(ticks))
+    {
+        BSP_Timebase_ResumeTick(0);
+        return r;
+    }
+    uint32_t before = LowPower_RtcTicks();
+
+    PWR->CR = (PWR->CR & ~LP_PWR_CR_PDDS) | LP_PWR_CR_LPDS | LP_PWR_CR_CWUF;
+    SCB->SCR |= (1UL << SCB_SCR_SLEEPDEEP);
+    LowPower_Wfi();
+    SCB->SCR &= ~(1UL << SCB_SCR_SLEEPDEEP);
+    uint32_t woke = TIM2->CNT;
+
+    bool timerFired = (RTC->ISR & LP_RTC_ISR_WUTF) != 0U;
+    uint32_t after  = LowPower_RtcTicks();
+    LowPower_WakeupDisarm();
+
+    uint32_t slept;
+    if (timerFired)
+    {
+        slept = (uint32_t)(((uint64_t)ticks * LOWPOWER_WUT_DIV * 1000000ULL) / s_lsiHz);
+    }
+    else
+    {
+        uint32_t day   = 86400U * ((RTC->PRER & 0x7FFFU) + 1U);
+        uint32_t async = ((RTC->PRER >> 16) & 0x7FU) + 1U;
+        uint32_t steps = (after + day - before) % day;
+        slept = (uint32_t)(((uint64_t)steps * async * 1000000ULL) / s_lsiHz);
+    }
+
+    r.sleptUs = slept;
+    r.early   = !timerFired;
+
+    BSP_Timebase_ResumeTick(slept);
+    r.resumeUs = TIM2->CNT - woke;
+
+    return r;
+}
+
+/**
+ * @brief Bring HSE/PLL back after Stop, through the RCC driver.
+ * @note  Call before unmasking IRQs: the woken handlers would otherwise
+ *        run with USART2, I2C1 and the basic timers clocked from HSI but
+ *        programmed for the saved PCLK1. Takes up to the HSE + PLL lock
+ *        time (~0.5 ms), which delays those handlers by as much.
+ */
+void BSP_LowPower_RestoreClocks(void)
+{
+    if (!s_restorePending)
+    {
+        return;
+    }
+    s_restorePending = false;
+
+    uint32_t src = (s_saved.cfgr >> 2) & 0x3U;
+    uint32_t pll = s_saved.pllcfgr;
+    RCC_OscInitTypeDef osc = {0};
+    RCC_ClkInitTypeDef clk = {0};
+
+    osc.PLL.PLLState = RCC_PLL_NONE;
+    if ((src == RCC_SYSCLKSOURCE_HSE) ||
+        ((src == RCC_SYSCLKSOURCE_PLLCLK) && (pll & RCC_PLLSOURCE_HSE)))
+    {
+        osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+        osc.HSEState = s_saved.hseBypass ? RCC_HSE_BYPASS : RCC_HSE_ON;
+    }
+    if (src == RCC_SYSCLKSOURCE_PLLCLK)
+    {
+        osc.PLL.PLLState  = RCC_PLL_ON;
+        osc.PLL.PLLSource = pll & RCC_PLLSOURCE_HSE;
+        osc.PLL.PLLM = pll & 0x3FU;
+        osc.PLL.PLLN = (pll >> 6) & 0x1FFU;
+        osc.PLL.PLLP = (((pll >> 16) & 0x3U) + 1U) * 2U;
+        osc.PLL.PLLQ = (pll >> 24) & 0xFU;
+        osc.PLL.PLLR = (pll >> 28) & 0x7U;
+    }
+    if (RCC_OscConfig(&osc) != RCC_OK)
+    {
+        return;                 /* stay on HSI */
+    }
+
+    clk.ClockType      = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK |
+                         RCC_CLOCKTYPE_PCLK1  | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource   = src;
+    clk.AHBCLKDivider  = s_saved.cfgr & (0xFU << 4);
+    clk.APB1CLKDivider = s_saved.cfgr & (0x7U << 10);
+    clk.APB2CLKDivider = (s_saved.cfgr & (0x7U << 13)) >> 3;   /* driver shifts by 3 */
+    (void)RCC_ClockConfig(&clk, s_saved.latency);
+}
+
+/* ===== WAKE-UP ISRs (only clear; the wake-up itself is the point) ===== */
+
+void RTC_WKUP_IRQHandler(void)
+{
+    LowPower_WakeupClear();
+}
+
+void TIM2_IRQHandler(void)
+{
+    TIM2->DIER &= ~TIMER_DIER_CC1IE;
+    TIM2->SR    = ~TIMER_SR_CC1IF;
+}
@@ -0,0 +1,50 @@
+/*
+ * bsp_oled_font.c
+ *
+ * Created on: Feb 28, 2026
+ * Author: Rahul B.
+ * Description: Font metrics: glyph lookup, kerning and string width
+ */
+
+#include "bsp_oled_font.h"
+#include <stddef.h>
+
+const OledGlyph_t *OledFont_Glyph(const OledFont_t *font, char c) {
+    if (c >= font->first && c <= font->last) {
+        const OledGlyph_t *glyph = &font->glyphs[c - font->first];
+        if (glyph->advance != 0) return glyph;
+    }
+    return &font->glyphs[font->fallback - font->first];
+}
+
+int8_t OledFont_Kerning(const OledFont_t *font, char left, char right) {
+    // Binary search: pairs are sorted by left, then right
+    int16_t lo = 0;
+    int16_t hi = (int16_t)font->kernCount - 1;
+
+    while (lo <= hi) {
+        int16_t mid = (lo + hi) / 2;
+        const OledKern_t *k = &font->kerning[mid];
+
+        if (k->left == left && k->right == right) return k->adjust;
+        if (k->left < left || (k->left == left && k->right < right)) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return 0;
+}
+
+uint8_t OledFont_CellWidth(const OledFont_t *font, char c, char next) {
+    uint8_t advance = OledFont_Glyph(font, c)->advance;
+
+    if (next == '\0' || font->kernCount == 0) return advance;
+    return (uint8_t)(advance + OledFont_Kerning(font, c, next));
+}
+
+uint16_t OledFont_TextWidth(const OledFont_t *font, const char *str) {
+    uint16_t width = 0;
+
+    for (; *str; str++) {
+        width += OledFont_CellWidth(font, str[0], str[1]);
+    }
+    return width;
+}
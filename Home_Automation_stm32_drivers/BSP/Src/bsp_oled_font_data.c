@@ -0,0 +1,613 @@
+/*
+ * bsp_oled_font_data.c
+ *
+ * Generated by Tools/fontgen/fontgen.py from small8.fnt, medium16.fnt, digits24.fnt.
+ * Do not edit: change the .fnt file and run the generator.
+ */
+
+#include "bsp_oled_font.h"
+#include <stddef.h>
+
+/* ===== SMALL8: 8 px, ' '..'~', 95 glyphs, 419 bytes ===== */
+static const uint8_t Small8_Bitmap[] = {
+    0x5F,                                                                   // '!'
+    0x07, 0x00, 0x07,                                                       // '"'
+    0x14, 0x7F, 0x14, 0x7F, 0x14,                                           // '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,                                           // '$'
+    0x23, 0x13, 0x08, 0x64, 0x62,                                           // '%'
+    0x36, 0x49, 0x55, 0x22, 0x50,                                           // '&'
+    0x05, 0x03,                                                             // '\''
+    0x1C, 0x22, 0x41,                                                       // '('
+    0x41, 0x22, 0x1C,                                                       // ')'
+    0x14, 0x08, 0x3E, 0x08, 0x14,                                           // '*'
+    0x08, 0x08, 0x3E, 0x08, 0x08,                                           // '+'
+    0x50, 0x30,                                                             // ','
+    0x08, 0x08, 0x08, 0x08, 0x08,                                           // '-'
+    0x60, 0x60,                                                             // '.'
+    0x20, 0x10, 0x08, 0x04, 0x02,                                           // '/'
+    0x3E, 0x51, 0x49, 0x45, 0x3E,                                           // '0'
+    0x42, 0x7F, 0x40,                                                       // '1'
+    0x42, 0x61, 0x51, 0x49, 0x46,                                           // '2'
+    0x21, 0x41, 0x45, 0x4B, 0x31,                                           // '3'
+    0x18, 0x14, 0x12, 0x7F, 0x10,                                           // '4'
+    0x27, 0x45, 0x45, 0x45, 0x39,                                           // '5'
+    0x3C, 0x4A, 0x49, 0x49, 0x30,                                           // '6'
+    0x01, 0x71, 0x09, 0x05, 0x03,                                           // '7'
+    0x36, 0x49, 0x49, 0x49, 0x36,                                           // '8'
+    0x06, 0x49, 0x49, 0x29, 0x1E,                                           // '9'
+    0x36, 0x36,                                                             // ':'
+    0x56, 0x36,                                                             // ';'
+    0x08, 0x14, 0x22, 0x41,                                                 // '<'
+    0x14, 0x14, 0x14, 0x14, 0x14,                                           // '='
+    0x41, 0x22, 0x14, 0x08,                                                 // '>'
+    0x02, 0x01, 0x51, 0x09, 0x06,                                           // '?'
+    0x32, 0x49, 0x79, 0x41, 0x3E,                                           // '@'
+    0x7E, 0x11, 0x11, 0x11, 0x7E,                                           // 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36,                                           // 'B'
+    0x3E, 0x41, 0x41, 0x41, 0x22,                                           // 'C'
+    0x7F, 0x41, 0x41, 0x22, 0x1C,                                           // 'D'
+    0x7F, 0x49, 0x49, 0x49, 0x41,                                           // 'E'
+    0x7F, 0x09, 0x09, 0x09, 0x01,                                           // 'F'
+    0x3E, 0x41, 0x49, 0x49, 0x7A,                                           // 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F,                                           // 'H'
+    0x41, 0x7F, 0x41,                                                       // 'I'
+    0x20, 0x40, 0x41, 0x3F, 0x01,                                           // 'J'
+    0x7F, 0x08, 0x14, 0x22, 0x41,                                           // 'K'
+    0x7F, 0x40, 0x40, 0x40, 0x40,                                           // 'L'
+    0x7F, 0x02, 0x0C, 0x02, 0x7F,                                           // 'M'
+    0x7F, 0x04, 0x08, 0x10, 0x7F,                                           // 'N'
+    0x3E, 0x41, 0x41, 0x41, 0x3E,                                           // 'O'
+    0x7F, 0x09, 0x09, 0x09, 0x06,                                           // 'P'
+    0x3E, 0x41, 0x51, 0x21, 0x5E,                                           // 'Q'
+    0x7F, 0x09, 0x19, 0x29, 0x46,                                           // 'R'
+    0x46, 0x49, 0x49, 0x49, 0x31,                                           // 'S'
+    0x01, 0x01, 0x7F, 0x01, 0x01,                                           // 'T'
+    0x3F, 0x40, 0x40, 0x40, 0x3F,                                           // 'U'
+    0x1F, 0x20, 0x40, 0x20, 0x1F,                                           // 'V'
+    0x3F, 0x40, 0x38, 0x40, 0x3F,                                           // 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63,                                           // 'X'
+    0x07, 0x08, 0x70, 0x08, 0x07,                                           // 'Y'
+    0x61, 0x51, 0x49, 0x45, 0x43,                                           // 'Z'
+    0x7F, 0x41, 0x41,                                                       // '['
+    0x02, 0x04, 0x08, 0x10, 0x20,                                           // '\\'
+    0x41, 0x41, 0x7F,                                                       // ']'
+    0x04, 0x02, 0x01, 0x02, 0x04,                                           // '^'
+    0x40, 0x40, 0x40, 0x40, 0x40,                                           // '_'
+    0x01, 0x02, 0x04,                                                       // '`'
+    0x20, 0x54, 0x54, 0x54, 0x78,                                           // 'a'
+    0x7F, 0x48, 0x44, 0x44, 0x38,                                           // 'b'
+    0x38, 0x44, 0x44, 0x44, 0x20,                                           // 'c'
+    0x38, 0x44, 0x44, 0x48, 0x7F,                                           // 'd'
+    0x38, 0x54, 0x54, 0x54, 0x18,                                           // 'e'
+    0x08, 0x7E, 0x09, 0x01, 0x02,                                           // 'f'
+    0x0C, 0x52, 0x52, 0x52, 0x3E,                                           // 'g'
+    0x7F, 0x08, 0x04, 0x04, 0x78,                                           // 'h'
+    0x44, 0x7D, 0x40,                                                       // 'i'
+    0x20, 0x40, 0x44, 0x3D,                                                 // 'j'
+    0x7F, 0x10, 0x28, 0x44,                                                 // 'k'
+    0x41, 0x7F, 0x40,                                                       // 'l'
+    0x7C, 0x04, 0x18, 0x04, 0x78,                                           // 'm'
+    0x7C, 0x08, 0x04, 0x04, 0x78,                                           // 'n'
+    0x38, 0x44, 0x44, 0x44, 0x38,                                           // 'o'
+    0x7C, 0x14, 0x14, 0x14, 0x08,                                           // 'p'
+    0x08, 0x14, 0x14, 0x18, 0x7C,                                           // 'q'
+    0x7C, 0x08, 0x04, 0x04, 0x08,                                           // 'r'
+    0x48, 0x54, 0x54, 0x54, 0x20,                                           // 's'
+    0x04, 0x3F, 0x44, 0x40, 0x20,                                           // 't'
+    0x3C, 0x40, 0x40, 0x20, 0x7C,                                           // 'u'
+    0x1C, 0x20, 0x40, 0x20, 0x1C,                                           // 'v'
+    0x3C, 0x40, 0x30, 0x40, 0x3C,                                           // 'w'
+    0x44, 0x28, 0x10, 0x28, 0x44,                                           // 'x'
+    0x0C, 0x50, 0x50, 0x50, 0x3C,                                           // 'y'
+    0x44, 0x64, 0x54, 0x4C, 0x44,                                           // 'z'
+    0x08, 0x36, 0x41,                                                       // '{'
+    0x7F,                                                                   // '|'
+    0x41, 0x36, 0x08,                                                       // '}'
+    0x10, 0x08, 0x08, 0x10, 0x08,                                           // '~'
+};
+
+static const OledGlyph_t Small8_Glyphs[95] = {
+    {     0,   0,   0,   3 },   // ' '
+    {     0,   1,   0,   2 },   // '!'
+    {     1,   3,   0,   4 },   // '"'
+    {     4,   5,   0,   6 },   // '#'
+    {     9,   5,   0,   6 },   // '$'
+    {    14,   5,   0,   6 },   // '%'
+    {    19,   5,   0,   6 },   // '&'
+    {    24,   2,   0,   3 },   // '\''
+    {    26,   3,   0,   4 },   // '('
+    {    29,   3,   0,   4 },   // ')'
+    {    32,   5,   0,   6 },   // '*'
+    {    37,   5,   0,   6 },   // '+'
+    {    42,   2,   0,   3 },   // ','
+    {    44,   5,   0,   6 },   // '-'
+    {    49,   2,   0,   3 },   // '.'
+    {    51,   5,   0,   6 },   // '/'
+    {    56,   5,   0,   6 },   // '0'
+    {    61,   3,   0,   4 },   // '1'
+    {    64,   5,   0,   6 },   // '2'
+    {    69,   5,   0,   6 },   // '3'
+    {    74,   5,   0,   6 },   // '4'
+    {    79,   5,   0,   6 },   // '5'
+    {    84,   5,   0,   6 },   // '6'
+    {    89,   5,   0,   6 },   // '7'
+    {    94,   5,   0,   6 },   // '8'
+    {    99,   5,   0,   6 },   // '9'
+    {   104,   2,   0,   3 },   // ':'
+    {   106,   2,   0,   3 },   // ';'
+    {   108,   4,   0,   5 },   // '<'
+    {   112,   5,   0,   6 },   // '='
+    {   117,   4,   0,   5 },   // '>'
+    {   121,   5,   0,   6 },   // '?'
+    {   126,   5,   0,   6 },   // '@'
+    {   131,   5,   0,   6 },   // 'A'
+    {   136,   5,   0,   6 },   // 'B'
+    {   141,   5,   0,   6 },   // 'C'
+    {   146,   5,   0,   6 },   // 'D'
+    {   151,   5,   0,   6 },   // 'E'
+    {   156,   5,   0,   6 },   // 'F'
+    {   161,   5,   0,   6 },   // 'G'
+    {   166,   5,   0,   6 },   // 'H'
+    {   171,   3,   0,   4 },   // 'I'
+    {   174,   5,   0,   6 },   // 'J'
+    {   179,   5,   0,   6 },   // 'K'
+    {   184,   5,   0,   6 },   // 'L'
+    {   189,   5,   0,   6 },   // 'M'
+    {   194,   5,   0,   6 },   // 'N'
+    {   199,   5,   0,   6 },   // 'O'
+    {   204,   5,   0,   6 },   // 'P'
+    {   209,   5,   0,   6 },   // 'Q'
+    {   214,   5,   0,   6 },   // 'R'
+    {   219,   5,   0,   6 },   // 'S'
+    {   224,   5,   0,   6 },   // 'T'
+    {   229,   5,   0,   6 },   // 'U'
+    {   234,   5,   0,   6 },   // 'V'
+    {   239,   5,   0,   6 },   // 'W'
+    {   244,   5,   0,   6 },   // 'X'
+    {   249,   5,   0,   6 },   // 'Y'
+    {   254,   5,   0,   6 },   // 'Z'
+    {   259,   3,   0,   4 },   // '['
+    {   262,   5,   0,   6 },   // '\\'
+    {   267,   3,   0,   4 },   // ']'
+    {   270,   5,   0,   6 },   // '^'
+    {   275,   5,   0,   6 },   // '_'
+    {   280,   3,   0,   4 },   // '`'
+    {   283,   5,   0,   6 },   // 'a'
+    {   288,   5,   0,   6 },   // 'b'
+    {   293,   5,   0,   6 },   // 'c'
+    {   298,   5,   0,   6 },   // 'd'
+    {   303,   5,   0,   6 },   // 'e'
+    {   308,   5,   0,   6 },   // 'f'
+    {   313,   5,   0,   6 },   // 'g'
+    {   318,   5,   0,   6 },   // 'h'
+    {   323,   3,   0,   4 },   // 'i'
+    {   326,   4,   0,   5 },   // 'j'
+    {   330,   4,   0,   5 },   // 'k'
+    {   334,   3,   0,   4 },   // 'l'
+    {   337,   5,   0,   6 },   // 'm'
+    {   342,   5,   0,   6 },   // 'n'
+    {   347,   5,   0,   6 },   // 'o'
+    {   352,   5,   0,   6 },   // 'p'
+    {   357,   5,   0,   6 },   // 'q'
+    {   362,   5,   0,   6 },   // 'r'
+    {   367,   5,   0,   6 },   // 's'
+    {   372,   5,   0,   6 },   // 't'
+    {   377,   5,   0,   6 },   // 'u'
+    {   382,   5,   0,   6 },   // 'v'
+    {   387,   5,   0,   6 },   // 'w'
+    {   392,   5,   0,   6 },   // 'x'
+    {   397,   5,   0,   6 },   // 'y'
+    {   402,   5,   0,   6 },   // 'z'
+    {   407,   3,   0,   4 },   // '{'
+    {   410,   1,   0,   2 },   // '|'
+    {   411,   3,   0,   4 },   // '}'
+    {   414,   5,   0,   6 },   // '~'
+};
+
+static const OledKern_t Small8_Kerning[9] = {
+    { '1', ':', -1 },
+    { 'F', '.', -1 },
+    { 'L', '\'', -1 },
+    { 'P', '.', -1 },
+    { 'T', ',', -1 },
+    { 'T', '.', -1 },
+    { 'r', ',', -1 },
+    { 'r', '.', -1 },
+    { 'y', '.', -1 },
+};
+
+const OledFont_t Font_Small8 = {
+    .name       = "Small8",
+    .height     = 8,
+    .pages      = 1,
+    .first      = ' ',
+    .last       = '~',
+    .fallback   = ' ',
+    .glyphs     = Small8_Glyphs,
+    .bitmap     = Small8_Bitmap,
+    .bitmapSize = sizeof(Small8_Bitmap),
+    .kerning    = Small8_Kerning,
+    .kernCount  = 9,
+};
+
+/* ===== MEDIUM16: 16 px, ' '..'~', 95 glyphs, 1676 bytes ===== */
+static const uint8_t Medium16_Bitmap[] = {
+    0xFF, 0x33, 0xFF, 0x33,                                                 // '!'
+    0x3F, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x3F, 0x00, // '"'
+    0x30, 0x03, 0x30, 0x03, 0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x03, 0x30, 0x03, // '#'
+    0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x03, 0x30, 0x03,                         
+    0x30, 0x0C, 0x30, 0x0C, 0xCC, 0x0C, 0xCC, 0x0C, 0xFF, 0x3F, 0xFF, 0x3F, // '$'
+    0xCC, 0x0C, 0xCC, 0x0C, 0x0C, 0x03, 0x0C, 0x03,                         
+    0x0F, 0x0C, 0x0F, 0x0C, 0x0F, 0x03, 0x0F, 0x03, 0xC0, 0x00, 0xC0, 0x00, // '%'
+    0x30, 0x3C, 0x30, 0x3C, 0x0C, 0x3C, 0x0C, 0x3C,                         
+    0x3C, 0x0F, 0x3C, 0x0F, 0xC3, 0x30, 0xC3, 0x30, 0x33, 0x33, 0x33, 0x33, // '&'
+    0x0C, 0x0C, 0x0C, 0x0C, 0x00, 0x33, 0x00, 0x33,                         
+    0x33, 0x00, 0x33, 0x00, 0x0F, 0x00, 0x0F, 0x00,                         // '\''
+    0xF0, 0x03, 0xF0, 0x03, 0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x30, 0x03, 0x30, // '('
+    0x03, 0x30, 0x03, 0x30, 0x0C, 0x0C, 0x0C, 0x0C, 0xF0, 0x03, 0xF0, 0x03, // ')'
+    0x30, 0x03, 0x30, 0x03, 0xC0, 0x00, 0xC0, 0x00, 0xFC, 0x0F, 0xFC, 0x0F, // '*'
+    0xC0, 0x00, 0xC0, 0x00, 0x30, 0x03, 0x30, 0x03,                         
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xFC, 0x0F, 0xFC, 0x0F, // '+'
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,                         
+    0x00, 0x33, 0x00, 0x33, 0x00, 0x0F, 0x00, 0x0F,                         // ','
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, // '-'
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,                         
+    0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C,                         // '.'
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x03, 0x00, 0x03, 0xC0, 0x00, 0xC0, 0x00, // '/'
+    0x30, 0x00, 0x30, 0x00, 0x0C, 0x00, 0x0C, 0x00,                         
+    0xFC, 0x0F, 0xFC, 0x0F, 0x03, 0x33, 0x03, 0x33, 0xC3, 0x30, 0xC3, 0x30, // '0'
+    0x33, 0x30, 0x33, 0x30, 0xFC, 0x0F, 0xFC, 0x0F,                         
+    0x0C, 0x30, 0x0C, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x30, 0x00, 0x30, // '1'
+    0x0C, 0x30, 0x0C, 0x30, 0x03, 0x3C, 0x03, 0x3C, 0x03, 0x33, 0x03, 0x33, // '2'
+    0xC3, 0x30, 0xC3, 0x30, 0x3C, 0x30, 0x3C, 0x30,                         
+    0x03, 0x0C, 0x03, 0x0C, 0x03, 0x30, 0x03, 0x30, 0x33, 0x30, 0x33, 0x30, // '3'
+    0xCF, 0x30, 0xCF, 0x30, 0x03, 0x0F, 0x03, 0x0F,                         
+    0xC0, 0x03, 0xC0, 0x03, 0x30, 0x03, 0x30, 0x03, 0x0C, 0x03, 0x0C, 0x03, // '4'
+    0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x03, 0x00, 0x03,                         
+    0x3F, 0x0C, 0x3F, 0x0C, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, // '5'
+    0x33, 0x30, 0x33, 0x30, 0xC3, 0x0F, 0xC3, 0x0F,                         
+    0xF0, 0x0F, 0xF0, 0x0F, 0xCC, 0x30, 0xCC, 0x30, 0xC3, 0x30, 0xC3, 0x30, // '6'
+    0xC3, 0x30, 0xC3, 0x30, 0x00, 0x0F, 0x00, 0x0F,                         
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x3F, 0x03, 0x3F, 0xC3, 0x00, 0xC3, 0x00, // '7'
+    0x33, 0x00, 0x33, 0x00, 0x0F, 0x00, 0x0F, 0x00,                         
+    0x3C, 0x0F, 0x3C, 0x0F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, // '8'
+    0xC3, 0x30, 0xC3, 0x30, 0x3C, 0x0F, 0x3C, 0x0F,                         
+    0x3C, 0x00, 0x3C, 0x00, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, // '9'
+    0xC3, 0x0C, 0xC3, 0x0C, 0xFC, 0x03, 0xFC, 0x03,                         
+    0x3C, 0x0F, 0x3C, 0x0F, 0x3C, 0x0F, 0x3C, 0x0F,                         // ':'
+    0x3C, 0x33, 0x3C, 0x33, 0x3C, 0x0F, 0x3C, 0x0F,                         // ';'
+    0xC0, 0x00, 0xC0, 0x00, 0x30, 0x03, 0x30, 0x03, 0x0C, 0x0C, 0x0C, 0x0C, // '<'
+    0x03, 0x30, 0x03, 0x30,                                                 
+    0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, // '='
+    0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03,                         
+    0x03, 0x30, 0x03, 0x30, 0x0C, 0x0C, 0x0C, 0x0C, 0x30, 0x03, 0x30, 0x03, // '>'
+    0xC0, 0x00, 0xC0, 0x00,                                                 
+    0x0C, 0x00, 0x0C, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x33, 0x03, 0x33, // '?'
+    0xC3, 0x00, 0xC3, 0x00, 0x3C, 0x00, 0x3C, 0x00,                         
+    0x0C, 0x0F, 0x0C, 0x0F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x3F, 0xC3, 0x3F, // '@'
+    0x03, 0x30, 0x03, 0x30, 0xFC, 0x0F, 0xFC, 0x0F,                         
+    0xFC, 0x3F, 0xFC, 0x3F, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, // 'A'
+    0x03, 0x03, 0x03, 0x03, 0xFC, 0x3F, 0xFC, 0x3F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, // 'B'
+    0xC3, 0x30, 0xC3, 0x30, 0x3C, 0x0F, 0x3C, 0x0F,                         
+    0xFC, 0x0F, 0xFC, 0x0F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, // 'C'
+    0x03, 0x30, 0x03, 0x30, 0x0C, 0x0C, 0x0C, 0x0C,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, // 'D'
+    0x0C, 0x0C, 0x0C, 0x0C, 0xF0, 0x03, 0xF0, 0x03,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, // 'E'
+    0xC3, 0x30, 0xC3, 0x30, 0x03, 0x30, 0x03, 0x30,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, // 'F'
+    0xC3, 0x00, 0xC3, 0x00, 0x03, 0x00, 0x03, 0x00,                         
+    0xFC, 0x0F, 0xFC, 0x0F, 0x03, 0x30, 0x03, 0x30, 0xC3, 0x30, 0xC3, 0x30, // 'G'
+    0xC3, 0x30, 0xC3, 0x30, 0xCC, 0x3F, 0xCC, 0x3F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, // 'H'
+    0xC0, 0x00, 0xC0, 0x00, 0xFF, 0x3F, 0xFF, 0x3F,                         
+    0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, // 'I'
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, 0x03, 0x30, 0x03, 0x30, // 'J'
+    0xFF, 0x0F, 0xFF, 0x0F, 0x03, 0x00, 0x03, 0x00,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0x30, 0x03, 0x30, 0x03, // 'K'
+    0x0C, 0x0C, 0x0C, 0x0C, 0x03, 0x30, 0x03, 0x30,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, // 'L'
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0x0C, 0x00, 0x0C, 0x00, 0xF0, 0x00, 0xF0, 0x00, // 'M'
+    0x0C, 0x00, 0x0C, 0x00, 0xFF, 0x3F, 0xFF, 0x3F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x00, 0x30, 0x00, 0xC0, 0x00, 0xC0, 0x00, // 'N'
+    0x00, 0x03, 0x00, 0x03, 0xFF, 0x3F, 0xFF, 0x3F,                         
+    0xFC, 0x0F, 0xFC, 0x0F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, // 'O'
+    0x03, 0x30, 0x03, 0x30, 0xFC, 0x0F, 0xFC, 0x0F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, // 'P'
+    0xC3, 0x00, 0xC3, 0x00, 0x3C, 0x00, 0x3C, 0x00,                         
+    0xFC, 0x0F, 0xFC, 0x0F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x33, 0x03, 0x33, // 'Q'
+    0x03, 0x0C, 0x03, 0x0C, 0xFC, 0x33, 0xFC, 0x33,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x03, 0xC3, 0x03, // 'R'
+    0xC3, 0x0C, 0xC3, 0x0C, 0x3C, 0x30, 0x3C, 0x30,                         
+    0x3C, 0x30, 0x3C, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, // 'S'
+    0xC3, 0x30, 0xC3, 0x30, 0x03, 0x0F, 0x03, 0x0F,                         
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xFF, 0x3F, 0xFF, 0x3F, // 'T'
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,                         
+    0xFF, 0x0F, 0xFF, 0x0F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, // 'U'
+    0x00, 0x30, 0x00, 0x30, 0xFF, 0x0F, 0xFF, 0x0F,                         
+    0xFF, 0x03, 0xFF, 0x03, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, // 'V'
+    0x00, 0x0C, 0x00, 0x0C, 0xFF, 0x03, 0xFF, 0x03,                         
+    0xFF, 0x0F, 0xFF, 0x0F, 0x00, 0x30, 0x00, 0x30, 0xC0, 0x0F, 0xC0, 0x0F, // 'W'
+    0x00, 0x30, 0x00, 0x30, 0xFF, 0x0F, 0xFF, 0x0F,                         
+    0x0F, 0x3C, 0x0F, 0x3C, 0x30, 0x03, 0x30, 0x03, 0xC0, 0x00, 0xC0, 0x00, // 'X'
+    0x30, 0x03, 0x30, 0x03, 0x0F, 0x3C, 0x0F, 0x3C,                         
+    0x3F, 0x00, 0x3F, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x3F, 0x00, 0x3F, // 'Y'
+    0xC0, 0x00, 0xC0, 0x00, 0x3F, 0x00, 0x3F, 0x00,                         
+    0x03, 0x3C, 0x03, 0x3C, 0x03, 0x33, 0x03, 0x33, 0xC3, 0x30, 0xC3, 0x30, // 'Z'
+    0x33, 0x30, 0x33, 0x30, 0x0F, 0x30, 0x0F, 0x30,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, // '['
+    0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, 0x00, 0xC0, 0x00, 0xC0, 0x00, // '\\'
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x0C,                         
+    0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, // ']'
+    0x30, 0x00, 0x30, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x03, 0x00, 0x03, 0x00, // '^'
+    0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, 0x00,                         
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, // '_'
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,                         
+    0x03, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, 0x00, // '`'
+    0x00, 0x0C, 0x00, 0x0C, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, // 'a'
+    0x30, 0x33, 0x30, 0x33, 0xC0, 0x3F, 0xC0, 0x3F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x30, 0xC0, 0x30, 0x30, 0x30, 0x30, 0x30, // 'b'
+    0x30, 0x30, 0x30, 0x30, 0xC0, 0x0F, 0xC0, 0x0F,                         
+    0xC0, 0x0F, 0xC0, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, // 'c'
+    0x30, 0x30, 0x30, 0x30, 0x00, 0x0C, 0x00, 0x0C,                         
+    0xC0, 0x0F, 0xC0, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, // 'd'
+    0xC0, 0x30, 0xC0, 0x30, 0xFF, 0x3F, 0xFF, 0x3F,                         
+    0xC0, 0x0F, 0xC0, 0x0F, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, // 'e'
+    0x30, 0x33, 0x30, 0x33, 0xC0, 0x03, 0xC0, 0x03,                         
+    0xC0, 0x00, 0xC0, 0x00, 0xFC, 0x3F, 0xFC, 0x3F, 0xC3, 0x00, 0xC3, 0x00, // 'f'
+    0x03, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x0C, 0x00,                         
+    0xF0, 0x00, 0xF0, 0x00, 0x0C, 0x33, 0x0C, 0x33, 0x0C, 0x33, 0x0C, 0x33, // 'g'
+    0x0C, 0x33, 0x0C, 0x33, 0xFC, 0x0F, 0xFC, 0x0F,                         
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0x30, 0x00, 0x30, 0x00, // 'h'
+    0x30, 0x00, 0x30, 0x00, 0xC0, 0x3F, 0xC0, 0x3F,                         
+    0x30, 0x30, 0x30, 0x30, 0xF3, 0x3F, 0xF3, 0x3F, 0x00, 0x30, 0x00, 0x30, // 'i'
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, // 'j'
+    0xF3, 0x0F, 0xF3, 0x0F,                                                 
+    0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x03, 0x00, 0x03, 0xC0, 0x0C, 0xC0, 0x0C, // 'k'
+    0x30, 0x30, 0x30, 0x30,                                                 
+    0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x30, 0x00, 0x30, // 'l'
+    0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x00, 0x30, 0x00, 0xC0, 0x03, 0xC0, 0x03, // 'm'
+    0x30, 0x00, 0x30, 0x00, 0xC0, 0x3F, 0xC0, 0x3F,                         
+    0xF0, 0x3F, 0xF0, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0x30, 0x00, 0x30, 0x00, // 'n'
+    0x30, 0x00, 0x30, 0x00, 0xC0, 0x3F, 0xC0, 0x3F,                         
+    0xC0, 0x0F, 0xC0, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, // 'o'
+    0x30, 0x30, 0x30, 0x30, 0xC0, 0x0F, 0xC0, 0x0F,                         
+    0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, // 'p'
+    0x30, 0x03, 0x30, 0x03, 0xC0, 0x00, 0xC0, 0x00,                         
+    0xC0, 0x00, 0xC0, 0x00, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, // 'q'
+    0xC0, 0x03, 0xC0, 0x03, 0xF0, 0x3F, 0xF0, 0x3F,                         
+    0xF0, 0x3F, 0xF0, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0x30, 0x00, 0x30, 0x00, // 'r'
+    0x30, 0x00, 0x30, 0x00, 0xC0, 0x00, 0xC0, 0x00,                         
+    0xC0, 0x30, 0xC0, 0x30, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, // 's'
+    0x30, 0x33, 0x30, 0x33, 0x00, 0x0C, 0x00, 0x0C,                         
+    0x30, 0x00, 0x30, 0x00, 0xFF, 0x0F, 0xFF, 0x0F, 0x30, 0x30, 0x30, 0x30, // 't'
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x0C, 0x00, 0x0C,                         
+    0xF0, 0x0F, 0xF0, 0x0F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, // 'u'
+    0x00, 0x0C, 0x00, 0x0C, 0xF0, 0x3F, 0xF0, 0x3F,                         
+    0xF0, 0x03, 0xF0, 0x03, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x30, // 'v'
+    0x00, 0x0C, 0x00, 0x0C, 0xF0, 0x03, 0xF0, 0x03,                         
+    0xF0, 0x0F, 0xF0, 0x0F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x0F, 0x00, 0x0F, // 'w'
+    0x00, 0x30, 0x00, 0x30, 0xF0, 0x0F, 0xF0, 0x0F,                         
+    0x30, 0x30, 0x30, 0x30, 0xC0, 0x0C, 0xC0, 0x0C, 0x00, 0x03, 0x00, 0x03, // 'x'
+    0xC0, 0x0C, 0xC0, 0x0C, 0x30, 0x30, 0x30, 0x30,                         
+    0xF0, 0x00, 0xF0, 0x00, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, // 'y'
+    0x00, 0x33, 0x00, 0x33, 0xF0, 0x0F, 0xF0, 0x0F,                         
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x30, 0x3C, 0x30, 0x33, 0x30, 0x33, // 'z'
+    0xF0, 0x30, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30,                         
+    0xC0, 0x00, 0xC0, 0x00, 0x3C, 0x0F, 0x3C, 0x0F, 0x03, 0x30, 0x03, 0x30, // '{'
+    0xFF, 0x3F, 0xFF, 0x3F,                                                 // '|'
+    0x03, 0x30, 0x03, 0x30, 0x3C, 0x0F, 0x3C, 0x0F, 0xC0, 0x00, 0xC0, 0x00, // '}'
+    0x00, 0x03, 0x00, 0x03, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, // '~'
+    0x00, 0x03, 0x00, 0x03, 0xC0, 0x00, 0xC0, 0x00,                         
+};
+
+static const OledGlyph_t Medium16_Glyphs[95] = {
+    {     0,   0,   0,   6 },   // ' '
+    {     0,   2,   0,   4 },   // '!'
+    {     4,   6,   0,   8 },   // '"'
+    {    16,  10,   0,  12 },   // '#'
+    {    36,  10,   0,  12 },   // '$'
+    {    56,  10,   0,  12 },   // '%'
+    {    76,  10,   0,  12 },   // '&'
+    {    96,   4,   0,   6 },   // '\''
+    {   104,   6,   0,   8 },   // '('
+    {   116,   6,   0,   8 },   // ')'
+    {   128,  10,   0,  12 },   // '*'
+    {   148,  10,   0,  12 },   // '+'
+    {   168,   4,   0,   6 },   // ','
+    {   176,  10,   0,  12 },   // '-'
+    {   196,   4,   0,   6 },   // '.'
+    {   204,  10,   0,  12 },   // '/'
+    {   224,  10,   0,  12 },   // '0'
+    {   244,   6,   0,   8 },   // '1'
+    {   256,  10,   0,  12 },   // '2'
+    {   276,  10,   0,  12 },   // '3'
+    {   296,  10,   0,  12 },   // '4'
+    {   316,  10,   0,  12 },   // '5'
+    {   336,  10,   0,  12 },   // '6'
+    {   356,  10,   0,  12 },   // '7'
+    {   376,  10,   0,  12 },   // '8'
+    {   396,  10,   0,  12 },   // '9'
+    {   416,   4,   0,   6 },   // ':'
+    {   424,   4,   0,   6 },   // ';'
+    {   432,   8,   0,  10 },   // '<'
+    {   448,  10,   0,  12 },   // '='
+    {   468,   8,   0,  10 },   // '>'
+    {   484,  10,   0,  12 },   // '?'
+    {   504,  10,   0,  12 },   // '@'
+    {   524,  10,   0,  12 },   // 'A'
+    {   544,  10,   0,  12 },   // 'B'
+    {   564,  10,   0,  12 },   // 'C'
+    {   584,  10,   0,  12 },   // 'D'
+    {   604,  10,   0,  12 },   // 'E'
+    {   624,  10,   0,  12 },   // 'F'
+    {   644,  10,   0,  12 },   // 'G'
+    {   664,  10,   0,  12 },   // 'H'
+    {   684,   6,   0,   8 },   // 'I'
+    {   696,  10,   0,  12 },   // 'J'
+    {   716,  10,   0,  12 },   // 'K'
+    {   736,  10,   0,  12 },   // 'L'
+    {   756,  10,   0,  12 },   // 'M'
+    {   776,  10,   0,  12 },   // 'N'
+    {   796,  10,   0,  12 },   // 'O'
+    {   816,  10,   0,  12 },   // 'P'
+    {   836,  10,   0,  12 },   // 'Q'
+    {   856,  10,   0,  12 },   // 'R'
+    {   876,  10,   0,  12 },   // 'S'
+    {   896,  10,   0,  12 },   // 'T'
+    {   916,  10,   0,  12 },   // 'U'
+    {   936,  10,   0,  12 },   // 'V'
+    {   956,  10,   0,  12 },   // 'W'
+    {   976,  10,   0,  12 },   // 'X'
+    {   996,  10,   0,  12 },   // 'Y'
+    {  1016,  10,   0,  12 },   // 'Z'
+    {  1036,   6,   0,   8 },   // '['
+    {  1048,  10,   0,  12 },   // '\\'
+    {  1068,   6,   0,   8 },   // ']'
+    {  1080,  10,   0,  12 },   // '^'
+    {  1100,  10,   0,  12 },   // '_'
+    {  1120,   6,   0,   8 },   // '`'
+    {  1132,  10,   0,  12 },   // 'a'
+    {  1152,  10,   0,  12 },   // 'b'
+    {  1172,  10,   0,  12 },   // 'c'
+    {  1192,  10,   0,  12 },   // 'd'
+    {  1212,  10,   0,  12 },   // 'e'
+    {  1232,  10,   0,  12 },   // 'f'
+    {  1252,  10,   0,  12 },   // 'g'
+    {  1272,  10,   0,  12 },   // 'h'
+    {  1292,   6,   0,   8 },   // 'i'
+    {  1304,   8,   0,  10 },   // 'j'
+    {  1320,   8,   0,  10 },   // 'k'
+    {  1336,   6,   0,   8 },   // 'l'
+    {  1348,  10,   0,  12 },   // 'm'
+    {  1368,  10,   0,  12 },   // 'n'
+    {  1388,  10,   0,  12 },   // 'o'
+    {  1408,  10,   0,  12 },   // 'p'
+    {  1428,  10,   0,  12 },   // 'q'
+    {  1448,  10,   0,  12 },   // 'r'
+    {  1468,  10,   0,  12 },   // 's'
+    {  1488,  10,   0,  12 },   // 't'
+    {  1508,  10,   0,  12 },   // 'u'
+    {  1528,  10,   0,  12 },   // 'v'
+    {  1548,  10,   0,  12 },   // 'w'
+    {  1568,  10,   0,  12 },   // 'x'
+    {  1588,  10,   0,  12 },   // 'y'
+    {  1608,  10,   0,  12 },   // 'z'
+    {  1628,   6,   0,   8 },   // '{'
+    {  1640,   2,   0,   4 },   // '|'
+    {  1644,   6,   0,   8 },   // '}'
+    {  1656,  10,   0,  12 },   // '~'
+};
+
+static const OledKern_t Medium16_Kerning[9] = {
+    { '1', ':', -2 },
+    { 'F', '.', -2 },
+    { 'L', '\'', -2 },
+    { 'P', '.', -2 },
+    { 'T', ',', -2 },
+    { 'T', '.', -2 },
+    { 'r', ',', -2 },
+    { 'r', '.', -2 },
+    { 'y', '.', -2 },
+};
+
+const OledFont_t Font_Medium16 = {
+    .name       = "Medium16",
+    .height     = 16,
+    .pages      = 2,
+    .first      = ' ',
+    .last       = '~',
+    .fallback   = ' ',
+    .glyphs     = Medium16_Glyphs,
+    .bitmap     = Medium16_Bitmap,
+    .bitmapSize = sizeof(Medium16_Bitmap),
+    .kerning    = Medium16_Kerning,
+    .kernCount  = 9,
+};
+
+/* ===== DIGITS24: 24 px, ' '..':', 16 glyphs, 423 bytes ===== */
+static const uint8_t Digits24_Bitmap[] = {
+    0x38, 0x00, 0x00, 0x7C, 0x00, 0x60, 0x7C, 0x00, 0x78, 0x38, 0x00, 0x1E, // '%'
+    0x00, 0x80, 0x07, 0x00, 0xE0, 0x01, 0x00, 0x7C, 0x00, 0x00, 0x1F, 0x00, 
+    0xC0, 0x03, 0x1C, 0xF0, 0x00, 0x3E, 0x3C, 0x00, 0x3E, 0x0C, 0x00, 0x1C, 
+    0x00, 0x10, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0xFF, 0x01, // '+'
+    0x80, 0xFF, 0x03, 0x00, 0xFF, 0x01, 0x00, 0x38, 0x00, 0x00, 0x10, 0x00, 
+    0x00, 0x10, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, // '-'
+    0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x10, 0x00, 
+    0x00, 0x00, 0x70, 0x00, 0x00, 0x70, 0x00, 0x00, 0x70,                   // '.'
+    0xF0, 0xC7, 0x1F, 0xF8, 0xEF, 0x3F, 0xF4, 0xC7, 0x5F, 0x0E, 0x00, 0xE0, // '0'
+    0x0E, 0x00, 0xE0, 0x0E, 0x00, 0xE0, 0x0E, 0x00, 0xE0, 0x0E, 0x00, 0xE0, 
+    0x0E, 0x00, 0xE0, 0xF4, 0xC7, 0x5F, 0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F, 
+    0xF0, 0xC7, 0x1F, 0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F,                   // '1'
+    0x00, 0xC0, 0x1F, 0x00, 0xE0, 0x3F, 0x04, 0xD0, 0x5F, 0x0E, 0x38, 0xE0, // '2'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 
+    0x0E, 0x38, 0xE0, 0xF4, 0x17, 0x40, 0xF8, 0x0F, 0x00, 0xF0, 0x07, 0x00, 
+    0x04, 0x10, 0x40, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, // '3'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0xF4, 0xD7, 0x5F, 
+    0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F,                                     
+    0xF0, 0x07, 0x00, 0xF8, 0x0F, 0x00, 0xF0, 0x17, 0x00, 0x00, 0x38, 0x00, // '4'
+    0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 0x00, 0x38, 0x00, 
+    0x00, 0x38, 0x00, 0xF0, 0xD7, 0x1F, 0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F, 
+    0xF0, 0x07, 0x00, 0xF8, 0x0F, 0x00, 0xF4, 0x17, 0x40, 0x0E, 0x38, 0xE0, // '5'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 
+    0x0E, 0x38, 0xE0, 0x04, 0xD0, 0x5F, 0x00, 0xE0, 0x3F, 0x00, 0xC0, 0x1F, 
+    0xF0, 0xC7, 0x1F, 0xF8, 0xEF, 0x3F, 0xF4, 0xD7, 0x5F, 0x0E, 0x38, 0xE0, // '6'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 
+    0x0E, 0x38, 0xE0, 0x04, 0xD0, 0x5F, 0x00, 0xE0, 0x3F, 0x00, 0xC0, 0x1F, 
+    0x04, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x0E, 0x00, 0x00, // '7'
+    0x0E, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x0E, 0x00, 0x00, 0xF4, 0xC7, 0x1F, 
+    0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F,                                     
+    0xF0, 0xC7, 0x1F, 0xF8, 0xEF, 0x3F, 0xF4, 0xD7, 0x5F, 0x0E, 0x38, 0xE0, // '8'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 
+    0x0E, 0x38, 0xE0, 0xF4, 0xD7, 0x5F, 0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F, 
+    0xF0, 0x07, 0x00, 0xF8, 0x0F, 0x00, 0xF4, 0x17, 0x40, 0x0E, 0x38, 0xE0, // '9'
+    0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 0x0E, 0x38, 0xE0, 
+    0x0E, 0x38, 0xE0, 0xF4, 0xD7, 0x5F, 0xF8, 0xEF, 0x3F, 0xF0, 0xC7, 0x1F, 
+    0xC0, 0x01, 0x07, 0xC0, 0x01, 0x07, 0xC0, 0x01, 0x07,                   // ':'
+};
+
+static const OledGlyph_t Digits24_Glyphs[27] = {
+    {     0,   0,   0,  14 },   // ' '
+    {     0,   0,   0,   0 },   // '!' (not in the font)
+    {     0,   0,   0,   0 },   // '"' (not in the font)
+    {     0,   0,   0,   0 },   // '#' (not in the font)
+    {     0,   0,   0,   0 },   // '$' (not in the font)
+    {     0,  12,   0,  14 },   // '%'
+    {     0,   0,   0,   0 },   // '&' (not in the font)
+    {     0,   0,   0,   0 },   // '\'' (not in the font)
+    {     0,   0,   0,   0 },   // '(' (not in the font)
+    {     0,   0,   0,   0 },   // ')' (not in the font)
+    {     0,   0,   0,   0 },   // '*' (not in the font)
+    {    36,   8,   1,  12 },   // '+'
+    {     0,   0,   0,   0 },   // ',' (not in the font)
+    {    60,   8,   1,  12 },   // '-'
+    {    84,   3,   0,   5 },   // '.'
+    {     0,   0,   0,   0 },   // '/' (not in the font)
+    {    93,  12,   0,  14 },   // '0'
+    {   129,   3,   9,  14 },   // '1'
+    {   138,  12,   0,  14 },   // '2'
+    {   174,  10,   2,  14 },   // '3'
+    {   204,  12,   0,  14 },   // '4'
+    {   240,  12,   0,  14 },   // '5'
+    {   276,  12,   0,  14 },   // '6'
+    {   312,  10,   2,  14 },   // '7'
+    {   342,  12,   0,  14 },   // '8'
+    {   378,  12,   0,  14 },   // '9'
+    {   414,   3,   0,   5 },   // ':'
+};
+
+const OledFont_t Font_Digits24 = {
+    .name       = "Digits24",
+    .height     = 24,
+    .pages      = 3,
+    .first      = ' ',
+    .last       = ':',
+    .fallback   = ' ',
+    .glyphs     = Digits24_Glyphs,
+    .bitmap     = Digits24_Bitmap,
+    .bitmapSize = sizeof(Digits24_Bitmap),
+    .kerning    = NULL,
+    .kernCount  = 0,
+};
@@ -0,0 +1,253 @@
+/*
+ * bsp_oled_gfx.c
+ *
+ * Created on: Mar 1, 2026
+ * Author: Rahul B.
+ * Description: 2D primitives and widgets for the SSD1306 OLED frame buffer
+ */
+
+#include "bsp_oled_gfx.h"
+#include <stdlib.h>
+#include <string.h>
+
+// --- Spans ---
+// Every primitive ends up here: columns x..x+w-1 of one page, the rows of
+// mask. A full byte that is set or cleared is a memset; else each byte is
+// ORed, ANDed or XORed with the mask. The whole span is marked dirty; the
+// flush trims it to the bytes that really changed against the panel.
+static void Gfx_FillSpan(uint8_t page, uint8_t x, uint8_t w, uint8_t mask, OledColor_t color) {
+    uint8_t *row = &BSP_OLED_GetDrawBuffer()[page * OLED_WIDTH + x];
+
+    if (mask == 0xFF && color != OLED_PIXEL_INVERT) {
+        memset(row, (color == OLED_PIXEL_ON) ? 0xFF : 0x00, w);
+    } else if (color == OLED_PIXEL_ON) {
+        for (uint8_t i = 0; i < w; i++) row[i] |= mask;
+    } else if (color == OLED_PIXEL_OFF) {
+        for (uint8_t i = 0; i < w; i++) row[i] &= (uint8_t)~mask;
+    } else {
+        for (uint8_t i = 0; i < w; i++) row[i] ^= mask;
+    }
+    BSP_OLED_MarkDirty(page, x, (uint8_t)(x + w - 1));
+}
+
+// Helper: cut pos, len down to 0..limit - 1; false if nothing is left
+static inline bool Gfx_Clip(int16_t *pos, int16_t *len, int16_t limit) {
+    if (*pos < 0) {
+        *len += *pos;
+        *pos = 0;
+    }
+    if (*pos + *len > limit) *len = limit - *pos;
+    return *len > 0;
+}
+
+// Helper: one pixel, for the outlines that are not spans
+static inline void Gfx_Plot(int16_t x, int16_t y, OledColor_t color) {
+    if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT) return;
+    Gfx_FillSpan((uint8_t)(y / 8), (uint8_t)x, 1, (uint8_t)(1U << (y % 8)), color);
+}
+
+// --- Primitives ---
+
+void BSP_OLED_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color) {
+    if (w <= 0 || h <= 0) return;
+    if (!Gfx_Clip(&x, &w, OLED_WIDTH) || !Gfx_Clip(&y, &h, OLED_HEIGHT)) return;
+
+    uint8_t first = (uint8_t)(y / 8);
+    uint8_t last = (uint8_t)((y + h - 1) / 8);
+    uint8_t top = (uint8_t)(0xFF << (y % 8));                   // rows from y down
+    uint8_t bottom = (uint8_t)(0xFF >> (7 - (y + h - 1) % 8));  // rows up to y + h - 1
+
+    for (uint8_t page = first; page <= last; page++) {
+        uint8_t mask = 0xFF;
+
+        if (page == first) mask &= top;
+        if (page == last) mask &= bottom;
+        Gfx_FillSpan(page, (uint8_t)x, (uint8_t)w, mask, color);
+    }
+}
+
+void BSP_OLED_DrawHLine(int16_t x, int16_t y, int16_t w, OledColor_t color) {
+    BSP_OLED_FillRect(x, y, w, 1, color);
+}
+
+void BSP_OLED_DrawVLine(int16_t x, int16_t y, int16_t h, OledColor_t color) {
+    BSP_OLED_FillRect(x, y, 1, h, color);
+}
+
+void BSP_OLED_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, OledColor_t color) {
+    if (w <= 0 || h <= 0) return;
+
+    BSP_OLED_DrawHLine(x, y, w, color);
+    if (h > 1) BSP_OLED_DrawHLine(x, y + h - 1, w, color);
+    if (h > 2) {
+        // Sides between the two lines, so no corner is drawn twice
+        BSP_OLED_DrawVLine(x, y + 1, h - 2, color);
+        if (w > 1) BSP_OLED_DrawVLine(x + w - 1, y + 1, h - 2, color);
+    }
+}
+
+void BSP_OLED_InvertRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    BSP_OLED_FillRect(x, y, w, h, OLED_PIXEL_INVERT);
+}
+
+/**
+ * @brief Bresenham line, drawn as runs
+ * @note  The pixels are those of the classic all-octant loop. Pixels that
+ *        share the row (x major) or column (y major) are collected and
+ *        drawn as one H/V line, so a shallow line costs a span per row
+ *        instead of a pixel per column.
+ */
+void BSP_OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, OledColor_t color) {
+    int16_t dx = (int16_t)abs(x1 - x0);
+    int16_t dy = (int16_t)-abs(y1 - y0);
+    int16_t sx = (x0 < x1) ? 1 : -1;
+    int16_t sy = (y0 < y1) ? 1 : -1;
+    bool xMajor = (dx >= -dy);
+    int32_t err = dx + dy;
+    int16_t runX = x0, runY = y0;   // first pixel of the current run
+
+    for (;;) {
+        bool last = (x0 == x1 && y0 == y1);
+        bool stepX = false, stepY = false;
+
+        if (!last) {
+            int32_t e2 = 2 * err;
+            if (e2 >= dy) { err += dy; stepX = true; }
+            if (e2 <= dx) { err += dx; stepY = true; }
+        }
+
+        // The run ends at the last pixel or when the minor axis moves
+        if (last || (xMajor ? stepY : stepX)) {
+            if (xMajor) BSP_OLED_DrawHLine((runX < x0) ? runX : x0, y0, (int16_t)(abs(x0 - runX) + 1), color);
+            else        BSP_OLED_DrawVLine(x0, (runY < y0) ? runY : y0, (int16_t)(abs(y0 - runY) + 1), color);
+        }
+        if (last) break;
+
+        if (stepX) x0 += sx;
+        if (stepY) y0 += sy;
+        if (xMajor ? stepY : stepX) {
+            runX = x0;
+            runY = y0;
+        }
+    }
+}
+
+// Helper: the (up to) four mirror images of dx, dy around cx, cy, each once
+static void Gfx_Plot4(int16_t cx, int16_t cy, int16_t dx, int16_t dy, OledColor_t color) {
+    Gfx_Plot(cx + dx, cy + dy, color);
+    if (dx != 0) Gfx_Plot(cx - dx, cy + dy, color);
+    if (dy != 0) Gfx_Plot(cx + dx, cy - dy, color);
+    if (dx != 0 && dy != 0) Gfx_Plot(cx - dx, cy - dy, color);
+}
+
+// Helper: rows cy + dy and cy - dy of a disc, half width hw
+static void Gfx_Rows2(int16_t cx, int16_t cy, int16_t dy, int16_t hw, OledColor_t color) {
+    BSP_OLED_DrawHLine(cx - hw, cy + dy, 2 * hw + 1, color);
+    if (dy != 0) BSP_OLED_DrawHLine(cx - hw, cy - dy, 2 * hw + 1, color);
+}
+
+/**
+ * @brief Midpoint circle
+ * @note  One octant is walked (x = 0..y) and mirrored 8 ways. x grows
+ *        every step and x <= y, so no point is met twice and an inverted
+ *        circle toggles each pixel once.
+ */
+void BSP_OLED_DrawCircle(int16_t cx, int16_t cy, int16_t r, OledColor_t color) {
+    int16_t x = 0, y = r;
+    int32_t d = 1 - r;
+
+    if (r < 0) return;
+    while (x <= y) {
+        Gfx_Plot4(cx, cy, x, y, color);
+        if (x != y) Gfx_Plot4(cx, cy, y, x, color);
+
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+    }
+}
+
+/**
+ * @brief Filled disc as one span per row
+ * @note  Same walk as BSP_OLED_DrawCircle(). Each step owns rows cy +- x
+ *        (half width y); rows cy +- y (half width x) are drawn when y is
+ *        about to move on, as x is then the widest for that row. The two
+ *        sets never share a row, so every row is drawn exactly once.
+ */
+void BSP_OLED_FillCircle(int16_t cx, int16_t cy, int16_t r, OledColor_t color) {
+    int16_t x = 0, y = r;
+    int32_t d = 1 - r;
+
+    if (r < 0) return;
+    while (x <= y) {
+        Gfx_Rows2(cx, cy, x, y, color);
+        if (d >= 0 && y > x) Gfx_Rows2(cx, cy, y, x, color);
+
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+    }
+}
+
+// --- Widgets ---
+
+// Helper: min and max of the values when the caller gave no range
+static void Gfx_Range(const int16_t *values, uint8_t count, int16_t *min, int16_t *max) {
+    if (*min < *max) return;
+
+    *min = *max = values[0];
+    for (uint8_t i = 1; i < count; i++) {
+        if (values[i] < *min) *min = values[i];
+        if (values[i] > *max) *max = values[i];
+    }
+    if (*min == *max) (*max)++;
+}
+
+// Helper: value clamped to min..max, scaled to 0..span
+static int16_t Gfx_Scale(int16_t value, int16_t min, int16_t max, int16_t span) {
+    if (value <= min) return 0;
+    if (value >= max) return span;
+    return (int16_t)(((int32_t)(value - min) * span) / (max - min));
+}
+
+void BSP_OLED_DrawSparkline(int16_t x, int16_t y, int16_t w, int16_t h,
+                            const int16_t *values, uint8_t count, int16_t min, int16_t max) {
+    int16_t prevX = 0, prevY = 0;
+
+    BSP_OLED_FillRect(x, y, w, h, OLED_PIXEL_OFF);
+    if (count == 0 || w <= 0 || h <= 0) return;
+    Gfx_Range(values, count, &min, &max);
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t px = x + ((count > 1) ? (int16_t)(((int32_t)i * (w - 1)) / (count - 1)) : 0);
+        int16_t py = y + (h - 1) - Gfx_Scale(values[i], min, max, h - 1);
+
+        if (i == 0) Gfx_Plot(px, py, OLED_PIXEL_ON);
+        else BSP_OLED_DrawLine(prevX, prevY, px, py, OLED_PIXEL_ON);
+        prevX = px;
+        prevY = py;
+    }
+}
+
+void BSP_OLED_DrawBarGraph(int16_t x, int16_t y, int16_t w, int16_t h,
+                           const int16_t *values, uint8_t count, int16_t min, int16_t max) {
+    BSP_OLED_FillRect(x, y, w, h, OLED_PIXEL_OFF);
+    if (count == 0 || w <= 0 || h <= 0) return;
+    Gfx_Range(values, count, &min, &max);
+
+    int16_t barW = (int16_t)((w - (count - 1)) / count);
+    if (barW < 1) barW = 1;
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t barH = Gfx_Scale(values[i], min, max, h);
+        BSP_OLED_FillRect(x + i * (barW + 1), y + h - barH, barW, barH, OLED_PIXEL_ON);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * bsp_oled_image.c
+ *
+ * Created on: Mar 3, 2026
+ * Author: Rahul B.
+ * Description: Compressed full screen images and animations for the SSD1306 OLED
+ */
+
+#include "bsp_oled_image.h"
+#include <string.h>
+
+// --- Decoding ---
+
+const uint8_t *OledImage_DecodePage(const uint8_t *src, uint8_t *dst) {
+    uint8_t *end = dst + OLED_WIDTH;
+
+    while (dst < end) {
+        uint8_t head = *src++;
+        uint8_t count = (uint8_t)((head & 0x7F) + 1);
+
+        if (head & 0x80) {
+            memset(dst, *src++, count);
+        } else {
+            memcpy(dst, src, count);
+            src += count;
+        }
+        dst += count;
+    }
+    return src;
+}
+
+void BSP_OLED_DrawImage(const OledImage_t *image, uint8_t frame) {
+    uint8_t *buffer = BSP_OLED_GetDrawBuffer();
+    const uint8_t *src = &image->data[image->frames[frame]];
+    uint8_t mask = *src++;
+
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        if (!(mask & (1U << page))) continue;
+
+        src = OledImage_DecodePage(src, &buffer[page * OLED_WIDTH]);
+        BSP_OLED_MarkDirty(page, 0, OLED_WIDTH - 1);
+    }
+}
+
+// --- Playback ---
+
+void BSP_OLED_PlayerInit(OledPlayer_t *player, const OledImage_t *image, uint8_t loops) {
+    PT_INIT(&player->pt);
+    player->image = image;
+    player->frame = 0;
+    player->loops = loops;
+}
+
+PT_THREAD(BSP_OLED_PlayerRun(OledPlayer_t *player)) {
+    Pt_t *pt = &player->pt;
+
+    PT_BEGIN(pt);
+
+    player->frame = 0;
+    BSP_OLED_DrawImage(player->image, 0);
+    BSP_OLED_Update();
+
+    while (player->image->frameCount > 1) {
+        PT_AWAIT_MS(pt, player->image->frameMs);
+
+        uint8_t next = (uint8_t)(player->frame + 1);
+
+        if (next == player->image->frameCount) {
+            // Back to frame 0 by the loop frame, if there is a loop left
+            if (player->loops != 0 && --player->loops == 0) break;
+            BSP_OLED_DrawImage(player->image, next);
+            next = 0;
+        } else {
+            BSP_OLED_DrawImage(player->image, next);
+        }
+        player->frame = next;
+        BSP_OLED_Update();
+    }
+
+    PT_END(pt);
+}
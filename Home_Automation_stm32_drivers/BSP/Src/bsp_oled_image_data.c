@@ -0,0 +1,72 @@
+/*
+ * bsp_oled_image_data.c
+ *
+ * Generated by Tools/imagegen/imagegen.py from Tools/imagegen/images.
+ * Do not edit: change the .pbm files and run the generator.
+ */
+
+#include "bsp_oled_image.h"
+
+/* ===== IMAGE_FACE: face.pbm, 335 bytes (raw 1024) ===== */
+static const uint8_t Image_Face_Data[] = {
+    // frame 0, pages 0xFF
+    0xFF, 0x9F, 0x00, 0x9B, 0xFF, 0x83, 0xFE, 0x00, 0xFC, 0x82, 0xEC, 0x05, 0xE0, 0xC0, 0xE0, 0xE0,
+    0x40, 0x00, 0x82, 0x80, 0x8A, 0x00, 0x00, 0x80, 0x82, 0x00, 0x02, 0x80, 0xC0, 0x80, 0xA0, 0x00,
+    0x9F, 0x00, 0xAC, 0xFF, 0x08, 0xFD, 0xFE, 0xFC, 0xF0, 0xF4, 0xF8, 0xFC, 0xFF, 0xFE, 0x83, 0xFF,
+    0x01, 0xFC, 0xFE, 0x83, 0xFF, 0x9F, 0x00, 0x9F, 0x00, 0x8D, 0xFF, 0x05, 0xE7, 0xFF, 0x7F, 0x1F,
+    0x07, 0x07, 0x82, 0x03, 0x02, 0x07, 0x0F, 0x0F, 0x83, 0x8F, 0x02, 0x1F, 0x1F, 0x07, 0x82, 0x0F,
+    0x00, 0x1F, 0x83, 0x3F, 0x83, 0x7F, 0x03, 0x1F, 0x3F, 0x7F, 0x7F, 0x8E, 0xFF, 0x9F, 0x00, 0x9F,
+    0x00, 0x0F, 0xF3, 0x7B, 0x77, 0x7F, 0xFF, 0xFF, 0xBF, 0xFF, 0xFF, 0xDF, 0x03, 0x01, 0x01, 0x07,
+    0x05, 0x0B, 0x85, 0x00, 0x0B, 0x40, 0x60, 0x70, 0x30, 0xF1, 0xE1, 0xF3, 0x23, 0x67, 0xC7, 0x06,
+    0x06, 0x84, 0x00, 0x02, 0xC0, 0xC0, 0xE8, 0x82, 0xFC, 0x06, 0xDC, 0x5C, 0xDC, 0x88, 0x00, 0x10,
+    0x3F, 0x8B, 0xFF, 0x9F, 0x00, 0x9F, 0x00, 0x0A, 0xFF, 0xFE, 0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0x7F,
+    0x7F, 0x3F, 0xB0, 0x8E, 0x00, 0x01, 0x01, 0x01, 0x8A, 0x00, 0x14, 0x01, 0x03, 0x00, 0x01, 0x03,
+    0x03, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0xC0, 0xCF, 0x85, 0x47, 0x0F, 0x4F, 0x2F, 0x6F, 0x4F,
+    0x82, 0x6F, 0x00, 0x3F, 0x9F, 0x00, 0x9F, 0x00, 0x84, 0xFE, 0x86, 0xFF, 0x02, 0xFC, 0xFC, 0x7C,
+    0x88, 0x00, 0x01, 0x80, 0xC0, 0x83, 0xE0, 0x05, 0xF0, 0xF0, 0xFC, 0xFC, 0xFE, 0xFE, 0x82, 0xFC,
+    0x01, 0xF4, 0xE0, 0x82, 0xC0, 0x00, 0x80, 0x83, 0x00, 0x0D, 0xE0, 0xF0, 0xB0, 0xC0, 0xC0, 0x90,
+    0xC0, 0xC0, 0x00, 0x80, 0x00, 0x00, 0x80, 0x80, 0xA0, 0x00, 0x9F, 0x00, 0x8F, 0xFF, 0x09, 0xFC,
+    0xD8, 0x10, 0x70, 0xE0, 0xE0, 0xC0, 0xF8, 0xFF, 0xC3, 0x84, 0x01, 0x10, 0x89, 0x99, 0xB9, 0x99,
+    0x99, 0xF9, 0x99, 0x99, 0x01, 0x81, 0xE3, 0xF3, 0xFF, 0xFB, 0xF8, 0xF8, 0xFE, 0x8F, 0xFF, 0x9F,
+    0x00, 0x9F, 0x00, 0x84, 0xFF, 0x83, 0x7F, 0x01, 0x3F, 0x3F, 0x82, 0x1F, 0x02, 0x0F, 0x07, 0x07,
+    0x84, 0x00, 0x04, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x88, 0x3F, 0x0A, 0x1F, 0x1F, 0x0F, 0x0F, 0x07,
+    0x03, 0x17, 0x07, 0x2F, 0x0F, 0x0F, 0x85, 0x1F, 0x83, 0x3F, 0x86, 0x7F, 0x9F, 0x00,
+    // loop: frame 0 -> 0, pages 0x00
+    0x00,
+};
+
+static const uint16_t Image_Face_Frames[2] = { 0, 334 };
+
+const OledImage_t Image_Face = {
+    .frameCount = 1,
+    .frameMs    = 0,
+    .data       = Image_Face_Data,
+    .frames     = Image_Face_Frames,
+    .size       = sizeof(Image_Face_Data),
+};
+
+/* ===== ANIM_HEART: heart_0.pbm, heart_1.pbm, 115 bytes (raw 2048) ===== */
+static const uint8_t Anim_Heart_Data[] = {
+    // frame 0, pages 0xFF
+    0xFF, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xB1, 0x00, 0x82, 0xF0, 0x85, 0xFE, 0x82, 0xF0, 0x85,
+    0xFE, 0x82, 0xF0, 0xB8, 0x00, 0xB1, 0x00, 0x82, 0x03, 0x82, 0x1F, 0x88, 0xFF, 0x82, 0x1F, 0x82,
+    0x03, 0xB8, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+    // frame 1, pages 0x3C
+    0x3C, 0xB1, 0x00, 0x89, 0xF0, 0x84, 0x00, 0x89, 0xF0, 0xB4, 0x00, 0xAC, 0x00, 0x84, 0xFE, 0x89,
+    0xFF, 0x84, 0xFE, 0x89, 0xFF, 0x84, 0xFE, 0xAF, 0x00, 0xAC, 0x00, 0x84, 0x07, 0x98, 0xFF, 0x84,
+    0x07, 0xAF, 0x00, 0xB6, 0x00, 0x8E, 0x1F, 0xB9, 0x00,
+    // loop: frame 1 -> 0, pages 0x3C
+    0x3C, 0xFF, 0x00, 0xB1, 0x00, 0x82, 0xF0, 0x85, 0xFE, 0x82, 0xF0, 0x85, 0xFE, 0x82, 0xF0, 0xB8,
+    0x00, 0xB1, 0x00, 0x82, 0x03, 0x82, 0x1F, 0x88, 0xFF, 0x82, 0x1F, 0x82, 0x03, 0xB8, 0x00, 0xFF,
+    0x00,
+};
+
+static const uint16_t Anim_Heart_Frames[3] = { 0, 41, 82 };
+
+const OledImage_t Anim_Heart = {
+    .frameCount = 2,
+    .frameMs    = 200,
+    .data       = Anim_Heart_Data,
+    .frames     = Anim_Heart_Frames,
+    .size       = sizeof(Anim_Heart_Data),
+};
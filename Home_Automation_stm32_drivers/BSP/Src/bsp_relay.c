@@ -9,28 +9,23 @@
 
 /* ===== Relay Initialization ===== */
 
-void BSP_Relay_Init(void) {
-    GPIO_Handle_t relay;
-    relay.pGPIOx = RELAY_PORT;
-    relay.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
-    relay.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    relay.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
-    relay.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
-
-    uint8_t pins[] = {RELAY1_PIN, RELAY2_PIN, RELAY3_PIN, RELAY4_PIN};
-    for(int i = 0; i < 4; i++) {
-        relay.GPIO_PinConfig.GPIO_PinNumber = pins[i];
-        GPIO_Init(&relay);
-        // relay is also working on active low logic here
-        GPIO_WriteToOutputPin(RELAY_PORT, pins[i], GPIO_PIN_SET);
+static const GPIO_Handle_t s_relay_pins[] = { BOARD_PINS_RELAY };
 
-    }
+void BSP_Relay_Init(void) {
+    GPIO_InitGroup(s_relay_pins, GPIO_PIN_COUNT(s_relay_pins));
+    // relay is also working on active low logic here: all off
+    GPIO_SetPins(RELAY_PORT, RELAY_ALL_MASK);
 }
 
 void BSP_Relay_SetState(uint8_t relay_pin, uint8_t state) {
     GPIO_WriteToOutputPin(RELAY_PORT, relay_pin, state);
 }
 
+// Drives every relay pin in one write: the bank switches together
+void BSP_Relay_SetAll(uint8_t state) {
+    GPIO_WriteMasked(RELAY_PORT, RELAY_ALL_MASK, (state == SET) ? RELAY_ALL_MASK : 0U);
+}
+
 void BSP_Relay_Toggle(uint8_t relay_pin) {
     GPIO_ToggleOutputPin(RELAY_PORT, relay_pin);
 }
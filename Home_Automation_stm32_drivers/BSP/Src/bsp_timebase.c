@@ -0,0 +1,297 @@
+/*
+ * bsp_timebase.c
+ *
+ * Created on: Feb 14, 2026
+ * Author: Rahul B.
+ * Description: System timebase - 1 ms SysTick tick + 64-bit microsecond clock
+ *
+ * TIM2 is a free-running 32-bit counter at 1 MHz; it wraps every ~71.6 min.
+ * The wrap is folded into s_us_high whenever the counter is sampled, and the
+ * SysTick handler samples it every millisecond, so a wrap is never missed.
+ */
+
+#include "bsp_timebase.h"
+#include "stm32f446xx_rcc_driver.h"
+#include "stm32f446xx_timer_driver.h"
+
+#if !defined(__arm__)
+/* Host builds: TIM2 and the core timer registers are RAM owned by the test */
+#undef TIM2
+#undef SYSTICK
+#undef SCB
+#define TIM2        (&g_TimebaseHostTIM2)
+#define SYSTICK     (&g_TimebaseHostSysTick)
+#define SCB         (&g_TimebaseHostSCB)
+#endif
+
+/* ===== PRIVATE STATE ===== */
+static volatile uint64_t s_ms_ticks  = 0;  /* SysTick count since init          */
+static volatile uint32_t s_us_high   = 0;  /* Upper 32 bits of the TIM2 count    */
+static volatile uint32_t s_last_cnt  = 0;  /* TIM2->CNT at the previous sample   */
+static volatile uint64_t s_us_base   = 0;  /* Time folded in by clock changes    */
+static volatile uint64_t s_tick_us   = 0;  /* now_us() of the last ms boundary   */
+static volatile uint32_t s_cyc_per_us = 1; /* SysTick clocks per microsecond     */
+static volatile uint8_t  s_initialized = 0;
+
+/* ===== CRITICAL SECTION HELPERS (nest-safe, usable from ISRs) ===== */
+#if defined(__arm__)
+static inline uint32_t Timebase_EnterCritical(void)
+{
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask" : "=r" (primask));
+    __asm volatile ("cpsid i" ::: "memory");
+    return primask;
+}
+
+static inline void Timebase_ExitCritical(uint32_t primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+#else
+/* Host builds: a spin lock stands in for PRIMASK, so a test thread can play
+ * SysTick_Handler. Not nest-safe, and nothing in this file nests it. */
+static volatile uint8_t s_host_lock = 0;
+
+static inline uint32_t Timebase_EnterCritical(void)
+{
+    while (__atomic_test_and_set(&s_host_lock, __ATOMIC_ACQUIRE))
+    {
+        /* the other thread is inside */
+    }
+    return 0;
+}
+
+static inline void Timebase_ExitCritical(uint32_t primask)
+{
+    (void)primask;
+    __atomic_clear(&s_host_lock, __ATOMIC_RELEASE);
+}
+#endif
+
+/**
+ * @brief Sample TIM2 and extend it to 64 bits. Call with IRQs masked.
+ */
+static uint64_t Timebase_SampleUs(void)
+{
+    uint32_t cnt = TIM2->CNT;
+
+    if (cnt < s_last_cnt)
+    {
+        s_us_high++;            /* TIM2 wrapped since the last sample */
+    }
+    s_last_cnt = cnt;
+
+    return ((uint64_t)s_us_high << 32) | cnt;
+}
+
+/**
+ * @brief Program SysTick for a 1 ms period from the current HCLK.
+ */
+static void Timebase_SysTickStart(void)
+{
+    uint32_t reload = RCC_GetHCLKFreq() / 1000U;
+
+    SYSTICK->CSR = 0;
+    s_cyc_per_us = (reload >= 1000U) ? (reload / 1000U) : 1U;
+
+    if ((reload == 0) || ((reload - 1U) > SYSTICK_RVR_MAX))
+    {
+        return;                 /* HCLK out of range for a 1 ms tick */
+    }
+
+    SYSTICK->RVR = reload - 1U;
+    SYSTICK->CVR = 0;
+    SYSTICK->CSR = (1U << SYSTICK_CSR_CLKSOURCE) |
+                   (1U << SYSTICK_CSR_TICKINT)   |
+                   (1U << SYSTICK_CSR_ENABLE);
+}
+
+/**
+ * @brief Start SysTick so that its first tick lands (1000 - phase_us) us
+ *        from now, then continue with full 1 ms periods. IRQs masked.
+ */
+static void Timebase_SysTickStartPhase(uint32_t phase_us)
+{
+    uint32_t reload = RCC_GetHCLKFreq() / 1000U;
+    uint32_t first  = (uint32_t)(((uint64_t)reload * (1000U - phase_us)) / 1000U);
+
+    Timebase_SysTickStart();
+    if ((SYSTICK->CSR == 0U) || (first < 2U) || (first >= reload))
+    {
+        return;                 /* out of range, or a full period anyway */
+    }
+
+    SYSTICK->CSR = 0;
+    SYSTICK->RVR = first - 1U;
+    SYSTICK->CVR = 0;
+    SYSTICK->CSR = (1U << SYSTICK_CSR_CLKSOURCE) |
+                   (1U << SYSTICK_CSR_TICKINT)   |
+                   (1U << SYSTICK_CSR_ENABLE);
+    while (SYSTICK->CVR == 0U)
+    {
+        /* wait for the short value to be loaded */
+    }
+    SYSTICK->RVR = reload - 1U; /* used from the next reload on */
+}
+
+/* ===== INITIALIZATION ===== */
+
+void BSP_Timebase_Init(void)
+{
+    uint32_t primask = Timebase_EnterCritical();
+
+    /* SysTick priority lives in SHPR3[31:24] */
+    SCB->SHPR3 &= ~(0xFFUL << 24);
+    SCB->SHPR3 |= ((uint32_t)(TIMEBASE_SYSTICK_PRIORITY << (8 - NO_PR_BITS_IMPLEMENTED)) << 24);
+
+    s_ms_ticks = 0;
+    s_us_high  = 0;
+    s_us_base  = 0;
+    s_last_cnt = TIM2->CNT;
+    s_tick_us  = TIM2->CNT;
+
+    Timebase_SysTickStart();
+    s_initialized = 1;
+
+    Timebase_ExitCritical(primask);
+}
+
+void BSP_Timebase_Reconfigure(void)
+{
+    uint32_t primask = Timebase_EnterCritical();
+
+    /* Fold the elapsed time into the base before TIM2 restarts at 0 */
+    s_us_base += Timebase_SampleUs();
+    s_us_high  = 0;
+
+    TIMER_DelayInit();          /* re-derives PSC for 1 MHz from the new PCLK1 */
+    TIMER_SetCounter(TIM2, 0);
+    s_last_cnt = 0;
+    s_tick_us  = s_us_base;     /* SysTick restarts with a fresh period */
+
+    Timebase_SysTickStart();
+
+    Timebase_ExitCritical(primask);
+}
+
+/**
+ * @brief Overrides the weak hook in the RCC driver.
+ */
+void RCC_ClockChangedCallback(void)
+{
+    if (s_initialized)
+    {
+        BSP_Timebase_Reconfigure();
+    }
+}
+
+/* ===== TICK SUPPRESSION (tickless idle) ===== */
+
+/**
+ * @brief Stop SysTick before a long sleep. Call with IRQs masked.
+ * @note  now_ms() stands still until BSP_Timebase_ResumeTick().
+ */
+void BSP_Timebase_SuspendTick(void)
+{
+    SYSTICK->CSR = 0;
+    (void)Timebase_SampleUs();
+    /* A tick that became pending under the mask is counted on resume */
+    SCB->ICSR = (1UL << SCB_ICSR_PENDSTCLR);
+}
+
+/**
+ * @brief Restart SysTick after a sleep and catch now_ms() up. IRQs masked.
+ * @param unseen_us time TIM2 did not count (Stop mode), 0 after WFI sleep
+ * @note  The ms phase is kept: the first tick lands on the next true
+ *        ms boundary of the now_us() axis, so now_ms() does not drift.
+ */
+void BSP_Timebase_ResumeTick(uint32_t unseen_us)
+{
+    s_us_base += unseen_us;
+
+    uint64_t now     = s_us_base + Timebase_SampleUs();
+    uint64_t elapsed = now - s_tick_us;
+    uint32_t phase   = (uint32_t)(elapsed % 1000U);
+
+    s_ms_ticks += elapsed / 1000U;
+    s_tick_us   = now - phase;
+
+    Timebase_SysTickStartPhase(phase);
+}
+
+/* ===== TICK ISR ===== */
+
+void SysTick_Handler(void)
+{
+    uint32_t primask = Timebase_EnterCritical();
+
+    s_ms_ticks++;
+    /* Sampling keeps the 32 -> 64 bit extension current; back-date the
+     * boundary by the time since the reload (entry latency) */
+    s_tick_us = s_us_base + Timebase_SampleUs() -
+                ((SYSTICK->RVR - SYSTICK->CVR) / s_cyc_per_us);
+
+    Timebase_ExitCritical(primask);
+}
+
+/* ===== TIME READ-OUT ===== */
+
+uint64_t now_us(void)
+{
+    uint32_t primask = Timebase_EnterCritical();
+    uint64_t us = s_us_base + Timebase_SampleUs();
+    Timebase_ExitCritical(primask);
+
+    return us;
+}
+
+/**
+ * @brief Low 32 bits of now_us() without the critical section.
+ * @note  The low word needs only the base and TIM2->CNT. Both change
+ *        together with IRQs masked (Reconfigure, ResumeTick), so no
+ *        interrupt sees one without the other.
+ */
+uint32_t now_us32(void)
+{
+    return (uint32_t)s_us_base + TIM2->CNT;
+}
+
+uint64_t now_ms(void)
+{
+    uint32_t primask = Timebase_EnterCritical();
+    uint64_t ms = s_ms_ticks;
+    Timebase_ExitCritical(primask);
+
+    return ms;
+}
+
+/* ===== DEADLINE HELPERS ===== */
+
+uint64_t deadline_after_us(uint32_t us)
+{
+    return now_us() + us;
+}
+
+uint64_t deadline_after_ms(uint32_t ms)
+{
+    return now_us() + ((uint64_t)ms * 1000U);
+}
+
+bool deadline_expired(uint64_t deadline)
+{
+    return now_us() >= deadline;
+}
+
+uint32_t deadline_remaining_ms(uint64_t deadline)
+{
+    uint64_t now = now_us();
+    uint64_t remaining;
+
+    if (now >= deadline)
+    {
+        return 0;
+    }
+
+    remaining = (deadline - now + 999U) / 1000U;
+    return (remaining > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)remaining;
+}
@@ -7,25 +7,16 @@
 
 #include "bsp_uart2_debug.h"
 #include "bsp_init.h"
+#include "profiler.h"
 
 USART_Handle_t usart2_handle;
 
 /* ===== USART2 GPIO Initialization ===== */
-void USART2_GPIOInit(void) {
-    GPIO_Handle_t usart_gpios;
-
-    usart_gpios.pGPIOx = USART_VCP_PORT;
-    usart_gpios.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
-    usart_gpios.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    usart_gpios.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
-    usart_gpios.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
-    usart_gpios.GPIO_PinConfig.GPIO_PinAltFunMode = USART_VCP_AF;
+static const GPIO_Handle_t s_usart_pins[] = { BOARD_PINS_USART2 };
 
-    usart_gpios.GPIO_PinConfig.GPIO_PinNumber = USART_TX_PIN;
-    GPIO_Init(&usart_gpios);
-
-    usart_gpios.GPIO_PinConfig.GPIO_PinNumber = USART_RX_PIN;
-    GPIO_Init(&usart_gpios);
+void USART2_GPIOInit(void) {
+    // PA2 (TX) and PA3 (RX), AF7
+    GPIO_InitGroup(s_usart_pins, GPIO_PIN_COUNT(s_usart_pins));
 }
 
 /* ===== USART2 Peripheral Initialization ===== */
@@ -43,12 +34,14 @@ void USART2_Init(void) {
 }
 
 void UART_Printf(const char *format, ...) {
+    PROF_BEGIN(PROF_ZONE_UART_PRINTF);
     char buffer[256];
     va_list args;
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format, args);
     USART_SendData(&usart2_handle, (uint8_t*)buffer, strlen(buffer));
     va_end(args);
+    PROF_END(PROF_ZONE_UART_PRINTF);
 }
 
 uint8_t UART_ReceiveByte(void)
@@ -58,6 +51,17 @@ uint8_t UART_ReceiveByte(void)
     return data;
 }
 
+/* Non-blocking receive: false if no byte is waiting */
+bool UART_TryReceiveByte(uint8_t *data)
+{
+    if (!(usart2_handle.pUSARTx->SR & USART_FLAG_RXNE))
+    {
+        return false;
+    }
+    *data = (uint8_t)usart2_handle.pUSARTx->DR;
+    return true;
+}
+
 void Debug_ClearScreen(void)
 {
     // VT100 Escape codes to clear screen and move cursor home
@@ -29,6 +29,14 @@
 #define NVIC_ICER2              	((volatile uint32_t*)0xE000E188)
 #define NVIC_ICER3              	((volatile uint32_t*)0xE000E18C)
 
+/*
+ * NVIC ICPRx (Interrupt Clear-Pending Registers) base addresses
+ */
+#define NVIC_ICPR0              	((volatile uint32_t*)0xE000E280)
+#define NVIC_ICPR1              	((volatile uint32_t*)0xE000E284)
+#define NVIC_ICPR2              	((volatile uint32_t*)0xE000E288)
+#define NVIC_ICPR3              	((volatile uint32_t*)0xE000E28C)
+
 /*
  * NVIC Priority Register base address
  */
@@ -86,6 +94,9 @@
 #define DMA2_Stream2_IRQn           (58)
 #define DMA2_Stream3_IRQn           (59)
 #define DMA2_Stream4_IRQn           (60)
+#define DMA2_Stream5_IRQn           (68)
+#define DMA2_Stream6_IRQn           (69)
+#define DMA2_Stream7_IRQn           (70)
 
 #define EXTI0_IRQn                  (6)
 #define EXTI1_IRQn                  (7)
@@ -263,6 +274,8 @@
 #define ADC2        				((ADC_RegDef_t*)ADC2_BASEADDR)
 #define ADC3        				((ADC_RegDef_t*)ADC3_BASEADDR)
 #define ADC_COMMON  				((ADC_Common_RegDef_t*)ADC_COMMON_BASEADDR)
+#define DMA1                    	((DMA_RegDef_t*)DMA1_BASEADDR)      /* DMA1 peripheral definition */
+#define DMA2                    	((DMA_RegDef_t*)DMA2_BASEADDR)      /* DMA2 peripheral definition */
 #define EXTI                    	((EXTI_RegDef_t*)EXTI_BASEADDR)        /* EXTI base address */
 #define FLASH                   	((FLASH_RegDef_t*)FLASH_R_BASE)
 #define GPIOA                   	((GPIO_RegDef_t*)GPIOA_BASEADDR)    /* GPIOA peripheral definition */
@@ -334,6 +347,12 @@
 #define ADC2_REG_RESET()    do{ (RCC->APB2RSTR |= (1 << 9)); (RCC->APB2RSTR &= ~(1 << 9)); }while(0)
 #define ADC3_REG_RESET()    do{ (RCC->APB2RSTR |= (1 << 10)); (RCC->APB2RSTR &= ~(1 << 10)); }while(0)
 
+/*
+ * Macros to reset DMA controllers
+ */
+#define DMA1_REG_RESET()        do{ (RCC->AHB1RSTR |= (1 << 21)); (RCC->AHB1RSTR &= ~(1 << 21)); }while(0)
+#define DMA2_REG_RESET()        do{ (RCC->AHB1RSTR |= (1 << 22)); (RCC->AHB1RSTR &= ~(1 << 22)); }while(0)
+
 /*
  * Macros to reset GPIOx peripherals
  */
@@ -401,6 +420,12 @@
 #define ADC2_PCLK_EN()  (RCC->APB2ENR |= (1 << 9))
 #define ADC3_PCLK_EN()  (RCC->APB2ENR |= (1 << 10))
 
+/*
+ * Clock Enable Macros for DMA controllers
+ */
+#define DMA1_PCLK_EN()          	(RCC->AHB1ENR |= (1 << 21))         /* Enable DMA1 clock */
+#define DMA2_PCLK_EN()          	(RCC->AHB1ENR |= (1 << 22))         /* Enable DMA2 clock */
+
 /*
  * Clock Enable Macros for GPIOx peripherals
  */
@@ -472,6 +497,12 @@
 #define ADC2_PCLK_DI()  (RCC->APB2ENR &= ~(1 << 9))
 #define ADC3_PCLK_DI()  (RCC->APB2ENR &= ~(1 << 10))
 
+/*
+ * Clock Disable Macros for DMA controllers
+ */
+#define DMA1_PCLK_DI()          	(RCC->AHB1ENR &= ~(1 << 21))        /* Disable DMA1 clock */
+#define DMA2_PCLK_DI()          	(RCC->AHB1ENR &= ~(1 << 22))        /* Disable DMA2 clock */
+
 /*
  * Clock Disable Macros for GPIOx peripherals
  */
@@ -583,6 +614,65 @@ typedef struct
     volatile uint32_t ISAR[5];      /* Offset: 0x60 Instruction Set Attributes Register */
 } SCB_RegDef_t;
 
+/*
+ * Processor Core Peripheral: SysTick (System Timer)
+ * Base Address: 0xE000E010
+ */
+#define SYSTICK_BASEADDR  0xE000E010UL
+#define SYSTICK           ((SysTick_RegDef_t*)SYSTICK_BASEADDR)
+
+typedef struct
+{
+    volatile uint32_t CSR;          /* Offset: 0x00 Control and Status Register */
+    volatile uint32_t RVR;          /* Offset: 0x04 Reload Value Register (24-bit) */
+    volatile uint32_t CVR;          /* Offset: 0x08 Current Value Register */
+    volatile uint32_t CALIB;        /* Offset: 0x0C Calibration Value Register */
+} SysTick_RegDef_t;
+
+/*
+ * SysTick CSR bit positions
+ */
+#define SYSTICK_CSR_ENABLE        0     /* Counter enable */
+#define SYSTICK_CSR_TICKINT       1     /* Exception request on count to 0 */
+#define SYSTICK_CSR_CLKSOURCE     2     /* 1 = processor clock (HCLK), 0 = HCLK/8 */
+#define SYSTICK_CSR_COUNTFLAG     16    /* Counted to 0 since last read */
+#define SYSTICK_RVR_MAX           0x00FFFFFFUL
+
+/*
+ * SCB ICSR / SCR bit positions
+ */
+#define SCB_ICSR_PENDSTCLR        25    /* Clear a pending SysTick */
+#define SCB_ICSR_PENDSTSET        26    /* SysTick pending */
+#define SCB_SCR_SLEEPONEXIT       1     /* Sleep again on return from ISR */
+#define SCB_SCR_SLEEPDEEP         2     /* WFI enters Stop (deep sleep) */
+
+/*
+ * Processor Core Peripheral: DWT (Data Watchpoint and Trace)
+ * Base Address: 0xE0001000
+ */
+#define DWT_BASEADDR      0xE0001000UL
+#define DWT               ((DWT_RegDef_t*)DWT_BASEADDR)
+
+typedef struct
+{
+    volatile uint32_t CTRL;         /* Offset: 0x00 Control Register */
+    volatile uint32_t CYCCNT;       /* Offset: 0x04 Cycle Count Register */
+    volatile uint32_t CPICNT;       /* Offset: 0x08 CPI Count Register */
+    volatile uint32_t EXCCNT;       /* Offset: 0x0C Exception Overhead Count Register */
+    volatile uint32_t SLEEPCNT;     /* Offset: 0x10 Sleep Count Register */
+    volatile uint32_t LSUCNT;       /* Offset: 0x14 LSU Count Register */
+    volatile uint32_t FOLDCNT;      /* Offset: 0x18 Folded-instruction Count Register */
+    volatile uint32_t PCSR;         /* Offset: 0x1C Program Counter Sample Register */
+} DWT_RegDef_t;
+
+#define DWT_CTRL_CYCCNTENA        0     /* Enable the cycle counter */
+
+/*
+ * CoreDebug DEMCR (Debug Exception and Monitor Control Register)
+ */
+#define COREDEBUG_DEMCR           ((volatile uint32_t*)0xE000EDFCUL)
+#define COREDEBUG_DEMCR_TRCENA    24    /* Enable DWT and ITM */
+
 /************************* peripheral register definition structure ***********/
 
 /*
@@ -622,6 +712,31 @@ typedef struct
     volatile uint32_t DR;     /* Regular data register */
 } ADC_RegDef_t;
 
+/*
+ * Peripheral register definition structure for one DMA stream
+ */
+typedef struct
+{
+    volatile uint32_t CR;           /* DMA stream x configuration register,        Address offset: 0x10 + 0x18 * x */
+    volatile uint32_t NDTR;         /* DMA stream x number of data register,       Address offset: 0x14 + 0x18 * x */
+    volatile uint32_t PAR;          /* DMA stream x peripheral address register,   Address offset: 0x18 + 0x18 * x */
+    volatile uint32_t M0AR;         /* DMA stream x memory 0 address register,     Address offset: 0x1C + 0x18 * x */
+    volatile uint32_t M1AR;         /* DMA stream x memory 1 address register,     Address offset: 0x20 + 0x18 * x */
+    volatile uint32_t FCR;          /* DMA stream x FIFO control register,         Address offset: 0x24 + 0x18 * x */
+} DMA_Stream_RegDef_t;
+
+/*
+ * Peripheral register definition structure for DMA (controller + its 8 streams)
+ */
+typedef struct
+{
+    volatile uint32_t LISR;         /* DMA low interrupt status register (streams 0-3),    Address offset: 0x00 */
+    volatile uint32_t HISR;         /* DMA high interrupt status register (streams 4-7),   Address offset: 0x04 */
+    volatile uint32_t LIFCR;        /* DMA low interrupt flag clear register,              Address offset: 0x08 */
+    volatile uint32_t HIFCR;        /* DMA high interrupt flag clear register,             Address offset: 0x0C */
+    DMA_Stream_RegDef_t S[8];       /* Streams 0-7,                                        Address offset: 0x10-0xCC */
+} DMA_RegDef_t;
+
 /*
  * Peripheral register definition structure for EXTI
  */
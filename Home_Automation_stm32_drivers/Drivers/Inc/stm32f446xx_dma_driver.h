@@ -0,0 +1,212 @@
+/*
+ * stm32f446xx_dma_driver.h
+ *
+ *  Created on: Feb 26, 2026
+ *      Author: Rahul B.
+ *
+ * DMA1/DMA2 stream driver. A stream is picked by controller + stream number
+ * and connected to its peripheral request by the channel (RM0390 Tables
+ * 28/29). Requests used or planned in this project:
+ *
+ *   I2C1_TX    DMA1 Stream7 Channel1   (OLED frames; Stream6 is left to USART2)
+ *   USART2_TX  DMA1 Stream6 Channel4
+ *   USART2_RX  DMA1 Stream5 Channel4
+ *   ADC1       DMA2 Stream0 Channel0   (or Stream4)
+ *
+ * Only DMA2 can do memory-to-memory transfers.
+ */
+
+#ifndef INC_STM32F446XX_DMA_DRIVER_H_
+#define INC_STM32F446XX_DMA_DRIVER_H_
+
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+/*
+ * @DMA_CHANNEL
+ * Request channel of a stream (CHSEL)
+ */
+#define DMA_CHANNEL_0           0
+#define DMA_CHANNEL_1           1
+#define DMA_CHANNEL_2           2
+#define DMA_CHANNEL_3           3
+#define DMA_CHANNEL_4           4
+#define DMA_CHANNEL_5           5
+#define DMA_CHANNEL_6           6
+#define DMA_CHANNEL_7           7
+
+/*
+ * @DMA_DIRECTION
+ */
+#define DMA_DIR_P2M             0       /* Peripheral to memory (ADC, USART RX) */
+#define DMA_DIR_M2P             1       /* Memory to peripheral (I2C TX, USART TX) */
+#define DMA_DIR_M2M             2       /* Memory to memory (DMA2 only) */
+
+/*
+ * @DMA_DATA_SIZE
+ * Peripheral / memory data width
+ */
+#define DMA_SIZE_BYTE           0       /* 8 bit */
+#define DMA_SIZE_HALFWORD       1       /* 16 bit */
+#define DMA_SIZE_WORD           2       /* 32 bit */
+
+/*
+ * @DMA_MODE
+ */
+#define DMA_MODE_NORMAL         0       /* Stream stops when NDTR reaches 0 */
+#define DMA_MODE_CIRCULAR       1       /* NDTR and addresses reload: continuous ring */
+
+/*
+ * @DMA_PRIORITY
+ * Software priority between streams of the same controller
+ */
+#define DMA_PRIORITY_LOW        0
+#define DMA_PRIORITY_MEDIUM     1
+#define DMA_PRIORITY_HIGH       2
+#define DMA_PRIORITY_VERY_HIGH  3
+
+/*
+ * @DMA_FIFO_MODE
+ */
+#define DMA_FIFO_DIRECT         0       /* Direct mode: every request moves one item */
+#define DMA_FIFO_ENABLE         1       /* 4-word FIFO, flushed at the threshold */
+
+/*
+ * @DMA_FIFO_THRESHOLD
+ */
+#define DMA_FIFO_TH_1QUARTER    0
+#define DMA_FIFO_TH_HALF        1
+#define DMA_FIFO_TH_3QUARTERS   2
+#define DMA_FIFO_TH_FULL        3
+
+/*
+ * DMA Stream States
+ */
+#define DMA_READY               0
+#define DMA_BUSY                1
+
+/*
+ * DMA Application Events
+ */
+#define DMA_EV_TC               0       /* Transfer complete (each lap in circular mode) */
+#define DMA_EV_HT               1       /* Half transfer */
+#define DMA_ERROR_TE            2       /* Transfer error: bus fault, stream disabled by hardware */
+#define DMA_ERROR_DME           3       /* Direct mode error */
+#define DMA_ERROR_FE            4       /* FIFO overrun/underrun */
+
+/*
+ * Bit position definitions DMA_SxCR
+ */
+#define DMA_SxCR_EN             0
+#define DMA_SxCR_DMEIE          1
+#define DMA_SxCR_TEIE           2
+#define DMA_SxCR_HTIE           3
+#define DMA_SxCR_TCIE           4
+#define DMA_SxCR_PFCTRL         5
+#define DMA_SxCR_DIR            6
+#define DMA_SxCR_CIRC           8
+#define DMA_SxCR_PINC           9
+#define DMA_SxCR_MINC           10
+#define DMA_SxCR_PSIZE          11
+#define DMA_SxCR_MSIZE          13
+#define DMA_SxCR_PINCOS         15
+#define DMA_SxCR_PL             16
+#define DMA_SxCR_DBM            18
+#define DMA_SxCR_CT             19
+#define DMA_SxCR_PBURST         21
+#define DMA_SxCR_MBURST         23
+#define DMA_SxCR_CHSEL          25
+
+/*
+ * Bit position definitions DMA_SxFCR
+ */
+#define DMA_SxFCR_FTH           0
+#define DMA_SxFCR_DMDIS         2
+#define DMA_SxFCR_FS            3
+#define DMA_SxFCR_FEIE          7
+
+/*
+ * Interrupt flags of one stream, as returned by DMA_GetFlagStatus()
+ * (the same 6-bit group sits at bit 0, 6, 16 or 22 of LISR/HISR)
+ */
+#define DMA_FLAG_FEIF           (1 << 0)
+#define DMA_FLAG_DMEIF          (1 << 2)
+#define DMA_FLAG_TEIF           (1 << 3)
+#define DMA_FLAG_HTIF           (1 << 4)
+#define DMA_FLAG_TCIF           (1 << 5)
+#define DMA_FLAG_ALL            (DMA_FLAG_FEIF | DMA_FLAG_DMEIF | DMA_FLAG_TEIF | DMA_FLAG_HTIF | DMA_FLAG_TCIF)
+
+/*
+ * Configuration structure for a DMA stream
+ */
+typedef struct
+{
+    uint8_t DMA_Channel;            /* Request channel @DMA_CHANNEL */
+    uint8_t DMA_Direction;          /* @DMA_DIRECTION */
+    uint8_t DMA_PeriphInc;          /* ENABLE: peripheral address increments */
+    uint8_t DMA_MemInc;             /* ENABLE: memory address increments */
+    uint8_t DMA_PeriphSize;         /* @DMA_DATA_SIZE */
+    uint8_t DMA_MemSize;            /* @DMA_DATA_SIZE */
+    uint8_t DMA_Mode;               /* @DMA_MODE */
+    uint8_t DMA_Priority;           /* @DMA_PRIORITY */
+    uint8_t DMA_FIFOMode;           /* @DMA_FIFO_MODE */
+    uint8_t DMA_FIFOThreshold;      /* @DMA_FIFO_THRESHOLD, FIFO mode only */
+    uint8_t DMA_HalfTransferIT;     /* ENABLE: report DMA_EV_HT (double buffering in circular mode) */
+} DMA_Config_t;
+
+typedef struct DMA_Handle DMA_Handle_t;
+
+/* Called from DMA_IRQHandling() with a DMA application event */
+typedef void (*DMA_Callback_t)(DMA_Handle_t *pDMAHandle, uint8_t AppEv);
+
+/*
+ * Handle structure for a DMA stream
+ */
+struct DMA_Handle
+{
+    DMA_RegDef_t    *pDMAx;         /* DMA1 or DMA2 */
+    uint8_t         Stream;         /* Stream number 0-7 */
+    DMA_Config_t    DMA_Config;     /* Stream configuration */
+    DMA_Callback_t  pCallback;      /* Transfer events (interrupt context), may be NULL */
+    void            *pContext;      /* Owner of the stream, e.g. the peripheral handle */
+    volatile uint8_t State;         /* DMA_READY or DMA_BUSY */
+};
+
+/******************************************************************************************
+ *                              APIs supported by this driver
+ *         For more information about the APIs, check the function definitions
+ ******************************************************************************************/
+
+/*
+ * Peripheral Clock setup
+ */
+void DMA_PeriClockControl(DMA_RegDef_t *pDMAx, uint8_t EnorDi);
+
+/*
+ * Init and De-init
+ */
+void DMA_Init(DMA_Handle_t *pDMAHandle);
+void DMA_DeInit(DMA_RegDef_t *pDMAx);
+
+/*
+ * Transfer control
+ */
+uint8_t DMA_StartIT(DMA_Handle_t *pDMAHandle, uint32_t PeriphAddr, uint32_t MemAddr, uint16_t Len);
+void DMA_Abort(DMA_Handle_t *pDMAHandle);
+uint16_t DMA_GetRemaining(DMA_Handle_t *pDMAHandle);
+
+/*
+ * Flag management
+ */
+uint8_t DMA_GetFlagStatus(DMA_Handle_t *pDMAHandle, uint8_t FlagName);
+void DMA_ClearFlag(DMA_Handle_t *pDMAHandle, uint8_t FlagName);
+
+/*
+ * IRQ Configuration and ISR handling
+ */
+uint8_t DMA_GetIRQNumber(DMA_RegDef_t *pDMAx, uint8_t Stream);
+void DMA_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi);
+void DMA_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);
+void DMA_IRQHandling(DMA_Handle_t *pDMAHandle);
+
+#endif /* INC_STM32F446XX_DMA_DRIVER_H_ */
@@ -68,6 +68,12 @@
 #define GPIO_PIN_NO_14          14
 #define GPIO_PIN_NO_15          15
 
+/*
+ * @GPIO_PIN_MASKS
+ * Bit mask of one pin, for the multi-pin APIs (GPIO_SetPins, GPIO_WriteMasked, ...)
+ */
+#define GPIO_PIN_MASK(pin)      ((uint16_t)(1U << (pin)))
+
 /*
  * Configuration structure for a GPIO pin
  */
@@ -90,6 +96,45 @@ typedef struct
     GPIO_PinConfig_t GPIO_PinConfig; /* Holds GPIO pin configuration settings */
 } GPIO_Handle_t;
 
+/*
+ * One row of a const pin table for GPIO_InitGroup()
+ * (port, pin, mode, output type, speed, pull-up/down, alternate function)
+ */
+#define GPIO_PIN_DESC(port, pin, mode, optype, speed, pupd, altfn) \
+    { (port), { (pin), (mode), (speed), (pupd), (optype), (altfn) } }
+
+#define GPIO_PIN_COUNT(table)   ((uint8_t)(sizeof(table) / sizeof((table)[0])))
+
+/*
+ * EXTI lines served by each interrupt vector, for GPIO_EXTI_Dispatch()
+ */
+#define GPIO_EXTI_LINE(n)       (1U << (n))
+#define GPIO_EXTI_LINES_9_5     0x000003E0U     /* EXTI9_5_IRQHandler */
+#define GPIO_EXTI_LINES_15_10   0x0000FC00U     /* EXTI15_10_IRQHandler */
+#define GPIO_EXTI_LINE_COUNT    16U
+
+/*
+ * Every vector enabled by GPIO_EXTI_Register() gets this priority, so the
+ * callbacks of two lines never pre-empt each other
+ */
+#define GPIO_EXTI_IRQ_PRIORITY  NVIC_IRQ_PRI15
+
+/*
+ * Callback of an EXTI line, called from the interrupt with the pin level
+ * read right after the edge (0 after a falling edge, 1 after a rising one)
+ */
+typedef void (*GPIO_EXTICallback_t)(uint8_t Line, uint8_t Level);
+
+/*
+ * Per-line statistics of the EXTI service
+ */
+typedef struct
+{
+    uint32_t Hits;                  /* Edges taken on the line */
+    uint32_t Unhandled;             /* Of those, edges with no callback attached */
+    uint32_t LastTime;              /* Clock (GPIO_EXTI_SetClock) at the last edge */
+} GPIO_EXTIStats_t;
+
 /******************************************************************************************
  *                              APIs supported by this driver
  *         For more information about the APIs, check the function definitions
@@ -99,6 +144,7 @@ typedef struct
  * Init and De-init
  */
 void GPIO_Init(GPIO_Handle_t *pGPIOHandle);
+void GPIO_InitGroup(const GPIO_Handle_t *pPins, uint8_t Count);
 void GPIO_DeInit(GPIO_RegDef_t *pGPIOx);
 
 /*
@@ -117,6 +163,33 @@ void GPIO_WriteToOutputPort(GPIO_RegDef_t *pGPIOx, uint16_t Value);
 
 void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber);
 
+/*
+ * Atomic multi-pin write (one store to BSRR)
+ */
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask);
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask);
+void GPIO_WriteMasked(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, uint16_t Value);
+
+/*
+ * Inline variants of the above for ISRs and scan loops: no call, the store
+ * is the whole function. Host emulators replace the out-of-line functions
+ * only, so code they run must not use these.
+ */
+static inline void GPIO_SetPinsFast(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+    pGPIOx->BSRR = PinMask;
+}
+
+static inline void GPIO_ResetPinsFast(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+    pGPIOx->BSRR = (uint32_t)PinMask << 16;
+}
+
+static inline void GPIO_WriteMaskedFast(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, uint16_t Value)
+{
+    pGPIOx->BSRR = ((uint32_t)(PinMask & (uint16_t)~Value) << 16) | (PinMask & Value);
+}
+
 /*
  * IRQ Configuration and ISR handling
  */
@@ -124,4 +197,18 @@ void GPIO_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi);
 void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);
 void GPIO_IRQHandling(uint8_t PinNumber);
 
+/*
+ * EXTI service: one callback per line, shared vectors demultiplexed
+ */
+void GPIO_EXTI_Attach(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, GPIO_EXTICallback_t Callback);
+void GPIO_EXTI_Register(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Trigger, GPIO_EXTICallback_t Callback);
+void GPIO_EXTI_Unregister(uint8_t Line);
+void GPIO_EXTI_SetClock(uint32_t (*pNow)(void));
+
+void GPIO_EXTI_Dispatch(uint32_t LineMask);
+void GPIO_EXTI_Service(uint32_t Lines);
+
+const GPIO_EXTIStats_t *GPIO_EXTI_GetStats(uint8_t Line);
+void GPIO_EXTI_ResetStats(void);
+
 #endif /* INC_STM32F446XX_GPIO_DRIVER_H_ */
@@ -10,6 +10,7 @@
 
 #include "stm32f446xx.h"
 #include "stm32f446xx_rcc_driver.h"
+#include "stm32f446xx_dma_driver.h"
 
 #include <stdint.h>
 
@@ -26,10 +27,15 @@ typedef struct
     uint8_t  I2C_FMDutyCycle;       /* Fast mode duty cycle: 2 or 16/9 */
 } I2C_Config_t;
 
+typedef struct I2C_Handle I2C_Handle_t;
+
+/* Called from the I2C interrupt handling with an I2C application event */
+typedef void (*I2C_Callback_t)(I2C_Handle_t *pI2CHandle, uint8_t AppEv);
+
 /*
  * Handle structure for I2Cx peripheral
  */
-typedef struct
+struct I2C_Handle
 {
     I2C_RegDef_t    *pI2Cx;         /* Base address of I2Cx peripheral */
     I2C_Config_t    I2C_Config;     /* I2C configuration settings */
@@ -45,7 +51,10 @@ typedef struct
     uint8_t TxBusy;            
     uint8_t RxBusy;            
 
-} I2C_Handle_t;
+    DMA_Handle_t    *pDMATx;        /* TX stream for I2C_MasterSendDataDMA(), NULL if unused */
+    I2C_Callback_t  pCallback;      /* Events of this bus (interrupt context), NULL: I2C_ApplicationEventCallback() */
+
+};
 
 /*
  * @I2C_SCL_SPEED
@@ -89,6 +98,7 @@ typedef struct
 #define I2C_ERROR_TIMEOUT               7
 #define I2C_EV_DATA_REQ                 8
 #define I2C_EV_DATA_RCV                 9
+#define I2C_ERROR_DMA                   10      /* TX stream reported an error */
 
 /*
  * I2C Repeated Start
@@ -231,6 +241,11 @@ void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint8_t
 uint8_t I2C_MasterSendDataIT(I2C_Handle_t *pI2CHandle, uint8_t *pTxbuffer, uint32_t Len, uint8_t SlaveAddr, uint8_t Sr);
 uint8_t I2C_MasterReceiveDataIT(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t Len, uint8_t SlaveAddr, uint8_t Sr);
 
+/*
+ * Data Send with DMA (pI2CHandle->pDMATx must be initialised)
+ */
+uint8_t I2C_MasterSendDataDMA(I2C_Handle_t *pI2CHandle, uint8_t *pTxbuffer, uint32_t Len, uint8_t SlaveAddr, uint8_t Sr);
+
 void I2C_CloseReceiveData(I2C_Handle_t *pI2CHandle);
 void I2C_CloseSendData(I2C_Handle_t *pI2CHandle);
 
@@ -255,7 +270,7 @@ void I2C_ManageAcking(I2C_RegDef_t *pI2Cx, uint8_t EnorDi);
 // void I2C_SlaveEnableDisableCallbackEvents(I2C_RegDef_t *pI2Cx, uint8_t EnorDi);
 
 /*
- * Application callback
+ * Application callback, for the handles without their own pCallback
  */
 void I2C_ApplicationEventCallback(I2C_Handle_t *pI2CHandle, uint8_t AppEv);
 
@@ -178,6 +178,9 @@ uint32_t RCC_GetPLLOutputClock(void);
 uint32_t RCC_GetSystemClock(void);
 uint32_t RCC_GetHCLKFreq(void);
 
+/* Application callback (weak) - called after the clock tree was changed */
+void RCC_ClockChangedCallback(void);
+
 /* Helper Macros for Easy Configuration */
 #define RCC_OSC_HSE_8MHZ_BYPASS() \
     { \
@@ -261,4 +261,15 @@ void TIMER_DelayMs(TIM_RegDef_t *pTIMx, uint32_t DelayMs);
 void TIMER_DelayUs(TIM_RegDef_t *pTIMx, uint32_t DelayUs);
 void TIMER_Basic_DelayMs(TIM_RegDef_t *pTIMx, uint16_t DelayMs);
 void TIMER_Basic_DelayMs_IT(TIM_RegDef_t *pTIMx, uint16_t DelayMs);
+
+/*
+ * One-pulse mode (TIM6/TIM7): one update interrupt per started interval
+ */
+void TIMER_OnePulseInit(TIM_RegDef_t *pTIMx, uint32_t TickHz);
+void TIMER_OnePulseStart(TIM_RegDef_t *pTIMx, uint16_t Ticks);
+
+/*
+ * Periodic mode: one update interrupt every Ticks ticks until TIMER_Disable()
+ */
+void TIMER_PeriodicInit(TIM_RegDef_t *pTIMx, uint32_t TickHz, uint16_t Ticks);
 #endif /* INC_STM32F446XX_TIMER_DRIVER_H_ */
@@ -0,0 +1,405 @@
+/*
+ * stm32f446xx_dma_driver.c
+ *
+ *  Created on: Feb 26, 2026
+ *      Author: Rahul B.
+ */
+
+#include "stm32f446xx_dma_driver.h"
+
+/* Position of a stream's flag group inside LISR/HISR (and LIFCR/HIFCR) */
+static const uint8_t DMA_FlagShift[4] = { 0, 6, 16, 22 };
+
+/* ----------- STATIC HELPER FUNCTIONS ----------- */
+
+static inline DMA_Stream_RegDef_t *DMA_GetStream(DMA_Handle_t *pDMAHandle)
+{
+    return &pDMAHandle->pDMAx->S[pDMAHandle->Stream & 0x7];
+}
+
+/*********************************************************************
+ * @fn              - DMA_Disable
+ *
+ * @brief           - Clears EN and waits until the stream has stopped
+ *
+ * @Note            - EN reads 1 until the current data item is finished;
+ *                    CR, PAR, M0AR and NDTR must not be written before.
+ *********************************************************************/
+static void DMA_Disable(DMA_Stream_RegDef_t *pStream)
+{
+    pStream->CR &= ~(1 << DMA_SxCR_EN);
+    while(pStream->CR & (1 << DMA_SxCR_EN));
+}
+
+/*********************************************************************
+ * @fn              - DMA_PeriClockControl
+ *
+ * @brief           - This function enables or disables the clock of
+ *                    the given DMA controller
+ *
+ * @param[in]       - DMA1 or DMA2
+ * @param[in]       - ENABLE or DISABLE macros
+ *
+ * @return          - none
+ */
+void DMA_PeriClockControl(DMA_RegDef_t *pDMAx, uint8_t EnorDi)
+{
+    if(EnorDi == ENABLE)
+    {
+        if(pDMAx == DMA1) DMA1_PCLK_EN();
+        else if(pDMAx == DMA2) DMA2_PCLK_EN();
+    }
+    else
+    {
+        if(pDMAx == DMA1) DMA1_PCLK_DI();
+        else if(pDMAx == DMA2) DMA2_PCLK_DI();
+    }
+}
+
+/*********************************************************************
+ * @fn              - DMA_Init
+ *
+ * @brief           - Configures one stream from the handle
+ *
+ * @param[in]       - Pointer to DMA handle structure
+ *
+ * @return          - none
+ *
+ * @Note            - Stops the stream and clears its flags first.
+ *                    Addresses and length are given to DMA_StartIT().
+ *                    Does not enable the NVIC line: see DMA_GetIRQNumber().
+ */
+void DMA_Init(DMA_Handle_t *pDMAHandle)
+{
+    DMA_Config_t *cfg = &pDMAHandle->DMA_Config;
+    DMA_Stream_RegDef_t *pStream = DMA_GetStream(pDMAHandle);
+    uint32_t tempreg = 0;
+
+    // 1. Clock, then stop the stream and drop stale flags
+    DMA_PeriClockControl(pDMAHandle->pDMAx, ENABLE);
+    DMA_Disable(pStream);
+    DMA_ClearFlag(pDMAHandle, DMA_FLAG_ALL);
+
+    // 2. Request channel, direction, increments and data widths
+    tempreg |= ((uint32_t)(cfg->DMA_Channel & 0x7) << DMA_SxCR_CHSEL);
+    tempreg |= ((uint32_t)(cfg->DMA_Direction & 0x3) << DMA_SxCR_DIR);
+    if(cfg->DMA_PeriphInc == ENABLE) tempreg |= (1 << DMA_SxCR_PINC);
+    if(cfg->DMA_MemInc == ENABLE) tempreg |= (1 << DMA_SxCR_MINC);
+    tempreg |= ((uint32_t)(cfg->DMA_PeriphSize & 0x3) << DMA_SxCR_PSIZE);
+    tempreg |= ((uint32_t)(cfg->DMA_MemSize & 0x3) << DMA_SxCR_MSIZE);
+
+    // 3. Circular mode and software priority
+    if(cfg->DMA_Mode == DMA_MODE_CIRCULAR) tempreg |= (1 << DMA_SxCR_CIRC);
+    tempreg |= ((uint32_t)(cfg->DMA_Priority & 0x3) << DMA_SxCR_PL);
+
+    pStream->CR = tempreg;
+
+    // 4. FIFO: direct mode (reset value) or threshold
+    //    Memory-to-memory transfers always go through the FIFO
+    if(cfg->DMA_FIFOMode == DMA_FIFO_ENABLE || cfg->DMA_Direction == DMA_DIR_M2M)
+    {
+        pStream->FCR = (1 << DMA_SxFCR_DMDIS) | ((uint32_t)(cfg->DMA_FIFOThreshold & 0x3) << DMA_SxFCR_FTH);
+    }
+    else
+    {
+        pStream->FCR = 0;
+    }
+
+    pDMAHandle->State = DMA_READY;
+}
+
+/*********************************************************************
+ * @fn              - DMA_DeInit
+ *
+ * @brief           - Resets every stream of the given DMA controller
+ *
+ * @param[in]       - DMA1 or DMA2
+ *
+ * @return          - none
+ */
+void DMA_DeInit(DMA_RegDef_t *pDMAx)
+{
+    if(pDMAx == DMA1) DMA1_REG_RESET();
+    else if(pDMAx == DMA2) DMA2_REG_RESET();
+}
+
+/*********************************************************************
+ * @fn              - DMA_StartIT
+ *
+ * @brief           - Starts a transfer; completion is reported through
+ *                    the handle callback from DMA_IRQHandling()
+ *
+ * @param[in]       - Pointer to DMA handle structure
+ * @param[in]       - Peripheral address (source for memory-to-memory)
+ * @param[in]       - Memory address (destination for memory-to-memory)
+ * @param[in]       - Number of data items (of the peripheral width), 1-65535
+ *
+ * @return          - DMA_BUSY (nothing done) or DMA_READY (started)
+ *
+ * @Note            - In circular mode the stream runs until DMA_Abort()
+ *********************************************************************/
+uint8_t DMA_StartIT(DMA_Handle_t *pDMAHandle, uint32_t PeriphAddr, uint32_t MemAddr, uint16_t Len)
+{
+    uint8_t busystate = pDMAHandle->State;
+    DMA_Stream_RegDef_t *pStream = DMA_GetStream(pDMAHandle);
+
+    if(busystate != DMA_BUSY && Len != 0)
+    {
+        // 1. Stream must be off to take new addresses; old flags would
+        //    raise the interrupt at once
+        DMA_Disable(pStream);
+        DMA_ClearFlag(pDMAHandle, DMA_FLAG_ALL);
+
+        // 2. Addresses and item count
+        pStream->PAR = PeriphAddr;
+        pStream->M0AR = MemAddr;
+        pStream->NDTR = Len;
+
+        // 3. Interrupts: complete + errors, half transfer if asked for
+        pStream->CR |= (1 << DMA_SxCR_TCIE) | (1 << DMA_SxCR_TEIE) | (1 << DMA_SxCR_DMEIE);
+        if(pDMAHandle->DMA_Config.DMA_HalfTransferIT == ENABLE)
+        {
+            pStream->CR |= (1 << DMA_SxCR_HTIE);
+        }
+        if(pStream->FCR & (1 << DMA_SxFCR_DMDIS))
+        {
+            pStream->FCR |= (1 << DMA_SxFCR_FEIE);
+        }
+
+        // 4. Go
+        pDMAHandle->State = DMA_BUSY;
+        pStream->CR |= (1 << DMA_SxCR_EN);
+    }
+
+    return busystate;
+}
+
+/*********************************************************************
+ * @fn              - DMA_Abort
+ *
+ * @brief           - Stops the stream, drops its pending flags and
+ *                    marks the handle ready
+ *
+ * @param[in]       - Pointer to DMA handle structure
+ *
+ * @return          - none
+ *
+ * @Note            - No callback is made
+ *********************************************************************/
+void DMA_Abort(DMA_Handle_t *pDMAHandle)
+{
+    DMA_Stream_RegDef_t *pStream = DMA_GetStream(pDMAHandle);
+
+    pStream->CR &= ~((1 << DMA_SxCR_TCIE) | (1 << DMA_SxCR_HTIE) | (1 << DMA_SxCR_TEIE) | (1 << DMA_SxCR_DMEIE));
+    pStream->FCR &= ~(1 << DMA_SxFCR_FEIE);
+    DMA_Disable(pStream);
+    DMA_ClearFlag(pDMAHandle, DMA_FLAG_ALL);
+
+    pDMAHandle->State = DMA_READY;
+}
+
+/*********************************************************************
+ * @fn              - DMA_GetRemaining
+ *
+ * @brief           - Data items the stream has not moved yet (NDTR)
+ *********************************************************************/
+uint16_t DMA_GetRemaining(DMA_Handle_t *pDMAHandle)
+{
+    return (uint16_t)DMA_GetStream(pDMAHandle)->NDTR;
+}
+
+/*********************************************************************
+ * @fn              - DMA_GetFlagStatus
+ *
+ * @brief           - Reads flags of the handle's stream
+ *
+ * @param[in]       - Pointer to DMA handle structure
+ * @param[in]       - DMA_FLAG_xxx (stream relative)
+ *
+ * @return          - FLAG_SET if any of them is set, else FLAG_RESET
+ *********************************************************************/
+uint8_t DMA_GetFlagStatus(DMA_Handle_t *pDMAHandle, uint8_t FlagName)
+{
+    uint8_t stream = pDMAHandle->Stream & 0x7;
+    uint32_t isr = (stream < 4) ? pDMAHandle->pDMAx->LISR : pDMAHandle->pDMAx->HISR;
+
+    if((isr >> DMA_FlagShift[stream & 0x3]) & FlagName)
+    {
+        return FLAG_SET;
+    }
+    return FLAG_RESET;
+}
+
+/*********************************************************************
+ * @fn              - DMA_ClearFlag
+ *
+ * @brief           - Clears flags of the handle's stream
+ *
+ * @Note            - LIFCR/HIFCR are write-1-to-clear: a plain write
+ *                    leaves the other streams' flags alone
+ *********************************************************************/
+void DMA_ClearFlag(DMA_Handle_t *pDMAHandle, uint8_t FlagName)
+{
+    uint8_t stream = pDMAHandle->Stream & 0x7;
+    uint32_t mask = (uint32_t)(FlagName & DMA_FLAG_ALL) << DMA_FlagShift[stream & 0x3];
+
+    if(stream < 4) pDMAHandle->pDMAx->LIFCR = mask;
+    else pDMAHandle->pDMAx->HIFCR = mask;
+}
+
+/*********************************************************************
+ * @fn              - DMA_GetIRQNumber
+ *
+ * @brief           - NVIC line of a stream (DMA1 Stream7 and DMA2
+ *                    Streams 5-7 are not contiguous with the others)
+ *********************************************************************/
+uint8_t DMA_GetIRQNumber(DMA_RegDef_t *pDMAx, uint8_t Stream)
+{
+    static const uint8_t dma1[8] = {
+        DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+        DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn
+    };
+    static const uint8_t dma2[8] = {
+        DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+        DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn
+    };
+
+    return (pDMAx == DMA2) ? dma2[Stream & 0x7] : dma1[Stream & 0x7];
+}
+
+/*********************************************************************
+ * @fn              - DMA_IRQInterruptConfig
+ *
+ * @brief           - Enables or disables a DMA stream IRQ in the NVIC
+ *
+ * @param[in]       - IRQ number (DMA_GetIRQNumber())
+ * @param[in]       - ENABLE or DISABLE
+ *
+ * @return          - none
+ */
+void DMA_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
+{
+    if(EnorDi == ENABLE)
+    {
+        if(IRQNumber <= 31)
+        {
+            *NVIC_ISER0 = (1 << IRQNumber);
+        }
+        else if(IRQNumber >= 32 && IRQNumber < 64)
+        {
+            *NVIC_ISER1 = (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96)
+        {
+            *NVIC_ISER2 = (1 << (IRQNumber % 32));
+        }
+    }
+    else
+    {
+        // ISER/ICER are write-1: other lines are not affected
+        if(IRQNumber <= 31)
+        {
+            *NVIC_ICER0 = (1 << IRQNumber);
+        }
+        else if(IRQNumber >= 32 && IRQNumber < 64)
+        {
+            *NVIC_ICER1 = (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96)
+        {
+            *NVIC_ICER2 = (1 << (IRQNumber % 32));
+        }
+    }
+}
+
+/*********************************************************************
+ * @fn              - DMA_IRQPriorityConfig
+ *
+ * @brief           - Configures the priority of a DMA stream IRQ
+ *
+ * @param[in]       - IRQ number
+ * @param[in]       - Priority (0-15)
+ *
+ * @return          - none
+ */
+void DMA_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
+{
+    uint8_t iprx = IRQNumber / 4;
+    uint8_t iprx_section = IRQNumber % 4;
+    uint8_t shift_amount = (8 * iprx_section) + (8 - NO_PR_BITS_IMPLEMENTED);
+
+    *(NVIC_PR_BASE_ADDR + iprx) &= ~(0xFF << shift_amount);
+    *(NVIC_PR_BASE_ADDR + iprx) |= (IRQPriority << shift_amount);
+}
+
+/*********************************************************************
+ * @fn              - DMA_IRQHandling
+ *
+ * @brief           - Handles the interrupt of the handle's stream
+ *
+ * @param[in]       - Pointer to DMA handle structure
+ *
+ * @return          - none
+ *
+ * @Note            - Only flags whose interrupt is enabled are handled
+ *                    and cleared. Errors are reported before HT, HT
+ *                    before TC. After TC in normal mode (or TE) the
+ *                    handle is ready again when the callback runs, so
+ *                    the callback may start the next transfer.
+ *********************************************************************/
+void DMA_IRQHandling(DMA_Handle_t *pDMAHandle)
+{
+    DMA_Stream_RegDef_t *pStream = DMA_GetStream(pDMAHandle);
+    uint8_t stream = pDMAHandle->Stream & 0x7;
+    uint32_t isr = (stream < 4) ? pDMAHandle->pDMAx->LISR : pDMAHandle->pDMAx->HISR;
+    uint32_t flags = (isr >> DMA_FlagShift[stream & 0x3]) & DMA_FLAG_ALL;
+    uint32_t cr = pStream->CR;
+    uint8_t events[5];
+    uint8_t count = 0;
+    uint8_t handled = 0;
+
+    // 1. Pick the enabled events and clear their flags in one write
+    if((flags & DMA_FLAG_TEIF) && (cr & (1 << DMA_SxCR_TEIE)))
+    {
+        handled |= DMA_FLAG_TEIF;
+        events[count++] = DMA_ERROR_TE;
+    }
+    if((flags & DMA_FLAG_DMEIF) && (cr & (1 << DMA_SxCR_DMEIE)))
+    {
+        handled |= DMA_FLAG_DMEIF;
+        events[count++] = DMA_ERROR_DME;
+    }
+    if((flags & DMA_FLAG_FEIF) && (pStream->FCR & (1 << DMA_SxFCR_FEIE)))
+    {
+        handled |= DMA_FLAG_FEIF;
+        events[count++] = DMA_ERROR_FE;
+    }
+    if((flags & DMA_FLAG_HTIF) && (cr & (1 << DMA_SxCR_HTIE)))
+    {
+        handled |= DMA_FLAG_HTIF;
+        events[count++] = DMA_EV_HT;
+    }
+    if((flags & DMA_FLAG_TCIF) && (cr & (1 << DMA_SxCR_TCIE)))
+    {
+        handled |= DMA_FLAG_TCIF;
+        events[count++] = DMA_EV_TC;
+    }
+    if(handled == 0) return;
+    DMA_ClearFlag(pDMAHandle, handled);
+
+    // 2. A transfer error disables the stream in hardware; a normal
+    //    mode transfer is over at TC
+    if((handled & DMA_FLAG_TEIF) || ((handled & DMA_FLAG_TCIF) && !(cr & (1 << DMA_SxCR_CIRC))))
+    {
+        pDMAHandle->State = DMA_READY;
+    }
+
+    // 3. Notify the owner
+    for(uint8_t i = 0; i < count; i++)
+    {
+        if(pDMAHandle->pCallback != NULL)
+        {
+            pDMAHandle->pCallback(pDMAHandle, events[i]);
+        }
+    }
+}
@@ -7,6 +7,14 @@
 
 #include "stm32f446xx_gpio_driver.h"
 
+/*
+ * EXTI service state: the callback and port of each line, and its statistics
+ */
+static GPIO_EXTICallback_t s_extiCallback[GPIO_EXTI_LINE_COUNT];
+static GPIO_RegDef_t *s_extiPort[GPIO_EXTI_LINE_COUNT];
+static GPIO_EXTIStats_t s_extiStats[GPIO_EXTI_LINE_COUNT];
+static uint32_t (*s_extiNow)(void);
+
 /*********************************************************************
  * @fn              - GPIO_PeriClockControl
  *
@@ -94,6 +102,44 @@ void GPIO_PeriClockControl(GPIO_RegDef_t *pGPIOx, uint8_t EnorDi)
     }
 }
 
+/*
+ * EXTI side of an interrupt mode pin: trigger edges, port selection, mask
+ */
+static void GPIO_ConfigInterrupt(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t PinMode)
+{
+    if(PinMode == GPIO_MODE_IT_FT)
+    {
+        // 1. Configure the FTSR (Falling Trigger Selection Register)
+        EXTI->FTSR |= (1 << PinNumber);
+        // Clear the corresponding RTSR bit
+        EXTI->RTSR &= ~(1 << PinNumber);
+    }
+    else if(PinMode == GPIO_MODE_IT_RT)
+    {
+        // 1. Configure the RTSR (Rising Trigger Selection Register)
+        EXTI->RTSR |= (1 << PinNumber);
+        // Clear the corresponding FTSR bit
+        EXTI->FTSR &= ~(1 << PinNumber);
+    }
+    else if(PinMode == GPIO_MODE_IT_RFT)
+    {
+        // 1. Configure both FTSR and RTSR
+        EXTI->FTSR |= (1 << PinNumber);
+        EXTI->RTSR |= (1 << PinNumber);
+    }
+
+    // 2. Configure the GPIO port selection in SYSCFG_EXTICR
+    uint8_t temp1 = PinNumber / 4;
+    uint8_t temp2 = PinNumber % 4;
+    uint8_t portcode = GPIO_BASEADDR_TO_CODE(pGPIOx);
+    SYSCFG_PCLK_EN();
+    SYSCFG->EXTICR[temp1] &= ~(0xF << (temp2 * 4));  // Clear bits first
+    SYSCFG->EXTICR[temp1] |= (portcode << (temp2 * 4));  // Then set
+
+    // 3. Enable the EXTI interrupt delivery using IMR (Interrupt Mask Register)
+    EXTI->IMR |= (1 << PinNumber);
+}
+
 /*********************************************************************
  * @fn              - GPIO_Init
  *
@@ -123,38 +169,8 @@ void GPIO_Init(GPIO_Handle_t *pGPIOHandle)
     else
     {
         // Interrupt mode
-        if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_FT)
-        {
-            // 1. Configure the FTSR (Falling Trigger Selection Register)
-            EXTI->FTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-            // Clear the corresponding RTSR bit
-            EXTI->RTSR &= ~(1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-        }
-        else if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RT)
-        {
-            // 1. Configure the RTSR (Rising Trigger Selection Register)
-            EXTI->RTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-            // Clear the corresponding FTSR bit
-            EXTI->FTSR &= ~(1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-        }
-        else if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RFT)
-        {
-            // 1. Configure both FTSR and RTSR
-            EXTI->FTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-            EXTI->RTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-        }
-
-        // 2. Configure the GPIO port selection in SYSCFG_EXTICR
-        uint8_t temp1 = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber / 4;
-        uint8_t temp2 = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber % 4;
-        uint8_t portcode = GPIO_BASEADDR_TO_CODE(pGPIOHandle->pGPIOx);
-        SYSCFG_PCLK_EN();
-        // SYSCFG->EXTICR[temp1] = portcode << (temp2 * 4);
-        SYSCFG->EXTICR[temp1] &= ~(0xF << (temp2 * 4));  // Clear bits first
-        SYSCFG->EXTICR[temp1] |= (portcode << (temp2 * 4));  // Then set
-
-        // 3. Enable the EXTI interrupt delivery using IMR (Interrupt Mask Register)
-        EXTI->IMR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+        GPIO_ConfigInterrupt(pGPIOHandle->pGPIOx, pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber,
+                             pGPIOHandle->GPIO_PinConfig.GPIO_PinMode);
     }
 
     // 2. Configure the speed
@@ -186,6 +202,89 @@ void GPIO_Init(GPIO_Handle_t *pGPIOHandle)
     }
 }
 
+/*********************************************************************
+ * @fn              - GPIO_InitGroup
+ *
+ * @brief           - This function initializes a table of pins, one port
+ *                    at a time
+ *
+ * @param[in]       - Pin table (const, may live in flash), each pin once
+ * @param[in]       - Number of pins in the table
+ *
+ * @return          - none
+ *
+ * @Note            - Gives the same registers as GPIO_Init() on every pin,
+ *                    but each register of a port is computed from all its
+ *                    pins and written once. MODER goes last, so a pin
+ *                    changes mode with its type, speed, pull and AF set.
+ */
+void GPIO_InitGroup(const GPIO_Handle_t *pPins, uint8_t Count)
+{
+    for(uint8_t i = 0; i < Count; i++)
+    {
+        GPIO_RegDef_t *pGPIOx = pPins[i].pGPIOx;
+        uint32_t mode = 0, modeMask = 0, speed = 0, pupd = 0, wideMask = 0;
+        uint32_t otype = 0, otypeMask = 0;
+        uint32_t afr[2] = {0, 0}, afrMask[2] = {0, 0};
+        uint8_t done = 0;
+
+        // A port is configured at its first pin in the table
+        for(uint8_t j = 0; j < i; j++)
+        {
+            if(pPins[j].pGPIOx == pGPIOx) done = 1;
+        }
+        if(done) continue;
+
+        GPIO_PeriClockControl(pGPIOx, ENABLE);
+
+        for(uint8_t j = i; j < Count; j++)
+        {
+            const GPIO_PinConfig_t *pConfig = &pPins[j].GPIO_PinConfig;
+            uint8_t pin = pConfig->GPIO_PinNumber;
+
+            if(pPins[j].pGPIOx != pGPIOx) continue;
+
+            if(pConfig->GPIO_PinMode <= GPIO_MODE_ANALOG)
+            {
+                modeMask |= (0x3U << (2 * pin));
+                mode |= ((uint32_t)pConfig->GPIO_PinMode << (2 * pin));
+            }
+            else
+            {
+                GPIO_ConfigInterrupt(pGPIOx, pin, pConfig->GPIO_PinMode);
+            }
+
+            wideMask |= (0x3U << (2 * pin));
+            speed |= ((uint32_t)pConfig->GPIO_PinSpeed << (2 * pin));
+            pupd |= ((uint32_t)pConfig->GPIO_PinPuPdControl << (2 * pin));
+            otypeMask |= (1U << pin);
+            otype |= ((uint32_t)pConfig->GPIO_PinOPType << pin);
+
+            if(pConfig->GPIO_PinMode == GPIO_MODE_ALTFN)
+            {
+                afrMask[pin / 8] |= (0xFU << (4 * (pin % 8)));
+                afr[pin / 8] |= ((uint32_t)pConfig->GPIO_PinAltFunMode << (4 * (pin % 8)));
+            }
+        }
+
+        pGPIOx->OTYPER = (pGPIOx->OTYPER & ~otypeMask) | otype;
+        pGPIOx->OSPEEDR = (pGPIOx->OSPEEDR & ~wideMask) | speed;
+        pGPIOx->PUPDR = (pGPIOx->PUPDR & ~wideMask) | pupd;
+        if(afrMask[0])
+        {
+            pGPIOx->AFR[0] = (pGPIOx->AFR[0] & ~afrMask[0]) | afr[0];
+        }
+        if(afrMask[1])
+        {
+            pGPIOx->AFR[1] = (pGPIOx->AFR[1] & ~afrMask[1]) | afr[1];
+        }
+        if(modeMask)
+        {
+            pGPIOx->MODER = (pGPIOx->MODER & ~modeMask) | mode;
+        }
+    }
+}
+
 /*********************************************************************
  * @fn              - GPIO_DeInit
  *
@@ -281,19 +380,20 @@ uint16_t GPIO_ReadFromInputPort(GPIO_RegDef_t *pGPIOx)
  *
  * @return          - none
  *
- * @Note            - none
+ * @Note            - One store to BSRR: atomic against ISRs writing other
+ *                    pins of the same port (no read-modify-write of ODR)
  */
 void GPIO_WriteToOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Value)
 {
     if(Value == GPIO_PIN_SET)
     {
-        // Set the pin
-        pGPIOx->ODR |= (1 << PinNumber);
+        // Set the pin (BS bits 0..15)
+        pGPIOx->BSRR = (1U << PinNumber);
     }
     else
     {
-        // Clear the pin
-        pGPIOx->ODR &= ~(1 << PinNumber);
+        // Clear the pin (BR bits 16..31)
+        pGPIOx->BSRR = (1U << (PinNumber + 16));
     }
 }
 
@@ -324,11 +424,75 @@ void GPIO_WriteToOutputPort(GPIO_RegDef_t *pGPIOx, uint16_t Value)
  *
  * @return          - none
  *
- * @Note            - none
+ * @Note            - ODR is read, the new level goes out through BSRR, so
+ *                    only this pin is written
  */
 void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber)
 {
-    pGPIOx->ODR ^= (1 << PinNumber);
+    uint32_t pin = (1U << PinNumber);
+
+    if(pGPIOx->ODR & pin)
+    {
+        pGPIOx->BSRR = (pin << 16);
+    }
+    else
+    {
+        pGPIOx->BSRR = pin;
+    }
+}
+
+/*********************************************************************
+ * @fn              - GPIO_SetPins
+ *
+ * @brief           - This function sets every pin of the mask in one write
+ *
+ * @param[in]       - Base address of the GPIO peripheral
+ * @param[in]       - Pin mask (bit n = pin n, see GPIO_PIN_MASK)
+ *
+ * @return          - none
+ *
+ * @Note            - One store to BSRR, the other pins are not touched
+ */
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+    GPIO_SetPinsFast(pGPIOx, PinMask);
+}
+
+/*********************************************************************
+ * @fn              - GPIO_ResetPins
+ *
+ * @brief           - This function clears every pin of the mask in one write
+ *
+ * @param[in]       - Base address of the GPIO peripheral
+ * @param[in]       - Pin mask (bit n = pin n, see GPIO_PIN_MASK)
+ *
+ * @return          - none
+ *
+ * @Note            - One store to BSRR, the other pins are not touched
+ */
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+    GPIO_ResetPinsFast(pGPIOx, PinMask);
+}
+
+/*********************************************************************
+ * @fn              - GPIO_WriteMasked
+ *
+ * @brief           - This function drives the pins of the mask to the
+ *                    matching bits of the value, all at once
+ *
+ * @param[in]       - Base address of the GPIO peripheral
+ * @param[in]       - Pin mask (bit n = pin n, see GPIO_PIN_MASK)
+ * @param[in]       - Pin levels, bits outside the mask are ignored
+ *
+ * @return          - none
+ *
+ * @Note            - One store to BSRR: the pins change on the same clock
+ *                    edge and the other pins are not touched
+ */
+void GPIO_WriteMasked(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, uint16_t Value)
+{
+    GPIO_WriteMaskedFast(pGPIOx, PinMask, Value);
 }
 
 /*********************************************************************
@@ -425,8 +589,220 @@ void GPIO_IRQHandling(uint8_t PinNumber)
     // Clear the EXTI PR register corresponding to the pin number
     if(EXTI->PR & (1 << PinNumber))
     {
-        // Clear
-        EXTI->PR |= (1 << PinNumber);
+        // Write 1 to this bit alone: "|=" would also clear every other pending line
+        EXTI->PR = (1 << PinNumber);
+    }
+}
+
+/*
+ * NVIC vector serving an EXTI line
+ */
+static uint8_t GPIO_EXTI_IRQNumber(uint8_t Line)
+{
+    if(Line <= 4)
+    {
+        return EXTI0_IRQn + Line;
+    }
+    return (Line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_Attach
+ *
+ * @brief           - Attaches a callback to the EXTI line of a pin
+ *
+ * @param[in]       - Base address of the GPIO port (the level passed to the callback is read there)
+ * @param[in]       - Pin number, i.e. EXTI line (0 to 15)
+ * @param[in]       - Callback, or NULL to detach
+ *
+ * @return          - none
+ *
+ * @Note            - Registry only: for pins that GPIO_Init() already put in an
+ *                    interrupt mode, with their vector enabled by the BSP
+ */
+void GPIO_EXTI_Attach(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, GPIO_EXTICallback_t Callback)
+{
+    if(PinNumber >= GPIO_EXTI_LINE_COUNT)
+    {
+        return;
+    }
+    // Port first: the interrupt may fire as soon as the callback is visible
+    s_extiPort[PinNumber] = pGPIOx;
+    s_extiCallback[PinNumber] = Callback;
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_Register
+ *
+ * @brief           - Attaches a callback to a pin and arms its EXTI line
+ *
+ * @param[in]       - Base address of the GPIO port
+ * @param[in]       - Pin number, i.e. EXTI line (0 to 15)
+ * @param[in]       - GPIO_MODE_IT_FT, GPIO_MODE_IT_RT or GPIO_MODE_IT_RFT
+ * @param[in]       - Callback
+ *
+ * @return          - none
+ *
+ * @Note            - Sets the edges, the port selection and the mask of the line,
+ *                    then enables its vector at GPIO_EXTI_IRQ_PRIORITY. The pin's
+ *                    mode and pull-up/down stay as GPIO_Init() left them.
+ */
+void GPIO_EXTI_Register(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Trigger, GPIO_EXTICallback_t Callback)
+{
+    uint8_t irq;
+
+    if(PinNumber >= GPIO_EXTI_LINE_COUNT)
+    {
+        return;
+    }
+    GPIO_EXTI_Attach(pGPIOx, PinNumber, Callback);
+    GPIO_ConfigInterrupt(pGPIOx, PinNumber, Trigger);
+
+    irq = GPIO_EXTI_IRQNumber(PinNumber);
+    GPIO_IRQPriorityConfig(irq, GPIO_EXTI_IRQ_PRIORITY);
+    GPIO_IRQInterruptConfig(irq, ENABLE);
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_Unregister
+ *
+ * @brief           - Masks an EXTI line and detaches its callback
+ *
+ * @param[in]       - EXTI line (0 to 15)
+ *
+ * @return          - none
+ *
+ * @Note            - The vector stays enabled, other lines may share it. The
+ *                    edges are deselected too: a masked line still latches
+ *                    PR, and GPIO_EXTI_Register() would then fire at once.
+ */
+void GPIO_EXTI_Unregister(uint8_t Line)
+{
+    if(Line >= GPIO_EXTI_LINE_COUNT)
+    {
+        return;
+    }
+    EXTI->IMR &= ~(1U << Line);
+    EXTI->FTSR &= ~(1U << Line);
+    EXTI->RTSR &= ~(1U << Line);
+    EXTI->PR = (1U << Line);
+    s_extiCallback[Line] = NULL;
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_SetClock
+ *
+ * @brief           - Sets the clock the EXTI service timestamps edges with
+ *
+ * @param[in]       - Clock function (e.g. now_us32), or NULL for no timestamps
+ *
+ * @return          - none
+ *
+ * @Note            - It runs in every EXTI vector: it must not mask interrupts
+ */
+void GPIO_EXTI_SetClock(uint32_t (*pNow)(void))
+{
+    s_extiNow = pNow;
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_Dispatch
+ *
+ * @brief           - Serves the pending EXTI lines of one interrupt vector
+ *
+ * @param[in]       - Lines of the vector (GPIO_EXTI_LINE(n), GPIO_EXTI_LINES_9_5, ...)
+ *
+ * @return          - none
+ *
+ * @Note            - Call from the EXTI IRQ handlers. All lines pending on entry
+ *                    are cleared with one write-1 store to PR, before any
+ *                    callback runs: an edge arriving during the callbacks
+ *                    pends again and is served by the next interrupt.
+ */
+void GPIO_EXTI_Dispatch(uint32_t LineMask)
+{
+    uint32_t pending = EXTI->PR & EXTI->IMR & LineMask;
+
+    if(pending == 0)
+    {
+        return;
+    }
+    EXTI->PR = pending;
+    GPIO_EXTI_Service(pending);
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_Service
+ *
+ * @brief           - Runs the callbacks of the given lines and counts their edges
+ *
+ * @param[in]       - Lines that took an edge, their pending bits already cleared
+ *
+ * @return          - none
+ *
+ * @Note            - Highest line first, one CLZ per line taken, so the cost does
+ *                    not depend on how many lines the vector shares. The lines
+ *                    of one call share one timestamp.
+ */
+void GPIO_EXTI_Service(uint32_t Lines)
+{
+    uint32_t now = s_extiNow ? s_extiNow() : 0;
+
+    Lines &= (1U << GPIO_EXTI_LINE_COUNT) - 1U;
+    while(Lines)
+    {
+        uint8_t line = (uint8_t)(31U - (uint32_t)__builtin_clz(Lines));
+        GPIO_EXTICallback_t callback = s_extiCallback[line];
+        GPIO_EXTIStats_t *stats = &s_extiStats[line];
+
+        Lines &= ~(1U << line);
+        stats->Hits++;
+        stats->LastTime = now;
+        if(callback)
+        {
+            callback(line, (uint8_t)((s_extiPort[line]->IDR >> line) & 0x1));
+        }
+        else
+        {
+            stats->Unhandled++;
+        }
+    }
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_GetStats
+ *
+ * @brief           - Returns the statistics of an EXTI line
+ *
+ * @param[in]       - EXTI line (0 to 15)
+ *
+ * @return          - Statistics of the line, or NULL for an invalid line
+ *
+ * @Note            - none
+ */
+const GPIO_EXTIStats_t *GPIO_EXTI_GetStats(uint8_t Line)
+{
+    return (Line < GPIO_EXTI_LINE_COUNT) ? &s_extiStats[Line] : NULL;
+}
+
+/*********************************************************************
+ * @fn              - GPIO_EXTI_ResetStats
+ *
+ * @brief           - Clears the statistics of every EXTI line
+ *
+ * @param[in]       - none
+ *
+ * @return          - none
+ *
+ * @Note            - none
+ */
+void GPIO_EXTI_ResetStats(void)
+{
+    for(uint8_t line = 0; line < GPIO_EXTI_LINE_COUNT; line++)
+    {
+        s_extiStats[line].Hits = 0;
+        s_extiStats[line].Unhandled = 0;
+        s_extiStats[line].LastTime = 0;
     }
 }
 
@@ -16,6 +16,8 @@ static void I2C_ExecuteAddressPhaseRead(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddr);
 static void I2C_ClearADDRFlag(I2C_RegDef_t *pI2Cx); 
 static void I2C_MasterHandleTXEInterrupt(I2C_Handle_t *pI2CHandle);
 static void I2C_MasterHandleRXNEInterrupt(I2C_Handle_t *pI2CHandle);
+static void I2C_DMATxCallback(DMA_Handle_t *pDMAHandle, uint8_t AppEv);
+static void I2C_NotifyEvent(I2C_Handle_t *pI2CHandle, uint8_t AppEv);
 
 /*********************************************************************
  * @fn              - I2C_GenerateStartCondition
@@ -502,7 +504,10 @@ uint8_t I2C_MasterSendDataIT(I2C_Handle_t *pI2CHandle,
         /* 4. Mark handle state as TX busy */
         pI2CHandle->TxRxState = I2C_BUSY_IN_TX;
 
-        /* 5. Generate START condition */
+        /* 5. Generate START condition
+              (CR1 must not be written while the previous STOP is pending,
+               which is the case when called from the TX complete callback) */
+        while(pI2CHandle->pI2Cx->CR1 & (1 << I2C_CR1_STOP));
         I2C_GenerateStartCondition(pI2CHandle->pI2Cx);
 
         /* 6. Enable IT events: 
@@ -517,6 +522,78 @@ uint8_t I2C_MasterSendDataIT(I2C_Handle_t *pI2CHandle,
     return busystate;
 }
 
+/*********************************************************************
+ * @fn              - I2C_MasterSendDataDMA
+ *
+ * @brief           - Non-blocking send where the data bytes are moved
+ *                    into DR by the TX DMA stream (Master mode)
+ *
+ * @return          - I2C_BUSY_IN_TX / I2C_BUSY_IN_RX (busy, nothing
+ *                    done) or I2C_READY
+ *
+ * @Note            - Only the SB, ADDR and BTF events interrupt the CPU
+ *                    (ITBUFEN stays off). The transfer ends on BTF once
+ *                    the stream has nothing left: STOP, I2C_EV_TX_CMPLT.
+ *                    Stream errors are reported as I2C_ERROR_DMA.
+ *********************************************************************/
+uint8_t I2C_MasterSendDataDMA(I2C_Handle_t *pI2CHandle,
+                              uint8_t *pTxbuffer,
+                              uint32_t Len,
+                              uint8_t SlaveAddr,
+                              uint8_t Sr)
+{
+    uint8_t busystate = pI2CHandle->TxRxState;
+
+    if(busystate != I2C_BUSY_IN_TX && busystate != I2C_BUSY_IN_RX)
+    {
+        /* 1. Save buffer, length, slave address and repeated start option */
+        pI2CHandle->pTxBuffer = pTxbuffer;
+        pI2CHandle->TxLen = Len;
+        pI2CHandle->DevAddr = SlaveAddr;
+        pI2CHandle->Sr = Sr;
+
+        /* 2. Mark handle state as TX busy */
+        pI2CHandle->TxRxState = I2C_BUSY_IN_TX;
+
+        /* 3. Arm the stream: memory -> DR, served on each TXE request */
+        pI2CHandle->pDMATx->pCallback = I2C_DMATxCallback;
+        pI2CHandle->pDMATx->pContext = pI2CHandle;
+        DMA_StartIT(pI2CHandle->pDMATx, (uint32_t)(uintptr_t)&pI2CHandle->pI2Cx->DR,
+                    (uint32_t)(uintptr_t)pTxbuffer, (uint16_t)Len);
+        pI2CHandle->pI2Cx->CR2 |= (1 << I2C_CR2_DMAEN);
+
+        /* 4. Generate START condition (not while the previous STOP is pending) */
+        while(pI2CHandle->pI2Cx->CR1 & (1 << I2C_CR1_STOP));
+        I2C_GenerateStartCondition(pI2CHandle->pI2Cx);
+
+        /* 5. Enable IT events: ITEVTEN and ITERREN, no buffer interrupts */
+        pI2CHandle->pI2Cx->CR2 |= (1 << I2C_CR2_ITEVTEN);
+        pI2CHandle->pI2Cx->CR2 |= (1 << I2C_CR2_ITERREN);
+    }
+
+    return busystate;
+}
+
+/*********************************************************************
+ * @fn              - I2C_DMATxCallback
+ *
+ * @brief           - Events of the TX stream (interrupt context)
+ *
+ * @Note            - Completion is taken from BTF, not from the stream:
+ *                    TC only means the last byte went into DR
+ *********************************************************************/
+static void I2C_DMATxCallback(DMA_Handle_t *pDMAHandle, uint8_t AppEv)
+{
+    I2C_Handle_t *pI2CHandle = (I2C_Handle_t *)pDMAHandle->pContext;
+
+    if(AppEv == DMA_EV_TC || AppEv == DMA_EV_HT) return;
+
+    if(pI2CHandle->TxRxState == I2C_BUSY_IN_TX && (pI2CHandle->pI2Cx->CR2 & (1 << I2C_CR2_DMAEN)))
+    {
+        I2C_NotifyEvent(pI2CHandle, I2C_ERROR_DMA);
+    }
+}
+
 /*********************************************************************
  * @fn              - I2C_MasterReceiveDataIT
  *
@@ -624,15 +701,15 @@ void I2C_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
     {
         if(IRQNumber <= 31)
         {
-            *NVIC_ICER0 |= (1 << IRQNumber);
+            *NVIC_ICER0 = (1 << IRQNumber);   // write-1-to-clear: |= would disable every enabled IRQ
         }
         else if(IRQNumber >= 32 && IRQNumber < 64)
         {
-            *NVIC_ICER1 |= (1 << (IRQNumber % 32));
+            *NVIC_ICER1 = (1 << (IRQNumber % 32));
         }
         else if(IRQNumber >= 64 && IRQNumber < 96)
         {
-            *NVIC_ICER2 |= (1 << (IRQNumber % 32));
+            *NVIC_ICER2 = (1 << (IRQNumber % 32));
         }
     }
 }
@@ -694,6 +771,12 @@ void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 			// Make sure TXE is also set
 			if(pI2CHandle->pI2Cx->SR1 & (1 << I2C_SR1_TXE))
 			{
+				// DMA transfer: done when the stream has moved every byte
+				if((pI2CHandle->pI2Cx->CR2 & (1 << I2C_CR2_DMAEN)) && DMA_GetRemaining(pI2CHandle->pDMATx) == 0)
+				{
+					pI2CHandle->TxLen = 0;
+				}
+
 				// BTF and TXE both are set
 				if(pI2CHandle->TxLen == 0)
 				{
@@ -708,7 +791,11 @@ void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 					I2C_CloseSendData(pI2CHandle);
 
 					// 3. Notify application about transmission complete
-					I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_TX_CMPLT);
+					I2C_NotifyEvent(pI2CHandle, I2C_EV_TX_CMPLT);
+
+					// The callback may have started the next transfer: the
+					// flags sampled below belong to the finished one
+					return;
 				}
 			}
 		}
@@ -728,7 +815,7 @@ void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->CR1 |= 0x0000;
 
 		// Notify application that STOP is detected
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_STOP);
+		I2C_NotifyEvent(pI2CHandle, I2C_EV_STOP);
 	}
 
 	temp3 = pI2CHandle->pI2Cx->SR1 & (1 << I2C_SR1_TXE);
@@ -751,7 +838,7 @@ void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 			// Make sure slave is in transmitter mode
 			if(pI2CHandle->pI2Cx->SR2 & (1 << I2C_SR2_TRA))
 			{
-				I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_DATA_REQ);
+				I2C_NotifyEvent(pI2CHandle, I2C_EV_DATA_REQ);
 			}
 		}
 	}
@@ -776,7 +863,7 @@ void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 			// Make sure slave is in receiver mode
 			if(!(pI2CHandle->pI2Cx->SR2 & (1 << I2C_SR2_TRA)))
 			{
-				I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_DATA_RCV);
+				I2C_NotifyEvent(pI2CHandle, I2C_EV_DATA_RCV);
 			}
 		}
 	}
@@ -817,7 +904,7 @@ void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->SR1 &= ~(1 << I2C_SR1_BERR);
 
 		// Implement the code to notify the application about the error
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_ERROR_BERR);
+		I2C_NotifyEvent(pI2CHandle, I2C_ERROR_BERR);
 	}
 
 	/***********************Check for arbitration lost error************************************/
@@ -830,7 +917,7 @@ void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->SR1 &= ~(1 << I2C_SR1_ARLO);
 
 		// Implement the code to notify the application about the error
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_ERROR_ARLO);
+		I2C_NotifyEvent(pI2CHandle, I2C_ERROR_ARLO);
 	}
 
 	/***********************Check for ACK failure error************************************/
@@ -843,7 +930,7 @@ void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->SR1 &= ~(1 << I2C_SR1_AF);
 
 		// Implement the code to notify the application about the error
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_ERROR_AF);
+		I2C_NotifyEvent(pI2CHandle, I2C_ERROR_AF);
 	}
 
 	/***********************Check for Overrun/underrun error************************************/
@@ -856,7 +943,7 @@ void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->SR1 &= ~(1 << I2C_SR1_OVR);
 
 		// Implement the code to notify the application about the error
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_ERROR_OVR);
+		I2C_NotifyEvent(pI2CHandle, I2C_ERROR_OVR);
 	}
 
 	/***********************Check for Time out error************************************/
@@ -869,7 +956,7 @@ void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle)
 		pI2CHandle->pI2Cx->SR1 &= ~(1 << I2C_SR1_TIMEOUT);
 
 		// Implement the code to notify the application about the error
-		I2C_ApplicationEventCallback(pI2CHandle, I2C_ERROR_TIMEOUT);
+		I2C_NotifyEvent(pI2CHandle, I2C_ERROR_TIMEOUT);
 	}
 }
 
@@ -918,18 +1005,10 @@ static void I2C_MasterHandleTXEInterrupt(I2C_Handle_t *pI2CHandle) {
         pI2CHandle->TxLen--;
     }
 
-    // If all data transmitted
+    // If all data loaded: stop the TXE interrupts. The last byte is still
+    // shifting out; the BTF event generates the STOP and closes the transfer.
     if (pI2CHandle->TxLen == 0) {
-        // Disable TXEIE interrupt
-        pI2CHandle->pI2Cx->CR2 &= ~(I2C_CR2_ITBUFEN);
-        // Generate Stop condition if required
-        if (pI2CHandle->Sr == I2C_DISABLE_SR) {
-            pI2CHandle->pI2Cx->CR1 |= I2C_CR1_STOP;
-        }
-        // Reset handle state
-        pI2CHandle->TxBusy = I2C_READY;
-        // Application callback: notify transmission complete
-        I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_TX_CMPLT);
+        pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITBUFEN);
     }
 }
 
@@ -953,19 +1032,103 @@ static void I2C_MasterHandleRXNEInterrupt(I2C_Handle_t *pI2CHandle) {
 
     // If all data received
     if (pI2CHandle->RxLen == 0) {
-        // Disable RXNE interrupt
-        pI2CHandle->pI2Cx->CR2 &= ~(I2C_CR2_ITBUFEN);
         // Generate Stop condition if required
         if (pI2CHandle->Sr == I2C_DISABLE_SR) {
-            pI2CHandle->pI2Cx->CR1 |= I2C_CR1_STOP;
+            I2C_GenerateStopCondition(pI2CHandle->pI2Cx);
         }
-        // Reset handle state
-        pI2CHandle->RxBusy = I2C_READY;
+        // Disable the interrupts and reset handle state
+        I2C_CloseReceiveData(pI2CHandle);
         // Application callback: notify reception complete
-        I2C_ApplicationEventCallback(pI2CHandle, I2C_EV_RX_CMPLT); 
+        I2C_NotifyEvent(pI2CHandle, I2C_EV_RX_CMPLT);
+    }
+}
+
+/*********************************************************************
+ * @fn              - I2C_CloseSendData
+ *
+ * @brief           - Ends an interrupt driven transmission: disables the
+ *                    I2C interrupts (and the TX stream of a DMA send)
+ *                    and marks the handle ready
+ *
+ * @param[in]       - pI2CHandle : Pointer to I2C handle
+ *
+ * @return          - none
+ *
+ * @Note            - Does not generate the STOP condition
+ *********************************************************************/
+void I2C_CloseSendData(I2C_Handle_t *pI2CHandle)
+{
+    if(pI2CHandle->pI2Cx->CR2 & (1 << I2C_CR2_DMAEN))
+    {
+        pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_DMAEN);
+        DMA_Abort(pI2CHandle->pDMATx);
+    }
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITBUFEN);
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITEVTEN);
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITERREN);
+
+    pI2CHandle->TxRxState = I2C_READY;
+    pI2CHandle->pTxBuffer = NULL;
+    pI2CHandle->TxLen = 0;
+}
+
+/*********************************************************************
+ * @fn              - I2C_CloseReceiveData
+ *
+ * @brief           - Ends an interrupt driven reception: disables the
+ *                    I2C interrupts, restores ACKing and marks the handle ready
+ *
+ * @param[in]       - pI2CHandle : Pointer to I2C handle
+ *
+ * @return          - none
+ *********************************************************************/
+void I2C_CloseReceiveData(I2C_Handle_t *pI2CHandle)
+{
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITBUFEN);
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITEVTEN);
+    pI2CHandle->pI2Cx->CR2 &= ~(1 << I2C_CR2_ITERREN);
+
+    pI2CHandle->TxRxState = I2C_READY;
+    pI2CHandle->pRxBuffer = NULL;
+    pI2CHandle->RxLen = 0;
+    pI2CHandle->RxSize = 0;
+
+    if (pI2CHandle->I2C_Config.I2C_AckControl == I2C_ACK_ENABLE) {
+        I2C_ManageAcking(pI2CHandle->pI2Cx, I2C_ACK_ENABLE);
+    }
+}
+
+/*********************************************************************
+ * @fn              - I2C_NotifyEvent
+ *
+ * @brief           - Hands an application event to the owner of the bus
+ *
+ * @Note            - The handle's pCallback if set, else the global
+ *                    I2C_ApplicationEventCallback(): one bus's owner
+ *                    does not take the events of the others
+ *********************************************************************/
+static void I2C_NotifyEvent(I2C_Handle_t *pI2CHandle, uint8_t AppEv)
+{
+    if(pI2CHandle->pCallback != NULL)
+    {
+        pI2CHandle->pCallback(pI2CHandle, AppEv);
+    }
+    else
+    {
+        I2C_ApplicationEventCallback(pI2CHandle, AppEv);
     }
 }
 
+/*
+ * Weak callback - user should override this in application
+ */
+__attribute__((weak)) void I2C_ApplicationEventCallback(I2C_Handle_t *pI2CHandle, uint8_t AppEv)
+{
+    /* User implementation */
+    (void)pI2CHandle;
+    (void)AppEv;
+}
+
 /*********************************************************************
  * @fn              - I2C_CheckDevice
  *
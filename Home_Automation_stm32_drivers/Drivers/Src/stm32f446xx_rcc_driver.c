@@ -240,9 +240,21 @@ RCC_StatusTypeDef RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_
         RCC->CFGR |= ((RCC_ClkInitStruct->APB2CLKDivider) << 3);
     }
 
+    /* Let timebase users re-derive their prescalers/reloads */
+    RCC_ClockChangedCallback();
+
     return RCC_OK;
 }
 
+/*
+ * Weak callback - invoked after every successful RCC_ClockConfig().
+ * Override in the application/BSP to re-derive clock dependent settings.
+ */
+__attribute__((weak)) void RCC_ClockChangedCallback(void)
+{
+    /* User implementation */
+}
+
 /*********************************************************************
  * @fn              - RCC_EnableHSE
  * @brief           - Enables or disables HSE oscillator
@@ -1120,3 +1120,107 @@ void TIMER_IRQHandling(TIMER_Handle_t *pTIMERHandle)
         g_TimerDelayComplete = 1;
     }
 }
+
+/*********************************************************************
+ * @fn              - TIMER_OnePulseInit
+ *
+ * @brief           - Sets up a basic timer (TIM6/TIM7) for one-shot
+ *                    intervals: each TIMER_OnePulseStart() gives one
+ *                    update interrupt, then the counter stops by itself
+ *
+ * @param[in]       - Base address of the Timer peripheral
+ * @param[in]       - Tick frequency in Hz (1000000 for 1 us ticks)
+ *
+ * @return          - none
+ *
+ * @Note            - The prescaler is derived from the current PCLK1;
+ *                    call again after a clock change. URS is set, so
+ *                    only the end of an interval sets UIF.
+ */
+void TIMER_OnePulseInit(TIM_RegDef_t *pTIMx, uint32_t TickHz)
+{
+    uint32_t timer_clock_freq = RCC_GetPCLK1Value();
+    uint8_t apb1_prescaler = (RCC->CFGR >> 10) & 0x7;
+
+    if(apb1_prescaler >= 4)
+    {
+        timer_clock_freq *= 2;
+    }
+
+    TIMER_PeriClockControl(pTIMx, ENABLE);
+
+    pTIMx->CR1 = 0;                         // Stop, ARR not buffered
+    pTIMx->PSC = (timer_clock_freq / TickHz) - 1;
+    pTIMx->CR1 = (1 << 3) | (1 << 2);       // OPM, URS
+    pTIMx->EGR = (1 << 0);                  // Load PSC now (no UIF with URS)
+    pTIMx->SR = 0;
+    pTIMx->DIER |= TIMER_DIER_UIE;
+}
+
+/*********************************************************************
+ * @fn              - TIMER_OnePulseStart
+ *
+ * @brief           - Starts one interval of Ticks timer ticks
+ *
+ * @param[in]       - Base address of the Timer peripheral
+ * @param[in]       - Interval length in ticks (2 or more)
+ *
+ * @return          - none
+ *
+ * @Note            - A null ARR blocks the counter, so shorter
+ *                    intervals are stretched to 2 ticks
+ */
+void TIMER_OnePulseStart(TIM_RegDef_t *pTIMx, uint16_t Ticks)
+{
+    if(Ticks < 2)
+    {
+        Ticks = 2;
+    }
+
+    pTIMx->CNT = 0;
+    pTIMx->ARR = Ticks - 1;
+    pTIMx->CR1 |= (1 << 0);                 // CEN, cleared again by OPM
+}
+
+/*********************************************************************
+ * @fn              - TIMER_PeriodicInit
+ *
+ * @brief           - Starts a timer that raises an update interrupt
+ *                    every Ticks ticks, until TIMER_Disable()
+ *
+ * @param[in]       - Base address of the Timer peripheral (APB1 timer)
+ * @param[in]       - Tick frequency in Hz (10000 for 100 us ticks)
+ * @param[in]       - Period in ticks (2 or more)
+ *
+ * @return          - none
+ *
+ * @Note            - The prescaler is derived from the current PCLK1;
+ *                    call again after a clock change. The NVIC side is
+ *                    left to the caller.
+ */
+void TIMER_PeriodicInit(TIM_RegDef_t *pTIMx, uint32_t TickHz, uint16_t Ticks)
+{
+    uint32_t timer_clock_freq = RCC_GetPCLK1Value();
+    uint8_t apb1_prescaler = (RCC->CFGR >> 10) & 0x7;
+
+    if(apb1_prescaler >= 4)
+    {
+        timer_clock_freq *= 2;
+    }
+    if(Ticks < 2)
+    {
+        Ticks = 2;
+    }
+
+    TIMER_PeriClockControl(pTIMx, ENABLE);
+
+    pTIMx->CR1 = 0;                         // Stop, ARR not buffered
+    pTIMx->PSC = (timer_clock_freq / TickHz) - 1;
+    pTIMx->ARR = Ticks - 1;
+    pTIMx->CNT = 0;
+    pTIMx->CR1 = (1 << 2);                  // URS
+    pTIMx->EGR = (1 << 0);                  // Load PSC now (no UIF with URS)
+    pTIMx->SR = 0;
+    pTIMx->DIER |= TIMER_DIER_UIE;
+    pTIMx->CR1 |= (1 << 0);                 // CEN
+}
@@ -0,0 +1,25 @@
+/*
+ * console.h
+ *
+ * Created on: Feb 22, 2026
+ * Author: Rahul B.
+ * Description: Single-key debug commands on USART2
+ *
+ * The "console" task polls USART2 without blocking and runs one command
+ * per received key:
+ *
+ *   p  profiler summary        h  profiler histograms   l  intrusion latency
+ *   o  OLED flush statistics   r  reset profiler/latency  s  scheduler statistics
+ *   t  FSM transition trace    i  idle statistics         ?  this list
+ *
+ * USART2 is unclocked in Stop mode, so keys sent while STANDBY sleeps in
+ * Stop are lost; press the blue button first.
+ */
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+void Console_Init(void);
+void Console_Task(void);
+
+#endif /* CONSOLE_H_ */
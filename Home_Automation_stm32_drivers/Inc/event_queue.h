@@ -0,0 +1,91 @@
+/*
+ * event_queue.h
+ *
+ * Created on: Feb 17, 2026
+ * Author: Rahul B.
+ * Description: Lock-free ISR -> main loop event queue
+ *
+ * Single-producer / single-consumer ring of small typed events. Interrupt
+ * handlers post with EventQueue_Post() without masking interrupts; the
+ * "events" scheduler task drains the ring with EventQueue_Dispatch() and
+ * calls the handler subscribed to each event source.
+ *
+ * Head is written only by the producer, tail only by the consumer. Both are
+ * free-running 32-bit indices, so the fill level is simply head - tail.
+ * A full ring drops the new event and counts it; nothing is overwritten.
+ *
+ * "Single producer" means: every ISR that posts must run at the same NVIC
+ * priority (EVENTQ_PRODUCER_PRIORITY), so no poster can pre-empt another.
+ *
+ * The poster supplies the timestamp (the EXTI dispatcher has already taken
+ * one, others use now_us32()), so posting never masks interrupts.
+ */
+
+#ifndef EVENT_QUEUE_H_
+#define EVENT_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ===== CONFIGURATION ===== */
+#define EVENTQ_SIZE                 32U             // must be a power of two
+#define EVENTQ_MASK                 (EVENTQ_SIZE - 1U)
+#define EVENTQ_PRODUCER_PRIORITY    15U             // NVIC priority of every posting ISR
+
+/**
+ * @brief Where an event came from
+ */
+typedef enum {
+   EVT_SRC_NONE = 0,
+   EVT_SRC_WAKEUP_BTN,         // PC13 user button (EXTI13)
+   EVT_SRC_IR1,                // PC6 IR sensor 1 (EXTI6)
+   EVT_SRC_IR2,                // PC8 IR sensor 2 (EXTI8)
+   EVT_SRC_TEST,               // synthetic events (unit tests)
+   EVT_SRC_COUNT
+} EventSource_t;
+
+/**
+ * @brief Pin level seen by the ISR, i.e. which edge was taken
+ */
+typedef enum {
+   EVT_EDGE_FALLING = 0,
+   EVT_EDGE_RISING
+} EventEdge_t;
+
+/**
+ * @brief One queued event (8 bytes)
+ */
+typedef struct {
+   uint8_t  source;            // EventSource_t
+   uint8_t  edge;              // EventEdge_t
+   uint16_t seq;               // producer sequence number, gaps = drops
+   uint32_t tick;              // low 32 bits of now_us() at the edge, from the poster
+} Event_t;
+
+typedef void (*EventHandler_t)(const Event_t *evt);
+
+/**
+ * @brief Queue statistics
+ */
+typedef struct {
+   uint32_t posted;            // events accepted into the ring
+   uint32_t dropped;           // events lost because the ring was full
+   uint32_t highWater;         // deepest fill level seen
+   uint32_t dispatched;        // events taken out by the consumer
+} EventQueueStats_t;
+
+/* ===== API ===== */
+void EventQueue_Init(void);
+void EventQueue_Subscribe(EventSource_t source, EventHandler_t handler);
+
+bool EventQueue_Post(EventSource_t source, EventEdge_t edge, uint32_t tick);   // producer (ISR) side
+bool EventQueue_Get(Event_t *evt);                                              // consumer side
+void EventQueue_Dispatch(void);                                                 // scheduler task
+
+uint32_t EventQueue_Delivered(EventSource_t source);                            // per-source delivery count
+bool EventQueue_Last(EventSource_t source, Event_t *evt);                       // newest delivered event
+
+uint32_t EventQueue_Count(void);
+const EventQueueStats_t *EventQueue_GetStats(void);
+
+#endif /* EVENT_QUEUE_H_ */
@@ -0,0 +1,157 @@
+/*
+ * fsm.h
+ *
+ * Created on: Feb 18, 2026
+ * Author: Rahul B.
+ * Description: Generic table-driven finite state machine engine
+ *
+ * A machine is described by two const tables:
+ *
+ *   states[]      - one row per state id: name + entry / exit / do hooks
+ *   transitions[] - { from, event, guard, action, to } rows, searched in
+ *                   order; the first row whose state and event match and
+ *                   whose guard passes (NULL = always) is taken
+ *
+ * Taking an external transition runs exit(from) -> action -> entry(to),
+ * so entry work happens exactly once per transition. A row with
+ * to == FSM_INTERNAL only runs its action and stays in the state.
+ * from == FSM_ANY_STATE matches every state.
+ *
+ * Run-to-completion: events raised from inside any hook or action are
+ * queued and handled after the current step finishes, never nested.
+ * The last FSM_TRACE_DEPTH transitions are kept in a trace ring.
+ *
+ * Hierarchy (optional, Fsm_SetHierarchy): parent[id] names the enclosing
+ * state, initial[id] the child a composite state starts in. The machine
+ * always rests in a leaf. An event is offered to the leaf's rows first,
+ * then bubbles up the parent chain, then to FSM_ANY_STATE rows. Leaving
+ * or entering nested states runs exit hooks innermost-first and entry
+ * hooks outermost-first, up to the common ancestor only; a row that
+ * targets a substate of its own state does not leave that state. Targeting
+ * FSM_HISTORY(composite) re-enters the child it was last in (shallow
+ * history) instead of its initial child. Only the leaf's do hook runs.
+ *
+ * The engine has no hardware dependencies (time comes from an optional
+ * clock callback), so it also builds and runs on a host.
+ */
+
+#ifndef FSM_H_
+#define FSM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ===== CONFIGURATION ===== */
+#define FSM_TRACE_DEPTH         16U     // transitions kept in the history ring
+#define FSM_EVENT_QUEUE_DEPTH   4U      // events raised while a step is running
+#define FSM_MAX_STATES          32U     // state ids must be below this
+
+/* ===== SPECIAL IDS ===== */
+#define FSM_ANY_STATE           0xFEU   // transitions[].from wildcard
+#define FSM_INTERNAL            0xFFU   // transitions[].to: action only, no exit/entry
+#define FSM_NO_STATE            0xFFU   // "none" in traces and before Fsm_Start()
+#define FSM_HISTORY_FLAG        0x80U
+#define FSM_HISTORY(id)         ((FsmStateId_t)((id) | FSM_HISTORY_FLAG))  // transitions[].to
+
+typedef uint8_t FsmStateId_t;
+typedef uint8_t FsmEventId_t;
+
+typedef struct Fsm Fsm_t;
+
+typedef void (*FsmAction_t)(Fsm_t *fsm);
+typedef bool (*FsmGuard_t)(Fsm_t *fsm);
+
+/**
+ * @brief One state: any hook may be NULL
+ */
+typedef struct {
+   const char *name;
+   FsmAction_t entry;          // once, when the state is entered
+   FsmAction_t exit;           // once, when the state is left
+   FsmAction_t run;            // every Fsm_Run() while in the state
+} FsmState_t;
+
+/**
+ * @brief One row of the transition table
+ */
+typedef struct {
+   FsmStateId_t from;          // state id or FSM_ANY_STATE
+   FsmEventId_t event;
+   FsmGuard_t guard;           // NULL = always taken
+   FsmAction_t action;         // runs between exit and entry, may be NULL
+   FsmStateId_t to;            // state id, FSM_HISTORY(id) or FSM_INTERNAL
+} FsmTransition_t;
+
+/**
+ * @brief One entry of the transition history
+ */
+typedef struct {
+   FsmStateId_t from;
+   FsmStateId_t to;
+   FsmEventId_t event;
+   uint32_t tick;              // clock() at the transition
+} FsmTraceEntry_t;
+
+typedef void (*FsmObserver_t)(Fsm_t *fsm, const FsmTraceEntry_t *step);
+
+/* Wraps every hook call; state owns the hook, FSM_NO_STATE for an action */
+typedef void (*FsmProbe_t)(Fsm_t *fsm, FsmStateId_t state, bool begin);
+
+/**
+ * @brief Machine instance - allocate statically, treat fields as private
+ */
+struct Fsm {
+   const FsmState_t *states;
+   const FsmTransition_t *transitions;
+   uint8_t numStates;
+   uint8_t numTransitions;
+
+   const FsmStateId_t *parent;                 // NULL = flat machine
+   const FsmStateId_t *initial;                // per composite state, FSM_NO_STATE for leaves
+   FsmStateId_t history[FSM_MAX_STATES];       // last active child of each composite
+
+   FsmStateId_t current;                       // always a leaf
+   FsmStateId_t previous;
+   FsmEventId_t event;                         // event being handled (for hooks)
+
+   bool busy;                                  // a step is in progress
+   uint8_t queueHead;
+   uint8_t queueCount;
+   FsmEventId_t queue[FSM_EVENT_QUEUE_DEPTH];
+
+   FsmTraceEntry_t trace[FSM_TRACE_DEPTH];
+   uint8_t traceNext;
+
+   uint32_t transitionCount;                   // external transitions taken
+   uint32_t unhandledCount;                    // events no row accepted
+   uint32_t droppedCount;                      // events lost, queue full
+
+   uint32_t (*clock)(void);                    // trace timestamps, may be NULL
+   FsmObserver_t observer;                     // called after every transition
+   FsmProbe_t probe;                           // around every hook, may be NULL
+   void *context;                              // user data for hooks
+};
+
+/* ===== API ===== */
+void Fsm_Init(Fsm_t *fsm,
+              const FsmState_t *states, uint8_t numStates,
+              const FsmTransition_t *transitions, uint8_t numTransitions,
+              uint32_t (*clock)(void), void *context);
+void Fsm_SetObserver(Fsm_t *fsm, FsmObserver_t observer);
+void Fsm_SetProbe(Fsm_t *fsm, FsmProbe_t probe);
+void Fsm_SetHierarchy(Fsm_t *fsm, const FsmStateId_t *parent, const FsmStateId_t *initial);
+void Fsm_Start(Fsm_t *fsm, FsmStateId_t initial);
+
+bool Fsm_Dispatch(Fsm_t *fsm, FsmEventId_t event);
+void Fsm_Run(Fsm_t *fsm);
+
+FsmStateId_t Fsm_GetState(const Fsm_t *fsm);
+bool Fsm_IsIn(const Fsm_t *fsm, FsmStateId_t state);               // leaf or any ancestor
+void Fsm_ClearHistory(Fsm_t *fsm, FsmStateId_t composite);
+const char *Fsm_StateName(const Fsm_t *fsm, FsmStateId_t id);
+void *Fsm_GetContext(const Fsm_t *fsm);
+
+uint8_t Fsm_TraceCount(const Fsm_t *fsm);
+const FsmTraceEntry_t *Fsm_GetTrace(const Fsm_t *fsm, uint8_t age);   // 0 = newest
+
+#endif /* FSM_H_ */
@@ -0,0 +1,55 @@
+/*
+ * idle.h
+ *
+ * Created on: Feb 21, 2026
+ * Author: Rahul B.
+ * Description: Tickless idle - sleep between scheduler deadlines
+ *
+ * Called from the main loop after every dispatcher pass. With interrupts
+ * masked it asks the scheduler how long nothing is due, then waits in the
+ * cheapest mode that fits the budget:
+ *
+ *   task due / event queued      return at once
+ *   budget <  IDLE_STOP_MIN_MS   Sleep mode, SysTick off, TIM2 deadline
+ *   budget >= IDLE_STOP_MIN_MS   Stop mode, RTC wakeup (only while allowed)
+ *
+ * The EXTI lines (PC13 button, PC6/PC8 IR sensors, keypad rows) wake either
+ * mode. After Stop the timebase is compensated and HSE/PLL restored before
+ * interrupts are unmasked, so their handlers run on the application clocks;
+ * wake-up latency is Stop wake-up plus IdleStats_t.maxResumeUs.
+ *
+ * With every key up the keypad is parked: TIM3 is off and a key press wakes
+ * the core through its row's EXTI edge. While a key is being scanned TIM3
+ * ends Sleep every scan tick and Stop is refused (Keypad_IsScanning()).
+ */
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Idle statistics (since Idle_Init / Idle_ResetStats)
+ */
+typedef struct {
+   uint32_t sleeps;            // Sleep mode entries
+   uint32_t stops;             // Stop mode entries
+   uint32_t earlyWakes;        // ended by an interrupt before the deadline
+   uint32_t lastResumeUs;      // wake-up until interrupts are unmasked
+   uint32_t maxResumeUs;
+   uint64_t idleUs;            // time spent in Sleep or Stop
+   uint64_t sinceUs;           // now_us() at the last reset
+} IdleStats_t;
+
+/* ===== API ===== */
+void Idle_Init(void);
+void Idle_Enter(void);                     // main loop, after Scheduler_Dispatch()
+void Idle_SetStopAllowed(bool allowed);    // Stop mode permitted (STANDBY only)
+
+const IdleStats_t *Idle_GetStats(void);
+uint8_t Idle_GetIdlePercent(void);
+void Idle_ResetStats(void);
+void Idle_PrintStats(void);
+
+#endif /* IDLE_H_ */
@@ -0,0 +1,123 @@
+/*
+ * latency.h
+ *
+ * Created on: Feb 23, 2026
+ * Author: Rahul B.
+ * Description: End-to-end intrusion latency (IR edge -> buzzer on)
+ *
+ * Every IR event is followed through four timestamps on the now_us() axis:
+ *
+ *   edge      the EXTI callback posts the event       (Event_t.tick)
+ *   dequeue   the "events" task hands it to the handler  Latency_Begin()
+ *   decision  the handler has decided to alert or not    Latency_Decided()
+ *   actuator  the buzzer pin is driven high              Latency_Actuated()
+ *
+ * and Latency_End() adds the differences to the record of that sensor:
+ *
+ *   queue     edge     -> dequeue    time spent waiting behind other tasks
+ *   decide    dequeue  -> decision
+ *   actuate   decision -> actuator
+ *   total     edge     -> actuator   only for events that raised an alert
+ *
+ * Each stage keeps count / min / max / sum and a log2 histogram with four
+ * sub-buckets per octave (error below 25 %), from which p50 and p99 upper
+ * bounds are derived. The breakdown of the worst total is kept as well, and
+ * totals above INTRUSION_LATENCY_BUDGET_US are counted.
+ *
+ * All calls are made in thread context (event handlers); only the edge
+ * stamp is taken in the ISR, by the event queue.
+ */
+
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "event_queue.h"
+
+/* ===== CONFIGURATION ===== */
+#define LAT_SUB_BITS            2U      // 4 sub-buckets per octave
+#define LAT_BUCKETS             68U     // exact below 4 us, last bucket from 229 ms up
+
+/**
+ * @brief Sensors that are traced
+ */
+typedef enum {
+   LAT_SENSOR_IR1 = 0,         // PC6
+   LAT_SENSOR_IR2,             // PC8
+   LAT_SENSOR_COUNT,
+   LAT_SENSOR_NONE = 0xFF
+} LatSensor_t;
+
+/**
+ * @brief Measured intervals
+ */
+typedef enum {
+   LAT_STAGE_QUEUE = 0,        // edge -> dequeue
+   LAT_STAGE_DECIDE,           // dequeue -> decision
+   LAT_STAGE_ACTUATE,          // decision -> actuator
+   LAT_STAGE_TOTAL,            // edge -> actuator
+   LAT_STAGE_COUNT
+} LatStage_t;
+
+/**
+ * @brief Timestamps of one event (low 32 bits of now_us())
+ */
+typedef struct {
+   uint8_t  sensor;            // LatSensor_t
+   bool     decided;           // decisionUs is valid
+   bool     actuated;          // actuatorUs is valid (an alert was raised)
+   uint16_t seq;               // Event_t.seq
+   uint32_t edgeUs;
+   uint32_t dequeueUs;
+   uint32_t decisionUs;
+   uint32_t actuatorUs;
+} LatTrace_t;
+
+/**
+ * @brief Accumulated samples of one stage (microseconds)
+ */
+typedef struct {
+   uint32_t count;
+   uint32_t minUs;
+   uint32_t maxUs;
+   uint64_t sumUs;
+   uint32_t hist[LAT_BUCKETS];
+} LatStageData_t;
+
+/**
+ * @brief Summary of one stage
+ */
+typedef struct {
+   uint32_t count;
+   uint32_t minUs;
+   uint32_t meanUs;
+   uint32_t p50Us;             // upper edge of the bucket holding the median
+   uint32_t p99Us;             // upper edge of the bucket holding the 99th percentile
+   uint32_t maxUs;
+} LatStats_t;
+
+/**
+ * @brief Everything recorded for one sensor
+ */
+typedef struct {
+   LatStageData_t stage[LAT_STAGE_COUNT];
+   LatTrace_t worst;           // breakdown of the largest total
+   uint32_t overBudget;        // totals above INTRUSION_LATENCY_BUDGET_US
+} LatSensorData_t;
+
+/* ===== API ===== */
+void Latency_Init(void);
+void Latency_Reset(void);
+
+void Latency_Begin(LatTrace_t *trace, const Event_t *evt);  // first thing in the handler
+void Latency_Decided(LatTrace_t *trace);
+void Latency_Actuated(void);                                // at the actuator write
+void Latency_End(LatTrace_t *trace);
+
+bool Latency_GetStats(LatSensor_t sensor, LatStage_t stage, LatStats_t *stats);
+const LatSensorData_t *Latency_GetSensor(LatSensor_t sensor);
+
+void Latency_Dump(void);                                    // per-sensor table over USART2
+
+#endif /* LATENCY_H_ */
@@ -0,0 +1,114 @@
+/*
+ * profiler.h
+ *
+ * Created on: Feb 22, 2026
+ * Author: Rahul B.
+ * Description: Cycle-accurate zone profiler (DWT CYCCNT) with histograms
+ *
+ * A zone is a named piece of code timed with a begin/end pair:
+ *
+ *   void BSP_OLED_Update(void)
+ *   {
+ *       PROF_BEGIN(PROF_ZONE_OLED_UPDATE);
+ *       ...
+ *       PROF_END(PROF_ZONE_OLED_UPDATE);
+ *   }
+ *
+ * Every sample lands in a fixed log2 histogram (bucket b holds durations
+ * of 2^(b+5) .. 2^(b+6)-1 cycles, bucket 0 everything below 64) plus
+ * count / min / max / sum, from which min, max, mean and a p99 upper bound
+ * are derived. Prof_Record() masks interrupts for a few cycles only, so
+ * zones may be timed inside ISRs as well.
+ *
+ * Built-in zones are listed in PROF_ZONE_LIST; more can be added at run
+ * time with Prof_AddZone(). The zone argument of PROF_BEGIN/PROF_END must
+ * be an identifier (an enum constant or a ProfZone_t variable).
+ *
+ * Time source: DWT CYCCNT on the target (HCLK cycles, wraps after
+ * 2^32 cycles), clock_gettime(CLOCK_MONOTONIC) nanoseconds on a host
+ * build, so the same zones can be benchmarked off-target.
+ * Build with PROF_ENABLED=0 to compile every zone out.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ===== CONFIGURATION ===== */
+#ifndef PROF_ENABLED
+#define PROF_ENABLED            1
+#endif
+
+#define PROF_MAX_ZONES          32U     // built-in + run-time zones
+#define PROF_BUCKETS            20U     // log2 buckets: < 64 .. >= 2^24 cycles
+#define PROF_BUCKET_SHIFT       5U      // bucket b starts at 2^(b + 5) cycles
+
+/* ===== BUILT-IN ZONES ===== */
+#define PROF_ZONE_LIST(X) \
+   X(OLED_UPDATE,  "BSP_OLED_Update")      \
+   X(LCD_PRINT,    "BSP_LCD_PrintString")  \
+   X(UART_PRINTF,  "UART_Printf")          \
+   X(KEYPAD_SCAN,  "Keypad_Scan")          \
+   X(LDR_READ,     "BSP_Sensor_ReadLDR")
+
+#define PROF_ZONE_ENUM(id, name)    PROF_ZONE_##id,
+
+enum {
+   PROF_ZONE_LIST(PROF_ZONE_ENUM)
+   PROF_ZONE_BUILTIN_COUNT
+};
+
+typedef uint8_t ProfZone_t;
+
+#define PROF_INVALID_ZONE       0xFFU
+
+/**
+ * @brief Accumulated samples of one zone (raw time-source ticks)
+ */
+typedef struct {
+   const char *name;
+   uint32_t count;
+   uint32_t minTicks;
+   uint32_t maxTicks;
+   uint64_t sumTicks;
+   uint32_t hist[PROF_BUCKETS];
+} ProfZoneData_t;
+
+/**
+ * @brief Summary of one zone in microseconds
+ */
+typedef struct {
+   uint32_t count;
+   uint32_t minUs;
+   uint32_t maxUs;
+   uint32_t meanUs;
+   uint32_t p99Us;             // upper edge of the bucket holding the 99th percentile
+} ProfStats_t;
+
+/* ===== API ===== */
+void Prof_Init(void);
+ProfZone_t Prof_AddZone(const char *name);
+void Prof_Reset(void);
+
+uint32_t Prof_Now(void);                                // raw ticks (cycles / ns)
+void Prof_Record(ProfZone_t zone, uint32_t ticks);      // thread and ISR safe
+
+bool Prof_GetStats(ProfZone_t zone, ProfStats_t *stats);
+const ProfZoneData_t *Prof_GetZone(ProfZone_t zone);
+uint32_t Prof_TicksPerUs(void);
+
+void Prof_Dump(void);                                   // summary table over USART2
+void Prof_DumpHistogram(ProfZone_t zone);
+
+/* ===== ZONE MACROS ===== */
+#if PROF_ENABLED
+#define PROF_BEGIN(zone)        const uint32_t profStart_##zone = Prof_Now()
+#define PROF_END(zone)          Prof_Record((zone), Prof_Now() - profStart_##zone)
+#else
+#define PROF_BEGIN(zone)        ((void)0)
+#define PROF_END(zone)          ((void)0)
+#endif
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,118 @@
+/*
+ * pt.h
+ *
+ * Created on: Feb 20, 2026
+ * Author: Rahul B.
+ * Description: Stackless coroutines (protothreads) for the cooperative scheduler
+ *
+ * A protothread is an ordinary function that can stop at a wait point and
+ * carry on from there the next time it is called. The resume point (the
+ * "local continuation") is the source line of the last wait, kept in a
+ * Pt_t together with one 32-bit scratch word: 8 bytes per coroutine.
+ *
+ *   static Pt_t blinkPt;
+ *
+ *   static PT_THREAD(Blink_Thread(Pt_t *pt))
+ *   {
+ *       PT_BEGIN(pt);
+ *       for (;;) {
+ *           BSP_LED_Toggle(LED_GREEN_PIN);
+ *           PT_AWAIT_MS(pt, 500);
+ *       }
+ *       PT_END(pt);
+ *   }
+ *
+ *   // scheduler task
+ *   void Blink_Task(void) { (void)Blink_Thread(&blinkPt); }
+ *
+ * Rules (the function returns at every wait, its stack frame is gone):
+ *   - locals do not survive a wait: keep such state static or in a struct
+ *   - no switch statement may span a wait point
+ *   - at most one PT_ wait macro per source line
+ */
+
+#ifndef PT_H_
+#define PT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bsp_timebase.h"
+#include "bsp_keypad.h"
+#include "event_queue.h"
+
+/* Millisecond clock used by PT_AWAIT_MS (wrap-safe 32-bit differences) */
+#ifndef PT_CLOCK_MS
+#define PT_CLOCK_MS()           ((uint32_t)now_ms())
+#endif
+
+/**
+ * @brief Coroutine control block - allocate statically, PT_INIT before use
+ */
+typedef struct {
+   uint16_t lc;                // resume line, 0 = start
+   uint32_t mark;              // await start time / event count snapshot
+} Pt_t;
+
+/* ===== THREAD RESULT ===== */
+typedef uint8_t PtStatus_t;
+
+#define PT_WAITING              0U      // blocked on a condition
+#define PT_YIELDED              1U      // gave up the CPU voluntarily
+#define PT_EXITED               2U      // left through PT_EXIT
+#define PT_ENDED                3U      // ran to PT_END
+
+#define PT_THREAD(decl)         PtStatus_t decl
+
+/* true while the thread has not finished: while (PT_SCHEDULE(f(&pt))) ... */
+#define PT_SCHEDULE(call)       ((call) < PT_EXITED)
+
+/* Every wait point is a case label right after the store of its line */
+#define PT_FALLTHROUGH          __attribute__((fallthrough))
+
+/* ===== STRUCTURE ===== */
+#define PT_INIT(pt)             do { (pt)->lc = 0U; } while (0)
+
+#define PT_BEGIN(pt)            { bool ptYielded = true; (void)ptYielded; \
+                                  switch ((pt)->lc) { case 0:
+
+#define PT_END(pt)              } PT_INIT(pt); return PT_ENDED; }
+
+/* ===== WAITING ===== */
+#define PT_WAIT_UNTIL(pt, cond) \
+   do { (pt)->lc = (uint16_t)__LINE__; PT_FALLTHROUGH; case __LINE__: \
+        if (!(cond)) return PT_WAITING; } while (0)
+
+#define PT_WAIT_WHILE(pt, cond) PT_WAIT_UNTIL(pt, !(cond))
+
+/* Give the other tasks one turn, then carry on */
+#define PT_YIELD(pt) \
+   do { ptYielded = false; (pt)->lc = (uint16_t)__LINE__; PT_FALLTHROUGH; case __LINE__: \
+        if (!ptYielded) return PT_YIELDED; } while (0)
+
+/* Run a child coroutine to completion */
+#define PT_SPAWN(pt, child, call) \
+   do { PT_INIT(child); PT_WAIT_WHILE(pt, PT_SCHEDULE(call)); } while (0)
+
+#define PT_RESTART(pt)          do { PT_INIT(pt); return PT_WAITING; } while (0)
+#define PT_EXIT(pt)             do { PT_INIT(pt); return PT_EXITED; } while (0)
+
+/* ===== AWAITS ===== */
+
+/* Sleep for ms milliseconds without blocking the main loop */
+#define PT_AWAIT_MS(pt, ms) \
+   do { (pt)->mark = PT_CLOCK_MS(); \
+        PT_WAIT_UNTIL(pt, (uint32_t)(PT_CLOCK_MS() - (pt)->mark) >= (uint32_t)(ms)); } while (0)
+
+/* Wait for a keypad key; key (a static char) receives it */
+#define PT_AWAIT_KEY(pt, key) \
+   PT_WAIT_UNTIL(pt, ((key) = Keypad_GetKey()) != KEYPAD_NO_KEY)
+
+/* Wait for the next event of one source delivered by the "events" task;
+ * *evt receives it. Only the newest is kept if several arrive in one pass. */
+#define PT_AWAIT_EVENT(pt, source, evt) \
+   do { (pt)->mark = EventQueue_Delivered(source); \
+        PT_WAIT_UNTIL(pt, EventQueue_Delivered(source) != (pt)->mark); \
+        (void)EventQueue_Last((source), (evt)); } while (0)
+
+#endif /* PT_H_ */
@@ -0,0 +1,70 @@
+/*
+ * scheduler.h
+ *
+ * Created on: Feb 15, 2026
+ * Author: Rahul B.
+ * Description: Cooperative run-to-completion task scheduler
+ *
+ * Tasks are plain void(void) functions that do a bounded amount of work and
+ * return. The dispatcher samples the 1 ms timebase once per pass and runs
+ * every due task in table (= registration) order, so the execution order is
+ * deterministic. Periodic tasks keep a fixed phase; one-shot tasks free their
+ * slot after running once.
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ===== CONFIGURATION ===== */
+#define SCHED_MAX_TASKS         12
+#define SCHED_INVALID_ID        (-1)
+#define SCHED_NO_DEADLINE       UINT32_MAX
+
+typedef void (*TaskFunc_t)(void);
+typedef int8_t TaskId_t;
+
+/* ms until the task has real work (0 = now, SCHED_NO_DEADLINE = none).
+ * Lets a fast polling task stay out of the idle budget while it has nothing to do. */
+typedef uint32_t (*TaskWakeHint_t)(void);
+
+/**
+ * @brief Task control block (read-only outside scheduler.c)
+ */
+typedef struct {
+   const char *name;
+   TaskFunc_t  func;
+   uint32_t    period;      // ms, 0 = one-shot
+   uint32_t    nextRun;     // due time on the GetSystemTick() axis
+   bool        used;
+   bool        active;
+   TaskWakeHint_t wakeHint; // NULL = wake for every period
+
+   /* Statistics */
+   uint32_t    runCount;
+   uint32_t    overruns;    // periods skipped because the task ran late
+   uint32_t    lastExecUs;
+   uint32_t    maxExecUs;
+} Task_t;
+
+/* ===== API ===== */
+void     Scheduler_Init(void);
+TaskId_t Scheduler_AddTask(const char *name, TaskFunc_t func, uint32_t period_ms);
+TaskId_t Scheduler_AddOneShot(const char *name, TaskFunc_t func, uint32_t delay_ms);
+void     Scheduler_RemoveTask(TaskId_t id);
+void     Scheduler_SuspendTask(TaskId_t id);
+void     Scheduler_ResumeTask(TaskId_t id);
+void     Scheduler_TriggerTask(TaskId_t id);
+void     Scheduler_SetPeriod(TaskId_t id, uint32_t period_ms);
+void     Scheduler_SetWakeHint(TaskId_t id, TaskWakeHint_t hint);
+
+void     Scheduler_Dispatch(void);
+bool     Scheduler_IsRunning(void);
+uint32_t Scheduler_MsUntilNextRun(void);     // idle budget, SCHED_NO_DEADLINE if none
+
+const Task_t *Scheduler_GetTask(TaskId_t id);
+void     Scheduler_PrintStats(void);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,84 @@
+/*
+ * soft_timer.h
+ *
+ * Created on: Feb 16, 2026
+ * Author: Rahul B.
+ * Description: Software timers on a hierarchical timing wheel
+ *
+ * Timer nodes are owned by the caller (static SoftTimer_t objects, no heap)
+ * and linked into a 4-level x 32-slot wheel with 1 ms resolution:
+ *
+ *   level 0 : deltas <       32 ms   one slot per tick
+ *   level 1 : deltas <     1024 ms   one slot per 32 ticks
+ *   level 2 : deltas <    32768 ms   one slot per 1024 ticks
+ *   level 3 : deltas < 1048576 ms   one slot per 32768 ticks (~17.5 min span)
+ *
+ * Start/stop are O(1) list operations. Each tick only touches the level 0
+ * slot that is due, plus a cascade of one higher-level slot every 32 ticks,
+ * so the per-tick cost does not grow with the number of armed timers.
+ * Longer delays are parked in the top level and re-cascaded until due.
+ *
+ * Callbacks run in thread context from SoftTimer_Process() (the "timers"
+ * scheduler task). Start/Stop must only be called from thread context.
+ */
+
+#ifndef SOFT_TIMER_H_
+#define SOFT_TIMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ===== WHEEL GEOMETRY ===== */
+#define STIMER_WHEEL_BITS       5
+#define STIMER_WHEEL_SIZE       (1UL << STIMER_WHEEL_BITS)
+#define STIMER_WHEEL_MASK       (STIMER_WHEEL_SIZE - 1UL)
+#define STIMER_LEVELS           4
+#define STIMER_MAX_DELTA        ((1UL << (STIMER_WHEEL_BITS * STIMER_LEVELS)) - 1UL)
+#define STIMER_NO_DEADLINE      UINT32_MAX
+
+typedef void (*SoftTimerCallback_t)(void *arg);
+
+/**
+ * @brief Intrusive doubly linked list link (first member of SoftTimer_t)
+ */
+typedef struct SoftTimerLink {
+   struct SoftTimerLink *next;
+   struct SoftTimerLink *prev;
+} SoftTimerLink_t;
+
+/**
+ * @brief Timer node - allocate statically, treat fields as private
+ */
+typedef struct {
+   SoftTimerLink_t link;
+   uint32_t expires;               // absolute tick (ms, GetSystemTick axis)
+   uint32_t period;                // 0 = one-shot
+   SoftTimerCallback_t callback;
+   void *arg;
+} SoftTimer_t;
+
+/**
+ * @brief Service statistics
+ */
+typedef struct {
+   uint32_t armed;                 // timers currently linked in the wheel
+   uint32_t expired;               // callbacks run since init
+   uint32_t cascaded;              // timers moved down a level
+   uint32_t ticks;                 // wheel ticks processed
+} SoftTimerStats_t;
+
+/* ===== API ===== */
+void SoftTimer_Init(void);
+void SoftTimer_Create(SoftTimer_t *timer, SoftTimerCallback_t callback, void *arg);
+void SoftTimer_Start(SoftTimer_t *timer, uint32_t delay_ms, uint32_t period_ms);
+void SoftTimer_Stop(SoftTimer_t *timer);
+bool SoftTimer_IsActive(const SoftTimer_t *timer);
+
+void SoftTimer_Process(void);                  // scheduler task: catch up to now
+void SoftTimer_AdvanceTo(uint32_t tick);       // run the wheel up to an explicit tick
+uint32_t SoftTimer_Now(void);                  // last tick processed by the wheel
+uint32_t SoftTimer_MsUntilNext(void);          // idle budget: ms until the wheel has work
+
+const SoftTimerStats_t *SoftTimer_GetStats(void);
+
+#endif /* SOFT_TIMER_H_ */
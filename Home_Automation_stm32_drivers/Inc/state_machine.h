@@ -11,6 +11,7 @@
 
 #include "stm32f446xx.h"
 #include "config.h"
+#include "fsm.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -35,13 +36,6 @@ typedef enum {
 } BuzzerPattern_t;
 
 ///* ===== MENU AND CONTROL ITEMS (Simplified) ===== */
-typedef enum {
-   MENU_MAIN,
-   MENU_SENSORS,
-   MENU_CONTROLS,
-   MENU_SETTINGS
-} MenuState_t;
-
 typedef enum {
    SENSOR_SCREEN_LDR,
    SENSOR_SCREEN_MOTION
@@ -95,9 +89,24 @@ typedef enum {
    STATE_CONTROL_DEVICES,
    STATE_SETTINGS,
    STATE_LOCKOUT,
-   STATE_ERROR
+   STATE_ERROR,
+   STATE_AUTHENTICATED,        // superstate of MENU / SENSOR_MONITOR / CONTROL / SETTINGS
+   STATE_COUNT
 } SystemState_t;
 
+/* ===== FSM Events ===== */
+typedef enum {
+   EV_NONE = 0,
+   EV_WAKEUP,                  // PC13 press or any key in STANDBY
+   EV_PIN_ENTERED,             // PIN_LENGTH digits collected
+   EV_SELECT,                  // menu ENTER (guarded by menuCursor)
+   EV_BACK,                    // '*' in a sub-screen
+   EV_LOGOUT,                  // '#'
+   EV_TIMEOUT,                 // SCREEN_TIMEOUT_SEC without a key
+   EV_LOCKOUT_DONE,            // LOCKOUT_TIME_SEC elapsed
+   EV_COUNT
+} SystemEvent_t;
+
 /* ===== ERROR TYPES ===== */
 typedef enum {
    ERROR_NONE = 0,
@@ -115,10 +124,9 @@ typedef enum {
 * @brief System Context - Complete State Information
 */
 typedef struct {
-   SystemState_t currentState;
+   SystemState_t currentState;     // always a leaf state (mirrored from the FSM)
    SystemState_t previousState;
 
-   MenuState_t currentMenu;
    SensorScreen_t currentSensorScreen;
    ControlMenuItem_t currentControlItem;
 
@@ -128,6 +136,8 @@ typedef struct {
    uint8_t loginAttempts;
    bool isAuthenticated;
 
+   uint32_t stateEntryTime;    // GetSystemTick() when currentState was entered
+
    uint32_t lastActivityTime;
    uint32_t lockoutEndTime;
    uint32_t errorRecoveryTime;
@@ -146,17 +156,12 @@ typedef struct {
 /* Core State Machine */
 void StateMachine_Init(void);
 void StateMachine_Run(void);
-//void StateMachine_SetState(SystemState_t newState);
-
-/* State Handlers */
-void Handle_Standby(void);
-void Handle_Authentication(void);
-void Handle_ActiveMenu(void);
-//void Handle_Error(void);          // NEW: Error state handler
-void Handle_Lockout(void);
-void Handle_SensorMonitor(void);
-void Handle_ControlDevices(void);
-//void Handle_Settings(void);
+void StateMachine_SetRunPeriod(uint32_t period_ms);
+bool StateMachine_Post(SystemEvent_t event);
+void StateMachine_PrintTrace(void);
+
+/* State Handlers (state/transition tables live in state_handlers.c) */
+void StateHandlers_Init(Fsm_t *fsm);
 
 //// Error management
 //void System_ReportError(SystemError_t error);  // NEW: Report error and enter ERROR state
@@ -165,6 +170,8 @@ void Handle_ControlDevices(void);
 //
 ///* Sensor Functions */
 //bool Sensors_Update(void);
+void Sensors_Init(void);
+void Sensors_Task(void);
 void Sensors_DisplayOnLCD(void);
 void Sensors_DisplayOnOLED(void);
 //void Sensors_SendUART(void);
@@ -172,6 +179,7 @@ void Sensors_DisplayOnOLED(void);
 ///* Device Control Functions */
 //void Device_ToggleLED(uint8_t pin);
 //void Device_ToggleRelay(uint8_t pin);
+void Device_Init(void);
 void Device_PlayBuzzer(BuzzerPattern_t pattern);
 //void Device_UpdateLDRAutoMode(void);
 //void Device_SendStatusUART(void);
@@ -181,9 +189,15 @@ void Menu_Display(void);
 //void Menu_ProcessSelection(void);
 //
 ///* Display Functions */
+void Display_Init(void);
+void Display_RequestRefresh(void);
+void Display_ClaimOLED(bool claimed);
+void Display_LCDTask(void);
+void Display_OLEDTask(void);
 void Display_UpdateOLED(void);
 void Display_UpdateLCD(void);
 void Display_ClearAll(void);
+void Display_PrintOLEDStats(void);
 //
 ///* Authentication Functions */
 //void Auth_ProcessKeyPress(char key);
@@ -193,7 +207,7 @@ void Display_ClearAll(void);
 ///* Utility Functions */
 uint32_t GetSystemTick(void);
 bool CheckTimeout(uint32_t lastTime, uint32_t interval);
-//uint8_t LDR_ToPercentage(uint16_t raw_value);
+uint8_t LDR_ToPercentage(uint16_t raw_value);
 //
 ///* Helper for peripheral test */
 void update_lcd_display(const char *line1, const char *line2);
@@ -201,15 +215,15 @@ void print_Log(const char *format, ...);
 //void Run_Complete_Peripheral_Test(void);
 ///* Function Prototypes to fix implicit declaration warnings */
 //
-//void Process_Intrusion_Events(void);
-//
 //// Add these core function prototypes
 //uint32_t SysTick_Config(uint32_t ticks);
 //void NVIC_SetPriority(int32_t IRQn, uint32_t priority);
 
 ///* ===== Function Prototypes ===== */
 //
-uint8_t System_SelfTest(void);           // ← ADDED
+void SelfTest_Start(void);               // power-on self-test, runs as a task
+bool SelfTest_IsRunning(void);
+uint8_t SelfTest_GetResult(void);
 
 /* ===== GLOBAL VARIABLE DECLARATIONS ===== */
 extern SystemContext_t g_SystemContext;
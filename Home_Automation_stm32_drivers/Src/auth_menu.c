@@ -40,6 +40,7 @@ static const char* controlMenuItems[] = {
 
 /**
 * @brief Display current menu on LCD
+* @note  Writes the LCD view; Display_UpdateLCD flushes it.
 */
 void Menu_Display(void)
 {
@@ -101,8 +102,6 @@ void Menu_Display(void)
        }
    }
 
-   BSP_LCD_SetCursor(0, 0);
-   BSP_LCD_PrintString(line1);
-   BSP_LCD_SetCursor(1, 0);
-   BSP_LCD_PrintString(line2);
+   BSP_LCD_SetLine(0, line1);
+   BSP_LCD_SetLine(1, line2);
 }
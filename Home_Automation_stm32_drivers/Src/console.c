@@ -0,0 +1,61 @@
+/*
+ * console.c
+ *
+ * Created on: Feb 22, 2026
+ * Author: Rahul B.
+ * Description: Single-key debug commands on USART2
+ */
+
+#include "console.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "idle.h"
+#include "latency.h"
+#include "state_machine.h"
+#include "bsp_uart2_debug.h"
+#include "config.h"
+
+static void Console_Help(void)
+{
+   UART_Printf("[CONSOLE] p=profile h=histograms l=latency o=oled r=reset s=sched t=trace i=idle\r\n");
+}
+
+static void Console_Histograms(void)
+{
+   for (ProfZone_t id = 0; id < PROF_MAX_ZONES; id++) {
+       const ProfZoneData_t *z = Prof_GetZone(id);
+       if (z == NULL) break;
+       if (z->count != 0U) Prof_DumpHistogram(id);
+   }
+}
+
+/**
+ * @brief Register the "console" task
+ */
+void Console_Init(void)
+{
+   Scheduler_AddTask("console", Console_Task, CONSOLE_TASK_PERIOD_MS);
+}
+
+/**
+ * @brief Scheduler task: run the command of every key received since the last pass
+ */
+void Console_Task(void)
+{
+   uint8_t ch;
+
+   while (UART_TryReceiveByte(&ch)) {
+       switch (ch) {
+       case 'p': Prof_Dump(); break;
+       case 'h': Console_Histograms(); break;
+       case 'l': Latency_Dump(); break;
+       case 'o': Display_PrintOLEDStats(); break;
+       case 'r': Prof_Reset(); Latency_Reset(); UART_Printf("[CONSOLE] profiler and latency reset\r\n"); break;
+       case 's': Scheduler_PrintStats(); break;
+       case 't': StateMachine_PrintTrace(); break;
+       case 'i': Idle_PrintStats(); break;
+       case '?': Console_Help(); break;
+       default: break;
+       }
+   }
+}
@@ -12,66 +12,103 @@
 #include "bsp_buzzer.h"
 #include "bsp_uart2_debug.h"
 #include "bsp_delay.h"
+#include "scheduler.h"
+#include "soft_timer.h"
+#include "latency.h"
 #include <stdio.h>
 
 /* ===== BUZZER CONTROL ===== */
 
 /**
- * @brief Play buzzer pattern
+ * @brief Buzzer pattern description: <count> beeps of on_ms, separated by off_ms
  */
-void Device_PlayBuzzer(BuzzerPattern_t pattern)
+typedef struct {
+    uint16_t on_ms;
+    uint16_t off_ms;
+    uint8_t count;
+    const char *name;
+} BuzzerPatternDef_t;
+
+static const BuzzerPatternDef_t buzzerPatterns[] = {
+    [BEEP_SUCCESS] = { 300,   0, 1, "SUCCESS" },  // Single short beep
+    [BEEP_ERROR]   = { 200, 200, 2, "ERROR"   },  // Two short beeps
+    [BEEP_WARNING] = { 200, 200, 3, "WARNING" },  // Three short beeps
+    [BEEP_ALARM]   = { 500, 200, 3, "ALARM"   },  // Three long beeps
+    [BEEP_MOTION]  = { 500,   0, 1, "MOTION"  },  // Single long beep
+};
+
+#define BUZZER_PATTERN_COUNT    (sizeof(buzzerPatterns) / sizeof(buzzerPatterns[0]))
+
+/* Pattern player state, advanced by the buzzer soft timer */
+static SoftTimer_t buzzerTimer;
+static const BuzzerPatternDef_t *activePattern = NULL;
+static uint8_t beepsLeft = 0;
+static bool buzzerOn = false;
+
+/**
+ * @brief Soft timer callback: next edge of the active buzzer pattern
+ */
+static void Device_BuzzerStep(void *arg)
 {
-    switch (pattern) {
-        case BEEP_SUCCESS:
-            // Single short beep (200ms)
-            BSP_Buzzer_On();
-            BSP_Delay_ms(300);
-            BSP_Buzzer_Off();
-            UART_Printf("[DEVICE] Buzzer: SUCCESS\r\n");
-            break;
+    (void)arg;
+
+    if (activePattern == NULL) return;
+
+    if (buzzerOn) {
+        BSP_Buzzer_Off();
+        buzzerOn = false;
+
+        if (--beepsLeft == 0) {
+            activePattern = NULL;
+            g_DeviceStates.buzzer_active = false;
+            return;
+        }
+        SoftTimer_Start(&buzzerTimer, activePattern->off_ms, 0);
+    } else {
+        BSP_Buzzer_On();
+        buzzerOn = true;
+        SoftTimer_Start(&buzzerTimer, activePattern->on_ms, 0);
+    }
+}
 
-        case BEEP_ERROR:
-            // Two short beeps (100ms each)
-            for (int i = 0; i < 2; i++) {
-                BSP_Buzzer_On();
-                BSP_Delay_ms(200);
-                BSP_Buzzer_Off();
-                BSP_Delay_ms(200);
-            }
-            UART_Printf("[DEVICE] Buzzer: ERROR\r\n");
-            break;
+/**
+ * @brief Prepare the buzzer pattern timer
+ */
+void Device_Init(void)
+{
+    activePattern = NULL;
+    SoftTimer_Create(&buzzerTimer, Device_BuzzerStep, NULL);
+}
 
-        case BEEP_WARNING:
-            // Three short beeps
-            for (int i = 0; i < 3; i++) {
-                BSP_Buzzer_On();
-                BSP_Delay_ms(200);
-                BSP_Buzzer_Off();
-                BSP_Delay_ms(200);
-            }
-            UART_Printf("[DEVICE] Buzzer: WARNING\r\n");
-            break;
+/**
+ * @brief Play buzzer pattern
+ * @note  Returns immediately once the scheduler runs; the pattern is played
+ *        by a soft timer. A new pattern replaces the current one.
+ *        Before the scheduler starts (boot, self-test) it plays inline.
+ */
+void Device_PlayBuzzer(BuzzerPattern_t pattern)
+{
+    if ((uint32_t)pattern >= BUZZER_PATTERN_COUNT) return;
 
-        case BEEP_ALARM:
-            // Three long beeps for alarm
-            for (int i = 0; i < 3; i++) {
-                BSP_Buzzer_On();
-                BSP_Delay_ms(500);
-                BSP_Buzzer_Off();
-                BSP_Delay_ms(200);
-            }
-            UART_Printf("[DEVICE] Buzzer: ALARM\r\n");
-            break;
+    const BuzzerPatternDef_t *p = &buzzerPatterns[pattern];
 
-        case BEEP_MOTION:
-            // Single long beep (500ms)
+    if (!Scheduler_IsRunning()) {
+        UART_Printf("[DEVICE] Buzzer: %s\r\n", p->name);
+        for (uint8_t i = 0; i < p->count; i++) {
             BSP_Buzzer_On();
-            BSP_Delay_ms(500);
+            BSP_Delay_ms(p->on_ms);
             BSP_Buzzer_Off();
-            UART_Printf("[DEVICE] Buzzer: MOTION\r\n");
-            break;
-
-        default:
-            break;
+            BSP_Delay_ms(p->off_ms);
+        }
+        return;
     }
+
+    activePattern = p;
+    beepsLeft = p->count;
+    buzzerOn = true;
+    g_DeviceStates.buzzer_active = true;
+    BSP_Buzzer_On();
+    Latency_Actuated();         /* before the log line, which blocks on USART2 */
+    SoftTimer_Start(&buzzerTimer, p->on_ms, 0);
+    UART_Printf("[DEVICE] Buzzer: %s\r\n", p->name);
 }
@@ -11,10 +11,112 @@
 #include "bsp_i2c_oled.h"
 #include "bsp_delay.h"
 #include "bsp_uart2_debug.h"
+#include "scheduler.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
 
+/* ===== REFRESH TASK STATE ===== */
+static TaskId_t lcdTaskId = SCHED_INVALID_ID;
+static TaskId_t oledTaskId = SCHED_INVALID_ID;
+static bool lcdClearPending = false;
+static bool msgHoldActive = false;      // a print_Log/alert message owns the screens
+static bool oledClaimed = false;        // an animation draws on the OLED itself
+static uint32_t msgHoldStart = 0;
+
+static void Display_HoldMessage(void)
+{
+    msgHoldActive = true;
+    msgHoldStart = GetSystemTick();
+}
+
+static bool Display_MessageHeld(void)
+{
+    if (msgHoldActive && CheckTimeout(msgHoldStart, DISPLAY_MSG_HOLD_MS)) {
+        msgHoldActive = false;
+    }
+    return msgHoldActive;
+}
+
+/**
+* @brief Register the periodic LCD and OLED refresh tasks
+*/
+void Display_Init(void)
+{
+    lcdTaskId = Scheduler_AddTask("lcd", Display_LCDTask, LCD_UPDATE_INTERVAL);
+    oledTaskId = Scheduler_AddTask("oled", Display_OLEDTask, OLED_UPDATE_INTERVAL);
+
+    // From here on OLED frames go out by DMA, driven from the I2C1 interrupt,
+    // and LCD bytes through the queue of the LCD_TIMER interrupt
+    BSP_OLED_SetAsync(true);
+    BSP_LCD_SetAsync(true);
+}
+
+/**
+* @brief Print the OLED flush statistics over USART2
+*/
+void Display_PrintOLEDStats(void)
+{
+    const OledFlushStats_t *fs = BSP_OLED_GetFlushStats();
+    const OledBusStats_t *bs = BSP_OLED_GetBusStats();
+
+    UART_Printf("[OLED] frames %u/%u done, %u in flight, %u coalesced, %u errors\r\n",
+                (unsigned)fs->completed, (unsigned)fs->started, (unsigned)BSP_OLED_FramesInFlight(),
+                (unsigned)fs->coalesced, (unsigned)fs->errors);
+    UART_Printf("[OLED] flush last %u us, max %u us; bus %u updates, %u windows, %u bytes\r\n",
+                (unsigned)fs->lastUs, (unsigned)fs->maxUs, (unsigned)bs->updates,
+                (unsigned)bs->windows, (unsigned)bs->bytes);
+}
+
+/**
+* @brief Ask for a full redraw of both displays on the next dispatch pass
+* @note  Call after a state change or a user visible value change.
+*/
+void Display_RequestRefresh(void)
+{
+    lcdClearPending = true;
+    Scheduler_TriggerTask(lcdTaskId);
+    Scheduler_TriggerTask(oledTaskId);
+}
+
+/**
+* @brief Hand the OLED to another drawer (boot animation) or take it back
+* @note  While claimed, the OLED task leaves the screen alone.
+*/
+void Display_ClaimOLED(bool claimed)
+{
+    oledClaimed = claimed;
+    if (!claimed) Display_RequestRefresh();
+}
+
+/**
+* @brief Scheduler task: redraw the LCD for the current state
+*/
+void Display_LCDTask(void)
+{
+    if (Display_MessageHeld()) return;
+
+    if (lcdClearPending) {
+        lcdClearPending = false;
+        BSP_LCD_ClearView();    // the flush decides whether a clear pays off
+    }
+    Display_UpdateLCD();
+}
+
+/**
+* @brief Scheduler task: redraw (or, while a message is held, flush) the OLED
+*/
+void Display_OLEDTask(void)
+{
+    if (oledClaimed) return;
+
+    if (Display_MessageHeld()) {
+        BSP_OLED_Update();
+        return;
+    }
+    Display_UpdateOLED();
+}
+
 /**
 * @brief Update OLED display based on current state
 */
@@ -34,14 +136,15 @@ void Display_UpdateLCD(void)
 
    switch (g_SystemContext.currentState) {
        case STATE_STANDBY:
-           BSP_LCD_SetCursor(0, 0);
-           BSP_LCD_PrintString(" System Ready   ");
-           BSP_LCD_SetCursor(1, 0);
-           BSP_LCD_PrintString(" Press Any Key  ");
+           BSP_LCD_SetLine(0, "  Standby Mode  ");
+           BSP_LCD_SetLine(1, " Press Any Key  ");
            break;
 
        case STATE_AUTHENTICATING:
-           // Handled by Auth_ProcessKeyPress
+           snprintf(line2, 25, "%.*s%*s", g_SystemContext.pinIndex, "****",
+                    16 - g_SystemContext.pinIndex, "");
+           BSP_LCD_SetLine(0, "ENTER PIN:      ");
+           BSP_LCD_SetLine(1, line2);
            break;
 
        case STATE_ACTIVE_MENU:
@@ -57,29 +160,26 @@ void Display_UpdateLCD(void)
            break;
 
        case STATE_SETTINGS:
-           BSP_LCD_SetCursor(0, 0);
-           BSP_LCD_PrintString("   Settings     ");
-           BSP_LCD_SetCursor(1, 0);
-           BSP_LCD_PrintString(" *=Back #=Logout");
+           BSP_LCD_SetLine(0, "   Settings     ");
+           BSP_LCD_SetLine(1, " *=Back #=Logout");
            break;
 
        case STATE_LOCKOUT:
            uint32_t remainingTime = (g_SystemContext.lockoutEndTime - GetSystemTick()) / 1000;
            snprintf(line1, 20, "  LOCKED OUT!   ");
            snprintf(line2, 25, "   Wait: %2lus   ", remainingTime);
-           BSP_LCD_SetCursor(0, 0);
-           BSP_LCD_PrintString(line1);
-           BSP_LCD_SetCursor(1, 0);
-           BSP_LCD_PrintString(line2);
+           BSP_LCD_SetLine(0, line1);
+           BSP_LCD_SetLine(1, line2);
            break;
 
        default:
-           BSP_LCD_SetCursor(0, 0);
-           BSP_LCD_PrintString("  Unknown State ");
-           BSP_LCD_SetCursor(1, 0);
-           BSP_LCD_PrintString("                ");
+           BSP_LCD_SetLine(0, "  Unknown State ");
+           BSP_LCD_SetLine(1, "");
            break;
    }
+
+   // Only the characters that changed go to the LCD
+   BSP_LCD_Flush();
 }
 
 /**
@@ -88,7 +188,8 @@ void Display_UpdateLCD(void)
 void Display_ClearAll(void)
 {
    // Clear LCD
-   BSP_LCD_SendCommand(LCD_CMD_CLEAR);
+   BSP_LCD_ClearView();
+   BSP_LCD_Flush();
 
    // Clear OLED
    BSP_OLED_Clear();
@@ -96,15 +197,13 @@ void Display_ClearAll(void)
 }
 
 /**
- * @brief Helper function to clear LCD and print two lines
+ * @brief Helper function to show two lines on the LCD (the rest blanked)
  */
 void update_lcd_display(const char *line1, const char *line2) {
-    BSP_LCD_SendCommand(LCD_CMD_CLEAR);
-    BSP_Delay_ms(2); // Wait for clear to finish
-    BSP_LCD_SetCursor(0, 0);
-    BSP_LCD_PrintString((char*)line1);
-    BSP_LCD_SetCursor(1, 0);
-    BSP_LCD_PrintString((char*)line2);
+    Display_HoldMessage();  // keep it visible over the periodic refresh
+    BSP_LCD_SetLine(0, line1);
+    BSP_LCD_SetLine(1, line2);
+    BSP_LCD_Flush();
 }
 
 /**
@@ -123,13 +222,18 @@ void print_Log(const char *format, ...) {
     UART_Printf("[DEBUG] %s\r\n", buffer);
 
     // 3. Output to LCD (Row 0)
-    BSP_LCD_SetCursor(0, 0);
-    BSP_LCD_PrintString("                "); // Manual clear line
-    BSP_LCD_SetCursor(0, 0);
-    BSP_LCD_PrintString(buffer);
+    BSP_LCD_SetLine(0, buffer);
+    BSP_LCD_Flush();
 
     // 4. Output to OLED (Row 20)
     OLED_Printf(0, 20, "> %-16s", buffer); // Use padding to overwrite old text
-    BSP_OLED_Update();
+
+    // 5. Hold the message; the OLED task flushes it instead of blocking here
+    Display_HoldMessage();
+    if (Scheduler_IsRunning()) {
+        Scheduler_TriggerTask(oledTaskId);
+    } else {
+        BSP_OLED_Update();
+    }
 }
 
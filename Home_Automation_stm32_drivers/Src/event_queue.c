@@ -0,0 +1,155 @@
+/*
+ * event_queue.c
+ *
+ * Created on: Feb 17, 2026
+ * Author: Rahul B.
+ * Description: Lock-free ISR -> main loop event queue
+ */
+
+#include "event_queue.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Orders the slot write before the index publish (and vice versa) */
+#if defined(__arm__)
+#define EVENTQ_BARRIER()    __asm volatile ("dmb" ::: "memory")
+#else
+#define EVENTQ_BARRIER()    __atomic_thread_fence(__ATOMIC_SEQ_CST)    /* host simulation builds */
+#endif
+
+/* ===== PRIVATE VARIABLES ===== */
+static Event_t s_ring[EVENTQ_SIZE];
+static volatile uint32_t s_head = 0;       // next slot to write (producer only)
+static volatile uint32_t s_tail = 0;       // next slot to read  (consumer only)
+static uint16_t s_seq = 0;                 // producer only
+static EventHandler_t s_handlers[EVT_SRC_COUNT];
+static Event_t s_last[EVT_SRC_COUNT];       // newest delivered event per source (consumer only)
+static uint32_t s_delivered[EVT_SRC_COUNT]; // events delivered per source (consumer only)
+static volatile EventQueueStats_t s_stats; // posted/dropped/highWater: producer, dispatched: consumer
+
+/* ===== API ===== */
+
+/**
+ * @brief Empty the ring, clear statistics and subscriptions
+ * @note  Call before any posting interrupt is enabled
+ */
+void EventQueue_Init(void)
+{
+   s_head = 0;
+   s_tail = 0;
+   s_seq = 0;
+   memset(s_handlers, 0, sizeof(s_handlers));
+   memset(s_last, 0, sizeof(s_last));
+   memset(s_delivered, 0, sizeof(s_delivered));
+   memset((void *)&s_stats, 0, sizeof(s_stats));
+}
+
+/**
+ * @brief Route one event source to a handler (NULL to discard its events)
+ */
+void EventQueue_Subscribe(EventSource_t source, EventHandler_t handler)
+{
+   if (source < EVT_SRC_COUNT) {
+       s_handlers[source] = handler;
+   }
+}
+
+/**
+ * @brief Post an event from an interrupt handler
+ * @param tick low 32 bits of now_us() at the edge (now_us32())
+ * @return false if the ring was full and the event was dropped
+ */
+bool EventQueue_Post(EventSource_t source, EventEdge_t edge, uint32_t tick)
+{
+   uint32_t head = s_head;
+   uint32_t level = head - s_tail;
+   uint16_t seq = s_seq++;                  // dropped events still consume a number
+
+   if (level >= EVENTQ_SIZE) {
+       s_stats.dropped++;
+       return false;
+   }
+
+   Event_t *slot = &s_ring[head & EVENTQ_MASK];
+   slot->source = (uint8_t)source;
+   slot->edge = (uint8_t)edge;
+   slot->seq = seq;
+   slot->tick = tick;
+
+   EVENTQ_BARRIER();
+   s_head = head + 1U;
+
+   s_stats.posted++;
+   if (level + 1U > s_stats.highWater) s_stats.highWater = level + 1U;
+   return true;
+}
+
+/**
+ * @brief Take the oldest event out of the ring (thread context only)
+ * @return false if the ring is empty
+ */
+bool EventQueue_Get(Event_t *evt)
+{
+   uint32_t tail = s_tail;
+
+   if (tail == s_head) return false;
+
+   EVENTQ_BARRIER();
+   *evt = s_ring[tail & EVENTQ_MASK];
+   EVENTQ_BARRIER();
+   s_tail = tail + 1U;
+
+   s_stats.dispatched++;
+   return true;
+}
+
+/**
+ * @brief Scheduler task: deliver queued events to their subscribers
+ * @note  At most one ring's worth per pass, so a flood cannot starve
+ *        the other tasks. Every delivered event is also latched per
+ *        source for pollers (PT_AWAIT_EVENT), subscribed or not.
+ */
+void EventQueue_Dispatch(void)
+{
+   Event_t evt;
+
+   for (uint32_t n = 0; (n < EVENTQ_SIZE) && EventQueue_Get(&evt); n++) {
+       if (evt.source >= EVT_SRC_COUNT) continue;
+
+       s_last[evt.source] = evt;
+       s_delivered[evt.source]++;
+       if (s_handlers[evt.source] != NULL) {
+           s_handlers[evt.source](&evt);
+       }
+   }
+}
+
+/**
+ * @brief Number of events of one source delivered so far
+ * @note  Pollers compare it against an earlier snapshot to see new events.
+ */
+uint32_t EventQueue_Delivered(EventSource_t source)
+{
+   return (source < EVT_SRC_COUNT) ? s_delivered[source] : 0U;
+}
+
+/**
+ * @brief Copy the newest delivered event of one source
+ * @return false if that source has not delivered anything yet
+ */
+bool EventQueue_Last(EventSource_t source, Event_t *evt)
+{
+   if ((source >= EVT_SRC_COUNT) || (s_delivered[source] == 0U)) return false;
+   *evt = s_last[source];
+   return true;
+}
+
+uint32_t EventQueue_Count(void)
+{
+   return s_head - s_tail;
+}
+
+const EventQueueStats_t *EventQueue_GetStats(void)
+{
+   return (const EventQueueStats_t *)&s_stats;
+}
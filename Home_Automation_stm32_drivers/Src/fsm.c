@@ -0,0 +1,326 @@
+/*
+ * fsm.c
+ *
+ * Created on: Feb 18, 2026
+ * Author: Rahul B.
+ * Description: Generic table-driven finite state machine engine
+ */
+
+#include "fsm.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ===== PRIVATE HELPERS ===== */
+
+/* Run one hook; 'state' owns it (FSM_NO_STATE for a transition action) */
+static void Fsm_Call(Fsm_t *fsm, FsmStateId_t state, FsmAction_t hook)
+{
+   if (hook == NULL) return;
+
+   if (fsm->probe != NULL) fsm->probe(fsm, state, true);
+   hook(fsm);
+   if (fsm->probe != NULL) fsm->probe(fsm, state, false);
+}
+
+static const FsmState_t *Fsm_State(const Fsm_t *fsm, FsmStateId_t id)
+{
+   return (id < fsm->numStates) ? &fsm->states[id] : NULL;
+}
+
+static FsmStateId_t Fsm_Parent(const Fsm_t *fsm, FsmStateId_t id)
+{
+   return ((fsm->parent != NULL) && (id < fsm->numStates)) ? fsm->parent[id] : FSM_NO_STATE;
+}
+
+/* true if outer is id itself or one of its ancestors (FSM_NO_STATE = root) */
+static bool Fsm_Contains(const Fsm_t *fsm, FsmStateId_t outer, FsmStateId_t id)
+{
+   for (; id != FSM_NO_STATE; id = Fsm_Parent(fsm, id)) {
+       if (id == outer) return true;
+   }
+   return outer == FSM_NO_STATE;
+}
+
+static void Fsm_Record(Fsm_t *fsm, FsmStateId_t from, FsmStateId_t to, FsmEventId_t event)
+{
+   FsmTraceEntry_t *step = &fsm->trace[fsm->traceNext];
+
+   step->from = from;
+   step->to = to;
+   step->event = event;
+   step->tick = (fsm->clock != NULL) ? fsm->clock() : 0U;
+
+   fsm->traceNext = (uint8_t)((fsm->traceNext + 1U) % FSM_TRACE_DEPTH);
+   fsm->transitionCount++;
+
+   if (fsm->observer != NULL) fsm->observer(fsm, step);
+}
+
+/**
+ * @brief Run entry hooks from just below 'top' down to 'id', outermost first
+ */
+static void Fsm_EnterPath(Fsm_t *fsm, FsmStateId_t top, FsmStateId_t id)
+{
+   FsmStateId_t path[FSM_MAX_STATES];
+   uint8_t depth = 0;
+
+   for (; (id != top) && (id != FSM_NO_STATE) && (depth < FSM_MAX_STATES); id = Fsm_Parent(fsm, id)) {
+       path[depth++] = id;
+   }
+   while (depth-- > 0U) {
+       const FsmState_t *state = Fsm_State(fsm, path[depth]);
+       if (state != NULL) Fsm_Call(fsm, path[depth], state->entry);
+   }
+}
+
+/**
+ * @brief Take an external transition from the row of 'source' to 'target'
+ * @note  Exits innermost-first up to the least common ancestor, runs the
+ *        action, enters down to the target, then drills into composite
+ *        targets (history or initial child) until a leaf is reached.
+ */
+static void Fsm_Enter(Fsm_t *fsm, FsmStateId_t source, FsmStateId_t target, FsmAction_t action)
+{
+   bool useHistory = (target & FSM_HISTORY_FLAG) != 0U;
+   target = (FsmStateId_t)(target & ~FSM_HISTORY_FLAG);
+
+   // Least common proper ancestor: a self transition leaves and re-enters.
+   // A row targeting a substate of its own state is local: source stays.
+   FsmStateId_t lca = Fsm_Parent(fsm, source);
+   if ((target != source) && (source != FSM_NO_STATE) && Fsm_Contains(fsm, source, target)) {
+       lca = source;
+   }
+   while ((lca != FSM_NO_STATE) && (!Fsm_Contains(fsm, lca, target) || (lca == target))) {
+       lca = Fsm_Parent(fsm, lca);
+   }
+
+   for (FsmStateId_t id = fsm->current; (id != lca) && (id != FSM_NO_STATE); id = Fsm_Parent(fsm, id)) {
+       const FsmState_t *state = Fsm_State(fsm, id);
+       FsmStateId_t up = Fsm_Parent(fsm, id);
+
+       if (state != NULL) Fsm_Call(fsm, id, state->exit);
+       if (up != FSM_NO_STATE) fsm->history[up] = id;
+   }
+
+   Fsm_Call(fsm, FSM_NO_STATE, action);
+
+   // Resolve the leaf before entering so the observer sees the final state
+   FsmStateId_t leaf = target;
+   for (bool first = true; (fsm->initial != NULL) && (leaf < fsm->numStates) &&
+                           (fsm->initial[leaf] != FSM_NO_STATE); first = false) {
+       FsmStateId_t child = fsm->initial[leaf];
+       if (first && useHistory && (fsm->history[leaf] != FSM_NO_STATE)) {
+           child = fsm->history[leaf];
+       }
+       leaf = child;
+   }
+
+   fsm->previous = fsm->current;
+   fsm->current = leaf;
+   Fsm_Record(fsm, fsm->previous, leaf, fsm->event);
+
+   Fsm_EnterPath(fsm, lca, leaf);
+}
+
+/**
+ * @brief Handle one event against the transition table
+ * @note  Rows of the leaf are tried first, then those of each ancestor,
+ *        then FSM_ANY_STATE rows.
+ * @return true if a row accepted it
+ */
+static bool Fsm_Step(Fsm_t *fsm, FsmEventId_t event)
+{
+   fsm->event = event;
+
+   FsmStateId_t level = fsm->current;
+   for (;;) {
+       for (uint8_t i = 0; i < fsm->numTransitions; i++) {
+           const FsmTransition_t *t = &fsm->transitions[i];
+
+           if ((t->event != event) || (t->from != level)) continue;
+           if ((t->guard != NULL) && !t->guard(fsm)) continue;
+
+           if (t->to == FSM_INTERNAL) {
+               Fsm_Call(fsm, FSM_NO_STATE, t->action);
+           } else {
+               Fsm_Enter(fsm, (level == FSM_ANY_STATE) ? fsm->current : level, t->to, t->action);
+           }
+           return true;
+       }
+
+       if (level == FSM_ANY_STATE) break;
+       level = Fsm_Parent(fsm, level);
+       if (level == FSM_NO_STATE) level = FSM_ANY_STATE;
+   }
+
+   fsm->unhandledCount++;
+   return false;
+}
+
+/**
+ * @brief Handle everything hooks queued during the last step
+ */
+static void Fsm_Drain(Fsm_t *fsm)
+{
+   while (fsm->queueCount != 0U) {
+       FsmEventId_t event = fsm->queue[fsm->queueHead];
+       fsm->queueHead = (uint8_t)((fsm->queueHead + 1U) % FSM_EVENT_QUEUE_DEPTH);
+       fsm->queueCount--;
+       (void)Fsm_Step(fsm, event);
+   }
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Bind the tables; the machine stays stopped until Fsm_Start()
+ * @param clock   timestamp source for the trace (NULL = no timestamps)
+ * @param context user data, returned by Fsm_GetContext()
+ */
+void Fsm_Init(Fsm_t *fsm,
+              const FsmState_t *states, uint8_t numStates,
+              const FsmTransition_t *transitions, uint8_t numTransitions,
+              uint32_t (*clock)(void), void *context)
+{
+   memset(fsm, 0, sizeof(*fsm));
+   fsm->states = states;
+   fsm->numStates = numStates;
+   fsm->transitions = transitions;
+   fsm->numTransitions = numTransitions;
+   fsm->current = FSM_NO_STATE;
+   fsm->previous = FSM_NO_STATE;
+   fsm->clock = clock;
+   fsm->context = context;
+   memset(fsm->history, FSM_NO_STATE, sizeof(fsm->history));
+}
+
+/**
+ * @brief Called after every transition (and the initial entry), before entry()
+ */
+void Fsm_SetObserver(Fsm_t *fsm, FsmObserver_t observer)
+{
+   fsm->observer = observer;
+}
+
+/**
+ * @brief Called before (begin = true) and after every hook and action,
+ *        e.g. to time them. NULL to remove.
+ */
+void Fsm_SetProbe(Fsm_t *fsm, FsmProbe_t probe)
+{
+   fsm->probe = probe;
+}
+
+/**
+ * @brief Make the machine hierarchical
+ * @param parent  parent[id] for every state, FSM_NO_STATE at the top level
+ * @param initial initial[id] for every state, FSM_NO_STATE for leaves
+ * @note  Both arrays must have numStates entries and outlive the machine.
+ */
+void Fsm_SetHierarchy(Fsm_t *fsm, const FsmStateId_t *parent, const FsmStateId_t *initial)
+{
+   fsm->parent = parent;
+   fsm->initial = initial;
+}
+
+/**
+ * @brief Enter the initial state (runs its entry hooks, outermost first)
+ */
+void Fsm_Start(Fsm_t *fsm, FsmStateId_t initial)
+{
+   fsm->busy = true;
+   fsm->event = 0;
+   Fsm_Enter(fsm, FSM_NO_STATE, initial, NULL);
+   Fsm_Drain(fsm);
+   fsm->busy = false;
+}
+
+/**
+ * @brief Feed one event to the machine
+ * @return true if a transition row accepted it. From inside a hook the
+ *         event is only queued: true means queued, false means dropped.
+ */
+bool Fsm_Dispatch(Fsm_t *fsm, FsmEventId_t event)
+{
+   if (fsm->busy) {
+       if (fsm->queueCount >= FSM_EVENT_QUEUE_DEPTH) {
+           fsm->droppedCount++;
+           return false;
+       }
+       fsm->queue[(fsm->queueHead + fsm->queueCount) % FSM_EVENT_QUEUE_DEPTH] = event;
+       fsm->queueCount++;
+       return true;
+   }
+
+   fsm->busy = true;
+   bool handled = Fsm_Step(fsm, event);
+   Fsm_Drain(fsm);
+   fsm->busy = false;
+
+   return handled;
+}
+
+/**
+ * @brief Run the "do" hook of the current state once
+ */
+void Fsm_Run(Fsm_t *fsm)
+{
+   const FsmState_t *state = Fsm_State(fsm, fsm->current);
+
+   if (fsm->busy || state == NULL) return;
+
+   fsm->busy = true;
+   fsm->event = 0;
+   Fsm_Call(fsm, fsm->current, state->run);
+   Fsm_Drain(fsm);
+   fsm->busy = false;
+}
+
+FsmStateId_t Fsm_GetState(const Fsm_t *fsm)
+{
+   return fsm->current;
+}
+
+bool Fsm_IsIn(const Fsm_t *fsm, FsmStateId_t state)
+{
+   return (fsm->current != FSM_NO_STATE) && (state != FSM_NO_STATE) &&
+          Fsm_Contains(fsm, state, fsm->current);
+}
+
+/**
+ * @brief Forget the remembered child: the next FSM_HISTORY() entry uses
+ *        the initial child again
+ */
+void Fsm_ClearHistory(Fsm_t *fsm, FsmStateId_t composite)
+{
+   if (composite < FSM_MAX_STATES) fsm->history[composite] = FSM_NO_STATE;
+}
+
+const char *Fsm_StateName(const Fsm_t *fsm, FsmStateId_t id)
+{
+   const FsmState_t *state = Fsm_State(fsm, id);
+   return ((state != NULL) && (state->name != NULL)) ? state->name : "-";
+}
+
+void *Fsm_GetContext(const Fsm_t *fsm)
+{
+   return fsm->context;
+}
+
+/**
+ * @brief Number of valid trace entries (at most FSM_TRACE_DEPTH)
+ */
+uint8_t Fsm_TraceCount(const Fsm_t *fsm)
+{
+   return (fsm->transitionCount < FSM_TRACE_DEPTH) ? (uint8_t)fsm->transitionCount
+                                                   : (uint8_t)FSM_TRACE_DEPTH;
+}
+
+/**
+ * @brief Trace entry by age: 0 = most recent transition
+ */
+const FsmTraceEntry_t *Fsm_GetTrace(const Fsm_t *fsm, uint8_t age)
+{
+   if (age >= Fsm_TraceCount(fsm)) return NULL;
+   return &fsm->trace[(fsm->traceNext + FSM_TRACE_DEPTH - 1U - age) % FSM_TRACE_DEPTH];
+}
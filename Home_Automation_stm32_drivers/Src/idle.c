@@ -0,0 +1,153 @@
+/*
+ * idle.c
+ *
+ * Created on: Feb 21, 2026
+ * Author: Rahul B.
+ * Description: Tickless idle - sleep between scheduler deadlines
+ */
+
+#include "idle.h"
+#include "scheduler.h"
+#include "event_queue.h"
+#include "bsp_lowpower.h"
+#include "bsp_i2c_oled.h"
+#include "bsp_lcd.h"
+#include "bsp_keypad.h"
+#include "bsp_timebase.h"
+#include "bsp_uart2_debug.h"
+#include "config.h"
+#include <string.h>
+
+/* ===== PRIVATE VARIABLES ===== */
+static IdleStats_t s_stats;
+static bool s_stopAllowed = false;
+
+/* ===== PRIVATE HELPERS ===== */
+
+static inline uint32_t Idle_Mask(void)
+{
+   uint32_t primask;
+   __asm volatile ("mrs %0, primask" : "=r" (primask));
+   __asm volatile ("cpsid i" ::: "memory");
+   return primask;
+}
+
+static inline void Idle_Unmask(uint32_t primask)
+{
+   __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+static void Idle_Account(const LowPowerResult_t *r)
+{
+   s_stats.idleUs += r->sleptUs;
+   s_stats.lastResumeUs = r->resumeUs;
+   if (r->resumeUs > s_stats.maxResumeUs) s_stats.maxResumeUs = r->resumeUs;
+   if (r->early) s_stats.earlyWakes++;
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Bring up the low-power BSP (RTC on LSI, ~20 ms calibration)
+ * @note  Call once the timebase runs. Does not touch the Stop permission,
+ *        which the STANDBY entry hook may already have granted.
+ */
+void Idle_Init(void)
+{
+   BSP_LowPower_Init();
+   Idle_ResetStats();
+
+   UART_Printf("[IDLE] LSI %u Hz, Stop mode %s\r\n", (unsigned)BSP_LowPower_GetLsiHz(),
+               BSP_LowPower_StopAvailable() ? "available" : "unavailable");
+}
+
+/**
+ * @brief Sleep until the next scheduler deadline or an interrupt
+ * @note  The budget is taken with interrupts masked, so an event posted
+ *        after the check still ends the sleep (WFI wakes on pending IRQs).
+ *        The budget is whole ms, so a deadline may be met up to
+ *        IDLE_SLEEP_GUARD_US early or late.
+ * @note  After Stop the clock tree is restored before unmasking, so the
+ *        wake-up ISRs see the PCLK1/TIM2/USART2 rates they were set up
+ *        for. The HSE start and PLL lock count as resume latency.
+ */
+void Idle_Enter(void)
+{
+   uint32_t primask = Idle_Mask();
+
+   if (EventQueue_Count() != 0U) {
+       Idle_Unmask(primask);
+       return;
+   }
+
+   uint32_t budget = Scheduler_MsUntilNextRun();
+   if (budget > LOWPOWER_STOP_MAX_MS) budget = LOWPOWER_STOP_MAX_MS;
+
+   LowPowerResult_t r = {0};
+   bool stopped = false;
+
+   // Stop would freeze I2C1 in the middle of an OLED frame, TIM6 in an LCD
+   // byte, TIM3 in a key
+   if (s_stopAllowed && (budget >= IDLE_STOP_MIN_MS) && BSP_LowPower_StopAvailable() &&
+       (BSP_OLED_FramesInFlight() == 0U) && (BSP_LCD_QueueDepth() == 0U) && !Keypad_IsScanning()) {
+       r = BSP_LowPower_Stop(budget - 1U);
+       stopped = (r.sleptUs != 0U) || r.early;
+       if (stopped) s_stats.stops++;
+   }
+
+   if (!stopped && (budget != 0U)) {
+       r = BSP_LowPower_Sleep(budget * 1000U - IDLE_SLEEP_GUARD_US);
+       s_stats.sleeps++;
+   }
+
+   if (stopped) {
+       uint64_t t0 = now_us();
+       BSP_LowPower_RestoreClocks();
+       r.resumeUs += (uint32_t)(now_us() - t0);
+   }
+
+   if (stopped || (r.sleptUs != 0U)) Idle_Account(&r);
+
+   // Wake-up ISRs run here, on the application's clocks again
+   Idle_Unmask(primask);
+}
+
+/**
+ * @brief Permit Stop mode for long budgets (Sleep is always permitted)
+ */
+void Idle_SetStopAllowed(bool allowed)
+{
+   s_stopAllowed = allowed;
+}
+
+const IdleStats_t *Idle_GetStats(void)
+{
+   return &s_stats;
+}
+
+/**
+ * @brief Share of wall time spent in Sleep or Stop since the last reset
+ */
+uint8_t Idle_GetIdlePercent(void)
+{
+   uint64_t total = now_us() - s_stats.sinceUs;
+   return (total != 0U) ? (uint8_t)((s_stats.idleUs * 100U) / total) : 0U;
+}
+
+void Idle_ResetStats(void)
+{
+   memset(&s_stats, 0, sizeof(s_stats));
+   s_stats.sinceUs = now_us();
+}
+
+/**
+ * @brief Dump idle statistics over USART2
+ */
+void Idle_PrintStats(void)
+{
+   UART_Printf("[IDLE] idle %u%%, sleeps %u, stops %u, early wakes %u\r\n",
+               (unsigned)Idle_GetIdlePercent(), (unsigned)s_stats.sleeps,
+               (unsigned)s_stats.stops, (unsigned)s_stats.earlyWakes);
+   UART_Printf("[IDLE] resume latency last %u us, max %u us\r\n",
+               (unsigned)s_stats.lastResumeUs, (unsigned)s_stats.maxResumeUs);
+}
@@ -0,0 +1,228 @@
+/*
+ * latency.c
+ *
+ * Created on: Feb 23, 2026
+ * Author: Rahul B.
+ * Description: End-to-end intrusion latency (IR edge -> buzzer on)
+ */
+
+#include "latency.h"
+#include "bsp_timebase.h"
+#include "bsp_uart2_debug.h"
+#include "config.h"
+#include <string.h>
+
+/* ===== PRIVATE VARIABLES ===== */
+static const char *const s_sensorNames[LAT_SENSOR_COUNT] = { "IR1", "IR2" };
+static const char *const s_stageNames[LAT_STAGE_COUNT] = { "queue", "decide", "actuate", "total" };
+
+static LatSensorData_t s_sensors[LAT_SENSOR_COUNT];
+static LatTrace_t *s_open = NULL;          // trace between Latency_Begin and Latency_End
+
+/* ===== PRIVATE HELPERS ===== */
+
+static inline uint32_t Latency_Now(void)
+{
+   return (uint32_t)now_us();
+}
+
+/*
+ * Bucket of a duration: values below 2^LAT_SUB_BITS get their own bucket,
+ * above that each octave is split by the LAT_SUB_BITS bits under the MSB.
+ */
+static uint32_t Latency_Bucket(uint32_t us)
+{
+   if (us < (1UL << LAT_SUB_BITS)) return us;
+
+   uint32_t msb = 31U - (uint32_t)__builtin_clz(us);
+   uint32_t sub = (us >> (msb - LAT_SUB_BITS)) & ((1UL << LAT_SUB_BITS) - 1U);
+   uint32_t b = ((msb - LAT_SUB_BITS + 1U) << LAT_SUB_BITS) | sub;
+
+   return (b < LAT_BUCKETS) ? b : (LAT_BUCKETS - 1U);
+}
+
+/* Largest duration that still falls into bucket b */
+static uint32_t Latency_BucketTop(uint32_t b)
+{
+   if (b < (1UL << LAT_SUB_BITS)) return b;
+
+   uint32_t shift = (b >> LAT_SUB_BITS) - 1U;
+   uint32_t lo = ((1UL << LAT_SUB_BITS) | (b & ((1UL << LAT_SUB_BITS) - 1U))) << shift;
+
+   return lo + (1UL << shift) - 1U;
+}
+
+/* Upper bound of the pct-th percentile, clamped to the largest sample */
+static uint32_t Latency_Percentile(const LatStageData_t *d, uint32_t pct)
+{
+   uint32_t rank = d->count - ((d->count * (100U - pct)) / 100U);
+   uint32_t seen = 0;
+
+   for (uint32_t b = 0; b < (LAT_BUCKETS - 1U); b++) {
+       seen += d->hist[b];
+       if (seen >= rank) {
+           uint32_t top = Latency_BucketTop(b);
+           return (top < d->maxUs) ? top : d->maxUs;
+       }
+   }
+   return d->maxUs;
+}
+
+static void Latency_Add(LatStageData_t *d, uint32_t us)
+{
+   d->count++;
+   d->sumUs += us;
+   if (us < d->minUs) d->minUs = us;
+   if (us > d->maxUs) d->maxUs = us;
+   d->hist[Latency_Bucket(us)]++;
+}
+
+static LatSensor_t Latency_SensorOf(uint8_t source)
+{
+   switch (source) {
+   case EVT_SRC_IR1: return LAT_SENSOR_IR1;
+   case EVT_SRC_IR2: return LAT_SENSOR_IR2;
+   default:          return LAT_SENSOR_NONE;
+   }
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Clear every record
+ */
+void Latency_Init(void)
+{
+   s_open = NULL;
+   Latency_Reset();
+}
+
+/**
+ * @brief Clear the samples, worst cases and budget counters
+ */
+void Latency_Reset(void)
+{
+   memset(s_sensors, 0, sizeof(s_sensors));
+   for (uint8_t s = 0; s < LAT_SENSOR_COUNT; s++) {
+       for (uint8_t st = 0; st < LAT_STAGE_COUNT; st++) {
+           s_sensors[s].stage[st].minUs = UINT32_MAX;
+       }
+   }
+}
+
+/**
+ * @brief Open a trace for a dequeued event: stamps the dequeue time
+ * @note  Events of other sources get LAT_SENSOR_NONE and are not recorded.
+ */
+void Latency_Begin(LatTrace_t *trace, const Event_t *evt)
+{
+   uint32_t now = Latency_Now();
+
+   memset(trace, 0, sizeof(*trace));
+   trace->sensor = (uint8_t)Latency_SensorOf(evt->source);
+   trace->seq = evt->seq;
+   trace->edgeUs = evt->tick;
+   trace->dequeueUs = now;
+   s_open = trace;
+}
+
+/**
+ * @brief The handler has decided whether to alert
+ */
+void Latency_Decided(LatTrace_t *trace)
+{
+   trace->decisionUs = Latency_Now();
+   trace->decided = true;
+}
+
+/**
+ * @brief Stamp the actuator write of the open trace, if any
+ * @note  Called right after the buzzer pin goes high; only the first
+ *        write between Latency_Begin and Latency_End counts.
+ */
+void Latency_Actuated(void)
+{
+   if ((s_open == NULL) || s_open->actuated) return;
+
+   s_open->actuatorUs = Latency_Now();
+   s_open->actuated = true;
+}
+
+/**
+ * @brief Close a trace and add its intervals to the record of its sensor
+ */
+void Latency_End(LatTrace_t *trace)
+{
+   if (s_open == trace) s_open = NULL;
+   if (trace->sensor >= LAT_SENSOR_COUNT) return;
+
+   LatSensorData_t *s = &s_sensors[trace->sensor];
+
+   Latency_Add(&s->stage[LAT_STAGE_QUEUE], trace->dequeueUs - trace->edgeUs);
+   if (!trace->decided) return;
+   Latency_Add(&s->stage[LAT_STAGE_DECIDE], trace->decisionUs - trace->dequeueUs);
+   if (!trace->actuated) return;
+   Latency_Add(&s->stage[LAT_STAGE_ACTUATE], trace->actuatorUs - trace->decisionUs);
+
+   uint32_t total = trace->actuatorUs - trace->edgeUs;
+   if (total >= s->stage[LAT_STAGE_TOTAL].maxUs) s->worst = *trace;
+   Latency_Add(&s->stage[LAT_STAGE_TOTAL], total);
+   if (total > INTRUSION_LATENCY_BUDGET_US) s->overBudget++;
+}
+
+/**
+ * @brief Summarise one stage of one sensor
+ * @return false for an unknown sensor/stage or one without samples
+ */
+bool Latency_GetStats(LatSensor_t sensor, LatStage_t stage, LatStats_t *stats)
+{
+   memset(stats, 0, sizeof(*stats));
+   if ((sensor >= LAT_SENSOR_COUNT) || (stage >= LAT_STAGE_COUNT)) return false;
+
+   const LatStageData_t *d = &s_sensors[sensor].stage[stage];
+   if (d->count == 0U) return false;
+
+   stats->count = d->count;
+   stats->minUs = d->minUs;
+   stats->meanUs = (uint32_t)(d->sumUs / d->count);
+   stats->p50Us = Latency_Percentile(d, 50U);
+   stats->p99Us = Latency_Percentile(d, 99U);
+   stats->maxUs = d->maxUs;
+
+   return true;
+}
+
+const LatSensorData_t *Latency_GetSensor(LatSensor_t sensor)
+{
+   return (sensor < LAT_SENSOR_COUNT) ? &s_sensors[sensor] : NULL;
+}
+
+/**
+ * @brief Print every stage with samples, the worst case and the budget
+ *        misses of each sensor over USART2
+ */
+void Latency_Dump(void)
+{
+   LatStats_t st;
+
+   UART_Printf("[LAT] %-11s %8s %8s %8s %8s %8s %8s\r\n",
+               "us", "count", "min", "mean", "p50", "p99", "max");
+   for (uint8_t s = 0; s < LAT_SENSOR_COUNT; s++) {
+       for (uint8_t stage = 0; stage < LAT_STAGE_COUNT; stage++) {
+           if (!Latency_GetStats((LatSensor_t)s, (LatStage_t)stage, &st)) continue;
+           UART_Printf("[LAT] %s %-7s %8u %8u %8u %8u %8u %8u\r\n", s_sensorNames[s], s_stageNames[stage],
+                       (unsigned)st.count, (unsigned)st.minUs, (unsigned)st.meanUs,
+                       (unsigned)st.p50Us, (unsigned)st.p99Us, (unsigned)st.maxUs);
+       }
+
+       const LatSensorData_t *d = &s_sensors[s];
+       if (d->stage[LAT_STAGE_TOTAL].count == 0U) continue;
+
+       const LatTrace_t *w = &d->worst;
+       UART_Printf("[LAT] %s worst: seq %u, queue %u + decide %u + actuate %u = %u us, %u over %u us budget\r\n",
+                   s_sensorNames[s], (unsigned)w->seq, (unsigned)(w->dequeueUs - w->edgeUs),
+                   (unsigned)(w->decisionUs - w->dequeueUs), (unsigned)(w->actuatorUs - w->decisionUs),
+                   (unsigned)(w->actuatorUs - w->edgeUs), (unsigned)d->overBudget,
+                   (unsigned)INTRUSION_LATENCY_BUDGET_US);
+   }
+}
@@ -9,68 +9,44 @@
 
 #include "main.h"
 #include "state_machine.h"
+#include "scheduler.h"
+#include "idle.h"
 #include "bsp_uart2_debug.h"
 #include "bsp_delay.h"
 #include <stdbool.h>
 #include <stdint.h>
 
-/* ===== Global Variables ===== */
-
-volatile uint8_t g_wakeup_flag = 0;
-volatile bool pc13_event = false;
-volatile bool pc8_intrusion_event = false;
-volatile bool pc6_intrusion_event = false;
-volatile uint32_t pc13_event_time = 0;
-
 /* ================= MAIN APPLICATION ================= */
 int main(void) {
 
     StateMachine_Init();
 
-    // Peripheral Self-Test
-    uint8_t test_result = System_SelfTest();
-    if (test_result != 0) {
-        UART_Printf(">> [WARNING] System test had errors (0x%X)\r\n", test_result);
-        UART_Printf(">> [INFO] Continuing anyway...\r\n");
-        Device_PlayBuzzer(BEEP_WARNING);
-    } else {
-        Device_PlayBuzzer(BEEP_SUCCESS);
-        UART_Printf(">> [SUCCESS] All tests passed!\r\n");
-    }
+    // Peripheral Self-Test, runs alongside the other tasks and reports when done
+    SelfTest_Start();
+
+    // Tickless idle: WFI / Stop mode whenever no task is due
+    Idle_Init();
 
     UART_Printf(">> [SYSTEM] Entering main loop .\r\n");
     while(1) {
-        StateMachine_Run();
+        Scheduler_Dispatch();   // timers, events, FSM, sensors, displays
+        Idle_Enter();           // sleep until the next deadline or interrupt
     }
 }
 
-/* Interrupt Handler for Button */
-void EXTI15_10_IRQHandler(void) {
-    if(EXTI->PR & (1 << 13)) {
-        EXTI->PR |= (1 << 13); // Clear pending bit
-        g_wakeup_flag = 1;
-    }
-}
-
-/**
- * @brief EXTI ISR for PC6 and PC8 (Intrusion Sensors)
- * EXTI lines 5–9 share this handler
+/* ===== Interrupt Handlers =====
+ * The EXTI vectors only hand their pending lines to the GPIO driver's EXTI
+ * service, which clears them and calls the callback attached to each line
+ * (see StateMachine_Init). A new sensor attaches a callback; nothing here
+ * changes.
  */
-void EXTI9_5_IRQHandler(void)
-{
-    /* PC6 - IR Sensor 1 */
-    if (EXTI->PR & (1 << 6))
-    {
-        UART_Printf("[ISR] PC6 IR Sensor triggered!\r\n");
-        EXTI->PR |= (1 << 6);     // Clear pending bit
-        pc6_intrusion_event = true;
-    }
 
-    /* PC8 - IR Sensor 2 */
-    if (EXTI->PR & (1 << 8))
-    {
-        UART_Printf("[ISR] PC8 triggered!\r\n");
-        EXTI->PR |= (1 << 8);     // Clear pending bit
-        pc8_intrusion_event = true;
-    }
-}
+void EXTI0_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(0)); }
+void EXTI1_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(1)); }
+void EXTI2_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(2)); }
+void EXTI3_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(3)); }
+void EXTI4_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINE(4)); }
+
+/* Lines 5-9 and 10-15 share a vector each */
+void EXTI9_5_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_9_5); }
+void EXTI15_10_IRQHandler(void) { GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_15_10); }
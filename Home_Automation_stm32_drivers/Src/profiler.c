@@ -0,0 +1,268 @@
+/*
+ * profiler.c
+ *
+ * Created on: Feb 22, 2026
+ * Author: Rahul B.
+ * Description: Cycle-accurate zone profiler (DWT CYCCNT) with histograms
+ */
+
+#include "profiler.h"
+#include "bsp_uart2_debug.h"
+#include <string.h>
+
+#if defined(__arm__)
+#include "stm32f446xx.h"
+#include "stm32f446xx_rcc_driver.h"
+#else
+#include <time.h>
+#endif
+
+/* ===== PRIVATE VARIABLES ===== */
+#define PROF_ZONE_NAME(id, name)    name,
+
+static const char *const s_builtinNames[PROF_ZONE_BUILTIN_COUNT] = {
+   PROF_ZONE_LIST(PROF_ZONE_NAME)
+};
+
+static ProfZoneData_t s_zones[PROF_MAX_ZONES];
+static uint8_t s_zoneCount = 0;
+static volatile bool s_running = false;
+
+/* ===== PRIVATE HELPERS ===== */
+
+#if defined(__arm__)
+static inline uint32_t Prof_Lock(void)
+{
+   uint32_t primask;
+   __asm volatile ("mrs %0, primask" : "=r" (primask));
+   __asm volatile ("cpsid i" ::: "memory");
+   return primask;
+}
+
+static inline void Prof_Unlock(uint32_t primask)
+{
+   __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+#else
+static inline uint32_t Prof_Lock(void) { return 0U; }
+static inline void Prof_Unlock(uint32_t primask) { (void)primask; }
+#endif
+
+static void Prof_ClearZone(ProfZoneData_t *z)
+{
+   const char *name = z->name;
+
+   memset(z, 0, sizeof(*z));
+   z->name = name;
+   z->minTicks = UINT32_MAX;
+}
+
+/* Log2 bucket: CLZ is a single instruction on the Cortex-M4 */
+static inline uint32_t Prof_Bucket(uint32_t ticks)
+{
+   if (ticks < (1UL << (PROF_BUCKET_SHIFT + 1U))) return 0U;
+
+   uint32_t b = (31U - (uint32_t)__builtin_clz(ticks)) - PROF_BUCKET_SHIFT;
+   return (b < PROF_BUCKETS) ? b : (PROF_BUCKETS - 1U);
+}
+
+static uint32_t Prof_ToUs(uint64_t ticks)
+{
+   return (uint32_t)(ticks / Prof_TicksPerUs());
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Start the time source and register the built-in zones
+ * @note  Call before the first instrumented function runs; samples taken
+ *        earlier are ignored.
+ */
+void Prof_Init(void)
+{
+#if defined(__arm__)
+   *COREDEBUG_DEMCR |= (1UL << COREDEBUG_DEMCR_TRCENA);
+   DWT->CYCCNT = 0;
+   DWT->CTRL |= (1UL << DWT_CTRL_CYCCNTENA);
+#endif
+
+   memset(s_zones, 0, sizeof(s_zones));
+   for (s_zoneCount = 0; s_zoneCount < PROF_ZONE_BUILTIN_COUNT; s_zoneCount++) {
+       s_zones[s_zoneCount].name = s_builtinNames[s_zoneCount];
+       Prof_ClearZone(&s_zones[s_zoneCount]);
+   }
+   s_running = true;
+}
+
+/**
+ * @brief Register a zone at run time (thread context)
+ * @return its id, PROF_INVALID_ZONE if the table is full
+ */
+ProfZone_t Prof_AddZone(const char *name)
+{
+   if (s_zoneCount >= PROF_MAX_ZONES) return PROF_INVALID_ZONE;
+
+   ProfZoneData_t *z = &s_zones[s_zoneCount];
+   z->name = name;
+   Prof_ClearZone(z);
+   return s_zoneCount++;
+}
+
+/**
+ * @brief Clear the samples of every zone (names are kept)
+ */
+void Prof_Reset(void)
+{
+   for (uint8_t i = 0; i < s_zoneCount; i++) {
+       uint32_t primask = Prof_Lock();
+       Prof_ClearZone(&s_zones[i]);
+       Prof_Unlock(primask);
+   }
+}
+
+/**
+ * @brief Raw time-source ticks: HCLK cycles on the target, ns on a host
+ */
+uint32_t Prof_Now(void)
+{
+#if defined(__arm__)
+   return DWT->CYCCNT;
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+uint32_t Prof_TicksPerUs(void)
+{
+#if defined(__arm__)
+   uint32_t mhz = RCC_GetHCLKFreq() / 1000000U;
+   return (mhz != 0U) ? mhz : 1U;
+#else
+   return 1000U;
+#endif
+}
+
+/**
+ * @brief Add one sample to a zone (safe from thread and interrupt context)
+ */
+void Prof_Record(ProfZone_t zone, uint32_t ticks)
+{
+   if (!s_running || (zone >= s_zoneCount)) return;
+
+   ProfZoneData_t *z = &s_zones[zone];
+   uint32_t bucket = Prof_Bucket(ticks);
+   uint32_t primask = Prof_Lock();
+
+   z->count++;
+   z->sumTicks += ticks;
+   if (ticks < z->minTicks) z->minTicks = ticks;
+   if (ticks > z->maxTicks) z->maxTicks = ticks;
+   z->hist[bucket]++;
+
+   Prof_Unlock(primask);
+}
+
+const ProfZoneData_t *Prof_GetZone(ProfZone_t zone)
+{
+   return (zone < s_zoneCount) ? &s_zones[zone] : NULL;
+}
+
+/* Snapshot a zone under the lock, so an ISR cannot tear it */
+static void Prof_Snapshot(ProfZone_t zone, ProfZoneData_t *z)
+{
+   uint32_t primask = Prof_Lock();
+   *z = s_zones[zone];
+   Prof_Unlock(primask);
+}
+
+/**
+ * @brief Upper edge (ticks) of the bucket that holds the 99th percentile
+ */
+static uint32_t Prof_P99Ticks(const ProfZoneData_t *z)
+{
+   uint32_t rank = z->count - (z->count / 100U);
+   uint32_t seen = 0;
+
+   for (uint32_t b = 0; b < (PROF_BUCKETS - 1U); b++) {
+       seen += z->hist[b];
+       if (seen >= rank) {
+           uint32_t top = (1UL << (b + PROF_BUCKET_SHIFT + 1U)) - 1U;
+           return (top < z->maxTicks) ? top : z->maxTicks;
+       }
+   }
+   return z->maxTicks;
+}
+
+/**
+ * @brief Summarise a zone in microseconds
+ * @return false for an unknown zone or one without samples
+ */
+bool Prof_GetStats(ProfZone_t zone, ProfStats_t *stats)
+{
+   ProfZoneData_t z;
+
+   memset(stats, 0, sizeof(*stats));
+   if (zone >= s_zoneCount) return false;
+
+   Prof_Snapshot(zone, &z);
+   if (z.count == 0U) return false;
+
+   stats->count = z.count;
+   stats->minUs = Prof_ToUs(z.minTicks);
+   stats->maxUs = Prof_ToUs(z.maxTicks);
+   stats->meanUs = Prof_ToUs(z.sumTicks / z.count);
+   stats->p99Us = Prof_ToUs(Prof_P99Ticks(&z));
+
+   return true;
+}
+
+/**
+ * @brief Print every zone with samples as one table row over USART2
+ * @note  Times in us with one decimal, from the raw ticks.
+ */
+void Prof_Dump(void)
+{
+   ProfZoneData_t z;
+
+   UART_Printf("[PROF] %-20s %8s %10s %10s %10s %10s\r\n",
+               "zone", "count", "min_us", "mean_us", "p99_us", "max_us");
+   for (ProfZone_t id = 0; id < s_zoneCount; id++) {
+       Prof_Snapshot(id, &z);
+       if (z.count == 0U) continue;
+
+       uint32_t t[4] = { z.minTicks, (uint32_t)(z.sumTicks / z.count), Prof_P99Ticks(&z), z.maxTicks };
+       uint32_t d[4];
+       for (uint8_t i = 0; i < 4U; i++) d[i] = Prof_ToUs((uint64_t)t[i] * 10U);
+
+       UART_Printf("[PROF] %-20s %8u %8u.%u %8u.%u %8u.%u %8u.%u\r\n", z.name, (unsigned)z.count,
+                   (unsigned)(d[0] / 10U), (unsigned)(d[0] % 10U), (unsigned)(d[1] / 10U), (unsigned)(d[1] % 10U),
+                   (unsigned)(d[2] / 10U), (unsigned)(d[2] % 10U), (unsigned)(d[3] / 10U), (unsigned)(d[3] % 10U));
+   }
+}
+
+/**
+ * @brief Print the non-empty buckets of one zone over USART2
+ * @note  Bucket edges are raw ticks (cycles on the target, ns on a host).
+ */
+void Prof_DumpHistogram(ProfZone_t zone)
+{
+   ProfZoneData_t z;
+
+   if (zone >= s_zoneCount) return;
+   Prof_Snapshot(zone, &z);
+
+   UART_Printf("[PROF] %s: %u samples (%u ticks/us)\r\n", z.name, (unsigned)z.count,
+               (unsigned)Prof_TicksPerUs());
+   for (uint32_t b = 0; b < PROF_BUCKETS; b++) {
+       if (z.hist[b] == 0U) continue;
+       uint32_t lo = (b == 0U) ? 0U : (1UL << (b + PROF_BUCKET_SHIFT));
+       if (b == (PROF_BUCKETS - 1U)) {
+           UART_Printf("[PROF]   >= %8u       ticks : %u\r\n", (unsigned)lo, (unsigned)z.hist[b]);
+       } else {
+           uint32_t hi = (1UL << (b + PROF_BUCKET_SHIFT + 1U)) - 1U;
+           UART_Printf("[PROF]   %8u..%8u ticks : %u\r\n", (unsigned)lo, (unsigned)hi, (unsigned)z.hist[b]);
+       }
+   }
+}
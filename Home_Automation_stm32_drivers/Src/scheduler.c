@@ -0,0 +1,231 @@
+/*
+ * scheduler.c
+ *
+ * Created on: Feb 15, 2026
+ * Author: Rahul B.
+ * Description: Cooperative run-to-completion task scheduler
+ */
+
+#include "scheduler.h"
+#include "bsp_timebase.h"
+#include "bsp_uart2_debug.h"
+#include <string.h>
+
+/* ===== PRIVATE VARIABLES ===== */
+static Task_t s_tasks[SCHED_MAX_TASKS];
+static bool   s_running = false;
+
+/* ===== PRIVATE HELPERS ===== */
+
+static inline uint32_t Sched_Now(void)
+{
+   return (uint32_t)now_ms();
+}
+
+/* Wrap-safe "a is at or after b" on the 32-bit ms axis */
+static inline bool Sched_IsDue(uint32_t now, uint32_t due)
+{
+   return (int32_t)(now - due) >= 0;
+}
+
+static bool Sched_IsValid(TaskId_t id)
+{
+   return (id >= 0) && (id < SCHED_MAX_TASKS) && s_tasks[id].used;
+}
+
+static TaskId_t Sched_Alloc(const char *name, TaskFunc_t func, uint32_t period, uint32_t delay)
+{
+   if (func == NULL) return SCHED_INVALID_ID;
+
+   for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+       Task_t *t = &s_tasks[id];
+       if (t->used) continue;
+
+       memset(t, 0, sizeof(*t));
+       t->name    = name;
+       t->func    = func;
+       t->period  = period;
+       t->nextRun = Sched_Now() + delay;
+       t->used    = true;
+       t->active  = true;
+       return id;
+   }
+
+   UART_Printf("[SCHED] No free slot for '%s'\r\n", name);
+   return SCHED_INVALID_ID;
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Clear the task table
+ */
+void Scheduler_Init(void)
+{
+   memset(s_tasks, 0, sizeof(s_tasks));
+   s_running = false;
+}
+
+/**
+ * @brief Register a periodic task. First run happens on the next dispatch.
+ */
+TaskId_t Scheduler_AddTask(const char *name, TaskFunc_t func, uint32_t period_ms)
+{
+   if (period_ms == 0) return SCHED_INVALID_ID;
+   return Sched_Alloc(name, func, period_ms, 0);
+}
+
+/**
+ * @brief Register a task that runs once, delay_ms from now, then frees its slot
+ */
+TaskId_t Scheduler_AddOneShot(const char *name, TaskFunc_t func, uint32_t delay_ms)
+{
+   return Sched_Alloc(name, func, 0, delay_ms);
+}
+
+void Scheduler_RemoveTask(TaskId_t id)
+{
+   if (Sched_IsValid(id)) {
+       s_tasks[id].used = false;
+       s_tasks[id].active = false;
+   }
+}
+
+void Scheduler_SuspendTask(TaskId_t id)
+{
+   if (Sched_IsValid(id)) s_tasks[id].active = false;
+}
+
+/**
+ * @brief Resume a suspended task; its phase restarts from now
+ */
+void Scheduler_ResumeTask(TaskId_t id)
+{
+   if (Sched_IsValid(id) && !s_tasks[id].active) {
+       s_tasks[id].nextRun = Sched_Now() + s_tasks[id].period;
+       s_tasks[id].active = true;
+   }
+}
+
+/**
+ * @brief Make a task due immediately (runs on the next dispatch pass)
+ */
+void Scheduler_TriggerTask(TaskId_t id)
+{
+   if (Sched_IsValid(id)) {
+       s_tasks[id].nextRun = Sched_Now();
+       s_tasks[id].active = true;
+   }
+}
+
+/**
+ * @brief Change a periodic task's period; the new phase starts from now
+ */
+void Scheduler_SetPeriod(TaskId_t id, uint32_t period_ms)
+{
+   if (Sched_IsValid(id) && (period_ms != 0) && (s_tasks[id].period != 0)) {
+       s_tasks[id].period = period_ms;
+       s_tasks[id].nextRun = Sched_Now() + period_ms;
+   }
+}
+
+/**
+ * @brief Attach a wake hint to a task (see TaskWakeHint_t)
+ * @note  The task still runs every period while the CPU is awake; the hint
+ *        only shapes Scheduler_MsUntilNextRun(). Periods it sleeps through
+ *        are not counted as overruns.
+ */
+void Scheduler_SetWakeHint(TaskId_t id, TaskWakeHint_t hint)
+{
+   if (Sched_IsValid(id)) s_tasks[id].wakeHint = hint;
+}
+
+/**
+ * @brief One dispatcher pass - call from the main loop
+ * @note  Time is sampled once, then due tasks run in table order.
+ */
+void Scheduler_Dispatch(void)
+{
+   uint32_t now = Sched_Now();
+
+   s_running = true;
+
+   for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+       Task_t *t = &s_tasks[id];
+
+       if (!t->used || !t->active || !Sched_IsDue(now, t->nextRun)) continue;
+
+       if (t->period != 0) {
+           t->nextRun += t->period;
+           if (Sched_IsDue(now, t->nextRun)) {
+               // Missed one or more periods: drop them instead of bursting
+               if (t->wakeHint == NULL) t->overruns++;
+               t->nextRun = now + t->period;
+           }
+       } else {
+           // One-shot: free the slot first so the callback may re-arm itself
+           TaskFunc_t func = t->func;
+           t->used = false;
+           t->active = false;
+           func();
+           continue;
+       }
+
+       uint64_t start = now_us();
+       t->func();
+       t->lastExecUs = (uint32_t)(now_us() - start);
+
+       if (t->lastExecUs > t->maxExecUs) t->maxExecUs = t->lastExecUs;
+       t->runCount++;
+   }
+}
+
+bool Scheduler_IsRunning(void)
+{
+   return s_running;
+}
+
+/**
+ * @brief Milliseconds until the next dispatch has something to run
+ * @return 0 if a task is due now, SCHED_NO_DEADLINE if nothing is scheduled
+ * @note  A hinted task counts at the later of its period and its hint.
+ */
+uint32_t Scheduler_MsUntilNextRun(void)
+{
+   uint32_t now = Sched_Now();
+   uint32_t best = SCHED_NO_DEADLINE;
+
+   for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+       const Task_t *t = &s_tasks[id];
+       if (!t->used || !t->active) continue;
+
+       uint32_t wait = Sched_IsDue(now, t->nextRun) ? 0U : (t->nextRun - now);
+       if (t->wakeHint != NULL) {
+           uint32_t hint = t->wakeHint();
+           if (hint > wait) wait = hint;
+       }
+       if (wait < best) best = wait;
+       if (best == 0U) break;
+   }
+   return best;
+}
+
+const Task_t *Scheduler_GetTask(TaskId_t id)
+{
+   return ((id >= 0) && (id < SCHED_MAX_TASKS)) ? &s_tasks[id] : NULL;
+}
+
+/**
+ * @brief Dump per-task statistics over USART2
+ */
+void Scheduler_PrintStats(void)
+{
+   UART_Printf("[SCHED] %-10s %6s %8s %8s %8s\r\n", "task", "period", "runs", "max_us", "overrun");
+   for (TaskId_t id = 0; id < SCHED_MAX_TASKS; id++) {
+       const Task_t *t = &s_tasks[id];
+       if (!t->used) continue;
+       UART_Printf("[SCHED] %-10s %6u %8u %8u %8u\r\n",
+                   t->name, (unsigned)t->period, (unsigned)t->runCount,
+                   (unsigned)t->maxExecUs, (unsigned)t->overruns);
+   }
+}
@@ -9,16 +9,47 @@
 #include "state_machine.h"
 #include "bsp_ldr.h"
 #include "bsp_uart2_debug.h"
+#include "scheduler.h"
 #include <stdio.h>
 
 #include "bsp_lcd.h"
 #include "bsp_i2c_oled.h"
+#include "bsp_oled_gfx.h"
 #include "bsp_uart2_debug.h"
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+
+// LDR1 light level (%) of the last SENSOR_HISTORY_LEN samples, oldest first
+static int16_t s_ldrHistory[SENSOR_HISTORY_LEN];
+static uint8_t s_ldrHistoryCount = 0;
 
 
+/**
+ * @brief Register the periodic sensor sampling task
+ */
+void Sensors_Init(void)
+{
+    Scheduler_AddTask("sensors", Sensors_Task, SENSOR_TASK_PERIOD_MS);
+}
+
+/**
+ * @brief Scheduler task: sample both LDRs into g_SensorData
+ */
+void Sensors_Task(void)
+{
+    g_SensorData.ldr1_value = BSP_Sensor_ReadLDR(SENSOR_LDR1_CHANNEL);
+    g_SensorData.ldr2_value = BSP_Sensor_ReadLDR(SENSOR_LDR2_CHANNEL);
+    g_SensorData.lastUpdateTime = GetSystemTick();
+
+    if (s_ldrHistoryCount == SENSOR_HISTORY_LEN) {
+        memmove(&s_ldrHistory[0], &s_ldrHistory[1], (SENSOR_HISTORY_LEN - 1) * sizeof(s_ldrHistory[0]));
+        s_ldrHistoryCount--;
+    }
+    s_ldrHistory[s_ldrHistoryCount++] = LDR_ToPercentage(g_SensorData.ldr1_value);
+}
+
 /**
  * @brief Convert LDR raw value to percentage
  */
@@ -32,6 +63,7 @@ uint8_t LDR_ToPercentage(uint16_t raw_value)
 
 /**
 * @brief Display sensor data on LCD based on current screen
+* @note  Writes the LCD view; Display_UpdateLCD flushes it.
 */
 void Sensors_DisplayOnLCD(void)
 {
@@ -54,10 +86,8 @@ void Sensors_DisplayOnLCD(void)
            break;
    }
 
-   BSP_LCD_SetCursor(0, 0);
-   BSP_LCD_PrintString(line1);
-   BSP_LCD_SetCursor(1, 0);
-   BSP_LCD_PrintString(line2);
+   BSP_LCD_SetLine(0, line1);
+   BSP_LCD_SetLine(1, line2);
 }
 /**
 * @brief Display system state on OLED
@@ -87,7 +117,17 @@ void Sensors_DisplayOnOLED(void)
    }
    BSP_OLED_PrintString(0, 16, buffer);
 
-   BSP_OLED_PrintString(0, 32, buffer);
+   // Line 4: light level, large enough to read across the room
+   snprintf(buffer, 32, "LDR %u%%", LDR_ToPercentage(g_SensorData.ldr1_value));
+   BSP_OLED_DrawText(0, 32, &Font_Medium16, buffer);
+
+   // Both LDRs as bars, LDR1 over the last samples as a sparkline
+   int16_t levels[2] = {
+       LDR_ToPercentage(g_SensorData.ldr1_value),
+       LDR_ToPercentage(g_SensorData.ldr2_value)
+   };
+   BSP_OLED_DrawBarGraph(OLED_WIDTH - 15, 32, 15, 15, levels, 2, 0, 100);
+   BSP_OLED_DrawSparkline(0, 49, OLED_WIDTH, 15, s_ldrHistory, s_ldrHistoryCount, 0, 100);
 
    BSP_OLED_Update();
 }
@@ -0,0 +1,281 @@
+/*
+ * soft_timer.c
+ *
+ * Created on: Feb 16, 2026
+ * Author: Rahul B.
+ * Description: Software timers on a hierarchical timing wheel
+ */
+
+#include "soft_timer.h"
+#include "bsp_timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ===== PRIVATE VARIABLES ===== */
+static SoftTimerLink_t s_wheel[STIMER_LEVELS][STIMER_WHEEL_SIZE];
+static uint32_t s_now = 0;                 // last tick the wheel has processed
+static SoftTimerStats_t s_stats;
+
+/* ===== LIST HELPERS (circular, sentinel headed) ===== */
+
+static inline void List_Init(SoftTimerLink_t *head)
+{
+   head->next = head;
+   head->prev = head;
+}
+
+static inline bool List_IsEmpty(const SoftTimerLink_t *head)
+{
+   return head->next == head;
+}
+
+static inline void List_Append(SoftTimerLink_t *head, SoftTimerLink_t *link)
+{
+   link->prev = head->prev;
+   link->next = head;
+   head->prev->next = link;
+   head->prev = link;
+}
+
+static inline void List_Unlink(SoftTimerLink_t *link)
+{
+   link->prev->next = link->next;
+   link->next->prev = link->prev;
+   link->next = NULL;
+   link->prev = NULL;
+}
+
+/* Move every node of src onto the (empty) dst list */
+static inline void List_Splice(SoftTimerLink_t *src, SoftTimerLink_t *dst)
+{
+   List_Init(dst);
+   if (List_IsEmpty(src)) return;
+
+   dst->next = src->next;
+   dst->prev = src->prev;
+   dst->next->prev = dst;
+   dst->prev->next = dst;
+   List_Init(src);
+}
+
+/* ===== WHEEL CORE ===== */
+
+/**
+ * @brief Link a timer into the slot that matches its distance from s_now
+ * @param earliest first tick the timer may still fire on: s_now + 1 from
+ *        thread context, s_now while cascading (that slot is run next)
+ */
+static void Wheel_Insert(SoftTimer_t *t, uint32_t earliest)
+{
+   uint32_t when = t->expires;
+
+   if ((int32_t)(when - earliest) < 0) {
+       when = earliest;                     // already due
+   }
+
+   uint32_t delta = when - s_now;
+
+   if (delta > STIMER_MAX_DELTA) {
+       // Beyond the wheel span: park in the top level, re-cascaded later
+       when = s_now + STIMER_MAX_DELTA;
+       delta = STIMER_MAX_DELTA;
+   }
+
+   uint8_t level = 0;
+   while ((level < (STIMER_LEVELS - 1)) &&
+          (delta >= (1UL << (STIMER_WHEEL_BITS * (level + 1))))) {
+       level++;
+   }
+
+   uint32_t slot = (when >> (STIMER_WHEEL_BITS * level)) & STIMER_WHEEL_MASK;
+   List_Append(&s_wheel[level][slot], &t->link);
+}
+
+/**
+ * @brief Re-insert every timer of one higher-level slot (moves them down)
+ */
+static void Wheel_Cascade(uint8_t level, uint32_t slot)
+{
+   SoftTimerLink_t pending;
+
+   List_Splice(&s_wheel[level][slot], &pending);
+
+   while (!List_IsEmpty(&pending)) {
+       SoftTimer_t *t = (SoftTimer_t *)pending.next;
+       List_Unlink(&t->link);
+       Wheel_Insert(t, s_now);
+       s_stats.cascaded++;
+   }
+}
+
+/**
+ * @brief Advance the wheel by exactly one tick and run what expires
+ */
+static void Wheel_Tick(void)
+{
+   SoftTimerLink_t due;
+
+   s_now++;
+   s_stats.ticks++;
+
+   // Every time a lower level wraps, pull the next slot of the level above
+   uint32_t idx = s_now & STIMER_WHEEL_MASK;
+   for (uint8_t level = 1; (idx == 0U) && (level < STIMER_LEVELS); level++) {
+       idx = (s_now >> (STIMER_WHEEL_BITS * level)) & STIMER_WHEEL_MASK;
+       Wheel_Cascade(level, idx);
+   }
+
+   // Detach the due slot first so callbacks may freely start/stop timers
+   List_Splice(&s_wheel[0][s_now & STIMER_WHEEL_MASK], &due);
+
+   while (!List_IsEmpty(&due)) {
+       SoftTimer_t *t = (SoftTimer_t *)due.next;
+       List_Unlink(&t->link);
+
+       if ((int32_t)(t->expires - s_now) > 0) {
+           Wheel_Insert(t, s_now + 1U);    // parked long timer, not due yet
+           continue;
+       }
+
+       s_stats.armed--;
+       s_stats.expired++;
+
+       if (t->period != 0U) {
+           t->expires += t->period;        // keep the phase
+           Wheel_Insert(t, s_now + 1U);
+           s_stats.armed++;
+       }
+
+       if (t->callback != NULL) {
+           t->callback(t->arg);
+       }
+   }
+}
+
+/* ===== API ===== */
+
+/**
+ * @brief Empty the wheel and align it with the system tick
+ */
+void SoftTimer_Init(void)
+{
+   for (uint8_t level = 0; level < STIMER_LEVELS; level++) {
+       for (uint32_t slot = 0; slot < STIMER_WHEEL_SIZE; slot++) {
+           List_Init(&s_wheel[level][slot]);
+       }
+   }
+   memset(&s_stats, 0, sizeof(s_stats));
+   s_now = (uint32_t)now_ms();
+}
+
+/**
+ * @brief Bind a callback to a timer node (does not arm it)
+ */
+void SoftTimer_Create(SoftTimer_t *timer, SoftTimerCallback_t callback, void *arg)
+{
+   memset(timer, 0, sizeof(*timer));
+   timer->callback = callback;
+   timer->arg = arg;
+}
+
+/**
+ * @brief Arm (or re-arm) a timer
+ * @param delay_ms  first expiry, relative to now
+ * @param period_ms 0 for one-shot, otherwise the reload period
+ */
+void SoftTimer_Start(SoftTimer_t *timer, uint32_t delay_ms, uint32_t period_ms)
+{
+   uint32_t base = (uint32_t)now_ms();
+
+   SoftTimer_Stop(timer);
+
+   // The wheel may run ahead of the tick when driven by SoftTimer_AdvanceTo()
+   if ((int32_t)(s_now - base) > 0) base = s_now;
+
+   timer->expires = base + delay_ms;
+   timer->period = period_ms;
+   Wheel_Insert(timer, s_now + 1U);
+   s_stats.armed++;
+}
+
+/**
+ * @brief Disarm a timer; safe to call on an idle timer or from a callback
+ */
+void SoftTimer_Stop(SoftTimer_t *timer)
+{
+   if (timer->link.next != NULL) {
+       List_Unlink(&timer->link);
+       s_stats.armed--;
+   }
+}
+
+bool SoftTimer_IsActive(const SoftTimer_t *timer)
+{
+   return timer->link.next != NULL;
+}
+
+/**
+ * @brief Run every tick between the last processed one and an explicit tick
+ */
+void SoftTimer_AdvanceTo(uint32_t tick)
+{
+   while ((int32_t)(tick - s_now) > 0) {
+       Wheel_Tick();
+   }
+}
+
+/**
+ * @brief Scheduler task: catch the wheel up with the system tick
+ */
+void SoftTimer_Process(void)
+{
+   SoftTimer_AdvanceTo((uint32_t)now_ms());
+}
+
+uint32_t SoftTimer_Now(void)
+{
+   return s_now;
+}
+
+/**
+ * @brief Milliseconds from now until the wheel has something to do
+ * @return 0 if it is behind, STIMER_NO_DEADLINE if no timer is armed
+ * @note  Level 0 gives exact expiries; a higher level only says which
+ *        cascade boundary moves a timer down, so the result may be early
+ *        (never late). Scheduler wake hint of the "timers" task.
+ */
+uint32_t SoftTimer_MsUntilNext(void)
+{
+   if (s_stats.armed == 0U) return STIMER_NO_DEADLINE;
+
+   uint32_t next = s_now + STIMER_MAX_DELTA;
+
+   for (uint32_t d = 1; d <= STIMER_WHEEL_SIZE; d++) {
+       if (!List_IsEmpty(&s_wheel[0][(s_now + d) & STIMER_WHEEL_MASK])) {
+           next = s_now + d;
+           break;
+       }
+   }
+
+   // Level L cascades its slot (tick >> 5L) on every multiple of 1 << 5L
+   for (uint8_t level = 1; level < STIMER_LEVELS; level++) {
+       uint32_t shift = STIMER_WHEEL_BITS * level;
+       uint32_t tick = (s_now | ((1UL << shift) - 1UL)) + 1UL;
+
+       for (uint32_t k = 0; k < STIMER_WHEEL_SIZE; k++, tick += (1UL << shift)) {
+           if ((int32_t)(tick - next) >= 0) break;
+           if (!List_IsEmpty(&s_wheel[level][(tick >> shift) & STIMER_WHEEL_MASK])) {
+               next = tick;
+               break;
+           }
+       }
+   }
+
+   int32_t wait = (int32_t)(next - (uint32_t)now_ms());
+   return (wait > 0) ? (uint32_t)wait : 0U;
+}
+
+const SoftTimerStats_t *SoftTimer_GetStats(void)
+{
+   return &s_stats;
+}
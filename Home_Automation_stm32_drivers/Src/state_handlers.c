@@ -17,6 +17,11 @@
 #include "bsp_buzzer.h"
 #include "bsp_relay.h"
 #include "config.h"
+#include "soft_timer.h"
+#include "event_queue.h"
+#include "scheduler.h"
+#include "pt.h"
+#include "idle.h"
 #include <stdio.h>
 #include <string.h>
 #include "bsp_button.h"
@@ -24,127 +29,292 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-/* GLOBAL VARIABLES (Missing in your previous build) */
+/* ========================================================================
+   The states below are driven by the table-driven engine (fsm.c):
+   - entry / exit hooks run exactly once per transition
+   - the "do" hook runs on every FSM scheduler pass: one bounded step of
+     work, keys are turned into events with StateMachine_Post()
+   - every state change goes through the transition table at the bottom
+   - MENU, SENSOR_MONITOR, CONTROL and SETTINGS are children of the
+     AUTHENTICATED superstate, which owns back / logout / inactivity once
+   Screens are drawn by the display tasks (Display_RequestRefresh() asks
+   for an immediate redraw).
+   ======================================================================== */
+
+/* ===== STATE TIMERS (callbacks run in thread context) ===== */
+#define STANDBY_BLINK_ON_MS     1000U
+#define STANDBY_BLINK_OFF_MS    3000U
+#define LOCKOUT_BLINK_MS        500U
+#define LOCKOUT_BLINK_CYCLES    3U
+
+static SoftTimer_t blinkTimer;          // standby white LED 1 s ON / 3 s OFF
+static SoftTimer_t alarmTimer;          // lockout red LED + buzzer blink
+static SoftTimer_t lockoutTimer;        // lockout duration
+static SoftTimer_t inactivityTimer;     // SCREEN_TIMEOUT_SEC without a key
+static bool blinkOn = false;
+static uint8_t alarmEdgesLeft = 0;
+
+static void Standby_Blink(void *arg)
+{
+    (void)arg;
+    blinkOn = !blinkOn;
+    if (blinkOn) {
+        BSP_LED_On(LED_WHITE_PIN);
+        SoftTimer_Start(&blinkTimer, STANDBY_BLINK_ON_MS, 0);
+    } else {
+        BSP_LED_Off(LED_WHITE_PIN);
+        SoftTimer_Start(&blinkTimer, STANDBY_BLINK_OFF_MS, 0);
+    }
+}
+
+static void Lockout_Alarm(void *arg)
+{
+    (void)arg;
+
+    // Edges count down from 2 * cycles: even = ON phase, odd = OFF phase
+    bool on = (--alarmEdgesLeft != 0U) && ((alarmEdgesLeft & 1U) == 0U);
+
+    if (alarmEdgesLeft == 0U) {
+        SoftTimer_Stop(&alarmTimer);
+    }
+
+    if (on) {
+        BSP_LED_On(LED_RED_PIN);
+        BSP_Buzzer_On();
+    } else {
+        BSP_LED_Off(LED_RED_PIN);
+        BSP_Buzzer_Off();
+    }
+}
 
-extern volatile uint8_t g_wakeup_flag;
+static void Lockout_Expired(void *arg)
+{
+    (void)arg;
+    StateMachine_Post(EV_LOCKOUT_DONE);
+}
 
-uint8_t login_attempts = 0;  
-uint8_t selected_item = 0;    
+static void Inactivity_Timeout(void *arg)
+{
+    (void)arg;
+    print_Log("SCREEN TIMEOUT");
+    StateMachine_Post(EV_TIMEOUT);
+}
 
 /**
- * @brief Safely changes system state and performs one-time entry actions
+ * @brief Event handler for the PC13 wake-up button (EVT_SRC_WAKEUP_BTN)
+ * @note  Only STANDBY has an EV_WAKEUP row, other states ignore it
  */
-void StateMachine_SetState(SystemState_t newState) {
-    if (g_SystemContext.currentState == newState) return;
+static void Wakeup_OnEvent(const Event_t *evt)
+{
+    (void)evt;
+    StateMachine_Post(EV_WAKEUP);
+}
 
-    // 1. Log transition to all three outputs once
-    const char* stateNames[] = {
-        "STANDBY", "AUTH GATE", "MAIN MENU", "MONITORING",
-        "DEVICE CTRL", "SETTINGS", "LOCKED!!", "SYS ERROR"
-    };
+/**
+ * @brief Keypad read for the AUTHENTICATED children
+ * @note  Any key restarts the SCREEN_TIMEOUT_SEC inactivity timer.
+ *        '*' and '#' become EV_BACK / EV_LOGOUT for the superstate and
+ *        are not returned to the caller.
+ */
+static char ReadKey_Authenticated(void)
+{
+    char key = Keypad_GetKey();
 
-    print_Log("TO: %s", stateNames[newState]); // Synchronized UART/LCD/OLED log
+    if (key == KEYPAD_NO_KEY) return key;
 
-    // 2. Perform one-time cleanup/initialization
-    BSP_LCD_SendCommand(LCD_CMD_CLEAR); // Clear LCD
-    BSP_OLED_Clear();                   // Clear OLED buffer
+    g_SystemContext.lastActivityTime = GetSystemTick();
+    SoftTimer_Start(&inactivityTimer, SCREEN_TIMEOUT_SEC * 1000U, 0);
 
-    // 3. Update state
-    g_SystemContext.currentState = newState;
+    if (key == KEY_BACK) {
+        StateMachine_Post(EV_BACK);
+        return KEYPAD_NO_KEY;
+    }
+    if (key == KEY_LOGOUT) {
+        StateMachine_Post(EV_LOGOUT);
+        return KEYPAD_NO_KEY;
+    }
+    return key;
 }
 
 /* ========================================================================
    STATE 1: STANDBY MODE
    - White LED blinks 1s ON / 3s OFF
    - Wait for keypad or button interrupt
-   - IR intrusion detection with buzzer alarm
    ======================================================================== */
-void Handle_Standby(void) {
+static void Standby_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
     BSP_LED_AllOff();
-    
-    BSP_LCD_SetCursor(0, 0);
-    BSP_LCD_PrintString(" Standby Mode ");
-    // UI: Static text only if just entered (handled by print_Log in SetState)
-    BSP_LCD_SetCursor(1, 0);
-    BSP_LCD_PrintString(" PRESS PC13 BTN ");
-
-    // White LED Blink Logic (PA7)
-	BSP_LED_On(LED_WHITE_PIN);
-	BSP_Delay_ms(1000);
-	BSP_LED_Off(LED_WHITE_PIN);
-
-	// Wait 3s or check for wakeup
-	for(int i=0; i<150; i++) {  // ✅ 150 × 20ms = 3000ms = 3 seconds
-		if(g_wakeup_flag || (GPIO_ReadFromInputPin(GPIOC, GPIO_PIN_NO_13) == 0)) {
-			g_wakeup_flag = 0;
-            BSP_Delay_ms(200); // Debounce
-			UART_Printf("[EVENT] Wakeup triggered!\r\n");
-            UART_Printf("[EVENT] Standby to Authentication \r\n");
-			Device_PlayBuzzer(BEEP_SUCCESS);
-			g_SystemContext.currentState = STATE_AUTHENTICATING;
-			return;
-		}
-		BSP_Delay_ms(20);
-	}
+    Display_RequestRefresh();
+
+    // White LED Blink Logic (PA7): 1 s ON / 3 s OFF
+    blinkOn = false;
+    Standby_Blink(NULL);
+
+    // Poll the keypad slowly and let the idle manager use Stop mode;
+    // PC13, the IR sensors and the keypad rows wake it through EXTI
+    StateMachine_SetRunPeriod(STANDBY_FSM_PERIOD_MS);
+    Idle_ResetStats();
+    Idle_SetStopAllowed(true);
+}
+
+static void Standby_Do(Fsm_t *fsm)
+{
+    (void)fsm;
+
+    // Wakeup: any keypad key or PC13 held low (the press itself is an event).
+    // A key wakes the keypad scan through its row's EXTI, and Stop waits
+    // while it scans, so the debounced state is current here
+    if (Keypad_AnyKeyDown() || Keypad_GetKey() != KEYPAD_NO_KEY ||
+        (GPIO_ReadFromInputPin(GPIOC, GPIO_PIN_NO_13) == 0)) {
+        StateMachine_Post(EV_WAKEUP);
+    }
+}
+
+static void Standby_Exit(Fsm_t *fsm)
+{
+    (void)fsm;
+    SoftTimer_Stop(&blinkTimer);
+    BSP_LED_Off(LED_WHITE_PIN);
+
+    // The key that woke the system is not the first PIN digit
+    Keypad_Flush();
+
+    Idle_SetStopAllowed(false);
+    StateMachine_SetRunPeriod(FSM_TASK_PERIOD_MS);
+}
+
+static void Standby_Wakeup(Fsm_t *fsm)
+{
+    (void)fsm;
+    UART_Printf("[EVENT] Wakeup triggered!\r\n");
+    Idle_PrintStats();
+    Device_PlayBuzzer(BEEP_SUCCESS);
 }
 
 /* ========================================================================
    STATE 2: AUTHENTICATION MODE
    - Green LED ON (all others OFF)
    - LCD shows "Enter PIN:"
-   - Wait for 4-digit PIN via keypad
+   - Collect a 4-digit PIN via keypad (a protothread, resumed every pass)
    - 3 failed attempts → LOCKOUT
    ======================================================================== */
-void Handle_Authentication(void)
+static Pt_t authPt;
+static char authKey;
+
+static void Auth_ClearPin(void)
 {
-	// print_Log("Auth Mode : ");
+    memset(g_SystemContext.pinBuffer, 0, sizeof(g_SystemContext.pinBuffer));
+    g_SystemContext.pinIndex = 0;
+}
+
+/* One PIN attempt; a wrong PIN (Auth_Retry) simply runs it again */
+static PT_THREAD(Auth_CollectPin(Pt_t *pt))
+{
+    PT_BEGIN(pt);
+
+    Auth_ClearPin();
+    while (g_SystemContext.pinIndex < PIN_LENGTH) {
+        PT_AWAIT_KEY(pt, authKey);
+        if (authKey < '0' || authKey > '9') continue;
+
+        g_SystemContext.pinBuffer[g_SystemContext.pinIndex++] = authKey;
+        BSP_LCD_WriteAt(1, g_SystemContext.pinIndex - 1, "*");
+        BSP_LCD_Flush();
+        UART_Printf("*");
+    }
+
+    g_SystemContext.pinBuffer[PIN_LENGTH] = '\0';
+    StateMachine_Post(EV_PIN_ENTERED);     // verdict before the next pass
+
+    PT_END(pt);
+}
 
+static void Auth_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
     BSP_LED_AllOff();
     BSP_LED_On(LED_GREEN_PIN);
+    Auth_ClearPin();
+    PT_INIT(&authPt);
+    Display_RequestRefresh();
+}
 
-    char input_pin[PIN_LENGTH + 1] = {0};
-    uint8_t char_count = 0; // Fixed: replaced 'count' with 'char_count'
+static void Auth_Do(Fsm_t *fsm)
+{
+    (void)fsm;
+    (void)Auth_CollectPin(&authPt);
+}
 
-    update_lcd_display("ENTER PIN:", "");
+static bool Auth_PinCorrect(Fsm_t *fsm)
+{
+    (void)fsm;
+    return strcmp(g_SystemContext.pinBuffer, MASTER_PIN) == 0;
+}
 
-    while(char_count < PIN_LENGTH) {
-        char key = Keypad_GetKey();
-        if(key != KEYPAD_NO_KEY && key >= '0' && key <= '9') {
-            input_pin[char_count] = key;
-            BSP_LCD_SetCursor(1, char_count);
-            BSP_LCD_SendData('*');
-            char_count++;
-            UART_Printf("*"); 
-        }
-    }
-    input_pin[PIN_LENGTH] = '\0';
+static bool Auth_AttemptsLeft(Fsm_t *fsm)
+{
+    (void)fsm;
+    return g_SystemContext.loginAttempts < MAX_LOGIN_ATTEMPTS;
+}
 
-    if(strcmp(input_pin, MASTER_PIN) == 0) {
-        print_Log("AUTH SUCCESS");
-        Device_PlayBuzzer(BEEP_SUCCESS);
-        login_attempts = 0;
-        g_SystemContext.currentState = STATE_ACTIVE_MENU;
-    } else {
-        login_attempts++; // Increase count on every failure
-
-        if(login_attempts > 3) {
-            // After 3 wrong tries, go to LOCKOUT
-        	Device_PlayBuzzer(BEEP_ERROR);
-            print_Log("MAX ATTEMPTS! LOCKOUT");
-            g_SystemContext.currentState = STATE_LOCKOUT;
-        } else {
-            // Still have chances left, go back to try again or stay in AUTH
-            print_Log("WRONG PIN! TRY %d/3", login_attempts);
-            Device_PlayBuzzer(BEEP_WARNING);
-            g_SystemContext.currentState = STATE_AUTHENTICATING; // Reset the auth screen
-        }
-        BSP_Delay_1s();
-    }
+static void Auth_Success(Fsm_t *fsm)
+{
+    (void)fsm;
+    print_Log("AUTH SUCCESS");
+    Device_PlayBuzzer(BEEP_SUCCESS);
+    g_SystemContext.loginAttempts = 0;
+}
+
+static void Auth_Retry(Fsm_t *fsm)
+{
+    (void)fsm;
+    g_SystemContext.loginAttempts++;
+
+    // The message is held for DISPLAY_MSG_HOLD_MS, then the PIN prompt is redrawn
+    print_Log("WRONG PIN! TRY %d/3", g_SystemContext.loginAttempts);
+    Device_PlayBuzzer(BEEP_WARNING);
+    Auth_ClearPin();
+}
+
+static void Auth_Lockout(Fsm_t *fsm)
+{
+    (void)fsm;
+    g_SystemContext.loginAttempts++;
+    Device_PlayBuzzer(BEEP_ERROR);
+    print_Log("MAX ATTEMPTS! LOCKOUT");
+}
+
+/* ========================================================================
+   SUPERSTATE: AUTHENTICATED
+   - Session bookkeeping and the SCREEN_TIMEOUT_SEC inactivity timer
+   - '*' returns to the menu, '#' logs out (rows bubble up from children)
+   - Re-login after a timeout resumes the last screen (shallow history);
+     an explicit logout forgets it
+   ======================================================================== */
+static void Authenticated_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
+    g_SystemContext.isAuthenticated = true;
+    g_SystemContext.lastActivityTime = GetSystemTick();
+    SoftTimer_Start(&inactivityTimer, SCREEN_TIMEOUT_SEC * 1000U, 0);
+}
+
+static void Authenticated_Exit(Fsm_t *fsm)
+{
+    (void)fsm;
+    SoftTimer_Stop(&inactivityTimer);
+    g_SystemContext.isAuthenticated = false;
+}
+
+static void Session_Forget(Fsm_t *fsm)
+{
+    Fsm_ClearHistory(fsm, STATE_AUTHENTICATED);
+    g_SystemContext.menuCursor = 0;
 }
 
 /* ========================================================================
    STATE 3: ACTIVE MENU MODE
-   - Green LED remains ON
    - Menu navigation: 2=Up, 8=Down, 5=Select, #=Logout
    - Four menu options:
      1. Sensor Monitor
@@ -152,162 +322,328 @@ void Handle_Authentication(void)
      3. Settings
      4. Logout
    ======================================================================== */
-void Handle_ActiveMenu(void)
+#define MENU_ITEM_SENSORS       0U
+#define MENU_ITEM_CONTROLS      1U
+#define MENU_ITEM_SETTINGS      2U
+#define MENU_ITEM_LOGOUT        3U
+
+static void Menu_Entry(Fsm_t *fsm)
 {
-//	print_Log("Active Mode : ");
-	BSP_LED_AllOff();
-//    BSP_LED_On(LED_GREEN_PIN);
-    Menu_Display();
-    
-    char key = Keypad_GetKey();
-    if(key == '2') { // Up
+    (void)fsm;
+    BSP_LED_AllOff();
+    Display_RequestRefresh();
+}
+
+static void Menu_Do(Fsm_t *fsm)
+{
+    (void)fsm;
+
+    char key = ReadKey_Authenticated();
+    if (key == KEYPAD_NO_KEY) return;
+
+    if(key == KEY_UP) {
         if (g_SystemContext.menuCursor > 0) {
             g_SystemContext.menuCursor--;
         }
-    } else if(key == '8') { // Down
-        if (g_SystemContext.menuCursor < 3) {
+    } else if(key == KEY_DOWN) {
+        if (g_SystemContext.menuCursor < MENU_ITEM_LOGOUT) {
             g_SystemContext.menuCursor++;
         }
-    } else if(key == '5') { // Select
-        switch(g_SystemContext.menuCursor) {
-            case 0: // Sensors
-                g_SystemContext.currentState = STATE_SENSOR_MONITOR;
-                break;
-            case 1: // Controls
-                g_SystemContext.currentState = STATE_CONTROL_DEVICES;
-                break;
-            case 2: // Settings
-                // Reserved for future
-                break;
-            case 3: // Logout
-                g_SystemContext.currentState = STATE_STANDBY;
-                g_SystemContext.isAuthenticated = false;
-                break;
-        }
-        BSP_LCD_SendCommand(LCD_CMD_CLEAR);
-    } else if(key == '#') {
-        g_SystemContext.currentState = STATE_STANDBY;
-        g_SystemContext.isAuthenticated = false;
+    } else if(key == KEY_ENTER) {
+        StateMachine_Post((g_SystemContext.menuCursor == MENU_ITEM_LOGOUT) ? EV_LOGOUT : EV_SELECT);
     }
-    BSP_Delay_ms(150);
+    Display_RequestRefresh();
 }
 
-void Handle_SensorMonitor(void) 
+static bool Menu_OnSensors(Fsm_t *fsm)  { (void)fsm; return g_SystemContext.menuCursor == MENU_ITEM_SENSORS; }
+static bool Menu_OnControls(Fsm_t *fsm) { (void)fsm; return g_SystemContext.menuCursor == MENU_ITEM_CONTROLS; }
+static bool Menu_OnSettings(Fsm_t *fsm) { (void)fsm; return g_SystemContext.menuCursor == MENU_ITEM_SETTINGS; }
+
+/* ========================================================================
+   STATE 4: SENSOR MONITOR
+   - Readings are sampled by Sensors_Task and drawn by the display tasks
+   - *=Back, #=Logout (handled by AUTHENTICATED)
+   ======================================================================== */
+static void Sensors_Entry(Fsm_t *fsm)
 {
-	BSP_LCD_SetCursor(0,0);
-	BSP_LCD_PrintString("SENSOR DASHBOARD");
-    // Update sensor readings
-    g_SensorData.ldr1_value = BSP_Sensor_ReadLDR(SENSOR_LDR1_CHANNEL);
-    g_SensorData.ldr2_value = BSP_Sensor_ReadLDR(SENSOR_LDR2_CHANNEL);
-    
-    Sensors_DisplayOnLCD();
-    
-    char key = Keypad_GetKey();
-    if(key == '*') {
-        g_SystemContext.currentState = STATE_ACTIVE_MENU;
-    } else if (key == '#') {
-        g_SystemContext.currentState = STATE_STANDBY;
-        g_SystemContext.isAuthenticated = false;
+    (void)fsm;
+    Display_RequestRefresh();
+}
+
+static void Sensors_Do(Fsm_t *fsm)
+{
+    (void)fsm;
+    (void)ReadKey_Authenticated();  // only '*' / '#' mean something here
+}
+
+/* ========================================================================
+   STATE 5: CONTROL DEVICES
+   - 2=Up, 8=Down, 5=Toggle, *=Back, #=Logout (handled by AUTHENTICATED)
+   ======================================================================== */
+static void Control_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
+    Display_RequestRefresh();
+}
+
+static void Control_Toggle(void)
+{
+    // Toggle selected device
+    switch(g_SystemContext.currentControlItem) {
+        case CONTROL_LED_GREEN:
+            BSP_LED_Toggle(LED_GREEN_PIN);
+            g_DeviceStates.led_green = !g_DeviceStates.led_green;
+            break;
+        case CONTROL_LED_RED:
+            BSP_LED_Toggle(LED_RED_PIN);
+            g_DeviceStates.led_red = !g_DeviceStates.led_red;
+            break;
+        case CONTROL_LED_WHITE:
+            BSP_LED_Toggle(LED_WHITE_PIN);
+            g_DeviceStates.led_white = !g_DeviceStates.led_white;
+            break;
+        case CONTROL_RELAY1:
+            BSP_Relay_Toggle(RELAY1_PIN);
+            g_DeviceStates.relay1 = !g_DeviceStates.relay1;
+            break;
+        case CONTROL_RELAY2:
+            BSP_Relay_Toggle(RELAY2_PIN);
+            g_DeviceStates.relay2 = !g_DeviceStates.relay2;
+            break;
+        case CONTROL_RELAY3:
+            BSP_Relay_Toggle(RELAY3_PIN);
+            g_DeviceStates.relay3 = !g_DeviceStates.relay3;
+            break;
+        case CONTROL_RELAY4:
+            BSP_Relay_Toggle(RELAY4_PIN);
+            g_DeviceStates.relay4 = !g_DeviceStates.relay4;
+            break;
+        case CONTROL_BUZZER:
+            Device_PlayBuzzer(BEEP_SUCCESS);
+            break;
     }
-    
-    BSP_Delay_ms(200);
 }
 
-void Handle_ControlDevices(void) 
+static void Control_Do(Fsm_t *fsm)
 {
-    Menu_Display();
-    
-    char key = Keypad_GetKey();
-    if(key == '2') { // Up
+    (void)fsm;
+
+    char key = ReadKey_Authenticated();
+    if (key == KEYPAD_NO_KEY) return;
+
+    if(key == KEY_UP) {
         if (g_SystemContext.currentControlItem > 0) {
             g_SystemContext.currentControlItem--;
         }
-    } else if(key == '8') { // Down
+    } else if(key == KEY_DOWN) {
         if (g_SystemContext.currentControlItem < CONTROL_MENU_MAX - 1) {
             g_SystemContext.currentControlItem++;
         }
-    } else if(key == '5') { // Toggle
-        // Toggle selected device
-        switch(g_SystemContext.currentControlItem) {
-            case CONTROL_LED_GREEN:
-                BSP_LED_Toggle(LED_GREEN_PIN);
-                g_DeviceStates.led_green = !g_DeviceStates.led_green;
-                break;
-            case CONTROL_LED_RED:
-                BSP_LED_Toggle(LED_RED_PIN);
-                g_DeviceStates.led_red = !g_DeviceStates.led_red;
-                break;
-            case CONTROL_LED_WHITE:
-                BSP_LED_Toggle(LED_WHITE_PIN);
-                g_DeviceStates.led_white = !g_DeviceStates.led_white;
-                break;
-            case CONTROL_RELAY1:
-                BSP_Relay_Toggle(RELAY1_PIN);
-                g_DeviceStates.relay1 = !g_DeviceStates.relay1;
-                break;
-            case CONTROL_RELAY2:
-                BSP_Relay_Toggle(RELAY2_PIN);
-                g_DeviceStates.relay2 = !g_DeviceStates.relay2;
-                break;
-            case CONTROL_RELAY3:
-                BSP_Relay_Toggle(RELAY3_PIN);
-                g_DeviceStates.relay3 = !g_DeviceStates.relay3;
-                break;
-            case CONTROL_RELAY4:
-                BSP_Relay_Toggle(RELAY4_PIN);
-                g_DeviceStates.relay4 = !g_DeviceStates.relay4;
-                break;
-            case CONTROL_BUZZER:
-                Device_PlayBuzzer(BEEP_SUCCESS);
-                break;
-        }
-    } else if(key == '*') {
-        g_SystemContext.currentState = STATE_ACTIVE_MENU;
-    } else if(key == '#') {
-        g_SystemContext.currentState = STATE_STANDBY;
-        g_SystemContext.isAuthenticated = false;
+    } else if(key == KEY_ENTER) {
+        Control_Toggle();
     }
-    BSP_Delay_ms(200);
+    Display_RequestRefresh();
+}
+
+/* ========================================================================
+   STATE 6: SETTINGS
+   - No settings yet, the screen only offers the way out
+   - *=Back, #=Logout (handled by AUTHENTICATED)
+   ======================================================================== */
+static void Settings_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
+    Display_RequestRefresh();
 }
 
-///* ========================================================================
-//   STATE 7: LOCKOUT MODE
-//   - Red LED + Buzzer blink 1s ON / 1s OFF for 3 cycles
-//   - Total duration: 5 seconds (configurable via LOCKOUT_TIME_SEC)
-//   - Then return to STANDBY
-//   ======================================================================== */
-void Handle_Lockout(void) 
+static void Settings_Do(Fsm_t *fsm)
 {
-    BSP_LCD_SetCursor(0,0);
-    BSP_LCD_PrintString(" SECURITY ALERT ");
-    BSP_LCD_SetCursor(1,0);
-    BSP_LCD_PrintString(" SYSTEM LOCKED  ");
+    (void)fsm;
+    (void)ReadKey_Authenticated();  // only '*' / '#' mean something here
+}
 
+/* ========================================================================
+   STATE 7: LOCKOUT MODE
+   - Red LED + Buzzer blink 500ms ON / 500ms OFF for 3 cycles
+   - Total duration: LOCKOUT_TIME_SEC, keypad ignored
+   - Then return to STANDBY (lockoutTimer -> EV_LOCKOUT_DONE)
+   ======================================================================== */
+static void Lockout_Entry(Fsm_t *fsm)
+{
+    (void)fsm;
+    g_SystemContext.lockoutEndTime = GetSystemTick() + (LOCKOUT_TIME_SEC * 1000U);
     UART_Printf("[ALERT] Lockout active\r\n");
+    Display_RequestRefresh();
 
-    for(int i=0; i < 3; i++) {
-        BSP_LED_On(LED_RED_PIN);
-        BSP_Buzzer_On();
-        BSP_Delay_ms(500);
-        BSP_LED_Off(LED_RED_PIN);
-        BSP_Buzzer_Off();
-        BSP_Delay_ms(500);
-    }
+    BSP_LED_On(LED_RED_PIN);
+    BSP_Buzzer_On();
+    alarmEdgesLeft = 2U * LOCKOUT_BLINK_CYCLES;
+    SoftTimer_Start(&alarmTimer, LOCKOUT_BLINK_MS, LOCKOUT_BLINK_MS);
+    SoftTimer_Start(&lockoutTimer, LOCKOUT_TIME_SEC * 1000U, 0);
+}
 
+static void Lockout_Do(Fsm_t *fsm)
+{
+    (void)fsm;
+    (void)Keypad_GetKey();  // drain - keys are ignored while locked
+}
+
+static void Lockout_Exit(Fsm_t *fsm)
+{
+    (void)fsm;
+    SoftTimer_Stop(&alarmTimer);
+    SoftTimer_Stop(&lockoutTimer);
+    BSP_LED_Off(LED_RED_PIN);
+    BSP_Buzzer_Off();
     g_SystemContext.loginAttempts = 0;
-    g_SystemContext.currentState = STATE_STANDBY;
+}
+
+/* ===== STATE TABLE (indexed by SystemState_t) ===== */
+static const FsmState_t stateTable[STATE_COUNT] = {
+    [STATE_STANDBY]         = { "STANDBY",     Standby_Entry,       Standby_Exit,       Standby_Do  },
+    [STATE_AUTHENTICATING]  = { "AUTH GATE",   Auth_Entry,          NULL,               Auth_Do     },
+    [STATE_ACTIVE_MENU]     = { "MAIN MENU",   Menu_Entry,          NULL,               Menu_Do     },
+    [STATE_SENSOR_MONITOR]  = { "MONITORING",  Sensors_Entry,       NULL,               Sensors_Do  },
+    [STATE_CONTROL_DEVICES] = { "DEVICE CTRL", Control_Entry,       NULL,               Control_Do  },
+    [STATE_SETTINGS]        = { "SETTINGS",    Settings_Entry,      NULL,               Settings_Do },
+    [STATE_LOCKOUT]         = { "LOCKED!!",    Lockout_Entry,       Lockout_Exit,       Lockout_Do  },
+    [STATE_ERROR]           = { "SYS ERROR",   NULL,                NULL,               NULL        },
+    [STATE_AUTHENTICATED]   = { "SESSION",     Authenticated_Entry, Authenticated_Exit, NULL        },
+};
+
+/* ===== HIERARCHY: parent of each state, initial child of each superstate ===== */
+static const FsmStateId_t stateParent[STATE_COUNT] = {
+    [STATE_STANDBY]         = FSM_NO_STATE,
+    [STATE_AUTHENTICATING]  = FSM_NO_STATE,
+    [STATE_ACTIVE_MENU]     = STATE_AUTHENTICATED,
+    [STATE_SENSOR_MONITOR]  = STATE_AUTHENTICATED,
+    [STATE_CONTROL_DEVICES] = STATE_AUTHENTICATED,
+    [STATE_SETTINGS]        = STATE_AUTHENTICATED,
+    [STATE_LOCKOUT]         = FSM_NO_STATE,
+    [STATE_ERROR]           = FSM_NO_STATE,
+    [STATE_AUTHENTICATED]   = FSM_NO_STATE,
+};
+
+static const FsmStateId_t stateInitial[STATE_COUNT] = {
+    [STATE_STANDBY]         = FSM_NO_STATE,
+    [STATE_AUTHENTICATING]  = FSM_NO_STATE,
+    [STATE_ACTIVE_MENU]     = FSM_NO_STATE,
+    [STATE_SENSOR_MONITOR]  = FSM_NO_STATE,
+    [STATE_CONTROL_DEVICES] = FSM_NO_STATE,
+    [STATE_SETTINGS]        = FSM_NO_STATE,
+    [STATE_LOCKOUT]         = FSM_NO_STATE,
+    [STATE_ERROR]           = FSM_NO_STATE,
+    [STATE_AUTHENTICATED]   = STATE_ACTIVE_MENU,
+};
+
+/* ===== TRANSITION TABLE (leaf rows first, then parent rows; first match wins) ===== */
+static const FsmTransition_t transitionTable[] = {
+    /* from                    event             guard              action          to */
+    { STATE_STANDBY,          EV_WAKEUP,        NULL,              Standby_Wakeup, STATE_AUTHENTICATING },
+
+    { STATE_AUTHENTICATING,   EV_PIN_ENTERED,   Auth_PinCorrect,   Auth_Success,   FSM_HISTORY(STATE_AUTHENTICATED) },
+    { STATE_AUTHENTICATING,   EV_PIN_ENTERED,   Auth_AttemptsLeft, Auth_Retry,     FSM_INTERNAL },
+    { STATE_AUTHENTICATING,   EV_PIN_ENTERED,   NULL,              Auth_Lockout,   STATE_LOCKOUT },
+
+    { STATE_ACTIVE_MENU,      EV_SELECT,        Menu_OnSensors,    NULL,           STATE_SENSOR_MONITOR },
+    { STATE_ACTIVE_MENU,      EV_SELECT,        Menu_OnControls,   NULL,           STATE_CONTROL_DEVICES },
+    { STATE_ACTIVE_MENU,      EV_SELECT,        Menu_OnSettings,   NULL,           STATE_SETTINGS },
+    { STATE_ACTIVE_MENU,      EV_BACK,          NULL,              NULL,           FSM_INTERNAL },  // already there
+
+    { STATE_AUTHENTICATED,    EV_BACK,          NULL,              NULL,           STATE_ACTIVE_MENU },
+    { STATE_AUTHENTICATED,    EV_LOGOUT,        NULL,              Session_Forget, STATE_STANDBY },
+    { STATE_AUTHENTICATED,    EV_TIMEOUT,       NULL,              NULL,           STATE_STANDBY },
+
+    { STATE_LOCKOUT,          EV_LOCKOUT_DONE,  NULL,              NULL,           STATE_STANDBY },
+};
+
+/**
+ * @brief Bind the state timers and tables (call once, after SoftTimer_Init)
+ */
+void StateHandlers_Init(Fsm_t *fsm)
+{
+    SoftTimer_Create(&blinkTimer, Standby_Blink, NULL);
+    SoftTimer_Create(&alarmTimer, Lockout_Alarm, NULL);
+    SoftTimer_Create(&lockoutTimer, Lockout_Expired, NULL);
+    SoftTimer_Create(&inactivityTimer, Inactivity_Timeout, NULL);
+    EventQueue_Subscribe(EVT_SRC_WAKEUP_BTN, Wakeup_OnEvent);
+
+    Fsm_Init(fsm,
+             stateTable, (uint8_t)(sizeof(stateTable) / sizeof(stateTable[0])),
+             transitionTable, (uint8_t)(sizeof(transitionTable) / sizeof(transitionTable[0])),
+             GetSystemTick, &g_SystemContext);
+    Fsm_SetHierarchy(fsm, stateParent, stateInitial);
+}
+
+/* ===== POWER-ON SELF-TEST =====
+ * A protothread run by the "selftest" scheduler task: the test keeps its
+ * sequential form while the FSM, intrusion events and displays run
+ * between its steps. The task removes itself when the test is done.
+ */
+static Pt_t selfTestPt;
+static TaskId_t selfTestTaskId = SCHED_INVALID_ID;
+static uint8_t selfTestResult = 0;
+
+static PT_THREAD(System_SelfTest(Pt_t *pt));
+
+/* Drives the relays back to g_DeviceStates (active LOW), which
+ * CONTROL_DEVICES keeps toggling while the test clicks them */
+static void SelfTest_RestoreRelays(void)
+{
+    BSP_Relay_SetState(RELAY1_PIN, g_DeviceStates.relay1 ? RESET : SET);
+    BSP_Relay_SetState(RELAY2_PIN, g_DeviceStates.relay2 ? RESET : SET);
+    BSP_Relay_SetState(RELAY3_PIN, g_DeviceStates.relay3 ? RESET : SET);
+    BSP_Relay_SetState(RELAY4_PIN, g_DeviceStates.relay4 ? RESET : SET);
+}
+
+static void SelfTest_Task(void)
+{
+    if (!PT_SCHEDULE(System_SelfTest(&selfTestPt))) {
+        Scheduler_RemoveTask(selfTestTaskId);
+        selfTestTaskId = SCHED_INVALID_ID;
+    }
+}
+
+/**
+ * @brief Start the self-test in the background (after StateMachine_Init)
+ */
+void SelfTest_Start(void)
+{
+    PT_INIT(&selfTestPt);
+    selfTestTaskId = Scheduler_AddTask("selftest", SelfTest_Task, SELFTEST_TASK_PERIOD_MS);
+}
+
+/**
+ * @brief true while the self-test task is still running
+ */
+bool SelfTest_IsRunning(void)
+{
+    return selfTestTaskId != SCHED_INVALID_ID;
+}
+
+/**
+ * @brief 0 if the last self-test passed, bitmask of errors otherwise
+ */
+uint8_t SelfTest_GetResult(void)
+{
+    return selfTestResult;
 }
 
 /**
  * @brief  Performs a comprehensive Autonomous Self-Test (POST).
  * Uses LEDs and Buzzer for physical signaling.
- * @return 0 if Pass, Bitmask of errors if Fail.
+ * @note   Protothread: ends with the bitmask of errors in SelfTest_GetResult().
  */
-uint8_t System_SelfTest(void) {
-    uint8_t error_mask = 0;
+static PT_THREAD(System_SelfTest(Pt_t *pt)) {
+    static Pt_t child;
+    static uint8_t error_mask;
+    static uint8_t cycle;
 //    char key;
 //    uint8_t key_pressed = 0;
 
+    PT_BEGIN(pt);
+
+    error_mask = 0;
     print_Log("Peripherals SCAN");
 
     // Toggle Green -> Red -> White -> Buzzer
@@ -332,8 +668,10 @@ uint8_t System_SelfTest(void) {
     /* --- TEST 2: I2C OLED (SSD1306) --- */
     UART_Printf("[SCAN] I2C OLED (Address 0x3C)...");
     if (I2C_CheckDevice(I2C1, OLED_I2C_ADDR) == 1) { // Check for ACK on I2C bus
-    	greet();
     	UART_Printf(" OK\r\n");
+    	Display_ClaimOLED(true);
+    	PT_SPAWN(pt, &child, greet(&child));
+    	Display_ClaimOLED(false);
     } else {
         UART_Printf(" NOT FOUND\r\n");
         error_mask |= (1 << 1);
@@ -383,19 +721,14 @@ uint8_t System_SelfTest(void) {
 //  	}
 
     /* --- TEST 5: Relay Matrix (Port B) --- */
-    print_Log("[SCAN] Relay ...");
+    // The menu is up by now: report on USART2 only, the displays are the FSM's
+    UART_Printf("[SCAN] Relay ...");
     // We toggle them fast so you hear a "click" during boot
-    for(int i=1; i<=5; i++) {
-        BSP_Delay_3s();
-        BSP_Relay_SetState(RELAY1_PIN, RESET);
-        BSP_Relay_SetState(RELAY2_PIN, RESET);
-        BSP_Relay_SetState(RELAY3_PIN, RESET);
-        BSP_Relay_SetState(RELAY4_PIN, RESET);
-        BSP_Delay_3s();
-        BSP_Relay_SetState(RELAY1_PIN, SET);
-        BSP_Relay_SetState(RELAY2_PIN, SET);
-        BSP_Relay_SetState(RELAY3_PIN, SET);
-        BSP_Relay_SetState(RELAY4_PIN, SET);
+    for(cycle=1; cycle<=5; cycle++) {
+        PT_AWAIT_MS(pt, 3000);
+        BSP_Relay_SetAll(RESET);
+        PT_AWAIT_MS(pt, 3000);
+        SelfTest_RestoreRelays();
     }
     UART_Printf(" OK\r\n");
 
@@ -406,9 +739,12 @@ uint8_t System_SelfTest(void) {
         Device_PlayBuzzer(BEEP_SUCCESS);
     } else {
         UART_Printf(">> STATUS: FATAL HARDWARE ERROR (Code: 0x%X)\r\n", error_mask);
+        UART_Printf(">> [INFO] Continuing anyway...\r\n");
         GPIO_WriteToOutputPin(LED_PORT, LED_RED_PIN, SET); // Solid RED for failure
         Device_PlayBuzzer(BEEP_ERROR);
     }
-    print_Log("TEST COMPLETE");
-    return error_mask;
+    UART_Printf(">> TEST COMPLETE\r\n");
+    selfTestResult = error_mask;
+
+    PT_END(pt);
 }
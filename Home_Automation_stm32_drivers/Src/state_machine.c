@@ -18,6 +18,13 @@
 #include "bsp_keypad.h"
 #include "bsp_uart2_debug.h"
 #include "bsp_delay.h"
+#include "bsp_timebase.h"
+#include "scheduler.h"
+#include "soft_timer.h"
+#include "event_queue.h"
+#include "profiler.h"
+#include "latency.h"
+#include "console.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -27,19 +34,80 @@ SystemContext_t g_SystemContext;
 SensorData_t g_SensorData;
 DeviceStates_t g_DeviceStates;
 
-extern volatile bool pc13_event;
-extern volatile bool pc8_intrusion_event;
-extern volatile bool pc6_intrusion_event;
-extern volatile uint32_t pc13_event_time;
+static void Intrusion_OnEvent(const Event_t *evt);
+static void Intrusion_ClearAlert(void *arg);
 
-void Process_Intrusion_Events(void);
+static SoftTimer_t intrusionAlertTimer;
+static Fsm_t systemFsm;
+static TaskId_t fsmTaskId = SCHED_INVALID_ID;
+static ProfZone_t stateZones[STATE_COUNT];
+static ProfZone_t actionZone = PROF_INVALID_ZONE;
+static uint32_t hookStart;
 
-///* ===== PRIVATE VARIABLES ===== */
-static uint32_t g_SystemTickCounter = 0;
+static const char *const eventNames[EV_COUNT] = {
+   "-", "WAKEUP", "PIN", "SELECT", "BACK", "LOGOUT", "TIMEOUT", "LOCKOUT_DONE"
+};
 
-void SysTick_Handler(void)
+/**
+ * @brief FSM observer: mirror the state into g_SystemContext and log it
+ */
+static void StateMachine_OnTransition(Fsm_t *fsm, const FsmTraceEntry_t *step)
+{
+   g_SystemContext.previousState = (step->from == FSM_NO_STATE) ? (SystemState_t)step->to
+                                                                 : (SystemState_t)step->from;
+   g_SystemContext.currentState = (SystemState_t)step->to;
+   g_SystemContext.stateEntryTime = step->tick;
+
+   UART_Printf("[FSM] %s -> %s (%s)\r\n", Fsm_StateName(fsm, step->from),
+               Fsm_StateName(fsm, step->to),
+               (step->event < EV_COUNT) ? eventNames[step->event] : "?");
+}
+
+/**
+ * @brief FSM probe: one profiler zone per state (entry, exit and do hooks)
+ *        plus one for all transition actions. Hooks never nest.
+ */
+static void StateMachine_Probe(Fsm_t *fsm, FsmStateId_t state, bool begin)
 {
-   g_SystemTickCounter++;
+   (void)fsm;
+   if (begin) {
+       hookStart = Prof_Now();
+   } else {
+       Prof_Record((state < STATE_COUNT) ? stateZones[state] : actionZone, Prof_Now() - hookStart);
+   }
+}
+
+/**
+ * @brief Wake hint of the "events" task: only a queued event is work
+ */
+static uint32_t Events_WakeHint(void)
+{
+   return (EventQueue_Count() != 0U) ? 0U : SCHED_NO_DEADLINE;
+}
+
+/* ===== EXTI CALLBACKS =====
+ * Called from the EXTI interrupts (GPIO_EXTI_Dispatch): queue the edge, all
+ * work happens in the "events" task. The dispatcher read the clock once
+ * before the callbacks of the vector; the edge carries that stamp.
+ */
+static uint32_t Exti_EdgeTime(uint8_t line)
+{
+   return GPIO_EXTI_GetStats(line)->LastTime;
+}
+
+static void WakeupBtn_OnEdge(uint8_t line, uint8_t level)
+{
+   EventQueue_Post(EVT_SRC_WAKEUP_BTN, level ? EVT_EDGE_RISING : EVT_EDGE_FALLING, Exti_EdgeTime(line));
+}
+
+static void IR1_OnEdge(uint8_t line, uint8_t level)
+{
+   EventQueue_Post(EVT_SRC_IR1, level ? EVT_EDGE_RISING : EVT_EDGE_FALLING, Exti_EdgeTime(line));
+}
+
+static void IR2_OnEdge(uint8_t line, uint8_t level)
+{
+   EventQueue_Post(EVT_SRC_IR2, level ? EVT_EDGE_RISING : EVT_EDGE_FALLING, Exti_EdgeTime(line));
 }
 
 /**
@@ -47,6 +115,18 @@ void SysTick_Handler(void)
 */
 void StateMachine_Init(void)
 {
+   // Cycle counter first: the BSP drivers are instrumented
+   Prof_Init();
+
+   // Event ring and EXTI callbacks must be in place before app_init() enables
+   // the EXTI interrupts; app_init() configures the pins and their vectors
+   EventQueue_Init();
+   Latency_Init();
+   GPIO_EXTI_SetClock(now_us32);      // no masking in the EXTI vectors
+   GPIO_EXTI_Attach(WAKEUP_BTN_PORT, WAKEUP_BTN_PIN, WakeupBtn_OnEdge);
+   GPIO_EXTI_Attach(IR1_PORT, IR1_PIN, IR1_OnEdge);
+   GPIO_EXTI_Attach(IR2_PORT, IR2_PIN, IR2_OnEdge);
+
    // Initialize all BSP components
 
    app_init();
@@ -59,7 +139,6 @@ void StateMachine_Init(void)
    // Set initial state
    g_SystemContext.currentState = STATE_STANDBY;
    g_SystemContext.previousState = STATE_STANDBY;
-   g_SystemContext.currentMenu = MENU_MAIN;
    g_SystemContext.currentSensorScreen = SENSOR_SCREEN_LDR;
    g_SystemContext.currentControlItem = CONTROL_LED_GREEN;
 
@@ -75,10 +154,9 @@ void StateMachine_Init(void)
    BSP_OLED_Update();
 
    // LCD Welcome
-   BSP_LCD_SetCursor(0, 0);
-   BSP_LCD_PrintString("  System Boot  ");
-   BSP_LCD_SetCursor(1, 0);
-   BSP_LCD_PrintString("  Please Wait  ");
+   BSP_LCD_SetLine(0, "  System Boot  ");
+   BSP_LCD_SetLine(1, "  Please Wait  ");
+   BSP_LCD_Flush();
 
    BSP_Delay_1s();
 
@@ -100,101 +178,143 @@ void StateMachine_Init(void)
    Display_UpdateOLED();
    Display_UpdateLCD();
    BSP_Delay_1s();
+
+   // Register the cooperative tasks (table order = dispatch order)
+   Scheduler_Init();
+   SoftTimer_Init();
+   SoftTimer_Create(&intrusionAlertTimer, Intrusion_ClearAlert, NULL);
+   // The 1 ms tasks tell the idle manager when they really have work
+   Scheduler_SetWakeHint(Scheduler_AddTask("timers", SoftTimer_Process, SOFT_TIMER_TASK_PERIOD_MS),
+                         SoftTimer_MsUntilNext);
+   Scheduler_SetWakeHint(Scheduler_AddTask("events", EventQueue_Dispatch, EVENT_TASK_PERIOD_MS),
+                         Events_WakeHint);
+   fsmTaskId = Scheduler_AddTask("fsm", StateMachine_Run, FSM_TASK_PERIOD_MS);
+   EventQueue_Subscribe(EVT_SRC_IR1, Intrusion_OnEvent);
+   EventQueue_Subscribe(EVT_SRC_IR2, Intrusion_OnEvent);
+   StateHandlers_Init(&systemFsm);
+   Fsm_SetObserver(&systemFsm, StateMachine_OnTransition);
+   for (uint8_t id = 0; id < STATE_COUNT; id++) {
+       stateZones[id] = Prof_AddZone(Fsm_StateName(&systemFsm, id));
+   }
+   actionZone = Prof_AddZone("fsm actions");
+   Fsm_SetProbe(&systemFsm, StateMachine_Probe);
+   Device_Init();
+   Sensors_Init();
+   Display_Init();
+   Console_Init();
+
+   // Runs STANDBY's entry hook, so the display tasks must exist by now
+   Fsm_Start(&systemFsm, STATE_STANDBY);
 }
 
 /**
- * @brief Main state machine execution - Call this in main loop
+ * @brief Main state machine execution - runs as the "fsm" scheduler task
+ * @note  Runs the "do" hook of the current state; transitions and their
+ *        entry/exit work happen in Fsm_Dispatch() via StateMachine_Post().
  */
 void StateMachine_Run(void)
 {
-    // Process intrusion events
-    Process_Intrusion_Events();
-
-    // State Machine Logic
-    switch (g_SystemContext.currentState) {
-        case STATE_STANDBY:
-            Handle_Standby();
-            break;
-
-        case STATE_AUTHENTICATING:
-            Handle_Authentication();
-            break;
-
-        case STATE_ACTIVE_MENU:
-            Handle_ActiveMenu();
-            break;
-
-        case STATE_SENSOR_MONITOR:
-            Handle_SensorMonitor();
-            break;
+    Fsm_Run(&systemFsm);
+}
 
-        case STATE_CONTROL_DEVICES:
-            Handle_ControlDevices();
-            break;
+/**
+ * @brief Change how often the "fsm" task runs the current state's do hook
+ * @note  STANDBY slows it down so the idle manager can use Stop mode.
+ */
+void StateMachine_SetRunPeriod(uint32_t period_ms)
+{
+    Scheduler_SetPeriod(fsmTaskId, period_ms);
+}
 
-        case STATE_LOCKOUT:
-            Handle_Lockout();
-            break;
+/**
+ * @brief Feed an event to the system FSM (thread context only)
+ * @return true if a transition accepted (or, from a hook, queued) it
+ */
+bool StateMachine_Post(SystemEvent_t event)
+{
+    return Fsm_Dispatch(&systemFsm, (FsmEventId_t)event);
+}
 
-        default:
-            // Invalid state - return to standby
-            UART_Printf("[CRITICAL] Invalid state detected: %d\r\n", g_SystemContext.currentState);
-            g_SystemContext.currentState = STATE_STANDBY;
-            break;
+/**
+ * @brief Dump the transition history over USART2, oldest first
+ */
+void StateMachine_PrintTrace(void)
+{
+    uint8_t count = Fsm_TraceCount(&systemFsm);
+
+    UART_Printf("[FSM] last %u transitions (%u total, %u unhandled, %u dropped)\r\n",
+                count, systemFsm.transitionCount, systemFsm.unhandledCount, systemFsm.droppedCount);
+    for (uint8_t age = count; age-- > 0U; ) {
+        const FsmTraceEntry_t *step = Fsm_GetTrace(&systemFsm, age);
+        UART_Printf("[FSM] %10u  %-11s -> %-11s (%s)\r\n", step->tick,
+                    Fsm_StateName(&systemFsm, step->from), Fsm_StateName(&systemFsm, step->to),
+                    (step->event < EV_COUNT) ? eventNames[step->event] : "?");
     }
+}
 
-    // Small delay to prevent CPU hogging
-    BSP_Delay_ms(20);
+/**
+ * @brief Soft timer callback: end of the 1 s red LED intrusion alert
+ */
+static void Intrusion_ClearAlert(void *arg)
+{
+    (void)arg;
+    BSP_LED_Off(LED_RED_PIN);
 }
 
-void Process_Intrusion_Events(void)
+/**
+ * @brief Event handler for both IR sensors (EVT_SRC_IR1 / EVT_SRC_IR2)
+ * @note  Alerts are rate limited to one every 2 s; every edge is still logged.
+ *        Actuators are driven before anything is printed, so the blocking
+ *        UART log stays out of the edge -> buzzer latency (see latency.h).
+ */
+static void Intrusion_OnEvent(const Event_t *evt)
 {
     static uint32_t last_intrusion_time = 0;
-    static bool intrusion_active = false;
-
-    bool pc6_triggered = false;
-    bool pc8_triggered = false;
-
-    /* --- Atomic flag copy --- */
-    __asm volatile ("cpsid i" ::: "memory");
+    static bool first_intrusion = true;
+    LatTrace_t trace;
 
-    pc6_triggered = pc6_intrusion_event;
-    pc8_triggered = pc8_intrusion_event;
-    pc6_intrusion_event = false;
-    pc8_intrusion_event = false;
+    Latency_Begin(&trace, evt);
 
-    __asm volatile ("cpsie i" ::: "memory");
     uint32_t current_time = GetSystemTick();
+    bool alert = first_intrusion || CheckTimeout(last_intrusion_time, 2000);
+
+    Latency_Decided(&trace);
 
     /* --- Intrusion detected --- */
-    if ((pc6_triggered || pc8_triggered) &&
-        CheckTimeout(last_intrusion_time, 2000))
+    if (alert)
     {
-        UART_Printf("[INTRUSION] Perimeter Breach!\r\n");
-
         BSP_LED_On(LED_RED_PIN);
         Device_PlayBuzzer(BEEP_WARNING);
-        update_lcd_display("INTRUSION!", "Check Perimeter");
+
+        /* --- Auto clear LED after 1 sec --- */
+        SoftTimer_Start(&intrusionAlertTimer, 1000, 0);
 
         last_intrusion_time = current_time;
-        intrusion_active = true;
+        first_intrusion = false;
     }
 
-    /* --- Auto clear LED after 1 sec --- */
-    if (intrusion_active &&
-        CheckTimeout(last_intrusion_time, 1000))
+    Latency_End(&trace);
+
+    UART_Printf("[EVENT] %s triggered (seq %u, t=%u us)\r\n",
+                (evt->source == EVT_SRC_IR1) ? "PC6 IR1" : "PC8 IR2",
+                (unsigned)evt->seq, (unsigned)evt->tick);
+
+    if (alert)
     {
-        BSP_LED_Off(LED_RED_PIN);
-        intrusion_active = false;
+        UART_Printf("[INTRUSION] Perimeter Breach! (edge -> buzzer %u us)\r\n",
+                    trace.actuated ? (unsigned)(trace.actuatorUs - trace.edgeUs) : 0U);
+        update_lcd_display("INTRUSION!", "Check Perimeter");
     }
 }
 
 /**
 * @brief Get current system tick in milliseconds
+* @note  Low 32 bits of now_ms(); wraps after ~49 days, so compare
+*        with unsigned subtraction (see CheckTimeout) or use now_ms().
 */
 uint32_t GetSystemTick(void)
 {
-   return g_SystemTickCounter;
+   return (uint32_t)now_ms();
 }
 
 /**
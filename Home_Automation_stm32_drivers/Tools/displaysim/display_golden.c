@@ -0,0 +1,363 @@
+/*
+ * display_golden.c
+ *
+ * Created on: Mar 4, 2026
+ * Author: Rahul B.
+ * Description: Golden image tests of the OLED and LCD screens on the display emulators
+ *
+ * Usage: display_golden <golden dir> <output dir> [--update]
+ *        (Tools/displaysim/run.py builds and runs it)
+ *
+ * The screens are drawn by the real display.c, sensors.c, auth_menu.c,
+ * bsp_lcd.c and bsp_i2c_oled.c, driven the way the scheduler drives them:
+ * a state change asks for a refresh, then the LCD and OLED tasks run. The
+ * scenarios run in a fixed order from power-on, so each one is drawn over
+ * the screen the one before left (as the dirty tracking sees it).
+ *
+ * After each scenario the glass of both panels is written to the output
+ * directory (<name>.oled.pbm, <name>.lcd.txt) and compared with the golden
+ * directory, and its cost on the buses is compared with golden/costs.txt:
+ *
+ *   oled_tx      I2C transactions to the OLED
+ *   oled_bytes   bytes on the I2C bus, address bytes included
+ *   lcd_bytes    instruction and data bytes sent to the LCD
+ *   blocked_us   time the CPU spent in BSP_Delay_* (LCD timing, mostly;
+ *                a full LCD queue makes the caller wait as well)
+ *
+ * A frame that differs or a cost that went up fails. A cost that went
+ * down is reported; --update writes the frames and costs as the new
+ * golden files. Protocol errors (GDDRAM writes while scrolling, unknown
+ * SSD1306 commands, LCD nibbles while it is busy) fail as well.
+ */
+
+#include "displaysim.h"
+#include "state_machine.h"
+#include "bsp_lcd.h"
+#include "bsp_i2c_oled.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SCENARIOS   16U
+#define COST_COUNT      4U
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} Scenario_t;
+
+typedef struct {
+    char name[32];
+    uint32_t cost[COST_COUNT];
+} CostLine_t;
+
+static const char *const s_costNames[COST_COUNT] = { "oled_tx", "oled_bytes", "lcd_bytes", "blocked_us" };
+
+static const char *s_goldenDir;
+static const char *s_outDir;
+static bool s_update = false;
+static uint8_t s_failures = 0;
+
+static CostLine_t s_golden[MAX_SCENARIOS];
+static uint8_t s_goldenCount = 0;
+static CostLine_t s_measured[MAX_SCENARIOS];
+static uint8_t s_measuredCount = 0;
+
+static void Fail(const char *scenario, const char *what)
+{
+    s_failures++;
+    printf("[FAIL] %s: %s\n", scenario, what);
+}
+
+/* ===== SCENARIOS ===== */
+
+/* What the scheduler does after a state change */
+static void Refresh(void)
+{
+    Display_RequestRefresh();
+    Display_LCDTask();
+    Display_OLEDTask();
+}
+
+static void Enter(SystemState_t state)
+{
+    g_SystemContext.previousState = g_SystemContext.currentState;
+    g_SystemContext.currentState = state;
+    Refresh();
+}
+
+static void Boot(void)
+{
+    BSP_LCD_Init();
+    BSP_OLED_Init();
+    Display_Init();
+    Display_ClearAll();
+}
+
+static void Standby(void)
+{
+    Enter(STATE_STANDBY);
+}
+
+static void PinEntry(void)
+{
+    g_SystemContext.pinIndex = 2;
+    Enter(STATE_AUTHENTICATING);
+}
+
+static void MainMenu(void)
+{
+    g_SystemContext.pinIndex = 0;
+    g_SystemContext.isAuthenticated = true;
+    strcpy(g_SystemContext.currentUser, "Rahul");
+    g_SystemContext.menuCursor = 1;
+    Enter(STATE_ACTIVE_MENU);
+}
+
+static void SensorMonitor(void)
+{
+    // 40 samples of a slow dusk: LDR1 darkens, LDR2 stays bright
+    for (uint16_t i = 0; i < 40U; i++) {
+        Sim_SetLDR(SENSOR_LDR1_CHANNEL, (uint16_t)(600U + i * 70U + ((i % 5U) * 90U)));
+        Sim_SetLDR(SENSOR_LDR2_CHANNEL, 900);
+        Sensors_Task();
+    }
+    g_SystemContext.currentSensorScreen = SENSOR_SCREEN_LDR;
+    Enter(STATE_SENSOR_MONITOR);
+}
+
+/* The periodic refresh with nothing new to show */
+static void SensorIdle(void)
+{
+    Sim_AdvanceUs(LCD_UPDATE_INTERVAL * 1000U);
+    Display_LCDTask();
+    Display_OLEDTask();
+}
+
+static void ControlMenu(void)
+{
+    g_DeviceStates.relay2 = true;
+    g_DeviceStates.relay3 = false;
+    g_SystemContext.currentControlItem = CONTROL_RELAY2;
+    Enter(STATE_CONTROL_DEVICES);
+}
+
+static void Settings(void)
+{
+    Enter(STATE_SETTINGS);
+}
+
+static void Lockout(void)
+{
+    g_SystemContext.isAuthenticated = false;
+    g_SystemContext.lockoutEndTime = GetSystemTick() + 42000U;
+    Enter(STATE_LOCKOUT);
+}
+
+static void LogMessage(void)
+{
+    print_Log("Door %s", "open");
+}
+
+/* Down to Logout and back up, a refresh per key as Menu_Do() does */
+static void MenuNavigation(void)
+{
+    static const int8_t keys[] = { +1, +1, +1, -1, -1, -1 };
+
+    g_SystemContext.isAuthenticated = true;
+    g_SystemContext.menuCursor = 0;
+    Enter(STATE_ACTIVE_MENU);
+    for (uint8_t i = 0; i < sizeof(keys); i++) {
+        g_SystemContext.menuCursor = (uint8_t)(g_SystemContext.menuCursor + keys[i]);
+        Refresh();
+    }
+}
+
+static const Scenario_t s_scenarios[] = {
+    { "boot",           Boot },
+    { "standby",        Standby },
+    { "pin_entry",      PinEntry },
+    { "main_menu",      MainMenu },
+    { "sensor_monitor", SensorMonitor },
+    { "sensor_idle",    SensorIdle },
+    { "control_menu",   ControlMenu },
+    { "settings",       Settings },
+    { "lockout",        Lockout },
+    { "log_message",    LogMessage },
+    { "menu_navigation", MenuNavigation },
+};
+
+/* ===== GOLDEN FILES ===== */
+
+static bool Read_File(const char *path, char *buf, size_t size, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL) return false;
+    *len = fread(buf, 1, size, f);
+    fclose(f);
+    return true;
+}
+
+static bool Same_Files(const char *a, const char *b)
+{
+    static char bufA[16384], bufB[16384];
+    size_t lenA, lenB;
+
+    if (!Read_File(a, bufA, sizeof(bufA), &lenA) || !Read_File(b, bufB, sizeof(bufB), &lenB)) return false;
+    return lenA == lenB && memcmp(bufA, bufB, lenA) == 0;
+}
+
+static void Load_Costs(void)
+{
+    char path[256], line[128];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s/costs.txt", s_goldenDir);
+    if ((f = fopen(path, "r")) == NULL) return;
+
+    while (fgets(line, sizeof(line), f) != NULL && s_goldenCount < MAX_SCENARIOS) {
+        CostLine_t *c = &s_golden[s_goldenCount];
+
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%31s %u %u %u %u", c->name, &c->cost[0], &c->cost[1], &c->cost[2], &c->cost[3]) == 5) {
+            s_goldenCount++;
+        }
+    }
+    fclose(f);
+}
+
+static void Save_Costs(void)
+{
+    char path[256];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s/costs.txt", s_goldenDir);
+    if ((f = fopen(path, "w")) == NULL) {
+        Fail("costs", "cannot write costs.txt");
+        return;
+    }
+    fprintf(f, "# scenario          oled_tx  oled_bytes  lcd_bytes  blocked_us\n");
+    for (uint8_t i = 0; i < s_measuredCount; i++) {
+        const CostLine_t *c = &s_measured[i];
+        fprintf(f, "%-18s %8u %11u %10u %11u\n", c->name, c->cost[0], c->cost[1], c->cost[2], c->cost[3]);
+    }
+    fclose(f);
+}
+
+static const CostLine_t *Golden_Cost(const char *name)
+{
+    for (uint8_t i = 0; i < s_goldenCount; i++) {
+        if (strcmp(s_golden[i].name, name) == 0) return &s_golden[i];
+    }
+    return NULL;
+}
+
+/* Writes the glass of one panel and compares it with its golden file */
+static void Check_Frame(const char *name, const char *suffix, bool (*write)(const char *))
+{
+    char out[256], golden[256], what[320];
+
+    snprintf(out, sizeof(out), "%s/%s.%s", s_outDir, name, suffix);
+    snprintf(golden, sizeof(golden), "%s/%s.%s", s_goldenDir, name, suffix);
+    if (!write(out)) {
+        Fail(name, "cannot write the output frame");
+        return;
+    }
+    if (s_update) {
+        if (!write(golden)) Fail(name, "cannot write the golden frame");
+        return;
+    }
+    if (!Same_Files(out, golden)) {
+        snprintf(what, sizeof(what), "%s differs from the golden frame, see %s", suffix, out);
+        Fail(name, what);
+    }
+}
+
+static void Check_Costs(const CostLine_t *c)
+{
+    const CostLine_t *g = Golden_Cost(c->name);
+    char what[96];
+
+    if (s_update) return;
+    if (g == NULL) {
+        Fail(c->name, "no golden cost, run with --update");
+        return;
+    }
+    for (uint8_t k = 0; k < COST_COUNT; k++) {
+        if (c->cost[k] > g->cost[k]) {
+            snprintf(what, sizeof(what), "%s went up: %u -> %u", s_costNames[k], g->cost[k], c->cost[k]);
+            Fail(c->name, what);
+        } else if (c->cost[k] < g->cost[k]) {
+            printf("[INFO] %s: %s went down: %u -> %u (--update to keep it)\n",
+                   c->name, s_costNames[k], g->cost[k], c->cost[k]);
+        }
+    }
+}
+
+/* ===== RUN ===== */
+
+static void Run_Scenario(const Scenario_t *s)
+{
+    CostLine_t *c = &s_measured[s_measuredCount++];
+    uint64_t blockedStart = Sim_BlockedUs();
+
+    Sim_OLED_ResetStats();
+    Sim_LCD_ResetStats();
+    s->run();
+
+    // Queued LCD bytes go out from the TIM6 interrupt (not blocking time)
+    while (BSP_LCD_QueueDepth() != 0U) Sim_AdvanceUs(LCD_EXEC_US);
+
+    const SimOledStats_t *oled = Sim_OLED_GetStats();
+    const SimLcdStats_t *lcd = Sim_LCD_GetStats();
+
+    snprintf(c->name, sizeof(c->name), "%s", s->name);
+    c->cost[0] = oled->transactions;
+    c->cost[1] = oled->bytes;
+    c->cost[2] = lcd->instructions + lcd->dataBytes;
+    c->cost[3] = (uint32_t)(Sim_BlockedUs() - blockedStart);
+
+    printf("%-18s %8u %11u %10u %11u\n", c->name, c->cost[0], c->cost[1], c->cost[2], c->cost[3]);
+
+    if (oled->ramWritesWhileScrolling != 0U) Fail(s->name, "GDDRAM written while scrolling");
+    if (oled->scrollSetupsWhileScrolling != 0U) Fail(s->name, "scroll set up while scrolling");
+    if (oled->unknownCommands != 0U) Fail(s->name, "unknown SSD1306 command");
+    if (lcd->busyViolations != 0U) Fail(s->name, "LCD written while busy");
+
+    Check_Frame(s->name, "oled.pbm", Sim_OLED_WritePBM);
+    Check_Frame(s->name, "lcd.txt", Sim_LCD_WriteText);
+    Check_Costs(c);
+
+    // Let held messages expire before the next scenario (not blocking time)
+    Sim_AdvanceUs(2U * DISPLAY_MSG_HOLD_MS * 1000U);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <golden dir> <output dir> [--update]\n", argv[0]);
+        return 2;
+    }
+    s_goldenDir = argv[1];
+    s_outDir = argv[2];
+    s_update = (argc > 3 && strcmp(argv[3], "--update") == 0);
+
+    Load_Costs();
+    Sim_OLED_Reset();
+    Sim_LCD_Reset();
+    Scheduler_Init();
+
+    printf("# scenario          oled_tx  oled_bytes  lcd_bytes  blocked_us\n");
+    for (uint8_t i = 0; i < sizeof(s_scenarios) / sizeof(s_scenarios[0]); i++) {
+        Run_Scenario(&s_scenarios[i]);
+    }
+
+    if (s_update) {
+        Save_Costs();
+        printf("golden files updated in %s\n", s_goldenDir);
+    }
+    printf("%s (%u failures)\n", s_failures ? "FAILED" : "ALL PASSED", s_failures);
+    return s_failures ? 1 : 0;
+}
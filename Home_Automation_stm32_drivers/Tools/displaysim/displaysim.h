@@ -0,0 +1,121 @@
+/*
+ * displaysim.h
+ *
+ * Created on: Mar 4, 2026
+ * Author: Rahul B.
+ * Description: Host emulators of the SSD1306 OLED and the HD44780 LCD
+ *
+ * A host build of the display layer (bsp_i2c_oled.c, bsp_lcd.c and the
+ * application code that draws with them) links these files instead of
+ * the register level drivers:
+ *
+ *   sim_ssd1306.c   the I2C driver: every transaction to the OLED address
+ *                   goes through an SSD1306 command interpreter into its
+ *                   GDDRAM. The DMA path completes at once: the bytes are
+ *                   delivered and I2C_EV_TX_CMPLT raised before
+ *                   I2C_MasterSendDataDMA() returns, unless a test defers
+ *                   it and plays the I2C1 interrupt itself. I2C1 is a
+ *                   register block in RAM.
+ *   sim_hd44780.c   the GPIO driver: the LCD pins of config.h feed an
+ *                   HD44780 in 4-bit mode, a nibble per falling edge of EN
+ *                   (the out-of-line single pin and BSRR mask writes; the
+ *                   inline GPIO_*Fast variants are not emulated)
+ *   sim_host.c      the clock (now_us/now_ms, BSP_Delay_* advance it
+ *                   instead of waiting), TIM6 in one-pulse mode (its
+ *                   interrupt runs when the clock passes the end of an
+ *                   interval), UART_Printf on stdout, and what display.c /
+ *                   sensors.c need from state_machine.c
+ *
+ * Both models count what crosses their bus, so a test can put a price on a
+ * screen, and render what the panel shows: a PBM image for the OLED, the
+ * 16x2 characters as text for the LCD. display_golden.c compares those
+ * against Tools/displaysim/golden; Tools/displaysim/run.py builds and runs it.
+ */
+
+#ifndef DISPLAYSIM_H_
+#define DISPLAYSIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- Clock ---
+uint64_t Sim_NowUs(void);
+void Sim_AdvanceUs(uint64_t us);        // runs the TIM6 interrupts that fall due
+uint64_t Sim_BlockedUs(void);           // time spent in BSP_Delay_* since power-up
+
+// --- Board ---
+void Sim_SetLDR(uint8_t channel, uint16_t raw);
+
+// --- SSD1306 ---
+typedef struct {
+    uint32_t transactions;      // I2C transactions to the OLED address
+    uint32_t bytes;             // bytes on the bus, address byte included
+    uint32_t commandBytes;      // command and argument bytes
+    uint32_t dataBytes;         // GDDRAM writes
+    uint32_t ramWritesWhileScrolling;   // prohibited by the datasheet
+    uint32_t scrollSetupsWhileScrolling;    // 26h/27h/29h/2Ah without 2Eh first, same
+    uint32_t unknownCommands;
+    uint8_t pagesWritten;       // GDDRAM pages written, bit n = page n
+} SimOledStats_t;
+
+#define SIM_OLED_LAST_TX        32      // bytes kept of the last transaction
+
+/* Power-on state: display off, page addressing, GDDRAM noise. The first
+   transaction powers the panel up if no test did. */
+void Sim_OLED_Reset(void);
+const SimOledStats_t *Sim_OLED_GetStats(void);
+void Sim_OLED_ResetStats(void);
+
+/* The RAM as the firmware addresses it: page by page, LSB = top row */
+const uint8_t *Sim_OLED_GetRAM(void);
+
+/* Pixel as seen on the glass: display on/off, inverse, entire display on
+   and the start line applied (x to the right, y down, as drawn) */
+bool Sim_OLED_Pixel(uint8_t x, uint8_t y);
+bool Sim_OLED_IsOn(void);
+bool Sim_OLED_IsScrolling(void);
+
+/* The glass as a 128x64 P1 PBM, 1 = lit */
+bool Sim_OLED_WritePBM(const char *path);
+
+/* The last transaction to the OLED address, control bytes included: its
+   length, and its first SIM_OLED_LAST_TX bytes */
+const uint8_t *Sim_OLED_LastTransaction(uint32_t *len);
+
+/* Bus time: every transaction advances the clock by its bytes, address
+   byte included. 0 (power-up) puts it on the bus in no time. */
+void Sim_OLED_SetBusTime(uint32_t usPerByte);
+
+/* Deferred DMA: I2C_MasterSendDataDMA() copies the transaction and
+   returns, I2C_BUSY_IN_TX while one is pending. Each call of
+   Sim_OLED_DmaStep() is the I2C1 interrupt that completes it; false if
+   none was pending. Sim_OLED_DmaFail() has the panel NACK it instead:
+   nothing delivered, I2C_ERROR_AF raised. */
+void Sim_OLED_SetDmaDeferred(bool deferred);
+bool Sim_OLED_DmaStep(void);
+bool Sim_OLED_DmaFail(void);
+
+// --- HD44780 ---
+#define SIM_LCD_COLS            16
+#define SIM_LCD_ROWS            2
+
+typedef struct {
+    uint32_t nibbles;           // falling edges of EN
+    uint32_t instructions;      // instruction bytes (RS = 0)
+    uint32_t dataBytes;         // characters written (RS = 1)
+    uint32_t busyViolations;    // nibbles sent before the last instruction finished
+} SimLcdStats_t;
+
+/* Power-on state: 8-bit interface, display off, DDRAM blank */
+void Sim_LCD_Reset(void);
+const SimLcdStats_t *Sim_LCD_GetStats(void);
+void Sim_LCD_ResetStats(void);
+
+/* Visible characters of row, display shift applied, SIM_LCD_COLS + 1 bytes */
+void Sim_LCD_GetRow(uint8_t row, char *out);
+bool Sim_LCD_IsOn(void);
+
+/* The visible characters framed as text, one line per row */
+bool Sim_LCD_WriteText(const char *path);
+
+#endif /* DISPLAYSIM_H_ */
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+run.py
+
+Created on: Mar 4, 2026
+Author: Rahul B.
+Description: Builds the display emulator test (display_golden.c) for the host
+             and runs it against Tools/displaysim/golden
+
+Usage (from the project directory):
+
+    python3 Tools/displaysim/run.py             compare frames and bus costs
+    python3 Tools/displaysim/run.py --update    accept the current ones as golden
+
+The firmware files in SOURCES are compiled as they are; the files of this
+directory stand in for the register level drivers (see displaysim.h). The
+compiler is $CC, gcc by default. The frames of a failed run are left in the
+output directory it prints, next to the golden ones for a diff.
+"""
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+PROJECT = os.path.normpath(os.path.join(HERE, "..", ".."))
+GOLDEN = os.path.join(HERE, "golden")
+
+# Firmware under test, relative to the project directory
+SOURCES = [
+    "Src/display.c",
+    "Src/sensors.c",
+    "Src/auth_menu.c",
+    "Src/scheduler.c",
+    "Src/profiler.c",
+    "BSP/Src/bsp_lcd.c",
+    "BSP/Src/bsp_i2c_oled.c",
+    "BSP/Src/bsp_oled_gfx.c",
+    "BSP/Src/bsp_oled_font.c",
+    "BSP/Src/bsp_oled_font_data.c",
+    "BSP/Src/bsp_oled_image.c",
+    "BSP/Src/bsp_oled_image_data.c",
+]
+
+# Emulators and the test
+SIM_SOURCES = ["sim_ssd1306.c", "sim_hd44780.c", "sim_host.c", "display_golden.c"]
+
+INCLUDES = ["Tools/displaysim", "Application/Inc", "BSP/Inc", "Drivers/Inc", "Inc"]
+
+CFLAGS = [
+    "-std=gnu11", "-O1", "-Wall",
+    # The peripheral base addresses of stm32f446xx.h are 32-bit integers
+    "-Wno-int-to-pointer-cast", "-Wno-pointer-to-int-cast",
+    # uint32_t is unsigned long on the target, the %lu there is right
+    "-Wno-format",
+]
+
+
+def main():
+    update = "--update" in sys.argv[1:]
+    cc = os.environ.get("CC", "gcc")
+    out = tempfile.mkdtemp(prefix="displaysim-")
+    exe = os.path.join(out, "display_golden")
+
+    cmd = [cc] + CFLAGS + ["-I" + os.path.join(PROJECT, d) for d in INCLUDES]
+    cmd += [os.path.join(PROJECT, s) for s in SOURCES]
+    cmd += [os.path.join(HERE, s) for s in SIM_SOURCES]
+    cmd += ["-o", exe]
+    if subprocess.call(cmd) != 0:
+        sys.stderr.write("displaysim: build failed\n")
+        return 2
+
+    os.makedirs(GOLDEN, exist_ok=True)
+    args = [exe, GOLDEN, out] + (["--update"] if update else [])
+    result = subprocess.call(args)
+
+    if result == 0:
+        shutil.rmtree(out)
+    else:
+        print("displaysim: frames of this run are in %s" % out)
+    return result
+
+
+if __name__ == "__main__":
+    sys.exit(main())
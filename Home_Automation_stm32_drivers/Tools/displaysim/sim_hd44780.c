@@ -0,0 +1,246 @@
+/*
+ * sim_hd44780.c
+ *
+ * Created on: Mar 4, 2026
+ * Author: Rahul B.
+ * Description: HD44780 emulator behind a host GPIO driver (see displaysim.h)
+ */
+
+#include "displaysim.h"
+#include "stm32f446xx_gpio_driver.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SIM_LCD_LINE_LEN        40U     // DDRAM bytes per line (2-line mode)
+#define SIM_LCD_EXEC_US         37U     // most instructions and data writes
+#define SIM_LCD_CLEAR_US        1520U   // clear display, return home
+
+// --- Controller State ---
+static uint8_t s_ddram[0x80];
+static uint8_t s_cgram[64];
+static uint8_t s_ac;                    // address counter (DDRAM or CGRAM)
+static bool s_cgMode;                   // s_ac points into CGRAM
+static bool s_eightBit, s_twoLines;
+static bool s_displayOn, s_cursorOn, s_blinkOn;
+static bool s_increment, s_shiftOnWrite;
+static int8_t s_shift;                  // display shift, > 0 = right
+static bool s_haveHigh;                 // 4-bit mode: high nibble latched
+static uint8_t s_high;
+static uint64_t s_busyUntilUs;
+
+// --- Pins (LCD_CTRL_PORT / LCD_DATA_PORT of config.h) ---
+static uint8_t s_rs, s_en, s_data;      // s_data: D7..D4 in bits 3..0
+
+static SimLcdStats_t s_stats;
+
+void Sim_LCD_Reset(void)
+{
+    memset(s_ddram, ' ', sizeof(s_ddram));
+    memset(s_cgram, 0, sizeof(s_cgram));
+    s_ac = 0;
+    s_cgMode = false;
+    s_eightBit = true;
+    s_twoLines = false;
+    s_displayOn = s_cursorOn = s_blinkOn = false;
+    s_increment = true;
+    s_shiftOnWrite = false;
+    s_shift = 0;
+    s_haveHigh = false;
+    s_busyUntilUs = 0;
+    s_rs = s_en = s_data = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+const SimLcdStats_t *Sim_LCD_GetStats(void)
+{
+    return &s_stats;
+}
+
+void Sim_LCD_ResetStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+bool Sim_LCD_IsOn(void)
+{
+    return s_displayOn;
+}
+
+// --- Instructions ---
+
+/* Next DDRAM address: line 1 is 00h..27h, line 2 40h..67h */
+static uint8_t Sim_LCD_Step(uint8_t ac, bool up)
+{
+    if (!s_twoLines) return (uint8_t)((ac + (up ? 1 : 0x4F)) % 0x50);
+
+    if (up) {
+        if (ac == 0x27) return 0x40;
+        if (ac == 0x67) return 0x00;
+        return (uint8_t)(ac + 1);
+    }
+    if (ac == 0x00) return 0x67;
+    if (ac == 0x40) return 0x27;
+    return (uint8_t)(ac - 1);
+}
+
+static void Sim_LCD_Instruction(uint8_t cmd)
+{
+    uint32_t execUs = SIM_LCD_EXEC_US;
+
+    s_stats.instructions++;
+    if (cmd & 0x80) {
+        s_ac = cmd & 0x7F;
+        s_cgMode = false;
+    } else if (cmd & 0x40) {
+        s_ac = cmd & 0x3F;
+        s_cgMode = true;
+    } else if (cmd & 0x20) {
+        s_eightBit = (cmd & 0x10) != 0;
+        s_twoLines = (cmd & 0x08) != 0;
+        s_haveHigh = false;
+    } else if (cmd & 0x10) {
+        bool right = (cmd & 0x04) != 0;
+
+        if (cmd & 0x08) s_shift = (int8_t)((s_shift + (right ? 1 : -1)) % (int8_t)SIM_LCD_LINE_LEN);
+        else s_ac = Sim_LCD_Step(s_ac, right);
+    } else if (cmd & 0x08) {
+        s_displayOn = (cmd & 0x04) != 0;
+        s_cursorOn = (cmd & 0x02) != 0;
+        s_blinkOn = (cmd & 0x01) != 0;
+    } else if (cmd & 0x04) {
+        s_increment = (cmd & 0x02) != 0;
+        s_shiftOnWrite = (cmd & 0x01) != 0;
+    } else if (cmd & 0x02) {
+        s_ac = 0;
+        s_cgMode = false;
+        s_shift = 0;
+        execUs = SIM_LCD_CLEAR_US;
+    } else if (cmd & 0x01) {
+        memset(s_ddram, ' ', sizeof(s_ddram));
+        s_ac = 0;
+        s_cgMode = false;
+        s_shift = 0;
+        s_increment = true;
+        execUs = SIM_LCD_CLEAR_US;
+    }
+    s_busyUntilUs = Sim_NowUs() + execUs;
+}
+
+static void Sim_LCD_Data(uint8_t value)
+{
+    s_stats.dataBytes++;
+    if (s_cgMode) {
+        s_cgram[s_ac & 0x3F] = value;
+        s_ac = (uint8_t)((s_ac + (s_increment ? 1 : -1)) & 0x3F);
+    } else {
+        s_ddram[s_ac & 0x7F] = value;
+        s_ac = Sim_LCD_Step(s_ac, s_increment);
+        if (s_shiftOnWrite) s_shift = (int8_t)((s_shift + (s_increment ? -1 : 1)) % (int8_t)SIM_LCD_LINE_LEN);
+    }
+    s_busyUntilUs = Sim_NowUs() + SIM_LCD_EXEC_US + 4U;
+}
+
+/* Falling edge of EN: the controller latches D7..D4 (D3..D0 are not wired) */
+static void Sim_LCD_Latch(void)
+{
+    s_stats.nibbles++;
+    if (Sim_NowUs() < s_busyUntilUs) s_stats.busyViolations++;
+
+    if (s_eightBit) {
+        uint8_t value = (uint8_t)(s_data << 4);
+        if (s_rs) Sim_LCD_Data(value);
+        else Sim_LCD_Instruction(value);
+        return;
+    }
+    if (!s_haveHigh) {
+        s_high = s_data;
+        s_haveHigh = true;
+        return;
+    }
+    s_haveHigh = false;
+
+    uint8_t value = (uint8_t)((s_high << 4) | s_data);
+    if (s_rs) Sim_LCD_Data(value);
+    else Sim_LCD_Instruction(value);
+}
+
+// --- Glass ---
+
+void Sim_LCD_GetRow(uint8_t row, char *out)
+{
+    uint8_t base = (row == 0) ? 0x00 : 0x40;
+
+    for (uint8_t col = 0; col < SIM_LCD_COLS; col++) {
+        int16_t offset = (int16_t)((col - s_shift) % (int16_t)SIM_LCD_LINE_LEN);
+        uint8_t c = ' ';
+
+        if (offset < 0) offset += SIM_LCD_LINE_LEN;
+        if (s_displayOn && (row == 0 || s_twoLines)) c = s_ddram[base + offset];
+        out[col] = (c >= 0x20 && c <= 0x7E) ? (char)c : '?';   // CGRAM and ROM symbols
+    }
+    out[SIM_LCD_COLS] = '\0';
+}
+
+bool Sim_LCD_WriteText(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    char line[SIM_LCD_COLS + 1];
+
+    if (f == NULL) return false;
+    fprintf(f, "+----------------+\n");
+    for (uint8_t row = 0; row < SIM_LCD_ROWS; row++) {
+        Sim_LCD_GetRow(row, line);
+        fprintf(f, "|%s|\n", line);
+    }
+    fprintf(f, "+----------------+\n");
+    return fclose(f) == 0;
+}
+
+// --- GPIO Driver ---
+
+/* One BSRR write: RS and D4-D7 take their levels first, EN last, so a
+ * falling EN in the same write latches the new data */
+static void Sim_GPIO_Write(GPIO_RegDef_t *pGPIOx, uint16_t setMask, uint16_t resetMask)
+{
+    static const uint8_t dataPins[4] = { LCD_D4_PIN, LCD_D5_PIN, LCD_D6_PIN, LCD_D7_PIN };
+    uint16_t rs = GPIO_PIN_MASK(LCD_RS_PIN), en = GPIO_PIN_MASK(LCD_EN_PIN);
+
+    if (pGPIOx == LCD_CTRL_PORT && ((setMask | resetMask) & rs)) {
+        s_rs = (setMask & rs) ? 1U : 0U;
+    }
+
+    if (pGPIOx == LCD_DATA_PORT) {
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            uint16_t pin = GPIO_PIN_MASK(dataPins[bit]);
+            if (setMask & pin) s_data |= (uint8_t)(1U << bit);
+            else if (resetMask & pin) s_data &= (uint8_t)~(1U << bit);
+        }
+    }
+
+    if (pGPIOx == LCD_CTRL_PORT && ((setMask | resetMask) & en)) {
+        uint8_t level = (setMask & en) ? 1U : 0U;
+        if (s_en && !level) Sim_LCD_Latch();
+        s_en = level;
+    }
+}
+
+void GPIO_WriteToOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Value)
+{
+    if (Value == GPIO_PIN_SET) Sim_GPIO_Write(pGPIOx, GPIO_PIN_MASK(PinNumber), 0);
+    else Sim_GPIO_Write(pGPIOx, 0, GPIO_PIN_MASK(PinNumber));
+}
+
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask) { Sim_GPIO_Write(pGPIOx, PinMask, 0); }
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask) { Sim_GPIO_Write(pGPIOx, 0, PinMask); }
+
+void GPIO_WriteMasked(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, uint16_t Value)
+{
+    Sim_GPIO_Write(pGPIOx, PinMask & Value, PinMask & (uint16_t)~Value);
+}
+
+void GPIO_Init(GPIO_Handle_t *pGPIOHandle) { (void)pGPIOHandle; }
+void GPIO_InitGroup(const GPIO_Handle_t *pPins, uint8_t Count) { (void)pPins; (void)Count; }
+void GPIO_PeriClockControl(GPIO_RegDef_t *pGPIOx, uint8_t EnorDi) { (void)pGPIOx; (void)EnorDi; }
+uint8_t GPIO_ReadFromInputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber) { (void)pGPIOx; (void)PinNumber; return 1; }
+void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber) { (void)pGPIOx; (void)PinNumber; }
@@ -0,0 +1,138 @@
+/*
+ * sim_host.c
+ *
+ * Created on: Mar 4, 2026
+ * Author: Rahul B.
+ * Description: Clock, delays, TIM6, console and application globals of the display emulator build
+ */
+
+#include "displaysim.h"
+#include "state_machine.h"
+#include "bsp_delay.h"
+#include "bsp_timebase.h"
+#include "bsp_uart2_debug.h"
+#include "stm32f446xx_timer_driver.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+// --- Clock ---
+// Time only moves when the firmware waits (BSP_Delay_*) or a test says so.
+static uint64_t s_nowUs = 0;
+static uint64_t s_blockedUs = 0;
+
+// --- TIM6 (one-pulse mode, the LCD transport) ---
+static uint32_t s_tim6TickUs = 1;
+static bool s_tim6Armed = false;
+static bool s_tim6Flag = false;
+static bool s_tim6IrqOn = false;
+static uint64_t s_tim6DueUs;
+
+void TIM6_DAC_IRQHandler(void);
+
+/* bsp_lcd.c brings the real handler, a build without the LCD links this */
+__attribute__((weak)) void TIM6_DAC_IRQHandler(void) { }
+
+/* Runs the interrupts due by `end`, each at its own time */
+static void Sim_RunUntil(uint64_t end)
+{
+    while (s_tim6Armed && s_tim6DueUs <= end) {
+        s_nowUs = s_tim6DueUs;
+        s_tim6Armed = false;
+        s_tim6Flag = true;
+        if (!s_tim6IrqOn) break;        // pending until the IRQ is enabled
+        TIM6_DAC_IRQHandler();
+    }
+    s_nowUs = end;
+}
+
+uint64_t Sim_NowUs(void) { return s_nowUs; }
+void Sim_AdvanceUs(uint64_t us) { Sim_RunUntil(s_nowUs + us); }
+uint64_t Sim_BlockedUs(void) { return s_blockedUs; }
+
+uint64_t now_us(void) { return s_nowUs; }
+uint64_t now_ms(void) { return s_nowUs / 1000U; }
+
+void BSP_Delay_us(uint32_t us)
+{
+    s_blockedUs += us;
+    Sim_RunUntil(s_nowUs + us);
+}
+
+void BSP_Delay_ms(uint32_t ms) { BSP_Delay_us(ms * 1000U); }
+void BSP_Delay_100ms(void) { BSP_Delay_ms(100); }
+void BSP_Delay_500ms(void) { BSP_Delay_ms(500); }
+void BSP_Delay_1s(void) { BSP_Delay_ms(1000); }
+void BSP_Delay_3s(void) { BSP_Delay_ms(3000); }
+
+void TIMER_OnePulseInit(TIM_RegDef_t *pTIMx, uint32_t TickHz)
+{
+    (void)pTIMx;
+    s_tim6TickUs = (TickHz >= 1000000U) ? 1U : 1000000U / TickHz;
+}
+
+void TIMER_OnePulseStart(TIM_RegDef_t *pTIMx, uint16_t Ticks)
+{
+    (void)pTIMx;
+    s_tim6Armed = true;
+    s_tim6DueUs = s_nowUs + (uint64_t)((Ticks < 2U) ? 2U : Ticks) * s_tim6TickUs;
+}
+
+uint8_t TIMER_GetFlagStatus(TIM_RegDef_t *pTIMx, uint16_t TIMER_FLAG)
+{
+    (void)pTIMx;
+    return ((TIMER_FLAG & TIMER_SR_UIF) && s_tim6Flag) ? FLAG_SET : FLAG_RESET;
+}
+
+void TIMER_ClearFlag(TIM_RegDef_t *pTIMx, uint16_t TIMER_FLAG)
+{
+    (void)pTIMx;
+    if (TIMER_FLAG & TIMER_SR_UIF) s_tim6Flag = false;
+}
+
+void TIMER_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
+{
+    if (IRQNumber != TIM6_DAC_IRQn) return;
+    s_tim6IrqOn = (EnorDi == ENABLE);
+    if (s_tim6IrqOn && s_tim6Flag) TIM6_DAC_IRQHandler();
+}
+
+void TIMER_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority) { (void)IRQNumber; (void)IRQPriority; }
+
+// --- Console ---
+
+void UART_Printf(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+// --- Board ---
+static uint16_t s_ldr[2] = { 2048, 2048 };
+
+void Sim_SetLDR(uint8_t channel, uint16_t raw)
+{
+    if (channel < 2) s_ldr[channel] = raw;
+}
+
+uint16_t BSP_Sensor_ReadLDR(uint8_t channel)
+{
+    return (channel < 2) ? s_ldr[channel] : 0;
+}
+
+// --- From state_machine.c ---
+SystemContext_t g_SystemContext;
+SensorData_t g_SensorData;
+DeviceStates_t g_DeviceStates;
+
+uint32_t GetSystemTick(void)
+{
+    return (uint32_t)now_ms();
+}
+
+bool CheckTimeout(uint32_t lastTime, uint32_t interval)
+{
+    return (GetSystemTick() - lastTime) >= interval;
+}
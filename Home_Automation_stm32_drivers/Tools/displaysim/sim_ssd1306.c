@@ -0,0 +1,357 @@
+/*
+ * sim_ssd1306.c
+ *
+ * Created on: Mar 4, 2026
+ * Author: Rahul B.
+ * Description: SSD1306 emulator behind a host I2C driver (see displaysim.h)
+ */
+
+#include "displaysim.h"
+#include "bsp_i2c_oled.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SIM_OLED_FRAME_US       10000U  // about 100 Hz with D5h = F0h
+
+// --- Panel State ---
+static bool s_powered = false;
+static uint8_t s_ram[OLED_PAGES * OLED_WIDTH];
+static uint8_t s_cmd[8];
+static uint8_t s_cmdLen;
+static uint8_t s_mode;                  // 20h: 0 horizontal, 1 vertical, 2 page
+static uint8_t s_colStart, s_colEnd, s_pageStart, s_pageEnd;
+static uint8_t s_col, s_page;
+static uint8_t s_startLine;
+static bool s_displayOn, s_inverse, s_entireOn;
+
+static uint8_t s_scroll[7];             // last 26h/27h and its arguments
+static bool s_scrolling;
+static uint64_t s_scrollStartUs;
+
+static SimOledStats_t s_stats;
+static uint8_t s_lastTx[SIM_OLED_LAST_TX];
+static uint32_t s_lastTxLen;
+static uint32_t s_usPerByte;
+
+// Frames between two scroll steps, by the interval code of 26h/27h
+static const uint16_t s_scrollFrames[8] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+
+void Sim_OLED_Reset(void)
+{
+    uint32_t noise = 0x1234567U;
+
+    for (uint16_t i = 0; i < sizeof(s_ram); i++) {
+        noise = noise * 1103515245U + 12345U;
+        s_ram[i] = (uint8_t)(noise >> 16);
+    }
+    s_cmdLen = 0;
+    s_mode = 2;
+    s_colStart = s_col = 0;
+    s_colEnd = OLED_WIDTH - 1;
+    s_pageStart = s_page = 0;
+    s_pageEnd = OLED_PAGES - 1;
+    s_startLine = 0;
+    s_displayOn = s_inverse = s_entireOn = false;
+    s_scrolling = false;
+    s_lastTxLen = 0;
+    s_powered = true;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+const SimOledStats_t *Sim_OLED_GetStats(void)
+{
+    return &s_stats;
+}
+
+void Sim_OLED_ResetStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+const uint8_t *Sim_OLED_GetRAM(void)
+{
+    return s_ram;
+}
+
+bool Sim_OLED_IsOn(void)
+{
+    return s_displayOn;
+}
+
+bool Sim_OLED_IsScrolling(void)
+{
+    return s_scrolling;
+}
+
+const uint8_t *Sim_OLED_LastTransaction(uint32_t *len)
+{
+    *len = s_lastTxLen;
+    return s_lastTx;
+}
+
+void Sim_OLED_SetBusTime(uint32_t usPerByte)
+{
+    s_usPerByte = usPerByte;
+}
+
+// --- Command Interpreter ---
+
+static uint8_t Sim_OLED_Args(uint8_t cmd)
+{
+    switch (cmd) {
+    case 0x26: case 0x27:
+        return 6;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* The panel stopped where the elapsed time put it: rotate the band */
+static void Sim_OLED_StopScroll(void)
+{
+    uint8_t row[OLED_WIDTH];
+
+    if (!s_scrolling) return;
+    s_scrolling = false;
+    if (s_scroll[0] != 0x26 && s_scroll[0] != 0x27) return;
+
+    uint64_t frames = (Sim_NowUs() - s_scrollStartUs) / SIM_OLED_FRAME_US;
+    uint8_t n = (uint8_t)((frames / s_scrollFrames[s_scroll[3] & 0x07]) % OLED_WIDTH);
+
+    for (uint8_t page = s_scroll[2] & 0x07; page <= (s_scroll[4] & 0x07); page++) {
+        memcpy(row, &s_ram[page * OLED_WIDTH], OLED_WIDTH);
+        for (uint8_t x = 0; x < OLED_WIDTH; x++) {
+            uint8_t from = (s_scroll[0] == 0x27) ? (uint8_t)((x + n) % OLED_WIDTH)
+                                                 : (uint8_t)((x + OLED_WIDTH - n) % OLED_WIDTH);
+            s_ram[page * OLED_WIDTH + x] = row[from];
+        }
+    }
+}
+
+static void Sim_OLED_Command(uint8_t byte)
+{
+    s_stats.commandBytes++;
+    s_cmd[s_cmdLen++] = byte;
+    if (s_cmdLen <= Sim_OLED_Args(s_cmd[0])) return;
+    s_cmdLen = 0;
+
+    uint8_t cmd = s_cmd[0];
+
+    if (cmd <= 0x0F) {
+        if (s_mode == 2) s_col = s_colStart = (uint8_t)((s_colStart & 0xF0) | cmd);
+    } else if (cmd <= 0x1F) {
+        if (s_mode == 2) s_col = s_colStart = (uint8_t)((s_colStart & 0x0F) | ((cmd & 0x07) << 4));
+    } else if (cmd == 0x20) {
+        s_mode = s_cmd[1] & 0x03;
+    } else if (cmd == 0x21) {
+        s_colStart = s_col = s_cmd[1] & 0x7F;
+        s_colEnd = s_cmd[2] & 0x7F;
+    } else if (cmd == 0x22) {
+        s_pageStart = s_page = s_cmd[1] & 0x07;
+        s_pageEnd = s_cmd[2] & 0x07;
+    } else if (cmd == 0x26 || cmd == 0x27 || cmd == 0x29 || cmd == 0x2A) {
+        if (s_scrolling) s_stats.scrollSetupsWhileScrolling++;
+        memcpy(s_scroll, s_cmd, sizeof(s_scroll));
+    } else if (cmd == 0x2E) {
+        Sim_OLED_StopScroll();
+    } else if (cmd == 0x2F) {
+        s_scrolling = true;
+        s_scrollStartUs = Sim_NowUs();
+    } else if (cmd >= 0x40 && cmd <= 0x7F) {
+        s_startLine = cmd & 0x3F;
+    } else if (cmd == 0xA4 || cmd == 0xA5) {
+        s_entireOn = (cmd == 0xA5);
+    } else if (cmd == 0xA6 || cmd == 0xA7) {
+        s_inverse = (cmd == 0xA7);
+    } else if (cmd == 0xAE || cmd == 0xAF) {
+        s_displayOn = (cmd == 0xAF);
+    } else if (cmd >= 0xB0 && cmd <= 0xB7) {
+        if (s_mode == 2) s_page = cmd & 0x07;
+    } else if (Sim_OLED_Args(cmd) == 0 && cmd != 0xA0 && cmd != 0xA1 && cmd != 0xC0 && cmd != 0xC8 && cmd != 0xE3) {
+        s_stats.unknownCommands++;
+    }
+}
+
+static void Sim_OLED_Data(uint8_t byte)
+{
+    s_stats.dataBytes++;
+    if (s_scrolling) s_stats.ramWritesWhileScrolling++;
+    s_stats.pagesWritten |= (uint8_t)(1U << s_page);
+    s_ram[s_page * OLED_WIDTH + s_col] = byte;
+
+    if (s_mode == 0) {
+        if (s_col++ == s_colEnd) {
+            s_col = s_colStart;
+            s_page = (s_page == s_pageEnd) ? s_pageStart : (uint8_t)(s_page + 1);
+        }
+    } else if (s_mode == 1) {
+        if (s_page++ == s_pageEnd) {
+            s_page = s_pageStart;
+            s_col = (s_col == s_colEnd) ? s_colStart : (uint8_t)(s_col + 1);
+        }
+    } else {
+        s_col = (s_col == OLED_WIDTH - 1) ? s_colStart : (uint8_t)(s_col + 1);
+    }
+}
+
+/* One transaction: control byte(s), then commands or GDDRAM data.
+   Co = 1 puts a control byte before every byte, Co = 0 ends them. */
+static void Sim_OLED_Transaction(const uint8_t *buf, uint32_t len)
+{
+    uint32_t i = 0;
+
+    if (!s_powered) Sim_OLED_Reset();
+    s_stats.transactions++;
+    s_stats.bytes += len + 1;
+    s_lastTxLen = len;
+    memcpy(s_lastTx, buf, (len < sizeof(s_lastTx)) ? len : sizeof(s_lastTx));
+
+    while (i < len) {
+        uint8_t control = buf[i++];
+        bool data = (control & 0x40) != 0;
+
+        if (control & 0x80) {
+            if (i < len) {
+                if (data) Sim_OLED_Data(buf[i]);
+                else Sim_OLED_Command(buf[i]);
+                i++;
+            }
+            continue;
+        }
+        for (; i < len; i++) {
+            if (data) Sim_OLED_Data(buf[i]);
+            else Sim_OLED_Command(buf[i]);
+        }
+    }
+    if (s_usPerByte != 0U) Sim_AdvanceUs((uint64_t)(len + 1) * s_usPerByte);
+}
+
+// --- Glass ---
+
+bool Sim_OLED_Pixel(uint8_t x, uint8_t y)
+{
+    if (!s_displayOn) return false;
+    if (s_entireOn) return true;
+
+    uint8_t row = (uint8_t)((y + s_startLine) % OLED_HEIGHT);
+    bool lit = (s_ram[(row / 8) * OLED_WIDTH + x] >> (row % 8)) & 1U;
+    return lit != s_inverse;
+}
+
+bool Sim_OLED_WritePBM(const char *path)
+{
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) return false;
+    fprintf(f, "P1\n%d %d\n", OLED_WIDTH, OLED_HEIGHT);
+    for (uint8_t y = 0; y < OLED_HEIGHT; y++) {
+        for (uint8_t x = 0; x < OLED_WIDTH; x++) fputc(Sim_OLED_Pixel(x, y) ? '1' : '0', f);
+        fputc('\n', f);
+    }
+    return fclose(f) == 0;
+}
+
+// --- I2C1 / DMA1 Driver ---
+
+static I2C_RegDef_t s_i2cRegs;
+static bool s_inDma = false;
+static I2C_Handle_t *s_dmaHandle;
+static uint8_t *s_dmaBuf;
+static uint32_t s_dmaLen;
+
+// Deferred DMA: the transaction waits here for Sim_OLED_DmaStep()
+static bool s_dmaDeferred = false;
+static uint8_t s_dmaPending[OLED_WIDTH + 1];
+static uint32_t s_dmaPendingLen;
+
+void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxbuffer, uint32_t Len, uint8_t SlaveAddr, uint8_t Sr)
+{
+    (void)pI2CHandle; (void)Sr;
+    if (SlaveAddr == OLED_I2C_ADDR) Sim_OLED_Transaction(pTxbuffer, Len);
+}
+
+/* Completes at once. A transfer started from the completion callback is
+   queued and run by the outer call, so a frame does not nest a call per
+   transaction. */
+uint8_t I2C_MasterSendDataDMA(I2C_Handle_t *pI2CHandle, uint8_t *pTxbuffer, uint32_t Len, uint8_t SlaveAddr, uint8_t Sr)
+{
+    (void)Sr;
+    if (SlaveAddr != OLED_I2C_ADDR) return I2C_READY;
+
+    if (s_dmaDeferred) {
+        if (s_dmaPendingLen != 0U) return I2C_BUSY_IN_TX;
+        if (Len > sizeof(s_dmaPending)) Len = sizeof(s_dmaPending);
+        memcpy(s_dmaPending, pTxbuffer, Len);
+        s_dmaPendingLen = Len;
+        s_dmaHandle = pI2CHandle;
+        return I2C_READY;
+    }
+
+    s_dmaHandle = pI2CHandle;
+    s_dmaBuf = pTxbuffer;
+    s_dmaLen = Len;
+    if (s_inDma) return I2C_READY;
+
+    s_inDma = true;
+    while (s_dmaBuf != NULL) {
+        uint8_t *buf = s_dmaBuf;
+
+        s_dmaBuf = NULL;
+        Sim_OLED_Transaction(buf, s_dmaLen);
+        if (s_dmaHandle->pCallback != NULL) s_dmaHandle->pCallback(s_dmaHandle, I2C_EV_TX_CMPLT);
+    }
+    s_inDma = false;
+    return I2C_READY;
+}
+
+void Sim_OLED_SetDmaDeferred(bool deferred)
+{
+    s_dmaDeferred = deferred;
+    s_dmaPendingLen = 0;
+}
+
+/* The copy goes to the panel before the callback, which may queue the next */
+bool Sim_OLED_DmaStep(void)
+{
+    uint32_t len = s_dmaPendingLen;
+
+    if (len == 0U) return false;
+    s_dmaPendingLen = 0;
+    Sim_OLED_Transaction(s_dmaPending, len);
+    if (s_dmaHandle->pCallback != NULL) s_dmaHandle->pCallback(s_dmaHandle, I2C_EV_TX_CMPLT);
+    return true;
+}
+
+bool Sim_OLED_DmaFail(void)
+{
+    if (s_dmaPendingLen == 0U) return false;
+    s_dmaPendingLen = 0;
+    if (s_dmaHandle->pCallback != NULL) s_dmaHandle->pCallback(s_dmaHandle, I2C_ERROR_AF);
+    return true;
+}
+
+/* I2C1 is a register block in RAM, so what the BSP writes (a STOP after an
+   error) can be read back through the handle */
+void I2C_Init(I2C_Handle_t *pI2CHandle)
+{
+    memset(&s_i2cRegs, 0, sizeof(s_i2cRegs));
+    pI2CHandle->pI2Cx = &s_i2cRegs;
+}
+
+void I2C_PeripheralControl(I2C_RegDef_t *pI2Cx, uint8_t EnOrDi) { (void)pI2Cx; (void)EnOrDi; }
+void I2C_CloseSendData(I2C_Handle_t *pI2CHandle) { (void)pI2CHandle; }
+void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle) { (void)pI2CHandle; }
+void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle) { (void)pI2CHandle; }
+void I2C_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi) { (void)IRQNumber; (void)EnorDi; }
+void I2C_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority) { (void)IRQNumber; (void)IRQPriority; }
+void DMA_Init(DMA_Handle_t *pDMAHandle) { (void)pDMAHandle; }
+void DMA_IRQHandling(DMA_Handle_t *pDMAHandle) { (void)pDMAHandle; }
+uint8_t DMA_GetIRQNumber(DMA_RegDef_t *pDMAx, uint8_t Stream) { (void)pDMAx; return Stream; }
+void DMA_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi) { (void)IRQNumber; (void)EnorDi; }
+void DMA_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority) { (void)IRQNumber; (void)IRQPriority; }
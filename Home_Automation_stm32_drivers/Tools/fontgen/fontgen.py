@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+"""
+fontgen.py
+
+Created on: Feb 28, 2026
+Author: Rahul B.
+Description: Builds the OLED font tables (BSP/Src/bsp_oled_font_data.c)
+             from the font descriptions in Tools/fontgen/fonts
+
+Usage (from the project directory):
+
+    python3 Tools/fontgen/fontgen.py            regenerate the tables
+    python3 Tools/fontgen/fontgen.py --check    exit 1 if they are stale
+
+Font description (.fnt), one directive per line, '#' starts a comment:
+
+    name     Small8         C name: Font_<name>
+    height   8              rows, a multiple of 8
+    spacing  1              blank columns after every glyph
+    trim     yes            yes: proportional, blank columns around the ink
+                            are dropped; no: leading blanks are kept as
+                            xOffset, the cell is the art width (tabular)
+    fallback ' '            drawn for characters not in the font
+    kern     T . -1         cell of T is 1 column narrower before '.'
+                            (characters bare, 'c' or 0xNN)
+    derive   small8.fnt 2   glyphs and kerning of another font, scaled x2
+                            (height and spacing scale too unless given)
+
+    glyph 'A'               then `height` rows of art, '#' = on, '.' = off
+    glyph 0x27 advance 3    character as hex; advance overrides the cell
+
+Characters are 'c' or 0xNN. The cell of a glyph is its art width (or
+the inked width with trim) plus spacing. Kerning may only remove blank
+columns: a pair that would cut into the ink of the left glyph is an
+error, since glyphs are drawn opaque.
+"""
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+FONTS_DIR = os.path.join(HERE, "fonts")
+OUTPUT = os.path.normpath(os.path.join(HERE, "..", "..", "BSP", "Src", "bsp_oled_font_data.c"))
+
+# Fonts in the order they are written out
+FONTS = ["small8.fnt", "medium16.fnt", "digits24.fnt"]
+
+
+class FontError(Exception):
+    pass
+
+
+def parse_char(token, where):
+    if len(token) == 3 and token[0] == "'" and token[2] == "'":
+        return token[1]
+    if token.lower().startswith("0x"):
+        return chr(int(token, 16))
+    raise FontError("%s: bad character %r (use 'c' or 0xNN)" % (where, token))
+
+
+def load(filename):
+    """Parse a .fnt file into a dict; glyph art is a list of row strings"""
+    path = os.path.join(FONTS_DIR, filename)
+    font = {"file": filename, "glyphs": {}, "advance": {}, "kerning": {}, "trim": True}
+    lines = open(path).read().splitlines()
+    i = 0
+
+    while i < len(lines):
+        where = "%s:%d" % (filename, i + 1)
+        words = re.findall(r"'.'|\S+", lines[i])
+        for n, word in enumerate(words):
+            if word.startswith("#"):
+                words = words[:n]
+                break
+        i += 1
+        if not words:
+            continue
+        key = words[0]
+
+        if key in ("name", "height", "spacing", "trim", "fallback") and len(words) == 2:
+            if key in ("height", "spacing"):
+                font[key] = int(words[1])
+            elif key == "trim":
+                font[key] = words[1] == "yes"
+            elif key == "fallback":
+                font[key] = parse_char(words[1], where)
+            else:
+                font[key] = words[1]
+        elif key == "kern" and len(words) == 4:
+            pair = tuple(w if len(w) == 1 else parse_char(w, where) for w in words[1:3])
+            font["kerning"][pair] = int(words[3])
+        elif key == "derive" and len(words) == 3:
+            base = load(words[1])
+            scale = int(words[2])
+            font["derive"] = (base, scale)
+        elif key == "glyph":
+            c = parse_char(words[1], where)
+            if len(words) == 4 and words[2] == "advance":
+                font["advance"][c] = int(words[3])
+            elif len(words) != 2:
+                raise FontError("%s: glyph <char> [advance N]" % where)
+            rows = [r.strip() for r in lines[i:i + font["height"]]]
+            i += font["height"]
+            widths = set(len(r) for r in rows)
+            if len(rows) != font["height"] or len(widths) != 1 or any(set(r) - set("#.") for r in rows):
+                raise FontError("%s: glyph %r needs %d rows of '#' and '.', all the same length"
+                                % (where, c, font["height"]))
+            font["glyphs"][c] = rows
+        else:
+            raise FontError("%s: cannot parse %r" % (where, lines[i - 1]))
+
+    if "derive" in font:
+        apply_derive(font)
+    for key in ("name", "height", "spacing", "fallback"):
+        if key not in font:
+            raise FontError("%s: missing '%s'" % (filename, key))
+    if font["height"] % 8:
+        raise FontError("%s: height must be a multiple of 8" % filename)
+    if font["fallback"] not in font["glyphs"]:
+        raise FontError("%s: fallback %r has no glyph" % (filename, font["fallback"]))
+    return font
+
+
+def apply_derive(font):
+    """Take over the glyphs of the base font, every pixel scale x scale"""
+    base, scale = font["derive"]
+    font.setdefault("height", base["height"] * scale)
+    font.setdefault("spacing", base["spacing"] * scale)
+    font.setdefault("fallback", base["fallback"])
+    font["trim"] = base["trim"]
+    for c, rows in base["glyphs"].items():
+        if c in font["glyphs"]:
+            continue
+        scaled = ["".join(p * scale for p in row) for row in rows for _ in range(scale)]
+        font["glyphs"][c] = scaled[:font["height"]] + ["." * len(scaled[0])] * (font["height"] - len(scaled))
+    for c, adv in base["advance"].items():
+        font["advance"].setdefault(c, adv * scale)
+    for pair, adj in base["kerning"].items():
+        font["kerning"].setdefault(pair, adj * scale)
+
+
+def build(font):
+    """Glyph table, packed bitmap and kerning of one font"""
+    pages = font["height"] // 8
+    chars = sorted(font["glyphs"])
+    first, last = chars[0], chars[-1]
+    bitmap, glyphs = [], {}
+
+    for c in chars:
+        rows = font["glyphs"][c]
+        width = len(rows[0])
+        cols = [sum(1 << r for r in range(font["height"]) if rows[r][x] == "#") for x in range(width)]
+        inked = [x for x in range(width) if cols[x]]
+        lo = inked[0] if inked else 0
+        hi = inked[-1] if inked else -1
+
+        if font["trim"]:
+            x_offset, cell = 0, (hi - lo + 1) + font["spacing"]
+        else:
+            x_offset, cell = lo, width + font["spacing"]
+        cell = font["advance"].get(c, cell)
+        if cell <= 0 or cell > 255 or x_offset + (hi - lo + 1) > cell:
+            raise FontError("%s: glyph %r does not fit its cell" % (font["file"], c))
+
+        offset = len(bitmap)
+        for x in range(lo, hi + 1):
+            bitmap.extend((cols[x] >> (8 * p)) & 0xFF for p in range(pages))
+        glyphs[c] = (offset, hi - lo + 1, x_offset, cell)
+
+    kerning = []
+    for (l, r), adj in sorted(font["kerning"].items()):
+        if l not in glyphs or r not in glyphs:
+            raise FontError("%s: kerning pair %r%r not in the font" % (font["file"], l, r))
+        offset, width, x_offset, cell = glyphs[l]
+        if cell + adj < x_offset + width or not -128 <= adj <= 127:
+            raise FontError("%s: kerning %r%r %d cuts into the ink" % (font["file"], l, r, adj))
+        kerning.append((l, r, adj))
+
+    if len(bitmap) > 0xFFFF:
+        raise FontError("%s: bitmap over 64 KB" % font["file"])
+    return {"pages": pages, "first": first, "last": last, "bitmap": bitmap,
+            "glyphs": glyphs, "kerning": kerning}
+
+
+def c_char(c):
+    return "'\\''" if c == "'" else "'\\\\'" if c == "\\" else "'%s'" % c
+
+
+def emit(fonts):
+    out = []
+    out.append("/*")
+    out.append(" * bsp_oled_font_data.c")
+    out.append(" *")
+    out.append(" * Generated by Tools/fontgen/fontgen.py from " + ", ".join(FONTS) + ".")
+    out.append(" * Do not edit: change the .fnt file and run the generator.")
+    out.append(" */")
+    out.append("")
+    out.append('#include "bsp_oled_font.h"')
+    out.append("#include <stddef.h>")
+
+    for font in fonts:
+        t = build(font)
+        n = font["name"]
+        count = ord(t["last"]) - ord(t["first"]) + 1
+        out.append("")
+        out.append("/* ===== %s: %d px, %s..%s, %d glyphs, %d bytes ===== */"
+                   % (n.upper(), font["height"], c_char(t["first"]), c_char(t["last"]),
+                      len(t["glyphs"]), len(t["bitmap"])))
+        out.append("static const uint8_t %s_Bitmap[] = {" % n)
+        for c in sorted(t["glyphs"]):
+            offset, width, _, _ = t["glyphs"][c]
+            data = t["bitmap"][offset:offset + width * t["pages"]]
+            for start in range(0, len(data), 12):
+                chunk = ", ".join("0x%02X" % b for b in data[start:start + 12]) + ","
+                out.append("    %-72s%s" % (chunk, "// " + c_char(c) if start == 0 else ""))
+        if not t["bitmap"]:
+            out.append("    0x00,")
+        out.append("};")
+        out.append("")
+        out.append("static const OledGlyph_t %s_Glyphs[%d] = {" % (n, count))
+        for code in range(ord(t["first"]), ord(t["last"]) + 1):
+            c = chr(code)
+            if c in t["glyphs"]:
+                offset, width, x_offset, cell = t["glyphs"][c]
+                out.append("    { %5d, %3d, %3d, %3d },   // %s" % (offset, width, x_offset, cell, c_char(c)))
+            else:
+                out.append("    {     0,   0,   0,   0 },   // %s (not in the font)" % c_char(c))
+        out.append("};")
+        if t["kerning"]:
+            out.append("")
+            out.append("static const OledKern_t %s_Kerning[%d] = {" % (n, len(t["kerning"])))
+            for l, r, adj in t["kerning"]:
+                out.append("    { %s, %s, %d }," % (c_char(l), c_char(r), adj))
+            out.append("};")
+        out.append("")
+        out.append("const OledFont_t Font_%s = {" % n)
+        out.append('    .name       = "%s",' % n)
+        out.append("    .height     = %d," % font["height"])
+        out.append("    .pages      = %d," % t["pages"])
+        out.append("    .first      = %s," % c_char(t["first"]))
+        out.append("    .last       = %s," % c_char(t["last"]))
+        out.append("    .fallback   = %s," % c_char(font["fallback"]))
+        out.append("    .glyphs     = %s_Glyphs," % n)
+        out.append("    .bitmap     = %s_Bitmap," % n)
+        out.append("    .bitmapSize = sizeof(%s_Bitmap)," % n)
+        out.append("    .kerning    = %s," % ("%s_Kerning" % n if t["kerning"] else "NULL"))
+        out.append("    .kernCount  = %d," % len(t["kerning"]))
+        out.append("};")
+
+    return "\n".join(out) + "\n"
+
+
+def main():
+    try:
+        text = emit([load(f) for f in FONTS])
+    except FontError as e:
+        sys.stderr.write("fontgen: %s\n" % e)
+        return 2
+
+    if "--check" in sys.argv[1:]:
+        current = open(OUTPUT).read() if os.path.exists(OUTPUT) else ""
+        if current != text:
+            sys.stderr.write("fontgen: %s is out of date, run Tools/fontgen/fontgen.py\n" % OUTPUT)
+            return 1
+        return 0
+
+    with open(OUTPUT, "w") as f:
+        f.write(text)
+    print("fontgen: wrote %s" % OUTPUT)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+imagegen.py
+
+Created on: Mar 3, 2026
+Author: Rahul B.
+Description: Builds the compressed OLED images and animations
+             (BSP/Src/bsp_oled_image_data.c) from the PBM files in
+             Tools/imagegen/images
+
+Usage (from the project directory):
+
+    python3 Tools/imagegen/imagegen.py            regenerate the tables
+    python3 Tools/imagegen/imagegen.py --check    exit 1 if they are stale
+
+Images are 128x64 PBM files (P1 text or P4 binary, as GIMP exports them);
+1 (black in a viewer) is a lit pixel. An animation is a list of them.
+
+Encoded format (see bsp_oled_image.h), per frame:
+
+    mask        1 byte, bit p set = page p follows
+    page        packets until 128 column bytes are produced:
+                  0x00..0x7F  n + 1 literal bytes follow
+                  0x80..0xFF  the next byte, (n & 0x7F) + 1 times
+
+Frame 0 holds all 8 pages. Each later frame holds only the pages that
+differ from the frame before, and one more frame takes the last back to
+the first, so a looping animation never redraws unchanged pages.
+"""
+
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+IMAGES_DIR = os.path.join(HERE, "images")
+OUTPUT = os.path.normpath(os.path.join(HERE, "..", "..", "BSP", "Src", "bsp_oled_image_data.c"))
+
+WIDTH, HEIGHT, PAGES = 128, 64, 8
+
+# C name, frames, ms per frame (0 for a still image)
+ASSETS = [
+    ("Image_Face", ["face.pbm"], 0),
+    ("Anim_Heart", ["heart_0.pbm", "heart_1.pbm"], 200),
+]
+
+
+class ImageError(Exception):
+    pass
+
+
+def load_pbm(filename):
+    """Frame buffer layout of a PBM: page by page, one byte per column, LSB on top"""
+    raw = open(os.path.join(IMAGES_DIR, filename), "rb").read()
+
+    # Header: magic, width, height; '#' comments anywhere before the raster
+    fields, pos = [], 0
+    while len(fields) < 3:
+        while raw[pos:pos + 1].isspace():
+            pos += 1
+        if raw[pos:pos + 1] == b"#":
+            pos = raw.index(b"\n", pos)
+            continue
+        end = pos
+        while end < len(raw) and not raw[end:end + 1].isspace():
+            end += 1
+        fields.append(raw[pos:end].decode())
+        pos = end
+    magic, width, height = fields[0], int(fields[1]), int(fields[2])
+    if (width, height) != (WIDTH, HEIGHT):
+        raise ImageError("%s: %dx%d, must be %dx%d" % (filename, width, height, WIDTH, HEIGHT))
+
+    if magic == "P1":
+        bits = [int(c) for c in raw[pos:].decode() if c in "01"]
+    elif magic == "P4":
+        stride = (width + 7) // 8
+        data = raw[pos + 1:]
+        bits = [(data[y * stride + x // 8] >> (7 - x % 8)) & 1 for y in range(height) for x in range(width)]
+    else:
+        raise ImageError("%s: not a PBM (P1 or P4)" % filename)
+    if len(bits) < width * height:
+        raise ImageError("%s: raster is short" % filename)
+
+    frame = bytearray(WIDTH * PAGES)
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            if bits[y * width + x]:
+                frame[(y // 8) * WIDTH + x] |= 1 << (y % 8)
+    return bytes(frame)
+
+
+def encode_page(row):
+    """Packets of one 128 byte page row: runs of 3 or more repeat, the rest literal"""
+    out, literal, i = [], [], 0
+
+    def flush():
+        if literal:
+            out.append(len(literal) - 1)
+            out.extend(literal)
+            del literal[:]
+
+    while i < len(row):
+        run = 1
+        while i + run < len(row) and run < 128 and row[i + run] == row[i]:
+            run += 1
+        if run >= 3:
+            flush()
+            out.extend((0x80 | (run - 1), row[i]))
+            i += run
+        else:
+            literal.append(row[i])
+            i += 1
+            if len(literal) == 128:
+                flush()
+    flush()
+    return out
+
+
+def encode_frame(frame, previous):
+    """Mask byte, then the pages that differ from previous (all if None)"""
+    mask, out = 0, []
+    for page in range(PAGES):
+        row = frame[page * WIDTH:(page + 1) * WIDTH]
+        if previous is not None and row == previous[page * WIDTH:(page + 1) * WIDTH]:
+            continue
+        mask |= 1 << page
+        out.extend(encode_page(row))
+    return [mask] + out
+
+
+def decode_frame(data, pos, frame):
+    """The decoder of bsp_oled_image.c, to check every frame round trips"""
+    mask = data[pos]
+    pos += 1
+    for page in range(PAGES):
+        if not mask & (1 << page):
+            continue
+        col = 0
+        while col < WIDTH:
+            head = data[pos]
+            count = (head & 0x7F) + 1
+            if head & 0x80:
+                frame[page * WIDTH + col:page * WIDTH + col + count] = bytes([data[pos + 1]]) * count
+                pos += 2
+            else:
+                frame[page * WIDTH + col:page * WIDTH + col + count] = bytes(data[pos + 1:pos + 1 + count])
+                pos += 1 + count
+            col += count
+        if col != WIDTH:
+            raise ImageError("page %d decodes to %d bytes" % (page, col))
+    return pos
+
+
+def build(name, files, frame_ms):
+    frames = [load_pbm(f) for f in files]
+    data, offsets = [], []
+
+    # Frames, then the loop frame (last -> first)
+    sequence = [(frames[0], None)] + [(frames[i], frames[i - 1]) for i in range(1, len(frames))]
+    sequence.append((frames[0], frames[-1]))
+    for frame, previous in sequence:
+        offsets.append(len(data))
+        data.extend(encode_frame(frame, previous))
+
+    screen = bytearray(WIDTH * PAGES)
+    for i, (frame, _) in enumerate(sequence):
+        decode_frame(data, offsets[i], screen)
+        if bytes(screen) != frame:
+            raise ImageError("%s: frame %d does not round trip" % (name, i))
+    if len(data) > 0xFFFF:
+        raise ImageError("%s: over 64 KB" % name)
+    return {"frames": len(frames), "ms": frame_ms, "data": data, "offsets": offsets,
+            "raw": len(frames) * WIDTH * PAGES}
+
+
+def emit(assets):
+    out = []
+    out.append("/*")
+    out.append(" * bsp_oled_image_data.c")
+    out.append(" *")
+    out.append(" * Generated by Tools/imagegen/imagegen.py from Tools/imagegen/images.")
+    out.append(" * Do not edit: change the .pbm files and run the generator.")
+    out.append(" */")
+    out.append("")
+    out.append('#include "bsp_oled_image.h"')
+
+    for name, files, frame_ms in assets:
+        t = build(name, files, frame_ms)
+        out.append("")
+        out.append("/* ===== %s: %s, %d bytes (raw %d) ===== */"
+                   % (name.upper(), ", ".join(files), len(t["data"]), t["raw"]))
+        out.append("static const uint8_t %s_Data[] = {" % name)
+        for i, start in enumerate(t["offsets"]):
+            end = t["offsets"][i + 1] if i + 1 < len(t["offsets"]) else len(t["data"])
+            label = "frame %d" % i if i < t["frames"] else "loop: frame %d -> 0" % (t["frames"] - 1)
+            out.append("    // %s, pages 0x%02X" % (label, t["data"][start]))
+            chunk = t["data"][start:end]
+            for k in range(0, len(chunk), 16):
+                out.append("    " + " ".join("0x%02X," % b for b in chunk[k:k + 16]))
+        out.append("};")
+        out.append("")
+        out.append("static const uint16_t %s_Frames[%d] = { %s };"
+                   % (name, len(t["offsets"]), ", ".join(str(o) for o in t["offsets"])))
+        out.append("")
+        out.append("const OledImage_t %s = {" % name)
+        out.append("    .frameCount = %d," % t["frames"])
+        out.append("    .frameMs    = %d," % t["ms"])
+        out.append("    .data       = %s_Data," % name)
+        out.append("    .frames     = %s_Frames," % name)
+        out.append("    .size       = sizeof(%s_Data)," % name)
+        out.append("};")
+
+    return "\n".join(out) + "\n"
+
+
+def main():
+    try:
+        text = emit(ASSETS)
+    except (ImageError, OSError) as e:
+        sys.stderr.write("imagegen: %s\n" % e)
+        return 2
+
+    if "--check" in sys.argv[1:]:
+        current = open(OUTPUT).read() if os.path.exists(OUTPUT) else ""
+        if current != text:
+            sys.stderr.write("imagegen: %s is out of date, run Tools/imagegen/imagegen.py\n" % OUTPUT)
+            return 1
+        return 0
+
+    with open(OUTPUT, "w") as f:
+        f.write(text)
+    print("imagegen: wrote %s" % OUTPUT)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())